@@ -165,6 +165,7 @@ CC_CONSTRUCTOR_ACCESS:
     virtual ~Action();
 
 protected:
+    friend class ActionManager;
     Node    *_originalTarget;
     /** 
      * The "target".
@@ -28,6 +28,7 @@
 #include "2d/CCActionInstant.h"
 #include "2d/CCNode.h"
 #include "2d/CCSprite.h"
+#include "base/allocator/CCAllocatorStrategyPool.h"
 
 #if defined(__GNUC__) && ((__GNUC__ >= 4) || ((__GNUC__ == 3) && (__GNUC_MINOR__ >= 1)))
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
@@ -37,6 +38,12 @@
 #endif
 
 NS_CC_BEGIN
+
+#if CC_ENABLE_ACTION_POOL
+CC_DEFINE_ALLOCATOR_POOL(CallFunc, 100)
+CC_DEFINE_ALLOCATOR_POOL(CallFuncN, 100)
+#endif
+
 //
 // InstantAction
 //
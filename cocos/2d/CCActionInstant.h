@@ -30,6 +30,7 @@ THE SOFTWARE.
 
 #include <functional>
 #include "2d/CCAction.h"
+#include "base/allocator/CCAllocatorMacros.h"
 
 NS_CC_BEGIN
 
@@ -318,6 +319,10 @@ private:
 class CC_DLL CallFunc : public ActionInstant //<NSCopying>
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** Creates the action with the callback of type std::function<void()>.
      This is the preferred way to create the callback.
      * When this funtion bound in js or lua ,the input param will be changed.
@@ -419,6 +424,10 @@ private:
 class CC_DLL CallFuncN : public CallFunc
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** Creates the action with the callback of type std::function<void()>.
      This is the preferred way to create the callback.
      *
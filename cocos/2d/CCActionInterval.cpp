@@ -38,9 +38,28 @@ THE SOFTWARE.
 #include "base/CCEventDispatcher.h"
 #include "platform/CCStdC.h"
 #include "base/CCScriptSupport.h"
+#include "base/allocator/CCAllocatorStrategyPool.h"
 
 NS_CC_BEGIN
 
+#if CC_ENABLE_ACTION_POOL
+CC_DEFINE_ALLOCATOR_POOL(Sequence, 100)
+CC_DEFINE_ALLOCATOR_POOL(Repeat, 100)
+CC_DEFINE_ALLOCATOR_POOL(RepeatForever, 100)
+CC_DEFINE_ALLOCATOR_POOL(Spawn, 100)
+CC_DEFINE_ALLOCATOR_POOL(RotateTo, 100)
+CC_DEFINE_ALLOCATOR_POOL(RotateBy, 100)
+CC_DEFINE_ALLOCATOR_POOL(MoveBy, 100)
+CC_DEFINE_ALLOCATOR_POOL(MoveTo, 100)
+CC_DEFINE_ALLOCATOR_POOL(ScaleTo, 100)
+CC_DEFINE_ALLOCATOR_POOL(ScaleBy, 100)
+CC_DEFINE_ALLOCATOR_POOL(FadeTo, 100)
+CC_DEFINE_ALLOCATOR_POOL(FadeIn, 100)
+CC_DEFINE_ALLOCATOR_POOL(FadeOut, 100)
+CC_DEFINE_ALLOCATOR_POOL(TintTo, 100)
+CC_DEFINE_ALLOCATOR_POOL(DelayTime, 100)
+#endif
+
 // Extra action for making a Sequence or Spawn when only adding one action to it.
 class ExtraAction : public FiniteTimeAction
 {
@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "2d/CCAnimation.h"
 #include "base/CCProtocols.h"
 #include "base/CCVector.h"
+#include "base/allocator/CCAllocatorMacros.h"
 
 NS_CC_BEGIN
 
@@ -110,6 +111,7 @@ CC_CONSTRUCTOR_ACCESS:
     bool initWithDuration(float d);
 
 protected:
+    friend class ActionManager;
     float _elapsed;
     bool   _firstTick;
 
@@ -123,6 +125,10 @@ protected:
 class CC_DLL Sequence : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** Helper constructor to create an array of sequenceable actions.
      *
      * @return An autoreleased Sequence object.
@@ -209,6 +215,10 @@ private:
 class CC_DLL Repeat : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** Creates a Repeat action. Times is an unsigned integer between 1 and pow(2,30).
      *
      * @param action The action needs to repeat.
@@ -280,6 +290,10 @@ private:
 class CC_DLL RepeatForever : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** Creates the action.
      *
      * @param action The action need to repeat forever.
@@ -345,6 +359,10 @@ private:
 class CC_DLL Spawn : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** Helper constructor to create an array of spawned actions.
      * @code
      * When this funtion bound to the js or lua, the input params changed.
@@ -433,6 +451,10 @@ private:
 class CC_DLL RotateTo : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates the action with separate rotation angles.
      *
@@ -495,6 +517,7 @@ CC_CONSTRUCTOR_ACCESS:
     void calculateAngles(float &startAngle, float &diffAngle, float dstAngle);
     
 protected:
+    friend class ActionManager;
     bool _is3D;
     Vec3 _dstAngle;
     Vec3 _startAngle;
@@ -510,6 +533,10 @@ private:
 class CC_DLL RotateBy : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates the action.
      *
@@ -562,6 +589,7 @@ CC_CONSTRUCTOR_ACCESS:
     bool initWithDuration(float duration, const Vec3& deltaAngle3D);
     
 protected:
+    friend class ActionManager;
     bool _is3D;
     Vec3 _deltaAngle;
     Vec3 _startAngle;
@@ -580,6 +608,10 @@ private:
 class CC_DLL MoveBy : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates the action.
      *
@@ -617,6 +649,7 @@ CC_CONSTRUCTOR_ACCESS:
     bool initWithDuration(float duration, const Vec3& deltaPosition);
 
 protected:
+    friend class ActionManager;
     bool _is3D;
     Vec3 _positionDelta;
     Vec3 _startPosition;
@@ -635,6 +668,10 @@ private:
 class CC_DLL MoveTo : public MoveBy
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates the action.
      * @param duration Duration time, in seconds.
@@ -959,6 +996,10 @@ private:
 class CC_DLL ScaleTo : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates the action with the same scale factor for X and Y.
      * @param duration Duration time, in seconds.
@@ -1018,6 +1059,7 @@ CC_CONSTRUCTOR_ACCESS:
     bool initWithDuration(float duration, float sx, float sy, float sz);
 
 protected:
+    friend class ActionManager;
     float _scaleX;
     float _scaleY;
     float _scaleZ;
@@ -1042,6 +1084,10 @@ private:
 class CC_DLL ScaleBy : public ScaleTo
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates the action with the same scale factor for X and Y.
      * @param duration Duration time, in seconds.
@@ -1136,6 +1182,10 @@ private:
 class CC_DLL FadeTo : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates an action with duration and opacity.
      * @param duration Duration time, in seconds.
@@ -1170,6 +1220,7 @@ protected:
     GLubyte _fromOpacity;
     friend class FadeOut;
     friend class FadeIn;
+    friend class ActionManager;
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(FadeTo);
 };
@@ -1181,6 +1232,10 @@ private:
 class CC_DLL FadeIn : public FadeTo
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates the action.
      * @param d Duration time, in seconds.
@@ -1216,6 +1271,10 @@ private:
 class CC_DLL FadeOut : public FadeTo
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates the action.
      * @param d Duration time, in seconds.
@@ -1250,6 +1309,10 @@ private:
 class CC_DLL TintTo : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates an action with duration and color.
      * @param duration Duration time, in seconds.
@@ -1286,6 +1349,7 @@ CC_CONSTRUCTOR_ACCESS:
     bool initWithDuration(float duration, GLubyte red, GLubyte green, GLubyte blue);
 
 protected:
+    friend class ActionManager;
     Color3B _to;
     Color3B _from;
 
@@ -1347,6 +1411,10 @@ private:
 class CC_DLL DelayTime : public ActionInterval
 {
 public:
+#if CC_ENABLE_ACTION_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /** 
      * Creates the action.
      * @param d Duration time, in seconds.
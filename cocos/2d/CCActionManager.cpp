@@ -25,36 +25,147 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
-
 #include "2d/CCActionManager.h"
+
+#include <algorithm>
+#include <cfloat>
+
 #include "2d/CCNode.h"
 #include "2d/CCAction.h"
+#include "2d/CCActionInterval.h"
 #include "base/CCScheduler.h"
 #include "base/ccMacros.h"
-#include "base/ccCArray.h"
-#include "base/uthash.h"
 
 NS_CC_BEGIN
-//
-// singleton stuff
-//
-typedef struct _hashElement
+
+// Kinds of TweenBatch. Only these exact types are batched, subclasses may override update().
+enum
 {
-    struct _ccArray     *actions;
-    Node                *target;
-    int                 actionIndex;
-    Action              *currentAction;
-    bool                currentActionSalvaged;
-    bool                paused;
-    UT_hash_handle      hh;
-} tHashElement;
+    TWEEN_NONE = -1,
+    TWEEN_POSITION,     // MoveBy, MoveTo
+    TWEEN_SCALE,        // ScaleTo, ScaleBy
+    TWEEN_ROTATION,     // RotateTo, RotateBy
+    TWEEN_OPACITY,      // FadeTo, FadeIn, FadeOut
+    TWEEN_COLOR,        // TintTo
+    TWEEN_KIND_COUNT
+};
+
+// TweenBatch::mode values of the rotation batch, the setter RotateTo/RotateBy::update() would use
+enum
+{
+    TWEEN_ROTATION_3D,
+    TWEEN_ROTATION_ANGLE,
+    TWEEN_ROTATION_SKEW
+};
+
+// The common interval actions only interpolate a node property from a start value.
+// Instead of calling the virtual step() of each of them, the actions of a kind are
+// evaluated together in plain loops over contiguous arrays, which the compiler can
+// vectorize, and the results are written back to the nodes afterwards.
+struct ActionManager::TweenBatch
+{
+    static const int MAX_COMPONENTS = 3;
+
+    std::vector<ActionInterval*> actions;   // not retained, nullptr when removed during update
+    std::vector<SlotIndex> targetSlots;
+    std::vector<float> elapsed;
+    std::vector<float> duration;
+    std::vector<float> started;             // 0 before the first step, see ActionInterval::_firstTick
+    std::vector<float> running;             // 0 when the target is paused
+    std::vector<float> time;
+    std::vector<float> start[MAX_COMPONENTS];
+    std::vector<float> delta[MAX_COMPONENTS];
+    std::vector<float> value[MAX_COMPONENTS];
+    std::vector<float> previous[MAX_COMPONENTS];    // MoveBy::_previousPosition
+    std::vector<unsigned char> mode;
+    int components;
+    size_t removed;
+
+    TweenBatch()
+    : components(MAX_COMPONENTS)
+    , removed(0)
+    {
+    }
+
+    size_t size() const { return actions.size(); }
+
+    void resize(size_t count)
+    {
+        actions.resize(count);
+        targetSlots.resize(count);
+        elapsed.resize(count);
+        duration.resize(count);
+        started.resize(count);
+        running.resize(count);
+        time.resize(count);
+        for (int c = 0; c < components; ++c)
+        {
+            start[c].resize(count);
+            delta[c].resize(count);
+            value[c].resize(count);
+            previous[c].resize(count);
+        }
+        mode.resize(count);
+    }
+
+    void move(size_t from, size_t to)
+    {
+        actions[to] = actions[from];
+        targetSlots[to] = targetSlots[from];
+        elapsed[to] = elapsed[from];
+        duration[to] = duration[from];
+        started[to] = started[from];
+        running[to] = running[from];
+        time[to] = time[from];
+        for (int c = 0; c < components; ++c)
+        {
+            start[c][to] = start[c][from];
+            delta[c][to] = delta[c][from];
+            value[c][to] = value[c][from];
+            previous[c][to] = previous[c][from];
+        }
+        mode[to] = mode[from];
+    }
+
+    // Same as ActionInterval::step() followed by the update() of the actions, without the node setters
+    void evaluate(float dt)
+    {
+        const size_t count = size();
+        float* e = elapsed.data();
+        float* s = started.data();
+        float* t = time.data();
+        const float* d = duration.data();
+        const float* r = running.data();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            // the first step starts at 0, paused actions keep their time
+            const float next = s[i] * (e[i] + dt);
+            e[i] = (r[i] != 0.0f) ? next : e[i];
+            s[i] = (r[i] != 0.0f) ? 1.0f : s[i];
+            // elapsed could be negative for rewind, MAX avoids a division by 0
+            t[i] = std::max(0.0f, std::min(1.0f, e[i] / std::max(d[i], FLT_EPSILON)));
+        }
+
+        for (int c = 0; c < components; ++c)
+        {
+            const float* from = start[c].data();
+            const float* by = delta[c].data();
+            float* out = value[c].data();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[i] = from[i] + by[i] * t[i];
+            }
+        }
+    }
+};
 
 ActionManager::ActionManager()
-: _targets(nullptr),
-  _currentTarget(nullptr),
-  _currentTargetSalvaged(false)
+: _tweenBatches(new (std::nothrow) TweenBatch[TWEEN_KIND_COUNT])
+, _updating(false)
 {
-
+    _tweenBatches[TWEEN_OPACITY].components = 1;
 }
 
 ActionManager::~ActionManager()
@@ -62,59 +173,413 @@ ActionManager::~ActionManager()
     CCLOGINFO("deallocing ActionManager: %p", this);
 
     removeAllActions();
+    delete [] _tweenBatches;
 }
 
 // private
 
-void ActionManager::deleteHashElement(tHashElement *element)
+ActionManager::SlotIndex ActionManager::getTargetSlot(Node *target, bool paused)
+{
+    auto iter = _targetSlots.find(target);
+    if (iter != _targetSlots.end())
+    {
+        return iter->second;
+    }
+
+    SlotIndex slot;
+    if (_freeTargetSlots.empty())
+    {
+        slot = static_cast<SlotIndex>(_targets.size());
+        _targets.emplace_back();
+    }
+    else
+    {
+        slot = _freeTargetSlots.back();
+        _freeTargetSlots.pop_back();
+    }
+
+    auto& element = _targets[slot];
+    target->retain();
+    element.target = target;
+    element.tweens = 0;
+    element.paused = paused;
+    element.hasRemovedActions = false;
+
+    _targetSlots.emplace(target, slot);
+    return slot;
+}
+
+void ActionManager::removeTarget(SlotIndex slot)
 {
-    ccArrayFree(element->actions);
-    HASH_DEL(_targets, element);
-    element->target->release();
-    free(element);
+    auto& element = _targets[slot];
+    Node* target = element.target;
+    _targetSlots.erase(target);
+
+    element.actions.clear();
+    element.target = nullptr;
+    element.tweens = 0;
+    element.paused = false;
+    element.hasRemovedActions = false;
+    _freeTargetSlots.push_back(slot);
+
+    // last, releasing the target may remove other actions
+    target->release();
 }
 
-void ActionManager::actionAllocWithHashElement(tHashElement *element)
+void ActionManager::removeActionAt(SlotIndex slot, size_t index)
 {
-    // 4 actions per Node by default
-    if (element->actions == nullptr)
+    auto& element = _targets[slot];
+    auto& entry = element.actions[index];
+    Action* action = entry.action;
+
+    if (entry.tweenKind != TWEEN_NONE)
     {
-        element->actions = ccArrayNew(4);
-    }else 
-    if (element->actions->num == element->actions->max)
+        removeTween(entry.tweenKind, entry.tweenIndex);
+        entry.tweenKind = TWEEN_NONE;
+        --element.tweens;
+    }
+
+    if (_updating)
     {
-        ccArrayDoubleCapacity(element->actions);
+        // The action may be the one being stepped. To prevent it from accidentally
+        // deallocating itself before finishing its step, it is released at the end of update.
+        entry.action = nullptr;
+        _salvagedActions.push_back(action);
+
+        if (!element.hasRemovedActions)
+        {
+            element.hasRemovedActions = true;
+            _targetsToCompact.push_back(slot);
+        }
     }
+    else
+    {
+        element.actions.erase(element.actions.begin() + index);
+        if (element.actions.empty())
+        {
+            removeTarget(slot);
+        }
 
+        action->release();
+    }
 }
 
-void ActionManager::removeActionAtIndex(ssize_t index, tHashElement *element)
+void ActionManager::removeSalvaged()
 {
-    Action *action = (Action*)element->actions->arr[index];
+    // tweens first, the index of the moved ones is updated in the action entries
+    for (int kind = 0; kind < TWEEN_KIND_COUNT; ++kind)
+    {
+        auto& batch = _tweenBatches[kind];
+        for (size_t i = batch.size(); batch.removed > 0 && i > 0; --i)
+        {
+            if (batch.actions[i - 1] == nullptr)
+            {
+                eraseTweenAt(kind, static_cast<unsigned int>(i - 1));
+                --batch.removed;
+            }
+        }
+    }
 
-    if (action == element->currentAction && (! element->currentActionSalvaged))
+    std::vector<SlotIndex> targetsToUnbatch;
+    targetsToUnbatch.swap(_targetsToUnbatch);
+    for (const auto slot : targetsToUnbatch)
     {
-        element->currentAction->retain();
-        element->currentActionSalvaged = true;
+        unbatchTweens(slot);
     }
 
-    ccArrayRemoveObjectAtIndex(element->actions, index, true);
+    std::vector<SlotIndex> targetsToCompact;
+    targetsToCompact.swap(_targetsToCompact);
+    std::vector<Action*> salvagedActions;
+    salvagedActions.swap(_salvagedActions);
 
-    // update actionIndex in case we are in tick. looping over the actions
-    if (element->actionIndex >= index)
+    for (const auto slot : targetsToCompact)
     {
-        element->actionIndex--;
+        auto& element = _targets[slot];
+        element.hasRemovedActions = false;
+        element.actions.erase(std::remove_if(element.actions.begin(), element.actions.end(), [](const ActionEntry& entry) {
+            return entry.action == nullptr;
+        }), element.actions.end());
     }
 
-    if (element->actions->num == 0)
+    // only delete the targets if no actions were added during update (issue #481)
+    for (const auto slot : targetsToCompact)
     {
-        if (_currentTarget == element)
+        if (_targets[slot].target && _targets[slot].actions.empty())
         {
-            _currentTargetSalvaged = true;
+            removeTarget(slot);
         }
-        else
+    }
+
+    for (auto action : salvagedActions)
+    {
+        action->release();
+    }
+}
+
+void ActionManager::addTween(int kind, ActionInterval *action, SlotIndex slot, ActionEntry& entry)
+{
+    auto& batch = _tweenBatches[kind];
+    const size_t index = batch.size();
+    batch.resize(index + 1);
+
+    batch.actions[index] = action;
+    batch.targetSlots[index] = slot;
+    batch.elapsed[index] = action->_elapsed;
+    batch.duration[index] = action->getDuration();
+    batch.started[index] = action->_firstTick ? 0.0f : 1.0f;
+    batch.running[index] = 0.0f;
+    batch.mode[index] = 0;
+
+    auto setComponents = [&batch, index](const Vec3& start, const Vec3& delta) {
+        batch.start[0][index] = start.x;
+        batch.start[1][index] = start.y;
+        batch.start[2][index] = start.z;
+        batch.delta[0][index] = delta.x;
+        batch.delta[1][index] = delta.y;
+        batch.delta[2][index] = delta.z;
+    };
+
+    switch (kind)
+    {
+        case TWEEN_POSITION:
+        {
+            auto move = static_cast<MoveBy*>(action);
+            setComponents(move->_startPosition, move->_positionDelta);
+            batch.previous[0][index] = move->_previousPosition.x;
+            batch.previous[1][index] = move->_previousPosition.y;
+            batch.previous[2][index] = move->_previousPosition.z;
+            break;
+        }
+        case TWEEN_SCALE:
+        {
+            auto scale = static_cast<ScaleTo*>(action);
+            setComponents(Vec3(scale->_startScaleX, scale->_startScaleY, scale->_startScaleZ),
+                          Vec3(scale->_deltaX, scale->_deltaY, scale->_deltaZ));
+            break;
+        }
+        case TWEEN_ROTATION:
+        {
+            Vec3 start;
+            Vec3 delta;
+            bool is3D;
+            if (typeid(*action) == typeid(RotateTo))
+            {
+                auto rotate = static_cast<RotateTo*>(action);
+                start = rotate->_startAngle;
+                delta = rotate->_diffAngle;
+                is3D = rotate->_is3D;
+            }
+            else
+            {
+                auto rotate = static_cast<RotateBy*>(action);
+                start = rotate->_startAngle;
+                delta = rotate->_deltaAngle;
+                is3D = rotate->_is3D;
+            }
+            setComponents(start, delta);
+
+            batch.mode[index] = is3D ? TWEEN_ROTATION_3D : TWEEN_ROTATION_SKEW;
+#if CC_USE_PHYSICS
+            if (!is3D && start.x == start.y && delta.x == delta.y)
+            {
+                batch.mode[index] = TWEEN_ROTATION_ANGLE;
+            }
+#endif // CC_USE_PHYSICS
+            break;
+        }
+        case TWEEN_OPACITY:
+        {
+            auto fade = static_cast<FadeTo*>(action);
+            batch.start[0][index] = fade->_fromOpacity;
+            batch.delta[0][index] = fade->_toOpacity - fade->_fromOpacity;
+            break;
+        }
+        case TWEEN_COLOR:
         {
-            deleteHashElement(element);
+            auto tint = static_cast<TintTo*>(action);
+            setComponents(Vec3(tint->_from.r, tint->_from.g, tint->_from.b),
+                          Vec3(tint->_to.r - tint->_from.r, tint->_to.g - tint->_from.g, tint->_to.b - tint->_from.b));
+            break;
+        }
+        default:
+            CCASSERT(false, "invalid tween kind");
+            break;
+    }
+
+    entry.tweenKind = kind;
+    entry.tweenIndex = static_cast<unsigned int>(index);
+    ++_targets[slot].tweens;
+}
+
+void ActionManager::removeTween(int kind, unsigned int index)
+{
+    auto& batch = _tweenBatches[kind];
+
+    if (_updating)
+    {
+        // the batch may be iterated, the slot is erased at the end of update
+        batch.actions[index] = nullptr;
+        batch.running[index] = 0.0f;
+        ++batch.removed;
+    }
+    else
+    {
+        eraseTweenAt(kind, index);
+    }
+}
+
+void ActionManager::eraseTweenAt(int kind, unsigned int index)
+{
+    auto& batch = _tweenBatches[kind];
+    const size_t last = batch.size() - 1;
+
+    if (index != last)
+    {
+        batch.move(last, index);
+
+        // the moved action has a new index
+        ActionInterval* moved = batch.actions[index];
+        if (moved)
+        {
+            for (auto& entry : _targets[batch.targetSlots[index]].actions)
+            {
+                if (entry.action == moved)
+                {
+                    entry.tweenIndex = index;
+                    break;
+                }
+            }
+        }
+    }
+
+    batch.resize(last);
+}
+
+void ActionManager::unbatchTweens(SlotIndex slot)
+{
+    // the actions are up to date after each update of their batch, they can be stepped from now on
+    auto& element = _targets[slot];
+    for (auto& entry : element.actions)
+    {
+        if (entry.tweenKind != TWEEN_NONE)
+        {
+            removeTween(entry.tweenKind, entry.tweenIndex);
+            entry.tweenKind = TWEEN_NONE;
+        }
+    }
+    element.tweens = 0;
+}
+
+void ActionManager::updateTweens(float dt)
+{
+    for (int kind = 0; kind < TWEEN_KIND_COUNT; ++kind)
+    {
+        auto& batch = _tweenBatches[kind];
+        const size_t count = batch.size();
+        if (count == 0)
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            batch.running[i] = (batch.actions[i] && !_targets[batch.targetSlots[i]].paused) ? 1.0f : 0.0f;
+        }
+
+        batch.evaluate(dt);
+
+        // Write the values back. The setters may add or remove actions: the arrays are indexed
+        // again after each call, added actions are evaluated from the next update.
+        for (size_t i = 0; i < count; ++i)
+        {
+            ActionInterval* action = batch.actions[i];
+            if (action == nullptr || batch.running[i] == 0.0f)
+            {
+                continue;
+            }
+
+            action->_elapsed = batch.elapsed[i];
+            action->_firstTick = false;
+
+            Node* target = action->getTarget();
+            if (target == nullptr)
+            {
+                continue;
+            }
+
+            switch (kind)
+            {
+                case TWEEN_POSITION:
+                {
+                    Vec3 newPos(batch.value[0][i], batch.value[1][i], batch.value[2][i]);
+#if CC_ENABLE_STACKABLE_ACTIONS
+                    const Vec3 previous(batch.previous[0][i], batch.previous[1][i], batch.previous[2][i]);
+                    const Vec3 currentPos = target->getPosition3D();
+                    if (currentPos != previous)
+                    {
+                        // the node was moved by someone else, move the start position as much
+                        Vec3 startPosition(batch.start[0][i], batch.start[1][i], batch.start[2][i]);
+                        startPosition = startPosition + (currentPos - previous);
+                        newPos = startPosition + Vec3(batch.delta[0][i], batch.delta[1][i], batch.delta[2][i]) * batch.time[i];
+
+                        batch.start[0][i] = startPosition.x;
+                        batch.start[1][i] = startPosition.y;
+                        batch.start[2][i] = startPosition.z;
+                    }
+                    batch.previous[0][i] = newPos.x;
+                    batch.previous[1][i] = newPos.y;
+                    batch.previous[2][i] = newPos.z;
+
+                    auto move = static_cast<MoveBy*>(action);
+                    move->_startPosition.set(batch.start[0][i], batch.start[1][i], batch.start[2][i]);
+                    move->_previousPosition = newPos;
+#endif // CC_ENABLE_STACKABLE_ACTIONS
+                    target->setPosition3D(newPos);
+                    break;
+                }
+                case TWEEN_SCALE:
+                    target->setScaleX(batch.value[0][i]);
+                    target->setScaleY(batch.value[1][i]);
+                    target->setScaleZ(batch.value[2][i]);
+                    break;
+                case TWEEN_ROTATION:
+                    if (batch.mode[i] == TWEEN_ROTATION_3D)
+                    {
+                        target->setRotation3D(Vec3(batch.value[0][i], batch.value[1][i], batch.value[2][i]));
+                    }
+                    else if (batch.mode[i] == TWEEN_ROTATION_ANGLE)
+                    {
+                        target->setRotation(batch.value[0][i]);
+                    }
+                    else
+                    {
+                        const float skewY = batch.value[1][i];
+                        target->setRotationSkewX(batch.value[0][i]);
+                        target->setRotationSkewY(skewY);
+                    }
+                    break;
+                case TWEEN_OPACITY:
+                    target->setOpacity((GLubyte)(batch.value[0][i]));
+                    break;
+                case TWEEN_COLOR:
+                    target->setColor(Color3B(GLubyte(batch.value[0][i]),
+                                             (GLubyte)(batch.value[1][i]),
+                                             (GLubyte)(batch.value[2][i])));
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // stop the finished actions, like update() does after step()
+        for (size_t i = 0; i < count; ++i)
+        {
+            ActionInterval* action = batch.actions[i];
+            if (action && batch.running[i] != 0.0f && action->isDone())
+            {
+                action->stop();
+                removeAction(action);
+            }
         }
     }
 }
@@ -123,21 +588,19 @@ void ActionManager::removeActionAtIndex(ssize_t index, tHashElement *element)
 
 void ActionManager::pauseTarget(Node *target)
 {
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-    if (element)
+    auto iter = _targetSlots.find(target);
+    if (iter != _targetSlots.end())
     {
-        element->paused = true;
+        _targets[iter->second].paused = true;
     }
 }
 
 void ActionManager::resumeTarget(Node *target)
 {
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-    if (element)
+    auto iter = _targetSlots.find(target);
+    if (iter != _targetSlots.end())
     {
-        element->paused = false;
+        _targets[iter->second].paused = false;
     }
 }
 
@@ -145,12 +608,12 @@ Vector<Node*> ActionManager::pauseAllRunningActions()
 {
     Vector<Node*> idsWithActions;
     
-    for (tHashElement *element=_targets; element != nullptr; element = (tHashElement *)element->hh.next) 
+    for (auto& element : _targets)
     {
-        if (! element->paused) 
+        if (element.target && ! element.paused)
         {
-            element->paused = true;
-            idsWithActions.pushBack(element->target);
+            element.paused = true;
+            idsWithActions.pushBack(element.target);
         }
     }    
     
@@ -171,36 +634,85 @@ void ActionManager::addAction(Action *action, Node *target, bool paused)
     CCASSERT(action != nullptr, "action can't be nullptr!");
     CCASSERT(target != nullptr, "target can't be nullptr!");
 
-    tHashElement *element = nullptr;
-    // we should convert it to Ref*, because we save it as Ref*
-    Ref *tmp = target;
-    HASH_FIND_PTR(_targets, &tmp, element);
-    if (! element)
+    const SlotIndex slot = getTargetSlot(target, paused);
+    auto& element = _targets[slot];
+
+    CCASSERT(std::find_if(element.actions.begin(), element.actions.end(), [action](const ActionEntry& entry) {
+        return entry.action == action;
+    }) == element.actions.end(), "action already be added!");
+
+    action->retain();
+    element.actions.push_back({action, TWEEN_NONE, 0});
+
+    action->startWithTarget(target);
+
+    // startWithTarget() computed the start values, the action can be batched now
+    int kind = TWEEN_NONE;
+    const auto& type = typeid(*action);
+    if (type == typeid(MoveBy) || type == typeid(MoveTo))
+        kind = TWEEN_POSITION;
+    else if (type == typeid(ScaleTo) || type == typeid(ScaleBy))
+        kind = TWEEN_SCALE;
+    else if (type == typeid(RotateTo) || type == typeid(RotateBy))
+        kind = TWEEN_ROTATION;
+    else if (type == typeid(FadeTo) || type == typeid(FadeIn) || type == typeid(FadeOut))
+        kind = TWEEN_OPACITY;
+    else if (type == typeid(TintTo))
+        kind = TWEEN_COLOR;
+
+#if CC_ENABLE_SCRIPT_BINDING
+    // javascript actions receive their updates from the script engine in step()
+    if (action->_scriptType == kScriptTypeJavascript)
     {
-        element = (tHashElement*)calloc(sizeof(*element), 1);
-        element->paused = paused;
-        target->retain();
-        element->target = target;
-        HASH_ADD_PTR(_targets, target, element);
+        kind = TWEEN_NONE;
     }
+#endif
 
-     actionAllocWithHashElement(element);
- 
-     CCASSERT(! ccArrayContainsObject(element->actions, action), "action already be added!");
-     ccArrayAppendObject(element->actions, action);
- 
-     action->startWithTarget(target);
+    // The batches run after the other actions and in no particular order, so a target
+    // is only batched while all its actions are tweens of different kinds. Otherwise
+    // all its actions are stepped on their own, in the order they were added.
+    bool batched = (kind != TWEEN_NONE);
+    for (size_t i = 0, count = element.actions.size() - 1; batched && i < count; ++i)
+    {
+        const auto& entry = element.actions[i];
+        if (entry.action && (entry.tweenKind == TWEEN_NONE || entry.tweenKind == kind))
+        {
+            batched = false;
+        }
+    }
+
+    if (batched)
+    {
+        addTween(kind, static_cast<ActionInterval*>(action), slot, element.actions.back());
+    }
+    else if (element.tweens > 0)
+    {
+        if (_updating)
+        {
+            // the tweens may have been evaluated already, they leave their batch at the end of update
+            if (std::find(_targetsToUnbatch.begin(), _targetsToUnbatch.end(), slot) == _targetsToUnbatch.end())
+            {
+                _targetsToUnbatch.push_back(slot);
+            }
+        }
+        else
+        {
+            unbatchTweens(slot);
+        }
+    }
 }
 
 // remove
 
 void ActionManager::removeAllActions()
 {
-    for (tHashElement *element = _targets; element != nullptr; )
+    // slots are never destroyed, only freed, so indices stay valid while targets are removed
+    for (SlotIndex slot = 0; slot < _targets.size(); ++slot)
     {
-        auto target = element->target;
-        element = (tHashElement*)element->hh.next;
-        removeAllActionsFromTarget(target);
+        if (_targets[slot].target)
+        {
+            removeAllActionsFromTarget(_targets[slot].target);
+        }
     }
 }
 
@@ -212,24 +724,18 @@ void ActionManager::removeAllActionsFromTarget(Node *target)
         return;
     }
 
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-    if (element)
+    auto iter = _targetSlots.find(target);
+    if (iter != _targetSlots.end())
     {
-        if (ccArrayContainsObject(element->actions, element->currentAction) && (! element->currentActionSalvaged))
-        {
-            element->currentAction->retain();
-            element->currentActionSalvaged = true;
-        }
+        const SlotIndex slot = iter->second;
 
-        ccArrayRemoveAllObjects(element->actions);
-        if (_currentTarget == element)
-        {
-            _currentTargetSalvaged = true;
-        }
-        else
+        // remove from the back so the indices are not shifted when not updating
+        for (size_t i = _targets[slot].actions.size(); i > 0; --i)
         {
-            deleteHashElement(element);
+            if (_targets[slot].actions[i - 1].action)
+            {
+                removeActionAt(slot, i - 1);
+            }
         }
     }
     else
@@ -246,15 +752,17 @@ void ActionManager::removeAction(Action *action)
         return;
     }
 
-    tHashElement *element = nullptr;
-    Ref *target = action->getOriginalTarget();
-    HASH_FIND_PTR(_targets, &target, element);
-    if (element)
+    auto iter = _targetSlots.find(action->getOriginalTarget());
+    if (iter != _targetSlots.end())
     {
-        auto i = ccArrayGetIndexOfObject(element->actions, action);
-        if (i != CC_INVALID_INDEX)
+        const auto& actions = _targets[iter->second].actions;
+        for (size_t i = 0, count = actions.size(); i < count; ++i)
         {
-            removeActionAtIndex(i, element);
+            if (actions[i].action == action)
+            {
+                removeActionAt(iter->second, i);
+                break;
+            }
         }
     }
     else
@@ -268,19 +776,17 @@ void ActionManager::removeActionByTag(int tag, Node *target)
     CCASSERT(tag != Action::INVALID_TAG, "Invalid tag value!");
     CCASSERT(target != nullptr, "target can't be nullptr!");
 
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-
-    if (element)
+    auto iter = _targetSlots.find(target);
+    if (iter != _targetSlots.end())
     {
-        auto limit = element->actions->num;
-        for (int i = 0; i < limit; ++i)
+        const auto& actions = _targets[iter->second].actions;
+        for (size_t i = 0, count = actions.size(); i < count; ++i)
         {
-            Action *action = (Action*)element->actions->arr[i];
+            Action *action = actions[i].action;
 
-            if (action->getTag() == (int)tag && action->getOriginalTarget() == target)
+            if (action && action->getTag() == (int)tag && action->getOriginalTarget() == target)
             {
-                removeActionAtIndex(i, element);
+                removeActionAt(iter->second, i);
                 break;
             }
         }
@@ -292,24 +798,19 @@ void ActionManager::removeAllActionsByTag(int tag, Node *target)
     CCASSERT(tag != Action::INVALID_TAG, "Invalid tag value!");
     CCASSERT(target != nullptr, "target can't be nullptr!");
     
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-    
-    if (element)
+    auto iter = _targetSlots.find(target);
+    if (iter != _targetSlots.end())
     {
-        auto limit = element->actions->num;
-        for (int i = 0; i < limit;)
+        const SlotIndex slot = iter->second;
+
+        // from the back, removing doesn't shift the actions still to check
+        for (size_t i = _targets[slot].actions.size(); i > 0; --i)
         {
-            Action *action = (Action*)element->actions->arr[i];
+            Action *action = _targets[slot].actions[i - 1].action;
             
-            if (action->getTag() == (int)tag && action->getOriginalTarget() == target)
-            {
-                removeActionAtIndex(i, element);
-                --limit;
-            }
-            else
+            if (action && action->getTag() == (int)tag && action->getOriginalTarget() == target)
             {
-                ++i;
+                removeActionAt(slot, i - 1);
             }
         }
     }
@@ -323,24 +824,19 @@ void ActionManager::removeActionsByFlags(unsigned int flags, Node *target)
     }
     CCASSERT(target != nullptr, "target can't be nullptr!");
 
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-
-    if (element)
+    auto iter = _targetSlots.find(target);
+    if (iter != _targetSlots.end())
     {
-        auto limit = element->actions->num;
-        for (int i = 0; i < limit;)
+        const SlotIndex slot = iter->second;
+
+        // from the back, removing doesn't shift the actions still to check
+        for (size_t i = _targets[slot].actions.size(); i > 0; --i)
         {
-            Action *action = (Action*)element->actions->arr[i];
+            Action *action = _targets[slot].actions[i - 1].action;
 
-            if ((action->getFlags() & flags) != 0 && action->getOriginalTarget() == target)
+            if (action && (action->getFlags() & flags) != 0 && action->getOriginalTarget() == target)
             {
-                removeActionAtIndex(i, element);
-                --limit;
-            }
-            else
-            {
-                ++i;
+                removeActionAt(slot, i - 1);
             }
         }
     }
@@ -348,28 +844,18 @@ void ActionManager::removeActionsByFlags(unsigned int flags, Node *target)
 
 // get
 
-// FIXME: Passing "const O *" instead of "const O&" because HASH_FIND_IT requries the address of a pointer
-// and, it is not possible to get the address of a reference
 Action* ActionManager::getActionByTag(int tag, const Node *target) const
 {
     CCASSERT(tag != Action::INVALID_TAG, "Invalid tag value!");
 
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-
-    if (element)
+    auto iter = _targetSlots.find(const_cast<Node*>(target));
+    if (iter != _targetSlots.end())
     {
-        if (element->actions != nullptr)
+        for (const auto& entry : _targets[iter->second].actions)
         {
-            auto limit = element->actions->num;
-            for (int i = 0; i < limit; ++i)
+            if (entry.action && entry.action->getTag() == (int)tag)
             {
-                Action *action = (Action*)element->actions->arr[i];
-
-                if (action->getTag() == (int)tag)
-                {
-                    return action;
-                }
+                return entry.action;
             }
         }
         //CCLOG("cocos2d : getActionByTag(tag = %d): Action not found", tag);
@@ -382,15 +868,15 @@ Action* ActionManager::getActionByTag(int tag, const Node *target) const
     return nullptr;
 }
 
-// FIXME: Passing "const O *" instead of "const O&" because HASH_FIND_IT requries the address of a pointer
-// and, it is not possible to get the address of a reference
 ssize_t ActionManager::getNumberOfRunningActionsInTarget(const Node *target) const
 {
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-    if (element)
+    auto iter = _targetSlots.find(const_cast<Node*>(target));
+    if (iter != _targetSlots.end())
     {
-        return element->actions ? element->actions->num : 0;
+        const auto& actions = _targets[iter->second].actions;
+        return std::count_if(actions.begin(), actions.end(), [](const ActionEntry& entry) {
+            return entry.action != nullptr;
+        });
     }
 
     return 0;
@@ -399,61 +885,46 @@ ssize_t ActionManager::getNumberOfRunningActionsInTarget(const Node *target) con
 // main loop
 void ActionManager::update(float dt)
 {
-    for (tHashElement *elt = _targets; elt != nullptr; )
+    _updating = true;
+
+    // actions that are not batched, in the order they were added to their target
+    // targets added during update are appended or reuse a free slot, they may be updated too
+    for (SlotIndex slot = 0; slot < _targets.size(); ++slot)
     {
-        _currentTarget = elt;
-        _currentTargetSalvaged = false;
+        const auto& element = _targets[slot];
+        if (element.target == nullptr || element.paused || element.tweens == element.actions.size())
+        {
+            continue;
+        }
 
-        if (! _currentTarget->paused)
+        // The 'actions' array may change while inside this loop, removed actions are set to nullptr.
+        // Steps may add targets too, so the element is fetched again after each step.
+        for (size_t i = 0; i < _targets[slot].actions.size(); ++i)
         {
-            // The 'actions' MutableArray may change while inside this loop.
-            for (_currentTarget->actionIndex = 0; _currentTarget->actionIndex < _currentTarget->actions->num;
-                _currentTarget->actionIndex++)
+            const auto& entry = _targets[slot].actions[i];
+            Action* action = entry.action;
+            if (action == nullptr || entry.tweenKind != TWEEN_NONE)
             {
-                _currentTarget->currentAction = (Action*)_currentTarget->actions->arr[_currentTarget->actionIndex];
-                if (_currentTarget->currentAction == nullptr)
-                {
-                    continue;
-                }
-
-                _currentTarget->currentActionSalvaged = false;
+                continue;
+            }
 
-                _currentTarget->currentAction->step(dt);
+            action->step(dt);
 
-                if (_currentTarget->currentActionSalvaged)
-                {
-                    // The currentAction told the node to remove it. To prevent the action from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    _currentTarget->currentAction->release();
-                } else
-                if (_currentTarget->currentAction->isDone())
-                {
-                    _currentTarget->currentAction->stop();
-
-                    Action *action = _currentTarget->currentAction;
-                    // Make currentAction nil to prevent removeAction from salvaging it.
-                    _currentTarget->currentAction = nullptr;
-                    removeAction(action);
-                }
-
-                _currentTarget->currentAction = nullptr;
+            // the action is released at the end of update if its step removed it
+            if (_targets[slot].actions[i].action == action && action->isDone())
+            {
+                action->stop();
+                removeActionAt(slot, i);
             }
         }
+    }
 
-        // elt, at this moment, is still valid
-        // so it is safe to ask this here (issue #490)
-        elt = (tHashElement*)(elt->hh.next);
+    updateTweens(dt);
 
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->actions->num == 0)
-        {
-            deleteHashElement(_currentTarget);
-        }
-    }
+    _updating = false;
 
     // issue #635
-    _currentTarget = nullptr;
+    removeSalvaged();
 }
 
 NS_CC_END
@@ -29,6 +29,9 @@ THE SOFTWARE.
 #ifndef __ACTION_CCACTION_MANAGER_H__
 #define __ACTION_CCACTION_MANAGER_H__
 
+#include <unordered_map>
+#include <vector>
+
 #include "2d/CCAction.h"
 #include "base/CCVector.h"
 #include "base/CCRef.h"
@@ -36,8 +39,7 @@ THE SOFTWARE.
 NS_CC_BEGIN
 
 class Action;
-
-struct _hashElement;
+class ActionInterval;
 
 /**
  * @addtogroup actions
@@ -75,6 +77,9 @@ public:
      If the target is already present, then the action will be added to the existing target.
      If the target is not present, a new instance of this target will be created either paused or not, and the action will be added to the newly created target.
      When the target is paused, the queued actions won't be 'ticked'.
+     The actions of a target are updated in the order they were added. Since v3.9, when all the actions of a target
+     are MoveBy/MoveTo, ScaleTo/ScaleBy, RotateTo/RotateBy, FadeTo/FadeIn/FadeOut or TintTo actions, each of a different
+     kind, they are updated in batches after the actions of the other targets.
      *
      * @param action    A certain action.
      * @param target    The target which need to be added an action.
@@ -175,16 +180,50 @@ public:
     void update(float dt);
     
 protected:
-    // declared in ActionManager.m
-
-    void removeActionAtIndex(ssize_t index, struct _hashElement *element);
-    void deleteHashElement(struct _hashElement *element);
-    void actionAllocWithHashElement(struct _hashElement *element);
+    // Index of a target in _targets, it doesn't change while the target runs actions
+    typedef unsigned int SlotIndex;
+
+    struct ActionEntry
+    {
+        Action *action;             // retained, nullptr when removed during update
+        int tweenKind;              // batch evaluating the action, or -1 when it is stepped on its own
+        unsigned int tweenIndex;    // index of the action in its batch
+    };
+
+    struct TargetEntry
+    {
+        std::vector<ActionEntry> actions;   // in the order they were added
+        Node *target;               // retained, nullptr when the slot is free
+        size_t tweens;              // actions evaluated by a batch
+        bool paused;
+        bool hasRemovedActions;     // actions were removed during update, compact it at the end of update
+    };
+
+    // Structure of arrays of the interval actions that only interpolate a node property, see CCActionManager.cpp
+    struct TweenBatch;
+
+    SlotIndex getTargetSlot(Node *target, bool paused);
+    void removeActionAt(SlotIndex slot, size_t index);
+    void removeTarget(SlotIndex slot);
+    void removeSalvaged();
+
+    void addTween(int kind, ActionInterval *action, SlotIndex slot, ActionEntry& entry);
+    void removeTween(int kind, unsigned int index);
+    void eraseTweenAt(int kind, unsigned int index);
+    void unbatchTweens(SlotIndex slot);
+    void updateTweens(float dt);
 
 protected:
-    struct _hashElement    *_targets;
-    struct _hashElement    *_currentTarget;
-    bool            _currentTargetSalvaged;
+    std::vector<TargetEntry> _targets;
+    std::vector<SlotIndex> _freeTargetSlots;
+    std::unordered_map<Node*, SlotIndex> _targetSlots;
+    TweenBatch *_tweenBatches;
+
+    // If true, removals only mark the actions, they are released at the end of update
+    bool _updating;
+    std::vector<Action*> _salvagedActions;
+    std::vector<SlotIndex> _targetsToCompact;
+    std::vector<SlotIndex> _targetsToUnbatch;   // targets whose tweens leave their batch at the end of update
 };
 
 // end of actions group
@@ -130,13 +130,13 @@ void CameraBackgroundDepthBrush::drawBackground(Camera* camera)
         glColorMask(_clearColor, _clearColor, _clearColor, _clearColor);
         glStencilMask(0);
         
-        oldDepthTest = glIsEnabled(GL_DEPTH_TEST);
+        oldDepthTest = GL::isEnabled(GL_DEPTH_TEST);
         glGetIntegerv(GL_DEPTH_FUNC, &oldDepthFunc);
-        glGetBooleanv(GL_DEPTH_WRITEMASK, &oldDepthMask);
+        oldDepthMask = GL::getDepthMask();
         
-        glDepthMask(GL_TRUE);
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_ALWAYS);
+        GL::depthMask(GL_TRUE);
+        GL::enable(GL_DEPTH_TEST);
+        GL::depthFunc(GL_ALWAYS);
     }
     
     //draw
@@ -147,7 +147,7 @@ void CameraBackgroundDepthBrush::drawBackground(Camera* camera)
     
     {
         GL::bindVAO(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
         
         GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
         
@@ -160,7 +160,7 @@ void CameraBackgroundDepthBrush::drawBackground(Camera* camera)
         // tex coords
         glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), &_quad.tl.texCoords);
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, indices);
     }
     
@@ -168,13 +168,13 @@ void CameraBackgroundDepthBrush::drawBackground(Camera* camera)
     {
         if(GL_FALSE == oldDepthTest)
         {
-            glDisable(GL_DEPTH_TEST);
+            GL::disable(GL_DEPTH_TEST);
         }
-        glDepthFunc(oldDepthFunc);
+        GL::depthFunc(oldDepthFunc);
         
         if(GL_FALSE == oldDepthMask)
         {
-            glDepthMask(GL_FALSE);
+            GL::depthMask(GL_FALSE);
         }
         
         /* IMPORTANT: We only need to update the states that are not restored.
@@ -248,8 +248,8 @@ CameraBackgroundSkyBoxBrush::~CameraBackgroundSkyBoxBrush()
 {
     CC_SAFE_RELEASE(_texture);
     
-    glDeleteBuffers(1, &_vertexBuffer);
-    glDeleteBuffers(1, &_indexBuffer);
+    GL::deleteBuffers(1, &_vertexBuffer);
+    GL::deleteBuffers(1, &_indexBuffer);
     
     _vertexBuffer = 0;
     _indexBuffer = 0;
@@ -305,22 +305,22 @@ void CameraBackgroundSkyBoxBrush::drawBackground(Camera* camera)
     
     _glProgramState->apply(Mat4::IDENTITY);
     
-    glEnable(GL_DEPTH_TEST);
+    GL::enable(GL_DEPTH_TEST);
     RenderState::StateBlock::_defaultState->setDepthTest(true);
     
-    glDepthMask(GL_TRUE);
+    GL::depthMask(GL_TRUE);
     RenderState::StateBlock::_defaultState->setDepthWrite(true);
     
-    glDepthFunc(GL_ALWAYS);
+    GL::depthFunc(GL_ALWAYS);
     RenderState::StateBlock::_defaultState->setDepthFunction(RenderState::DEPTH_ALWAYS);
     
-    glEnable(GL_CULL_FACE);
+    GL::enable(GL_CULL_FACE);
     RenderState::StateBlock::_defaultState->setCullFace(true);
     
-    glCullFace(GL_BACK);
+    GL::cullFace(GL_BACK);
     RenderState::StateBlock::_defaultState->setCullFaceSide(RenderState::CULL_FACE_SIDE_BACK);
     
-    glDisable(GL_BLEND);
+    GL::disable(GL_BLEND);
     RenderState::StateBlock::_defaultState->setBlend(false);
     
     if (Configuration::getInstance()->supportsShareableVAO())
@@ -331,10 +331,10 @@ void CameraBackgroundSkyBoxBrush::drawBackground(Camera* camera)
     {
         GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POSITION);
         
-        glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+        GL::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
         glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(Vec3), nullptr);
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
     }
     
     glDrawElements(GL_TRIANGLES, (GLsizei)36, GL_UNSIGNED_BYTE, nullptr);
@@ -345,8 +345,8 @@ void CameraBackgroundSkyBoxBrush::drawBackground(Camera* camera)
     }
     else
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
     
     CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, 8);
@@ -369,9 +369,9 @@ bool CameraBackgroundSkyBoxBrush::init()
 void CameraBackgroundSkyBoxBrush::initBuffer()
 {
     if (_vertexBuffer)
-        glDeleteBuffers(1, &_vertexBuffer);
+        GL::deleteBuffers(1, &_vertexBuffer);
     if (_indexBuffer)
-        glDeleteBuffers(1, &_indexBuffer);
+        GL::deleteBuffers(1, &_indexBuffer);
     
     if (Configuration::getInstance()->supportsShareableVAO() && _vao)
     {
@@ -394,7 +394,7 @@ void CameraBackgroundSkyBoxBrush::initBuffer()
     };
     
     glGenBuffers(1, &_vertexBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vexBuf), vexBuf, GL_STATIC_DRAW);
     
     // init index buffer object
@@ -407,7 +407,7 @@ void CameraBackgroundSkyBoxBrush::initBuffer()
     };
     
     glGenBuffers(1, &_indexBuffer);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(idxBuf), idxBuf, GL_STATIC_DRAW);
     
     if (Configuration::getInstance()->supportsShareableVAO())
@@ -251,7 +251,7 @@ void ClippingNode::drawFullScreenQuadClearStencil()
     glProgram->setUniformsForBuiltins();
     glProgram->setUniformLocationWith4fv(colorLocation, (GLfloat*) &color.r, 1);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
     GL::enableVertexAttribs( GL::VERTEX_ATTRIB_FLAG_POSITION );
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, 0, vertices);
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
@@ -409,7 +409,7 @@ void ClippingNode::onBeforeVisit()
 
     // manually save the stencil state
 
-    _currentStencilEnabled = glIsEnabled(GL_STENCIL_TEST);
+    _currentStencilEnabled = GL::isEnabled(GL_STENCIL_TEST);
     glGetIntegerv(GL_STENCIL_WRITEMASK, (GLint *)&_currentStencilWriteMask);
     glGetIntegerv(GL_STENCIL_FUNC, (GLint *)&_currentStencilFunc);
     glGetIntegerv(GL_STENCIL_REF, &_currentStencilRef);
@@ -419,7 +419,7 @@ void ClippingNode::onBeforeVisit()
     glGetIntegerv(GL_STENCIL_PASS_DEPTH_PASS, (GLint *)&_currentStencilPassDepthPass);
 
     // enable stencil use
-    glEnable(GL_STENCIL_TEST);
+    GL::enable(GL_STENCIL_TEST);
 //    RenderState::StateBlock::_defaultState->setStencilTest(true);
 
     // check for OpenGL error while enabling stencil test
@@ -432,15 +432,15 @@ void ClippingNode::onBeforeVisit()
 
     // manually save the depth test state
 
-    glGetBooleanv(GL_DEPTH_WRITEMASK, &_currentDepthWriteMask);
+    _currentDepthWriteMask = GL::getDepthMask();
 
     // disable depth test while drawing the stencil
-    //glDisable(GL_DEPTH_TEST);
+    //GL::disable(GL_DEPTH_TEST);
     // disable update to the depth buffer while drawing the stencil,
     // as the stencil is not meant to be rendered in the real scene,
     // it should never prevent something else to be drawn,
     // only disabling depth buffer update should do
-    glDepthMask(GL_FALSE);
+    GL::depthMask(GL_FALSE);
     RenderState::StateBlock::_defaultState->setDepthWrite(false);
 
     ///////////////////////////////////
@@ -486,7 +486,7 @@ void ClippingNode::onBeforeVisit()
         glGetIntegerv(GL_ALPHA_TEST_FUNC, (GLint *)&_currentAlphaTestFunc);
         glGetFloatv(GL_ALPHA_TEST_REF, &_currentAlphaTestRef);
         // enable alpha testing
-        glEnable(GL_ALPHA_TEST);
+        GL::enable(GL_ALPHA_TEST);
         // check for OpenGL error while enabling alpha test
         CHECK_GL_ERROR_DEBUG();
         // pixel will be drawn only if greater than an alpha threshold
@@ -509,17 +509,17 @@ void ClippingNode::onAfterDrawStencil()
         glAlphaFunc(_currentAlphaTestFunc, _currentAlphaTestRef);
         if (!_currentAlphaTestEnabled)
         {
-            glDisable(GL_ALPHA_TEST);
+            GL::disable(GL_ALPHA_TEST);
         }
 #endif
     }
 
     // restore the depth test state
-    glDepthMask(_currentDepthWriteMask);
+    GL::depthMask(_currentDepthWriteMask);
     RenderState::StateBlock::_defaultState->setDepthWrite(_currentDepthWriteMask != 0);
 
     //if (currentDepthTestEnabled) {
-    //    glEnable(GL_DEPTH_TEST);
+    //    GL::enable(GL_DEPTH_TEST);
     //}
 
     ///////////////////////////////////
@@ -558,7 +558,7 @@ void ClippingNode::onAfterVisit()
     glStencilMask(_currentStencilWriteMask);
     if (!_currentStencilEnabled)
     {
-        glDisable(GL_STENCIL_TEST);
+        GL::disable(GL_STENCIL_TEST);
 //        RenderState::StateBlock::_defaultState->setStencilTest(false);
     }
 
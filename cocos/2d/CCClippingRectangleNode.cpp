@@ -4,6 +4,7 @@
 #include "renderer/CCRenderer.h"
 #include "math/Vec2.h"
 #include "CCGLView.h"
+#include "renderer/ccGLStateCache.h"
 
 NS_CC_BEGIN
 
@@ -40,7 +41,7 @@ void ClippingRectangleNode::setClippingRegion(const Rect &clippingRegion)
 void ClippingRectangleNode::onBeforeVisitScissor()
 {
     if (_clippingEnabled) {
-        glEnable(GL_SCISSOR_TEST);
+        GL::enable(GL_SCISSOR_TEST);
 
         float scaleX = _scaleX;
         float scaleY = _scaleY;
@@ -64,7 +65,7 @@ void ClippingRectangleNode::onAfterVisitScissor()
 {
     if (_clippingEnabled)
     {
-        glDisable(GL_SCISSOR_TEST);
+        GL::disable(GL_SCISSOR_TEST);
     }
 }
 
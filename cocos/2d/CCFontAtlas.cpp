@@ -24,25 +24,132 @@
  ****************************************************************************/
 
 #include "2d/CCFontAtlas.h"
+#include <algorithm>
 #if CC_TARGET_PLATFORM != CC_PLATFORM_WIN32 && CC_TARGET_PLATFORM != CC_PLATFORM_WINRT && CC_TARGET_PLATFORM != CC_PLATFORM_ANDROID
 #include <iconv.h>
 #elif CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
 #include "android/jni/Java_org_cocos2dx_lib_Cocos2dxHelper.h"
 #endif
 #include "2d/CCFontFreeType.h"
+#include "2d/CCFontAtlasCache.h"
 #include "base/ccUTF8.h"
 #include "base/CCDirector.h"
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventType.h"
+#include "base/CCJobSystem.h"
+#include "platform/CCFileUtils.h"
+#include "deprecated/CCString.h"
 
 NS_CC_BEGIN
 
+namespace
+{
+    const char DISK_CACHE_MAGIC[4] = { 'C', 'C', 'F', 'A' };
+    const uint32_t DISK_CACHE_VERSION = 1;
+
+    // the index of an atlas in the disk cache, followed by its letters, the pages are in other files
+    struct DiskCacheHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t pageWidth;
+        uint32_t pageHeight;
+        uint32_t pageDataSize;
+        uint32_t pageCount;
+        uint32_t letterCount;
+        int32_t letterPadding;
+        int32_t letterEdgeExtend;
+        int32_t currLineHeight;
+        float currentPageOrigX;
+        float currentPageOrigY;
+        float contentScaleFactor;
+        uint32_t reserved[3];
+    };
+    static_assert(sizeof(DiskCacheHeader) == 64, "the disk cache header is 64 bytes");
+
+    struct DiskCacheLetter
+    {
+        uint32_t utf16Char;
+        float U;
+        float V;
+        float width;
+        float height;
+        float offsetX;
+        float offsetY;
+        int32_t textureID;
+        int32_t xAdvance;
+        uint32_t validDefinition;
+    };
+    static_assert(sizeof(DiskCacheLetter) == 40, "the disk cache letters are 40 bytes");
+}
+
 const int FontAtlas::CacheTextureWidth = 512;
 const int FontAtlas::CacheTextureHeight = 512;
 const char* FontAtlas::CMD_PURGE_FONTATLAS = "__cc_PURGE_FONTATLAS";
 const char* FontAtlas::CMD_RESET_FONTATLAS = "__cc_RESET_FONTATLAS";
 
+// atlases whose current page has rows not uploaded to its texture yet
+static std::vector<FontAtlas*> s_atlasesToUpdate;
+// set while the atlases are purged, the atlases created meanwhile don't use the disk cache
+static bool s_diskCacheSuspended = false;
+// Disk cache paths in use: nullptr for a live atlas, or the job writing the files of a released one.
+// Two atlases of the same font data, e.g. reached by different paths, would overwrite each other's files.
+static std::unordered_map<std::string, JobSystem::JobHandle> s_diskCachePaths;
+
+static bool claimDiskCachePath(const std::string& path)
+{
+    auto iter = s_diskCachePaths.find(path);
+    if (iter != s_diskCachePaths.end())
+    {
+        if (iter->second == nullptr)
+        {
+            return false;
+        }
+        // the files of the released atlas are only complete once they are written
+        JobSystem::getInstance()->wait(iter->second);
+    }
+    s_diskCachePaths[path] = nullptr;
+    return true;
+}
+
+// the files are written by writeDataToFile(), they are mapped as they are even if FileUtils doesn't map the files
+static MappedFile mapDiskCacheFile(const std::string& path)
+{
+    auto fileUtils = FileUtils::getInstance();
+    MappedFile file;
+    if (!file.map(fileUtils->getSuitableFOpen(path)))
+    {
+        file = fileUtils->mapFile(path);
+    }
+    return file;
+}
+
+static bool writeDiskCacheFiles(const Data& page, const std::string& pagePath, const Data& index, const std::string& indexPath)
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->writeDataToFile(page, pagePath))
+    {
+        CCLOG("cocos2d: FontAtlas: can't write %s", pagePath.c_str());
+        return false;
+    }
+
+    // written aside and renamed, so a partially written index is never read
+    auto temporaryPath = indexPath + ".tmp";
+    bool written = fileUtils->writeDataToFile(index, temporaryPath);
+    if (written && fileUtils->isFileExist(indexPath))
+    {
+        // rename doesn't replace files on every platform
+        fileUtils->removeFile(indexPath);
+    }
+    if (!written || !fileUtils->renameFile(temporaryPath, indexPath))
+    {
+        CCLOG("cocos2d: FontAtlas: can't write %s", indexPath.c_str());
+        return false;
+    }
+    return true;
+}
+
 FontAtlas::FontAtlas(Font &theFont) 
 : _font(&theFont)
 , _fontFreeType(nullptr)
@@ -52,6 +159,11 @@ FontAtlas::FontAtlas(Font &theFont)
 , _rendererRecreatedListener(nullptr)
 , _antialiasEnabled(true)
 , _currLineHeight(0)
+, _currentPageDirtyTop(CacheTextureHeight)
+, _currentPageDirtyBottom(0)
+, _diskCacheDirty(false)
+, _diskCacheIndexRemoved(false)
+, _comeToBackgroundListener(nullptr)
 {
     _font->retain();
 
@@ -89,9 +201,30 @@ FontAtlas::FontAtlas(Font &theFont)
         addTexture(texture,0);
         texture->release();
 
-#if CC_ENABLE_CACHE_TEXTURE_DATA
         auto eventDispatcher = Director::getInstance()->getEventDispatcher();
 
+        if (FontAtlasCache::isDiskCacheEnabled() && !s_diskCacheSuspended)
+        {
+            auto key = _fontFreeType->getGlyphBitmapsKey();
+            auto path = FontAtlasCache::getDiskCachePath() + key;
+            if (!key.empty() && !claimDiskCachePath(path))
+            {
+                CCLOG("cocos2d: FontAtlas: %s is used by another atlas of the same font, this one isn't cached", path.c_str());
+            }
+            else if (!key.empty())
+            {
+                _diskCachePath = path;
+                loadFromDiskCache();
+
+                // the application may be killed in background
+                _comeToBackgroundListener = EventListenerCustom::create(EVENT_COME_TO_BACKGROUND, [this](EventCustom* event){
+                    saveToDiskCache();
+                });
+                eventDispatcher->addEventListenerWithFixedPriority(_comeToBackgroundListener, 1);
+            }
+        }
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
         _rendererRecreatedListener = EventListenerCustom::create(EVENT_RENDERER_RECREATED, CC_CALLBACK_1(FontAtlas::listenRendererRecreated, this));
         eventDispatcher->addEventListenerWithFixedPriority(_rendererRecreatedListener, 1);
 #endif
@@ -100,6 +233,34 @@ FontAtlas::FontAtlas(Font &theFont)
 
 FontAtlas::~FontAtlas()
 {
+    if (_comeToBackgroundListener)
+    {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_comeToBackgroundListener);
+        _comeToBackgroundListener = nullptr;
+    }
+
+    if (!_diskCachePath.empty())
+    {
+        // written by a job, the atlases are released on scene changes
+        if (_diskCacheDirty)
+        {
+            auto page = std::make_shared<Data>();
+            page->copy(_currentPageData, _currentPageDataSize);
+            auto index = std::make_shared<Data>(createDiskCacheIndex());
+            auto pagePath = getDiskCachePagePath(_currentPage);
+            auto indexPath = _diskCachePath + ".atlas";
+            prepareDiskCacheWrite();
+
+            s_diskCachePaths[_diskCachePath] = JobSystem::getInstance()->schedule([page, pagePath, index, indexPath](){
+                writeDiskCacheFiles(*page, pagePath, *index, indexPath);
+            }, nullptr, JobSystem::Priority::LOW);
+        }
+        else
+        {
+            s_diskCachePaths.erase(_diskCachePath);
+        }
+    }
+
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     if (_fontFreeType && _rendererRecreatedListener)
     {
@@ -109,6 +270,11 @@ FontAtlas::~FontAtlas()
     }
 #endif
 
+    if (_currentPageDirtyBottom > _currentPageDirtyTop)
+    {
+        s_atlasesToUpdate.erase(std::remove(s_atlasesToUpdate.begin(), s_atlasesToUpdate.end(), this), s_atlasesToUpdate.end());
+    }
+
     _font->release();
     relaseTextures();
 
@@ -136,9 +302,12 @@ void FontAtlas::purgeTexturesAtlas()
 {
     if (_fontFreeType && _atlasTextures.size() > 1)
     {
+        // the atlas created again by the labels only renders their letters, instead of loading all the pages
+        s_diskCacheSuspended = true;
         auto eventDispatcher = Director::getInstance()->getEventDispatcher();
         eventDispatcher->dispatchCustomEvent(CMD_PURGE_FONTATLAS,this);
         eventDispatcher->dispatchCustomEvent(CMD_RESET_FONTATLAS,this);
+        s_diskCacheSuspended = false;
     }
 }
 
@@ -300,32 +469,38 @@ bool FontAtlas::prepareLetterDefinitions(const std::u16string& utf16Text)
         return false;
     }
 
+    std::vector<FontFreeType::GlyphBitmap> glyphs(codeMapOfNewChar.size());
+    std::vector<char16_t> glyphChars;
+    glyphChars.reserve(codeMapOfNewChar.size());
+    for (auto&& it : codeMapOfNewChar)
+    {
+        glyphs[glyphChars.size()].charCode = it.second;
+        glyphChars.push_back(it.first);
+    }
+    _fontFreeType->getGlyphBitmaps(glyphs);
+
     int adjustForDistanceMap = _letterPadding / 2;
     int adjustForExtend = _letterEdgeExtend / 2;
-    long bitmapWidth;
-    long bitmapHeight;
-    Rect tempRect;
     FontLetterDefinition tempDef;
 
     auto scaleFactor = CC_CONTENT_SCALE_FACTOR();
-    auto  pixelFormat = _fontFreeType->getOutlineSize() > 0 ? Texture2D::PixelFormat::AI88 : Texture2D::PixelFormat::A8;
+    auto bytesPerPixel = _fontFreeType->getGlyphBitmapBytesPerPixel();
 
-    float startY = _currentPageOrigY;
-
-    for (auto&& it : codeMapOfNewChar)
+    for (size_t index = 0; index < glyphs.size(); ++index)
     {
-        auto bitmap = _fontFreeType->getGlyphBitmap(it.second, bitmapWidth, bitmapHeight, tempRect, tempDef.xAdvance);
-        if (bitmap && bitmapWidth > 0 && bitmapHeight > 0)
+        const auto& glyph = glyphs[index];
+        tempDef.xAdvance = glyph.xAdvance;
+        if (!glyph.pixels.empty())
         {
             tempDef.validDefinition = true;
-            tempDef.width = tempRect.size.width + _letterPadding + _letterEdgeExtend;
-            tempDef.height = tempRect.size.height + _letterPadding + _letterEdgeExtend;
-            tempDef.offsetX = tempRect.origin.x + adjustForDistanceMap + adjustForExtend;
-            tempDef.offsetY = _fontAscender + tempRect.origin.y - adjustForDistanceMap - adjustForExtend;
+            tempDef.width = glyph.rect.size.width + _letterPadding + _letterEdgeExtend;
+            tempDef.height = glyph.rect.size.height + _letterPadding + _letterEdgeExtend;
+            tempDef.offsetX = glyph.rect.origin.x + adjustForDistanceMap + adjustForExtend;
+            tempDef.offsetY = _fontAscender + glyph.rect.origin.y - adjustForDistanceMap - adjustForExtend;
 
-            if (bitmapHeight > _currLineHeight)
+            if (glyph.height > _currLineHeight)
             {
-                _currLineHeight = static_cast<int>(bitmapHeight) + _letterPadding + _letterEdgeExtend + 1;
+                _currLineHeight = static_cast<int>(glyph.height) + _letterPadding + _letterEdgeExtend + 1;
             }
             if (_currentPageOrigX + tempDef.width > CacheTextureWidth)
             {
@@ -334,39 +509,29 @@ bool FontAtlas::prepareLetterDefinitions(const std::u16string& utf16Text)
                 _currentPageOrigX = 0;
                 if (_currentPageOrigY + _lineHeight >= CacheTextureHeight)
                 {
-                    unsigned char *data = nullptr;
-                    if (pixelFormat == Texture2D::PixelFormat::AI88)
+                    // the page is full, upload it before its data is reused by the next page
+                    updateTextures();
+                    if (!_diskCachePath.empty())
                     {
-                        data = _currentPageData + CacheTextureWidth * (int)startY * 2;
+                        savePageToDiskCache(_currentPage);
                     }
-                    else
-                    {
-                        data = _currentPageData + CacheTextureWidth * (int)startY;
-                    }
-                    _atlasTextures[_currentPage]->updateWithData(data, 0, startY,
-                        CacheTextureWidth, CacheTextureHeight - startY);
-
-                    startY = 0.0f;
 
                     _currentPageOrigY = 0;
                     memset(_currentPageData, 0, _currentPageDataSize);
                     _currentPage++;
-                    auto tex = new (std::nothrow) Texture2D;
-                    if (_antialiasEnabled)
-                    {
-                        tex->setAntiAliasTexParameters();
-                    }
-                    else
-                    {
-                        tex->setAliasTexParameters();
-                    }
-                    tex->initWithData(_currentPageData, _currentPageDataSize,
-                        pixelFormat, CacheTextureWidth, CacheTextureHeight, Size(CacheTextureWidth, CacheTextureHeight));
-                    addTexture(tex, _currentPage);
-                    tex->release();
+                    addPageTexture(_currentPage, _currentPageData);
                 }
             }
-            _fontFreeType->renderCharAt(_currentPageData, _currentPageOrigX + adjustForExtend, _currentPageOrigY + adjustForExtend, bitmap, bitmapWidth, bitmapHeight);
+
+            int posX = static_cast<int>(_currentPageOrigX) + adjustForExtend;
+            int posY = static_cast<int>(_currentPageOrigY) + adjustForExtend;
+            auto rowSize = glyph.pixelsWidth * bytesPerPixel;
+            for (long y = 0; y < glyph.pixelsHeight; ++y)
+            {
+                memcpy(_currentPageData + ((posY + y) * CacheTextureWidth + posX) * bytesPerPixel,
+                    glyph.pixels.data() + y * rowSize, rowSize);
+            }
+            addDirtyRows(static_cast<int>(_currentPageOrigY), posY + static_cast<int>(glyph.pixelsHeight));
 
             tempDef.U = _currentPageOrigX;
             tempDef.V = _currentPageOrigY;
@@ -394,23 +559,257 @@ bool FontAtlas::prepareLetterDefinitions(const std::u16string& utf16Text)
             _currentPageOrigX += 1;
         }
 
-        _letterDefinitions[it.first] = tempDef;
+        _letterDefinitions[glyphChars[index]] = tempDef;
     }
 
-    unsigned char *data = nullptr;
-    if (pixelFormat == Texture2D::PixelFormat::AI88)
+    _diskCacheDirty = true;
+    return true;
+}
+
+void FontAtlas::addPageTexture(int slot, const unsigned char* data)
+{
+    auto pixelFormat = _fontFreeType->getOutlineSize() > 0 ? Texture2D::PixelFormat::AI88 : Texture2D::PixelFormat::A8;
+    auto tex = new (std::nothrow) Texture2D;
+    if (_antialiasEnabled)
     {
-        data = _currentPageData + CacheTextureWidth * (int)startY * 2;
+        tex->setAntiAliasTexParameters();
     }
     else
     {
-        data = _currentPageData + CacheTextureWidth * (int)startY;
+        tex->setAliasTexParameters();
     }
-    _atlasTextures[_currentPage]->updateWithData(data, 0, startY, CacheTextureWidth, _currentPageOrigY - startY + _lineHeight);
+    tex->initWithData(data, _currentPageDataSize,
+        pixelFormat, CacheTextureWidth, CacheTextureHeight, Size(CacheTextureWidth, CacheTextureHeight));
+    addTexture(tex, slot);
+    tex->release();
+}
 
+std::string FontAtlas::getDiskCachePagePath(int page) const
+{
+    return StringUtils::format("%s.%d.page", _diskCachePath.c_str(), page);
+}
+
+bool FontAtlas::loadFromDiskCache()
+{
+    auto fileUtils = FileUtils::getInstance();
+    auto indexPath = _diskCachePath + ".atlas";
+    if (!fileUtils->isFileExist(indexPath))
+        return false;
+
+    auto index = mapDiskCacheFile(indexPath);
+    auto header = (const DiskCacheHeader*)index.getBytes();
+    if (index.isNull() || (size_t)index.getSize() < sizeof(DiskCacheHeader)
+        || memcmp(header->magic, DISK_CACHE_MAGIC, sizeof(DISK_CACHE_MAGIC)) != 0
+        || header->version != DISK_CACHE_VERSION
+        || header->pageWidth != (uint32_t)CacheTextureWidth || header->pageHeight != (uint32_t)CacheTextureHeight
+        || header->pageDataSize != (uint32_t)_currentPageDataSize || header->pageCount == 0
+        || header->letterPadding != _letterPadding || header->letterEdgeExtend != _letterEdgeExtend
+        || header->contentScaleFactor != CC_CONTENT_SCALE_FACTOR()
+        || (size_t)index.getSize() != sizeof(DiskCacheHeader) + header->letterCount * sizeof(DiskCacheLetter))
+    {
+        CCLOG("cocos2d: FontAtlas: ignoring the invalid disk cache %s", indexPath.c_str());
+        return false;
+    }
+
+    // check all the files before changing the atlas
+    std::vector<MappedFile> pages(header->pageCount);
+    for (uint32_t page = 0; page < header->pageCount; ++page)
+    {
+        pages[page] = mapDiskCacheFile(getDiskCachePagePath(page));
+        if (pages[page].getSize() != _currentPageDataSize)
+        {
+            CCLOG("cocos2d: FontAtlas: ignoring the disk cache %s, page %u is missing", indexPath.c_str(), page);
+            return false;
+        }
+    }
+
+    auto letters = (const DiskCacheLetter*)(header + 1);
+    for (uint32_t i = 0; i < header->letterCount; ++i)
+    {
+        if (letters[i].textureID < 0 || (uint32_t)letters[i].textureID >= header->pageCount)
+        {
+            CCLOG("cocos2d: FontAtlas: ignoring the invalid disk cache %s", indexPath.c_str());
+            return false;
+        }
+    }
+
+    for (uint32_t page = 0; page < header->pageCount; ++page)
+    {
+        if (page == 0)
+        {
+            _atlasTextures[0]->updateWithData(pages[0].getBytes(), 0, 0, CacheTextureWidth, CacheTextureHeight);
+        }
+        else
+        {
+            addPageTexture(page, pages[page].getBytes());
+        }
+    }
+    memcpy(_currentPageData, pages.back().getBytes(), _currentPageDataSize);
+    _currentPage = header->pageCount - 1;
+    _currentPageOrigX = header->currentPageOrigX;
+    _currentPageOrigY = header->currentPageOrigY;
+    _currLineHeight = header->currLineHeight;
+
+    FontLetterDefinition letterDefinition;
+    for (uint32_t i = 0; i < header->letterCount; ++i)
+    {
+        const auto& letter = letters[i];
+        letterDefinition.U = letter.U;
+        letterDefinition.V = letter.V;
+        letterDefinition.width = letter.width;
+        letterDefinition.height = letter.height;
+        letterDefinition.offsetX = letter.offsetX;
+        letterDefinition.offsetY = letter.offsetY;
+        letterDefinition.textureID = letter.textureID;
+        letterDefinition.xAdvance = letter.xAdvance;
+        letterDefinition.validDefinition = letter.validDefinition != 0;
+        _letterDefinitions[(char16_t)letter.utf16Char] = letterDefinition;
+    }
+
+    // the pages in the cache are the ones this atlas keeps filling
+    _diskCacheIndexRemoved = true;
     return true;
 }
 
+void FontAtlas::prepareDiskCacheWrite()
+{
+    auto fileUtils = FileUtils::getInstance();
+    auto directory = FontAtlasCache::getDiskCachePath();
+    if (!fileUtils->isDirectoryExist(directory))
+    {
+        fileUtils->createDirectory(directory);
+    }
+
+    if (!_diskCacheIndexRemoved)
+    {
+        // the pages of another atlas are overwritten, its index doesn't match them anymore
+        auto indexPath = _diskCachePath + ".atlas";
+        if (fileUtils->isFileExist(indexPath))
+        {
+            fileUtils->removeFile(indexPath);
+        }
+        _diskCacheIndexRemoved = true;
+    }
+}
+
+void FontAtlas::savePageToDiskCache(int page)
+{
+    prepareDiskCacheWrite();
+
+    auto fileUtils = FileUtils::getInstance();
+    Data data;
+    data.copy(_currentPageData, _currentPageDataSize);
+    if (!fileUtils->writeDataToFile(std::move(data), getDiskCachePagePath(page)))
+    {
+        CCLOG("cocos2d: FontAtlas: can't write %s", getDiskCachePagePath(page).c_str());
+    }
+}
+
+void FontAtlas::saveToDiskCache()
+{
+    if (_diskCachePath.empty() || !_diskCacheDirty)
+        return;
+
+    prepareDiskCacheWrite();
+
+    Data page;
+    page.copy(_currentPageData, _currentPageDataSize);
+    if (writeDiskCacheFiles(page, getDiskCachePagePath(_currentPage), createDiskCacheIndex(), _diskCachePath + ".atlas"))
+    {
+        _diskCacheDirty = false;
+    }
+}
+
+Data FontAtlas::createDiskCacheIndex() const
+{
+    Data data;
+    auto letterCount = _letterDefinitions.size();
+    auto size = sizeof(DiskCacheHeader) + letterCount * sizeof(DiskCacheLetter);
+    auto bytes = (unsigned char*)malloc(size);
+    if (bytes == nullptr)
+        return data;
+    memset(bytes, 0, size);
+
+    auto header = (DiskCacheHeader*)bytes;
+    memcpy(header->magic, DISK_CACHE_MAGIC, sizeof(DISK_CACHE_MAGIC));
+    header->version = DISK_CACHE_VERSION;
+    header->pageWidth = CacheTextureWidth;
+    header->pageHeight = CacheTextureHeight;
+    header->pageDataSize = _currentPageDataSize;
+    header->pageCount = _currentPage + 1;
+    header->letterCount = (uint32_t)letterCount;
+    header->letterPadding = _letterPadding;
+    header->letterEdgeExtend = _letterEdgeExtend;
+    header->currLineHeight = _currLineHeight;
+    header->currentPageOrigX = _currentPageOrigX;
+    header->currentPageOrigY = _currentPageOrigY;
+    header->contentScaleFactor = CC_CONTENT_SCALE_FACTOR();
+
+    auto letter = (DiskCacheLetter*)(header + 1);
+    for (const auto& item : _letterDefinitions)
+    {
+        const auto& letterDefinition = item.second;
+        letter->utf16Char = item.first;
+        letter->U = letterDefinition.U;
+        letter->V = letterDefinition.V;
+        letter->width = letterDefinition.width;
+        letter->height = letterDefinition.height;
+        letter->offsetX = letterDefinition.offsetX;
+        letter->offsetY = letterDefinition.offsetY;
+        letter->textureID = letterDefinition.textureID;
+        letter->xAdvance = letterDefinition.xAdvance;
+        letter->validDefinition = letterDefinition.validDefinition ? 1 : 0;
+        ++letter;
+    }
+
+    data.fastSet(bytes, size);
+    return data;
+}
+
+void FontAtlas::waitForDiskCacheWrites()
+{
+    for (auto& item : s_diskCachePaths)
+    {
+        if (item.second)
+        {
+            JobSystem::getInstance()->wait(item.second);
+        }
+    }
+}
+
+void FontAtlas::addDirtyRows(int top, int bottom)
+{
+    if (_currentPageDirtyBottom <= _currentPageDirtyTop)
+    {
+        s_atlasesToUpdate.push_back(this);
+    }
+    _currentPageDirtyTop = std::min(_currentPageDirtyTop, std::max(top, 0));
+    _currentPageDirtyBottom = std::max(_currentPageDirtyBottom, std::min(bottom, CacheTextureHeight));
+}
+
+void FontAtlas::updateTextures()
+{
+    if (_currentPageDirtyBottom <= _currentPageDirtyTop)
+        return;
+
+    int bytesPerPixel = _fontFreeType->getOutlineSize() > 0 ? 2 : 1;
+    auto data = _currentPageData + CacheTextureWidth * _currentPageDirtyTop * bytesPerPixel;
+    _atlasTextures[_currentPage]->updateWithData(data, 0, _currentPageDirtyTop,
+        CacheTextureWidth, _currentPageDirtyBottom - _currentPageDirtyTop);
+
+    _currentPageDirtyTop = CacheTextureHeight;
+    _currentPageDirtyBottom = 0;
+    s_atlasesToUpdate.erase(std::remove(s_atlasesToUpdate.begin(), s_atlasesToUpdate.end(), this), s_atlasesToUpdate.end());
+}
+
+void FontAtlas::updatePendingTextures()
+{
+    while (!s_atlasesToUpdate.empty())
+    {
+        s_atlasesToUpdate.back()->updateTextures();
+    }
+}
+
 void FontAtlas::addTexture(Texture2D *texture, int slot)
 {
     texture->retain();
@@ -30,9 +30,11 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "platform/CCPlatformMacros.h"
 #include "base/CCRef.h"
+#include "base/CCData.h"
 #include "platform/CCStdC.h" // ssize_t on windows
 
 NS_CC_BEGIN
@@ -76,7 +78,28 @@ public:
     void addLetterDefinition(char16_t utf16Char, const FontLetterDefinition &letterDefinition);
     bool getLetterDefinitionForChar(char16_t utf16Char, FontLetterDefinition &letterDefinition);
     
+    /** Renders the glyphs of the new letters into the current page.
+     The page texture isn't updated right away, the rows added during a frame are uploaded at once by updateTextures().
+     */
     bool prepareLetterDefinitions(const std::u16string& utf16String);
+    
+    /** Uploads the rows of the current page which were added since the last update to its texture. */
+    void updateTextures();
+    
+    /** Updates the textures of all the font atlases with pending rows, Director calls it before rendering each frame.
+     Call it before rendering with Renderer::render() outside of the main loop if letters were added meanwhile.
+     */
+    static void updatePendingTextures();
+    
+    /** Saves the pages and the letter definitions to the disk cache if letters were added since they were loaded.
+     It does nothing if FontAtlasCache::isDiskCacheEnabled() was false when the atlas was created,
+     or if another atlas of the same font data was using the disk cache.
+     The atlases released with new letters save them in the background.
+     */
+    void saveToDiskCache();
+
+    /** Blocks until the released atlases are saved to the disk cache, Director calls it when it ends. */
+    static void waitForDiskCacheWrites();
 
     inline const std::unordered_map<ssize_t, Texture2D*>& getTextures() const{ return _atlasTextures;}
     void  addTexture(Texture2D *texture, int slot);
@@ -115,6 +138,16 @@ protected:
 
     void conversionU16TOGB2312(const std::u16string& u16Text, std::unordered_map<unsigned short, unsigned short>& charCodeMap);
 
+    void addDirtyRows(int top, int bottom);
+    void addPageTexture(int slot, const unsigned char* data);
+
+    std::string getDiskCachePagePath(int page) const;
+    bool loadFromDiskCache();
+    // creates the directory and removes the index of the pages this atlas overwrites
+    void prepareDiskCacheWrite();
+    void savePageToDiskCache(int page);
+    Data createDiskCacheIndex() const;
+
     std::unordered_map<ssize_t, Texture2D*> _atlasTextures;
     std::unordered_map<char16_t, FontLetterDefinition> _letterDefinitions;
     float _lineHeight;
@@ -135,6 +168,17 @@ protected:
     EventListenerCustom* _rendererRecreatedListener;
     bool _antialiasEnabled;
     int _currLineHeight;
+    // rows of the current page not uploaded to its texture yet, empty when top >= bottom
+    int _currentPageDirtyTop;
+    int _currentPageDirtyBottom;
+
+    // path of the files of the atlas in the disk cache without extension, empty if it isn't cached
+    std::string _diskCachePath;
+    // letters were added since the disk cache was loaded or saved
+    bool _diskCacheDirty;
+    // the index in the disk cache was removed or written by this atlas, so the pages on disk are its own
+    bool _diskCacheIndexRemoved;
+    EventListenerCustom* _comeToBackgroundListener;
 
     friend class Label;
 };
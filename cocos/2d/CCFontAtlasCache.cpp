@@ -32,10 +32,12 @@
 #include "2d/CCFontAtlas.h"
 #include "2d/CCFontCharMap.h"
 #include "2d/CCLabel.h"
+#include "platform/CCFileUtils.h"
 
 NS_CC_BEGIN
 
 std::unordered_map<std::string, FontAtlas *> FontAtlasCache::_atlasMap;
+bool FontAtlasCache::_diskCacheEnabled = false;
 
 void FontAtlasCache::purgeCachedData()
 {
@@ -46,6 +48,24 @@ void FontAtlasCache::purgeCachedData()
     }
 }
 
+std::string FontAtlasCache::getDiskCachePath()
+{
+    return FileUtils::getInstance()->getWritablePath() + "fontatlas/";
+}
+
+void FontAtlasCache::removeDiskCache()
+{
+    // the released atlases may be writing into the directory
+    FontAtlas::waitForDiskCacheWrites();
+
+    auto fileUtils = FileUtils::getInstance();
+    auto path = getDiskCachePath();
+    if (fileUtils->isDirectoryExist(path))
+    {
+        fileUtils->removeDirectory(path);
+    }
+}
+
 FontAtlas* FontAtlasCache::getFontAtlasTTF(const _ttfConfig* config)
 {  
     bool useDistanceField = config->distanceFieldEnabled;
@@ -28,6 +28,7 @@
 
 /// @cond DO_NOT_SHOW
 
+#include <string>
 #include <unordered_map>
 #include "base/ccTypes.h"
 
@@ -54,9 +55,32 @@ public:
      */
     static void purgeCachedData();
     
+    /** Enables the cache on disk of the TTF font atlases, it is disabled by default.
+     The pages and letter definitions of an atlas are saved when it is released or the application goes to background,
+     and the atlas of the same font file, size, outline and distance field loads them instead of rendering the letters again.
+     @since v3.9
+     */
+    static void setDiskCacheEnabled(bool enabled) { _diskCacheEnabled = enabled; }
+    
+    /** Whether the TTF font atlases are cached on disk.
+     @since v3.9
+     */
+    static bool isDiskCacheEnabled() { return _diskCacheEnabled; }
+    
+    /** Returns the directory of the disk cache, in the writable path.
+     @since v3.9
+     */
+    static std::string getDiskCachePath();
+    
+    /** Removes the font atlases cached on disk.
+     @since v3.9
+     */
+    static void removeDiskCache();
+    
 private:
     static std::string generateFontName(const std::string& fontFileName, int size, bool useDistanceField);
     static std::unordered_map<std::string, FontAtlas *> _atlasMap;
+    static bool _diskCacheEnabled;
 };
 
 NS_CC_END
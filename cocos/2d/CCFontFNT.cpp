@@ -147,7 +147,7 @@ public:
     std::set<unsigned int>* getCharacterSet() const;
 private:
     std::set<unsigned int>* parseConfigFile(const std::string& controlFile);
-    std::set<unsigned int>* parseBinaryConfigFile(unsigned char* pData, unsigned long size, const std::string& controlFile);
+    std::set<unsigned int>* parseBinaryConfigFile(const unsigned char* pData, unsigned long size, const std::string& controlFile);
     void parseCharacterDefinition(const char* line, BMFontDef *characterDefinition);
     void parseInfoArguments(const char* line);
     void parseCommonArguments(const char* line);
@@ -272,10 +272,14 @@ void BMFontConfiguration::purgeFontDefDictionary()
 
 std::set<unsigned int>* BMFontConfiguration::parseConfigFile(const std::string& controlFile)
 {
-    Data data = FileUtils::getInstance()->getDataFromFile(controlFile);
+    MappedFile data = FileUtils::getInstance()->mapFile(controlFile);
     CCASSERT((!data.isNull()), "BMFontConfiguration::parseConfigFile | Open file error.");
+    if (data.isNull())
+    {
+        return nullptr;
+    }
 
-    if (memcmp("BMF", data.getBytes(), 3) == 0) {
+    if (data.getSize() >= 3 && memcmp("BMF", data.getBytes(), 3) == 0) {
         std::set<unsigned int>* ret = parseBinaryConfigFile(data.getBytes(), data.getSize(), controlFile);
         return ret;
     }
@@ -292,7 +296,8 @@ std::set<unsigned int>* BMFontConfiguration::parseConfigFile(const std::string&
     auto contentsLen = data.getSize();
     char line[512];
     
-    auto next = strchr(contents, '\n');
+    // the data isn't null terminated, search the line ends within it
+    auto next = (const char*)memchr(contents, '\n', contentsLen);
     auto base = contents;
     int lineLength = 0;
     int parseCount = 0;
@@ -306,7 +311,7 @@ std::set<unsigned int>* BMFontConfiguration::parseConfigFile(const std::string&
         if (parseCount < contentsLen)
         {
             base = next + 1;
-            next = strchr(base, '\n');
+            next = (const char*)memchr(base, '\n', contentsLen - parseCount);
         } 
         else
         {
@@ -357,7 +362,7 @@ std::set<unsigned int>* BMFontConfiguration::parseConfigFile(const std::string&
     return validCharsString;
 }
 
-std::set<unsigned int>* BMFontConfiguration::parseBinaryConfigFile(unsigned char* pData, unsigned long size, const std::string& controlFile)
+std::set<unsigned int>* BMFontConfiguration::parseBinaryConfigFile(const unsigned char* pData, unsigned long size, const std::string& controlFile)
 {
     /* based on http://www.angelcode.com/products/bmfont/doc/file_format.html file format */
 
@@ -29,7 +29,12 @@ THE SOFTWARE.
 #include "CCFontAtlas.h"
 #include "base/CCDirector.h"
 #include "base/ccUTF8.h"
+#include "base/CCJobSystem.h"
 #include "platform/CCFileUtils.h"
+#include "deprecated/CCString.h"
+#include "xxhash.h"
+
+#include <algorithm>
 
 NS_CC_BEGIN
 
@@ -38,6 +43,9 @@ FT_Library FontFreeType::_FTlibrary;
 bool       FontFreeType::_FTInitialized = false;
 const int  FontFreeType::DistanceMapSpread = 3;
 
+// below this number of glyphs, they are rendered on the cocos thread only
+static const size_t GLYPHS_PER_JOB_MIN = 8;
+
 const char* FontFreeType::_glyphASCII = "\"!#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~¡¢£¤¥¦§¨©ª«¬­®¯°±²³´µ¶·¸¹º»¼½¾¿ÀÁÂÃÄÅÆÇÈÉÊËÌÍÎÏÐÑÒÓÔÕÖ×ØÙÚÛÜÝÞßàáâãäåæçèéêëìíîïðñòóôõö÷øùúûüýþ ";
 const char* FontFreeType::_glyphNEHE = "!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~ ";
 
@@ -103,6 +111,7 @@ FontFreeType::FontFreeType(bool distanceFieldEnabled /* = false */,int outline /
 , _lineHeight(0)
 , _fontAtlas(nullptr)
 , _encoding(FT_ENCODING_UNICODE)
+, _charSize(0)
 , _usedGlyphs(GlyphCollection::ASCII)
 {
     if (outline > 0)
@@ -171,6 +180,7 @@ bool FontFreeType::createFontObject(const std::string &fontName, int fontSize)
     int fontSizePoints = (int)(64.f * fontSize * CC_CONTENT_SCALE_FACTOR());
     if (FT_Set_Char_Size(face, fontSizePoints, fontSizePoints, dpi, dpi))
         return false;
+    _charSize = fontSizePoints;
     
     // store the face globally
     _fontRef = face;
@@ -182,6 +192,12 @@ bool FontFreeType::createFontObject(const std::string &fontName, int fontSize)
 
 FontFreeType::~FontFreeType()
 {
+    for (auto renderer : _idleGlyphRenderers)
+    {
+        destroyGlyphRenderer(renderer);
+    }
+    _idleGlyphRenderers.clear();
+
     if (_stroker)
     {
         FT_Stroker_Done(_stroker);
@@ -272,37 +288,44 @@ int FontFreeType::getFontAscender() const
 }
 
 unsigned char* FontFreeType::getGlyphBitmap(unsigned short theChar, long &outWidth, long &outHeight, Rect &outRect,int &xAdvance)
+{
+    GlyphRenderer renderer = { _FTlibrary, _fontRef, _stroker };
+    return getGlyphBitmap(renderer, theChar, outWidth, outHeight, outRect, xAdvance);
+}
+
+unsigned char* FontFreeType::getGlyphBitmap(const GlyphRenderer& renderer, unsigned short theChar, long &outWidth, long &outHeight, Rect &outRect,int &xAdvance)
 {
     bool invalidChar = true;
     unsigned char* ret = nullptr;
+    FT_Face face = renderer.face;
 
     do
     {
-        if (_fontRef == nullptr)
+        if (face == nullptr)
             break;
 
         if (_distanceFieldEnabled)
         {
-            if (FT_Load_Char(_fontRef, theChar, FT_LOAD_RENDER | FT_LOAD_NO_HINTING | FT_LOAD_NO_AUTOHINT))
+            if (FT_Load_Char(face, theChar, FT_LOAD_RENDER | FT_LOAD_NO_HINTING | FT_LOAD_NO_AUTOHINT))
                 break;
         }
         else
         {
-            if (FT_Load_Char(_fontRef, theChar, FT_LOAD_RENDER | FT_LOAD_NO_AUTOHINT))
+            if (FT_Load_Char(face, theChar, FT_LOAD_RENDER | FT_LOAD_NO_AUTOHINT))
                 break;
         }
 
-        auto& metrics = _fontRef->glyph->metrics;
+        auto& metrics = face->glyph->metrics;
         outRect.origin.x = metrics.horiBearingX >> 6;
         outRect.origin.y = -(metrics.horiBearingY >> 6);
         outRect.size.width = (metrics.width >> 6);
         outRect.size.height = (metrics.height >> 6);
 
-        xAdvance = (static_cast<int>(_fontRef->glyph->metrics.horiAdvance >> 6));
+        xAdvance = (static_cast<int>(face->glyph->metrics.horiAdvance >> 6));
 
-        outWidth  = _fontRef->glyph->bitmap.width;
-        outHeight = _fontRef->glyph->bitmap.rows;
-        ret = _fontRef->glyph->bitmap.buffer;
+        outWidth  = face->glyph->bitmap.width;
+        outHeight = face->glyph->bitmap.rows;
+        ret = face->glyph->bitmap.buffer;
 
         if (_outlineSize > 0)
         {
@@ -310,7 +333,7 @@ unsigned char* FontFreeType::getGlyphBitmap(unsigned short theChar, long &outWid
             memcpy(copyBitmap,ret,outWidth * outHeight * sizeof(unsigned char));
 
             FT_BBox bbox;
-            auto outlineBitmap = getGlyphBitmapWithOutline(theChar,bbox);
+            auto outlineBitmap = getGlyphBitmapWithOutline(renderer, theChar, bbox);
             if(outlineBitmap == nullptr)
             {
                 ret = nullptr;
@@ -393,17 +416,17 @@ unsigned char* FontFreeType::getGlyphBitmap(unsigned short theChar, long &outWid
     }
 }
 
-unsigned char * FontFreeType::getGlyphBitmapWithOutline(unsigned short theChar, FT_BBox &bbox)
+unsigned char * FontFreeType::getGlyphBitmapWithOutline(const GlyphRenderer& renderer, unsigned short theChar, FT_BBox &bbox)
 {   
     unsigned char* ret = nullptr;
-    if (FT_Load_Char(_fontRef, theChar, FT_LOAD_NO_BITMAP) == 0)
+    if (FT_Load_Char(renderer.face, theChar, FT_LOAD_NO_BITMAP) == 0)
     {
-        if (_fontRef->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+        if (renderer.face->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
         {
             FT_Glyph glyph;
-            if (FT_Get_Glyph(_fontRef->glyph, &glyph) == 0)
+            if (FT_Get_Glyph(renderer.face->glyph, &glyph) == 0)
             {
-                FT_Glyph_StrokeBorder(&glyph, _stroker, 0, 1);
+                FT_Glyph_StrokeBorder(&glyph, renderer.stroker, 0, 1);
                 if (glyph->format == FT_GLYPH_FORMAT_OUTLINE)
                 {
                     FT_Outline *outline = &reinterpret_cast<FT_OutlineGlyph>(glyph)->outline;
@@ -426,7 +449,7 @@ unsigned char * FontFreeType::getGlyphBitmapWithOutline(unsigned short theChar,
                     params.target = &bmp;
                     params.flags = FT_RASTER_FLAG_AA;
                     FT_Outline_Translate(outline,-bbox.xMin,-bbox.yMin);
-                    FT_Outline_Render(_FTlibrary, outline, &params);
+                    FT_Outline_Render(renderer.library, outline, &params);
 
                     ret = bmp.buffer;
                 }
@@ -599,6 +622,226 @@ void FontFreeType::renderCharAt(unsigned char *dest,int posX, int posY, unsigned
     } 
 }
 
+void FontFreeType::renderGlyphBitmap(const GlyphRenderer& renderer, GlyphBitmap& glyph)
+{
+    glyph.width = 0;
+    glyph.height = 0;
+    glyph.pixels.clear();
+    glyph.pixelsWidth = 0;
+    glyph.pixelsHeight = 0;
+
+    auto bitmap = getGlyphBitmap(renderer, glyph.charCode, glyph.width, glyph.height, glyph.rect, glyph.xAdvance);
+    if (bitmap && glyph.width > 0 && glyph.height > 0)
+    {
+        if (_distanceFieldEnabled)
+        {
+            auto distanceMap = makeDistanceMap(bitmap, glyph.width, glyph.height);
+            glyph.pixelsWidth = glyph.width + 2 * DistanceMapSpread;
+            glyph.pixelsHeight = glyph.height + 2 * DistanceMapSpread;
+            glyph.pixels.assign(distanceMap, distanceMap + glyph.pixelsWidth * glyph.pixelsHeight);
+            free(distanceMap);
+        }
+        else
+        {
+            glyph.pixelsWidth = glyph.width;
+            glyph.pixelsHeight = glyph.height;
+            glyph.pixels.assign(bitmap, bitmap + glyph.pixelsWidth * glyph.pixelsHeight * getGlyphBitmapBytesPerPixel());
+        }
+    }
+
+    // the outline bitmap is allocated by getGlyphBitmap, the others belong to the face
+    if (bitmap && _outlineSize > 0)
+    {
+        delete [] bitmap;
+    }
+}
+
+void FontFreeType::renderGlyphBitmaps(const GlyphRenderer& renderer, GlyphBitmap* glyphs, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        renderGlyphBitmap(renderer, glyphs[i]);
+    }
+}
+
+void FontFreeType::getGlyphBitmaps(std::vector<GlyphBitmap>& glyphs)
+{
+    GlyphRenderer mainRenderer = { _FTlibrary, _fontRef, _stroker };
+
+    auto fontDataIter = s_cacheFontData.find(_fontName);
+    if (glyphs.size() < 2 * GLYPHS_PER_JOB_MIN || _fontRef == nullptr || fontDataIter == s_cacheFontData.end())
+    {
+        renderGlyphBitmaps(mainRenderer, glyphs.data(), glyphs.size());
+        return;
+    }
+
+    // this thread renders its share too
+    auto jobSystem = JobSystem::getInstance();
+    size_t jobCount = std::min(glyphs.size() / GLYPHS_PER_JOB_MIN, (size_t)jobSystem->getWorkerCount() + 1);
+
+    // the font data is shared by the faces, and it is not released while this font exists
+    const unsigned char* fontData = fontDataIter->second.data.getBytes();
+    FT_Long fontDataSize = static_cast<FT_Long>(fontDataIter->second.data.getSize());
+
+    // xAdvance is set once a glyph is rendered
+    for (auto& glyph : glyphs)
+    {
+        glyph.xAdvance = -1;
+    }
+
+    // A share is rendered by whoever claims it first: a job when it starts, or this thread
+    // once it is done with its own share, so the jobs stuck behind other tasks are not waited for.
+    struct Share
+    {
+        GlyphBitmap* glyphs;
+        size_t count;
+        std::shared_ptr<std::atomic<bool>> claimed;
+        JobSystem::JobHandle job;
+    };
+
+    size_t glyphsPerJob = (glyphs.size() + jobCount - 1) / jobCount;
+    std::vector<Share> shares;
+    shares.reserve(jobCount - 1);
+    for (size_t first = glyphsPerJob; first < glyphs.size(); first += glyphsPerJob)
+    {
+        Share share;
+        share.glyphs = glyphs.data() + first;
+        share.count = std::min(glyphsPerJob, glyphs.size() - first);
+        share.claimed = std::make_shared<std::atomic<bool>>(false);
+
+        auto jobGlyphs = share.glyphs;
+        auto jobGlyphCount = share.count;
+        auto claimed = share.claimed;
+        share.job = jobSystem->schedule([this, jobGlyphs, jobGlyphCount, claimed, fontData, fontDataSize](){
+            // the glyphs and the font may be gone if this thread claimed the share
+            if (claimed->exchange(true))
+                return;
+
+            GlyphRenderer* renderer = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(_glyphRenderersMutex);
+                if (!_idleGlyphRenderers.empty())
+                {
+                    renderer = _idleGlyphRenderers.back();
+                    _idleGlyphRenderers.pop_back();
+                }
+            }
+            if (renderer == nullptr)
+            {
+                renderer = createGlyphRenderer(fontData, fontDataSize);
+                if (renderer == nullptr)
+                    return;
+            }
+
+            renderGlyphBitmaps(*renderer, jobGlyphs, jobGlyphCount);
+
+            std::lock_guard<std::mutex> lock(_glyphRenderersMutex);
+            _idleGlyphRenderers.push_back(renderer);
+        }, nullptr, JobSystem::Priority::HIGH);
+        shares.push_back(share);
+    }
+
+    // the first glyphs are rendered on this thread meanwhile
+    renderGlyphBitmaps(mainRenderer, glyphs.data(), std::min(glyphsPerJob, glyphs.size()));
+
+    // then the shares of the jobs that did not start yet, the others are waited for
+    for (auto& share : shares)
+    {
+        if (!share.claimed->exchange(true))
+        {
+            share.job->cancel();
+            renderGlyphBitmaps(mainRenderer, share.glyphs, share.count);
+        }
+        else
+        {
+            jobSystem->wait(share.job);
+        }
+    }
+
+    // render the glyphs of the jobs that could not create a face
+    for (auto& glyph : glyphs)
+    {
+        if (glyph.xAdvance < 0)
+        {
+            renderGlyphBitmap(mainRenderer, glyph);
+        }
+    }
+}
+
+std::string FontFreeType::getGlyphBitmapsKey() const
+{
+    auto fontDataIter = s_cacheFontData.find(_fontName);
+    if (_fontRef == nullptr || fontDataIter == s_cacheFontData.end())
+        return "";
+
+    const Data& fontData = fontDataIter->second.data;
+    unsigned int hash = XXH32(fontData.getBytes(), (int)fontData.getSize(), 0);
+    return StringUtils::format("%08x_%ld_%d_%d", hash, (long)_charSize, (int)(_outlineSize * 64), _distanceFieldEnabled ? 1 : 0);
+}
+
+FontFreeType::GlyphRenderer* FontFreeType::createGlyphRenderer(const unsigned char* fontData, FT_Long fontDataSize) const
+{
+    auto renderer = new (std::nothrow) GlyphRenderer();
+    if (renderer == nullptr)
+        return nullptr;
+
+    do
+    {
+        if (FT_Init_FreeType(&renderer->library))
+        {
+            renderer->library = nullptr;
+            break;
+        }
+
+        if (FT_New_Memory_Face(renderer->library, fontData, fontDataSize, 0, &renderer->face))
+        {
+            renderer->face = nullptr;
+            break;
+        }
+
+        int dpi = 72;
+        if (FT_Select_Charmap(renderer->face, _encoding) ||
+            FT_Set_Char_Size(renderer->face, _charSize, _charSize, dpi, dpi))
+            break;
+
+        if (_stroker)
+        {
+            if (FT_Stroker_New(renderer->library, &renderer->stroker))
+            {
+                renderer->stroker = nullptr;
+                break;
+            }
+            FT_Stroker_Set(renderer->stroker,
+                (int)(_outlineSize * 64),
+                FT_STROKER_LINECAP_ROUND,
+                FT_STROKER_LINEJOIN_ROUND,
+                0);
+        }
+
+        return renderer;
+    } while (0);
+
+    destroyGlyphRenderer(renderer);
+    return nullptr;
+}
+
+void FontFreeType::destroyGlyphRenderer(GlyphRenderer* renderer)
+{
+    if (renderer->stroker)
+    {
+        FT_Stroker_Done(renderer->stroker);
+    }
+    if (renderer->face)
+    {
+        FT_Done_Face(renderer->face);
+    }
+    if (renderer->library)
+    {
+        FT_Done_FreeType(renderer->library);
+    }
+    delete renderer;
+}
+
 void FontFreeType::setGlyphCollection(GlyphCollection glyphs, const char* customGlyphs /* = nullptr */)
 {
     _usedGlyphs = glyphs;
@@ -31,6 +31,8 @@
 #include "CCFont.h"
 
 #include <string>
+#include <vector>
+#include <mutex>
 #include <ft2build.h>
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WINRT)
@@ -53,6 +55,21 @@ class CC_DLL FontFreeType : public Font
 public:
     static const int DistanceMapSpread;
 
+    /** A glyph rendered by getGlyphBitmaps, ready to be copied into a font atlas page. */
+    struct GlyphBitmap
+    {
+        unsigned short charCode;
+        // the size of the glyph bitmap, as returned by getGlyphBitmap
+        long width;
+        long height;
+        Rect rect;
+        int xAdvance;
+        // the pixels copied into the atlas, with the distance map computed if it is enabled, empty if there is no bitmap
+        std::vector<unsigned char> pixels;
+        long pixelsWidth;
+        long pixelsHeight;
+    };
+
     static FontFreeType* create(const std::string &fontName, int fontSize, GlyphCollection glyphs, 
         const char *customGlyphs,bool distanceFieldEnabled = false,int outline = 0);
 
@@ -62,7 +79,8 @@ public:
 
     float getOutlineSize() const { return _outlineSize; }
 
-    void renderCharAt(unsigned char *dest,int posX, int posY, unsigned char* bitmap,long bitmapWidth,long bitmapHeight); 
+    /** @deprecated Use getGlyphBitmaps() instead, it renders the glyphs with their distance map or outline. */
+    CC_DEPRECATED_ATTRIBUTE void renderCharAt(unsigned char *dest,int posX, int posY, unsigned char* bitmap,long bitmapWidth,long bitmapHeight); 
 
     FT_Encoding getEncoding() const { return _encoding; }
 
@@ -70,6 +88,20 @@ public:
     
     unsigned char* getGlyphBitmap(unsigned short theChar, long &outWidth, long &outHeight, Rect &outRect,int &xAdvance);
     
+    /** Renders the glyphs whose charCode is set. When there are many of them they are rendered
+     * in parallel on the job system, each job thread using its own FreeType face. The shares of the jobs
+     * that did not start when the calling thread is done with its own are rendered by the calling thread.
+     */
+    void getGlyphBitmaps(std::vector<GlyphBitmap>& glyphs);
+    
+    /** Returns the number of bytes per pixel of GlyphBitmap::pixels */
+    int getGlyphBitmapBytesPerPixel() const { return (_outlineSize > 0 && !_distanceFieldEnabled) ? 2 : 1; }
+    
+    /** Returns a key of the glyph bitmaps made from the hash of the font data, the size, the outline and the distance field.
+     * It is empty if the font isn't loaded.
+     */
+    std::string getGlyphBitmapsKey() const;
+    
     int getFontAscender() const;
 
     virtual FontAtlas* createFontAtlas() override;
@@ -80,6 +112,14 @@ private:
     static FT_Library _FTlibrary;
     static bool _FTInitialized;
 
+    // A face of the font, FreeType objects can't be used on several threads at the same time
+    struct GlyphRenderer
+    {
+        FT_Library library;
+        FT_Face face;
+        FT_Stroker stroker;
+    };
+
     FontFreeType(bool distanceFieldEnabled = false, int outline = 0);
     virtual ~FontFreeType();
 
@@ -89,7 +129,14 @@ private:
     FT_Library getFTLibrary();
     
     int getHorizontalKerningForChars(unsigned short firstChar, unsigned short secondChar) const;
-    unsigned char* getGlyphBitmapWithOutline(unsigned short code, FT_BBox &bbox);
+    unsigned char* getGlyphBitmap(const GlyphRenderer& renderer, unsigned short theChar, long &outWidth, long &outHeight, Rect &outRect,int &xAdvance);
+    unsigned char* getGlyphBitmapWithOutline(const GlyphRenderer& renderer, unsigned short code, FT_BBox &bbox);
+    void renderGlyphBitmap(const GlyphRenderer& renderer, GlyphBitmap& glyph);
+    void renderGlyphBitmaps(const GlyphRenderer& renderer, GlyphBitmap* glyphs, size_t count);
+
+    // creates a face with its own library, to be used by a job thread
+    GlyphRenderer* createGlyphRenderer(const unsigned char* fontData, FT_Long fontDataSize) const;
+    static void destroyGlyphRenderer(GlyphRenderer* renderer);
 
     void setGlyphCollection(GlyphCollection glyphs, const char* customGlyphs = nullptr);
     const char* getGlyphCollection() const;
@@ -97,6 +144,11 @@ private:
     FT_Face _fontRef;
     FT_Stroker _stroker;
     FT_Encoding _encoding;
+    FT_F26Dot6 _charSize;
+
+    // the faces of the job threads, created the first time they are needed
+    std::vector<GlyphRenderer*> _idleGlyphRenderers;
+    std::mutex _glyphRenderersMutex;
 
     std::string _fontName;
     bool _distanceFieldEnabled;
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <algorithm>
 #include <string>
 #include <regex>
+#include <atomic>
 
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
@@ -44,6 +45,9 @@ THE SOFTWARE.
 #include "renderer/CCGLProgram.h"
 #include "renderer/CCGLProgramState.h"
 #include "renderer/CCMaterial.h"
+#include "renderer/CCRenderer.h"
+#include "renderer/CCRenderCommandRecorder.h"
+#include "base/CCJobSystem.h"
 #include "math/TransformUtils.h"
 #include "deprecated/CCString.h"
 
@@ -66,6 +70,7 @@ bool nodeComparisonLess(Node* n1, Node* n2)
 
 // FIXME:: Yes, nodes might have a sort problem once every 15 days if the game runs at 60 FPS and each frame sprites are reordered.
 int Node::s_globalOrderOfArrival = 1;
+int Node::s_visitCachesCount = 0;
 
 // MARK: Constructor, Destructor, Init
 
@@ -106,6 +111,10 @@ Node::Node()
 , _visible(true)
 , _ignoreAnchorPointForPosition(false)
 , _reorderChildDirty(false)
+, _parallelVisitEnabled(false)
+, _visitCache(nullptr)
+, _touchBoundsTracked(false)
+, _touchBoundsDirty(false)
 , _isTransitionFinished(false)
 #if CC_ENABLE_SCRIPT_BINDING
 , _updateScriptHandler(0)
@@ -186,6 +195,8 @@ Node::~Node()
     
     _eventDispatcher->removeEventListenersForTarget(this);
     
+    setVisitCacheEnabled(false);
+    
 #if CC_NODE_DEBUG_VERIFY_EVENT_LISTENERS && COCOS2D_DEBUG > 0
     _eventDispatcher->debugCheckNodeHasNoEventListenersOnDestruction(this);
 #endif
@@ -241,6 +252,7 @@ void Node::setSkewX(float skewX)
     
     _skewX = skewX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 float Node::getSkewY() const
@@ -255,6 +267,7 @@ void Node::setSkewY(float skewY)
     
     _skewY = skewY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 void Node::setLocalZOrder(int z)
@@ -284,6 +297,7 @@ void Node::setGlobalZOrder(float globalZOrder)
     {
         _globalZOrder = globalZOrder;
         _eventDispatcher->setDirtyForNode(this);
+        invalidateVisitCache();
     }
 }
 
@@ -302,6 +316,7 @@ void Node::setRotation(float rotation)
     
     _rotationZ_X = _rotationZ_Y = rotation;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
     
     updateRotationQuat();
 }
@@ -319,6 +334,7 @@ void Node::setRotation3D(const Vec3& rotation)
         return;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -370,6 +386,7 @@ void Node::setRotationQuat(const Quaternion& quat)
     _rotationQuat = quat;
     updateRotation3D();
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 Quaternion Node::getRotationQuat() const
@@ -384,6 +401,7 @@ void Node::setRotationSkewX(float rotationX)
     
     _rotationZ_X = rotationX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
     
     updateRotationQuat();
 }
@@ -400,6 +418,7 @@ void Node::setRotationSkewY(float rotationY)
     
     _rotationZ_Y = rotationY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
     
     updateRotationQuat();
 }
@@ -419,6 +438,7 @@ void Node::setScale(float scale)
     
     _scaleX = _scaleY = _scaleZ = scale;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 /// scaleX getter
@@ -436,6 +456,7 @@ void Node::setScale(float scaleX,float scaleY)
     _scaleX = scaleX;
     _scaleY = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 /// scaleX setter
@@ -446,6 +467,7 @@ void Node::setScaleX(float scaleX)
     
     _scaleX = scaleX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 /// scaleY getter
@@ -462,6 +484,7 @@ void Node::setScaleZ(float scaleZ)
     
     _scaleZ = scaleZ;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 /// scaleY getter
@@ -478,6 +501,7 @@ void Node::setScaleY(float scaleY)
     
     _scaleY = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 
@@ -508,6 +532,7 @@ void Node::setPosition(float x, float y)
     _position.y = y;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
     _usingNormalizedPosition = false;
 }
 
@@ -553,6 +578,7 @@ void Node::setPositionZ(float positionZ)
         return;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 
     _positionZ = positionZ;
 }
@@ -573,6 +599,7 @@ void Node::setNormalizedPosition(const Vec2& position)
     _usingNormalizedPosition = true;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 ssize_t Node::getChildrenCount() const
@@ -594,6 +621,7 @@ void Node::setVisible(bool visible)
         _visible = visible;
         if(_visible)
             _transformUpdated = _transformDirty = _inverseDirty = true;
+        invalidateVisitCache();
     }
 }
 
@@ -615,6 +643,7 @@ void Node::setAnchorPoint(const Vec2& point)
         _anchorPoint = point;
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        invalidateVisitCache();
     }
 }
 
@@ -632,6 +661,7 @@ void Node::setContentSize(const Size & size)
 
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = _contentSizeDirty = true;
+        invalidateVisitCache();
     }
 }
 
@@ -646,6 +676,7 @@ void Node::setParent(Node * parent)
 {
     _parent = parent;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 /// isRelativeAnchorPoint getter
@@ -660,6 +691,7 @@ void Node::ignoreAnchorPointForPosition(bool newValue)
     {
         _ignoreAnchorPointForPosition = newValue;
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        invalidateVisitCache();
     }
 }
 
@@ -726,6 +758,7 @@ void Node::setGLProgramState(cocos2d::GLProgramState* glProgramState)
 
         if (_glProgramState)
             _glProgramState->setNodeBinding(this);
+        invalidateVisitCache();
     }
 }
 
@@ -739,6 +772,7 @@ void Node::setGLProgram(GLProgram* glProgram)
         _glProgramState->retain();
 
         _glProgramState->setNodeBinding(this);
+        invalidateVisitCache();
     }
 }
 
@@ -1078,6 +1112,7 @@ void Node::removeAllChildrenWithCleanup(bool cleanup)
     }
     
     _children.clear();
+    invalidateVisitCache();
 }
 
 void Node::detachChild(Node *child, ssize_t childIndex, bool doCleanup)
@@ -1102,6 +1137,7 @@ void Node::detachChild(Node *child, ssize_t childIndex, bool doCleanup)
     child->setParent(nullptr);
 
     _children.erase(childIndex);
+    invalidateVisitCache();
 }
 
 
@@ -1112,6 +1148,7 @@ void Node::insertChild(Node* child, int z)
     _reorderChildDirty = true;
     _children.pushBack(child);
     child->_localZOrder = z;
+    invalidateVisitCache();
 }
 
 void Node::reorderChild(Node *child, int zOrder)
@@ -1120,6 +1157,8 @@ void Node::reorderChild(Node *child, int zOrder)
     _reorderChildDirty = true;
     child->setOrderOfArrival(s_globalOrderOfArrival++);
     child->_localZOrder = zOrder;
+    invalidateVisitCache();
+    _eventDispatcher->setDirtyForNode(child);
 }
 
 void Node::sortAllChildren()
@@ -1152,6 +1191,8 @@ void Node::visit()
 
 uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
 {
+    _director->getRenderer()->addVisitedNodes(1);
+
     if(_usingNormalizedPosition)
     {
         CCASSERT(_parent, "setNormalizedPosition() doesn't work with orphan nodes");
@@ -1161,6 +1202,7 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
             _position.x = _normalizedPosition.x * s.width;
             _position.y = _normalizedPosition.y * s.height;
             _transformUpdated = _transformDirty = _inverseDirty = true;
+            invalidateVisitCache();
             _normalizedPositionDirty = false;
         }
     }
@@ -1179,12 +1221,146 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
     if(flags & FLAGS_DIRTY_MASK)
         _modelViewTransform = this->transform(parentTransform);
     
+    if (_touchBoundsTracked && !_touchBoundsDirty && (flags & FLAGS_DIRTY_MASK))
+    {
+        _touchBoundsDirty = true;
+        _eventDispatcher->setTouchBoundsDirtyForNode(this);
+    }
+
     _transformUpdated = false;
     _contentSizeDirty = false;
 
     return flags;
 }
 
+// MARK: visit cache
+
+struct Node::VisitCache
+{
+    RenderCommandRecorder recorder;
+    // what the recorded commands depend on, besides the subtree itself
+    Mat4 parentTransform;
+    Mat4 viewProjection;
+    const Camera* camera;
+    int renderQueue;
+    // cleared from any thread by invalidateVisitCache()
+    std::atomic<bool> valid;
+    // beginVisitCache() calls not ended yet, the visit() of a subclass may call the one of its base class
+    int nestedVisits;
+
+    VisitCache()
+    : camera(nullptr)
+    , renderQueue(-1)
+    , valid(false)
+    , nestedVisits(0)
+    {
+    }
+
+    static int getCurrentRenderQueue(Renderer* renderer)
+    {
+        auto current = RenderCommandRecorder::getCurrent();
+        return current ? current->getCurrentRenderQueue() : renderer->getCurrentRenderQueue();
+    }
+
+    bool isValid(Renderer* renderer, const Mat4& transform, uint32_t parentFlags) const
+    {
+        if (!valid.load(std::memory_order_relaxed) || (parentFlags & FLAGS_DIRTY_MASK))
+            return false;
+
+        auto visitingCamera = Camera::getVisitingCamera();
+        if (visitingCamera != camera
+            || (visitingCamera && memcmp(visitingCamera->getViewProjectionMatrix().m, viewProjection.m, sizeof(viewProjection.m)) != 0)
+            || getCurrentRenderQueue(renderer) != renderQueue)
+            return false;
+
+        return memcmp(transform.m, parentTransform.m, sizeof(parentTransform.m)) == 0;
+    }
+
+    void begin(Renderer* renderer, const Mat4& transform)
+    {
+        // set before visiting the subtree, so that a descendant changing itself while it is visited records again next frame
+        valid.store(true, std::memory_order_relaxed);
+        parentTransform = transform;
+        camera = Camera::getVisitingCamera();
+        if (camera)
+            viewProjection = camera->getViewProjectionMatrix();
+        renderQueue = getCurrentRenderQueue(renderer);
+
+        recorder.clear();
+        recorder.begin(renderQueue, Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW));
+    }
+
+    void end()
+    {
+        recorder.end();
+    }
+};
+
+void Node::setVisitCacheEnabled(bool enabled)
+{
+    if (enabled == (_visitCache != nullptr))
+        return;
+
+    if (enabled)
+    {
+        _visitCache = new (std::nothrow) VisitCache();
+        ++s_visitCachesCount;
+    }
+    else
+    {
+        CC_SAFE_DELETE(_visitCache);
+        --s_visitCachesCount;
+    }
+}
+
+void Node::invalidateVisitCache()
+{
+    if (s_visitCachesCount == 0)
+        return;
+
+    for (Node* node = this; node != nullptr; node = node->_parent)
+    {
+        if (node->_visitCache)
+            node->_visitCache->valid.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool Node::beginVisitCache(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (!_visitCache || _visitCache->nestedVisits++ > 0)
+        return false;
+
+    // nothing changed in the subtree since the last visit, add the same commands again
+    if (_visitCache->isValid(renderer, parentTransform, parentFlags))
+    {
+        --_visitCache->nestedVisits;
+        _visitCache->recorder.replay(renderer);
+        return true;
+    }
+    _visitCache->begin(renderer, parentTransform);
+    return false;
+}
+
+void Node::endVisitCache(Renderer* renderer)
+{
+    if (!_visitCache || --_visitCache->nestedVisits > 0)
+        return;
+
+    _visitCache->end();
+    _visitCache->recorder.replay(renderer);
+}
+
+bool Node::isVisitCacheValid() const
+{
+    return _visitCache && _visitCache->valid.load(std::memory_order_relaxed);
+}
+
+void Node::markVisitCacheValid()
+{
+    CCASSERT(_visitCache, "The visit cache is not enabled");
+    _visitCache->valid.store(true, std::memory_order_relaxed);
+}
+
 bool Node::isVisitableByVisitingCamera() const
 {
     auto camera = Camera::getVisitingCamera();
@@ -1200,6 +1376,11 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
         return;
     }
 
+    if (beginVisitCache(renderer, parentTransform, parentFlags))
+    {
+        return;
+    }
+
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
     // IMPORTANT:
@@ -1212,7 +1393,13 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
 
     int i = 0;
 
-    if(!_children.empty())
+    // no nested parallel visits, the workers are already busy
+    if (_parallelVisitEnabled && _children.size() > 1 && RenderCommandRecorder::getCurrent() == nullptr)
+    {
+        sortAllChildren();
+        visitChildrenInParallel(renderer, flags, visibleByCamera);
+    }
+    else if(!_children.empty())
     {
         sortAllChildren();
         // draw children zOrder < 0
@@ -1239,12 +1426,118 @@ void Node::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t paren
 
     _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
     
+    endVisitCache(renderer);
+    
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
     // reset for next frame
     // _orderOfArrival = 0;
 }
 
+// reused between frames, parallel visits only start from the main thread so they never overlap
+static std::vector<RenderCommandRecorder> s_visitRecorders;
+
+void Node::visitChildrenInParallel(Renderer* renderer, uint32_t flags, bool visibleByCamera)
+{
+    auto jobSystem = JobSystem::getInstance();
+    
+    // children zOrder < 0 are drawn before this node, the others after it
+    ssize_t childrenCount = _children.size();
+    ssize_t firstNonNegative = 0;
+    while (firstNonNegative < childrenCount && _children.at(firstNonNegative)->_localZOrder < 0)
+    {
+        ++firstNonNegative;
+    }
+    
+    // split both ranges in more chunks than threads to balance uneven subtrees,
+    // a chunk never crosses the self draw
+    std::vector<std::pair<ssize_t, ssize_t>> chunks;
+    ssize_t maxChunksPerRange = (jobSystem->getWorkerCount() + 1) * 2;
+    ssize_t ranges[] = {0, firstNonNegative, childrenCount};
+    size_t negativeChunksCount = 0;
+    for (int r = 0; r < 2; ++r)
+    {
+        ssize_t begin = ranges[r];
+        ssize_t length = ranges[r + 1] - begin;
+        ssize_t chunksCount = std::min(length, maxChunksPerRange);
+        for (ssize_t c = 0; c < chunksCount; ++c)
+        {
+            chunks.push_back(std::make_pair(begin + length * c / chunksCount, begin + length * (c + 1) / chunksCount));
+        }
+        if (r == 0)
+        {
+            negativeChunksCount = chunks.size();
+        }
+    }
+    
+    if (s_visitRecorders.size() < chunks.size())
+    {
+        s_visitRecorders.resize(chunks.size());
+    }
+    
+    int renderQueue = renderer->getCurrentRenderQueue();
+    std::atomic<size_t> nextChunk(0);
+    auto visitChunks = [&]() {
+        for (size_t index = nextChunk++; index < chunks.size(); index = nextChunk++)
+        {
+            auto& recorder = s_visitRecorders[index];
+            recorder.begin(renderQueue, _modelViewTransform);
+            for (ssize_t i = chunks[index].first; i < chunks[index].second; ++i)
+            {
+                _children.at(i)->visit(renderer, _modelViewTransform, flags);
+            }
+            recorder.end();
+        }
+    };
+    
+    // The job threads and this thread take the chunks one by one. A job that did not start once this thread is out
+    // of chunks is dropped instead of waited for, the job threads may be busy with long tasks.
+    struct Helper
+    {
+        std::shared_ptr<std::atomic<bool>> started;
+        JobSystem::JobHandle job;
+    };
+    std::vector<Helper> helpers(std::min((size_t)jobSystem->getWorkerCount(), chunks.size() - 1));
+    for (auto& helper : helpers)
+    {
+        auto started = std::make_shared<std::atomic<bool>>(false);
+        helper.started = started;
+        helper.job = jobSystem->schedule([started, &visitChunks]() {
+            if (started->exchange(true))
+                return;
+            visitChunks();
+        }, nullptr, JobSystem::Priority::HIGH);
+    }
+    
+    visitChunks();
+    
+    for (auto& helper : helpers)
+    {
+        if (helper.started->exchange(true))
+        {
+            jobSystem->wait(helper.job);
+        }
+        else
+        {
+            helper.job->cancel();
+        }
+    }
+    
+    // merge the recorded commands in the order of a serial visit
+    for (size_t c = 0; c < negativeChunksCount; ++c)
+    {
+        s_visitRecorders[c].submit(renderer);
+    }
+    
+    if (visibleByCamera)
+        this->draw(renderer, _modelViewTransform, flags);
+    
+    for (size_t c = negativeChunksCount; c < chunks.size(); ++c)
+    {
+        s_visitRecorders[c].submit(renderer);
+    }
+}
+
 Mat4 Node::transform(const Mat4& parentTransform)
 {
     return parentTransform * this->getNodeToParentTransform();
@@ -1744,6 +2037,7 @@ void Node::setNodeToParentTransform(const Mat4& transform)
     _transform = transform;
     _transformDirty = false;
     _transformUpdated = true;
+    invalidateVisitCache();
 }
 
 void Node::setAdditionalTransform(const AffineTransform& additionalTransform)
@@ -1765,6 +2059,7 @@ void Node::setAdditionalTransform(Mat4* additionalTransform)
         _useAdditionalTransform = true;
     }
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateVisitCache();
 }
 
 
@@ -2112,6 +2407,7 @@ bool isScreenPointInRect(const Vec2 &pt, const Camera* camera, const Mat4& w2l,
 void Node::setCameraMask(unsigned short mask, bool applyChildren)
 {
     _cameraMask = mask;
+    invalidateVisitCache();
     if (applyChildren)
     {
         for (const auto& child : _children)
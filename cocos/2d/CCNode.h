@@ -1142,6 +1142,55 @@ public:
     virtual void visit(Renderer *renderer, const Mat4& parentTransform, uint32_t parentFlags);
     virtual void visit() final;
 
+    /**
+     * Enables or disables visiting the children subtrees in parallel, on the threads of the JobSystem.
+     * Each thread records the render commands of its subtrees, they are added to the renderer in the same order as a serial visit.
+     * Only enable it on nodes whose descendants don't create objects, issue GL calls or change shared state in visit() and draw(),
+     * e.g. sprites, particles and labels that are already up to date. Nested nodes with parallel visit enabled are visited serially.
+     *
+     * @param enabled True to visit the children in parallel.
+     */
+    void setParallelVisitEnabled(bool enabled) { _parallelVisitEnabled = enabled; }
+    /**
+     * Whether the children subtrees are visited in parallel or not.
+     *
+     * @return True if the children subtrees are visited in parallel.
+     */
+    bool isParallelVisitEnabled() const { return _parallelVisitEnabled; }
+
+    /**
+     * Enables or disables caching the visit of this node and its children.
+     * The render commands of the subtree are recorded once, then added to the renderer again on the next frames
+     * without visiting the subtree, until the parent transform, the visiting camera or something in the subtree changes.
+     * Use it for big static subtrees like backgrounds, tile maps or UI panels.
+     *
+     * Changes of transforms, content sizes, visibility, children and z orders of the descendants, and of the textures,
+     * texture rects and blend functions of sprites invalidate the cache automatically.
+     * Vertex and color changes made in place by the nodes are drawn without invalidating it. Any other change to what
+     * a descendant draws, like the string of a Label or a custom draw() depending on external state, must be followed
+     * by a call to `invalidateVisitCache()`.
+     *
+     * A node overriding visit() only supports it when its override calls `beginVisitCache()` and `endVisitCache()`,
+     * as the ones of ProtectedNode, the ui widgets and ScrollView do. Descendants are recorded whatever their visit() does.
+     *
+     * @param enabled True to cache the visit of the subtree.
+     * @since v3.9
+     */
+    void setVisitCacheEnabled(bool enabled);
+    /**
+     * Whether the visit of this node and its children is cached or not.
+     *
+     * @return True if the visit is cached.
+     * @since v3.9
+     */
+    bool isVisitCacheEnabled() const { return _visitCache != nullptr; }
+    /**
+     * Invalidates the cached visits of this node and of all its ancestors, so they are visited again on the next frame.
+     * It does nothing when no node has its visit cached.
+     * @since v3.9
+     */
+    void invalidateVisitCache();
+
 
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
@@ -1725,6 +1774,22 @@ protected:
 
     Mat4 transform(const Mat4 &parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
+    void visitChildrenInParallel(Renderer* renderer, uint32_t flags, bool visibleByCamera);
+
+    /**
+     * Adds the cached commands of the subtree again when nothing changed since the last visit, otherwise starts recording the visit.
+     * Overrides of visit() call it after the visibility check and call endVisitCache() at the end of the visit,
+     * so that the visit cache of the node works. Nested calls from the visit() of a base class are ignored.
+     *
+     * @return True if the cached commands were added and the subtree must not be visited.
+     */
+    bool beginVisitCache(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags);
+    /// Stops recording the visit started by beginVisitCache() and adds the recorded commands.
+    void endVisitCache(Renderer* renderer);
+    /// Whether nothing invalidated the visit cache since it was last recorded or marked valid. False when it is disabled.
+    bool isVisitCacheValid() const;
+    /// Marks the visit cache as valid, for subclasses that record their subtree by themselves in visit().
+    void markVisitCacheValid();
 
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
@@ -1819,6 +1884,11 @@ protected:
                                           ///< Used by Layer and Scene.
 
     bool _reorderChildDirty;          ///< children order dirty flag
+    bool _parallelVisitEnabled;       ///< children subtrees are visited on worker threads
+    struct VisitCache;
+    VisitCache* _visitCache;          ///< recorded commands of the subtree, see setVisitCacheEnabled()
+    bool _touchBoundsTracked;         ///< the EventDispatcher indexes the screen-space bounds of this node
+    bool _touchBoundsDirty;           ///< the transform changed since the indexed bounds were computed
     bool _isTransitionFinished;       ///< flag to indicate whether the transition was finished
 
 #if CC_ENABLE_SCRIPT_BINDING
@@ -1838,6 +1908,7 @@ protected:
     bool        _cascadeOpacityEnabled;
 
     static int s_globalOrderOfArrival;
+    static int s_visitCachesCount;
     
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
@@ -1860,6 +1931,8 @@ public:
     friend class PhysicsBody;
 #endif
 
+    friend class EventDispatcher;
+
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(Node);
 };
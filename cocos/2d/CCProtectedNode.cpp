@@ -172,6 +172,7 @@ void ProtectedNode::removeProtectedChild(cocos2d::Node *child, bool cleanup)
         child->setParent(nullptr);
         
         _protectedChildren.erase(index);
+        invalidateVisitCache();
     }
 }
 
@@ -203,6 +204,7 @@ void ProtectedNode::removeAllProtectedChildrenWithCleanup(bool cleanup)
     }
     
     _protectedChildren.clear();
+    invalidateVisitCache();
 }
 
 void ProtectedNode::removeProtectedChildByTag(int tag, bool cleanup)
@@ -227,6 +229,7 @@ void ProtectedNode::insertProtectedChild(cocos2d::Node *child, int z)
     _reorderProtectedChildDirty = true;
     _protectedChildren.pushBack(child);
     child->setLocalZOrder(z);
+    invalidateVisitCache();
 }
 
 void ProtectedNode::sortAllProtectedChildren()
@@ -243,6 +246,7 @@ void ProtectedNode::reorderProtectedChild(cocos2d::Node *child, int localZOrder)
     _reorderProtectedChildDirty = true;
     child->setOrderOfArrival(s_globalOrderOfArrival++);
     child->setLocalZOrder(localZOrder);
+    invalidateVisitCache();
 }
 
 void ProtectedNode::visit(Renderer* renderer, const Mat4 &parentTransform, uint32_t parentFlags)
@@ -253,6 +257,11 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4 &parentTransform, uint3
         return;
     }
     
+    if (beginVisitCache(renderer, parentTransform, parentFlags))
+    {
+        return;
+    }
+    
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
     
     // IMPORTANT:
@@ -312,6 +321,8 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4 &parentTransform, uint3
     // setOrderOfArrival(0);
     
     director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    
+    endVisitCache(renderer);
 }
 
 void ProtectedNode::onEnter()
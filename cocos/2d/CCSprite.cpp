@@ -38,12 +38,17 @@ THE SOFTWARE.
 #include "renderer/CCRenderer.h"
 #include "base/CCDirector.h"
 #include "2d/CCCamera.h"
+#include "base/allocator/CCAllocatorStrategyPool.h"
 
 #include "deprecated/CCString.h"
 
 
 NS_CC_BEGIN
 
+#if CC_ENABLE_SPRITE_POOL
+CC_DEFINE_ALLOCATOR_POOL(Sprite, 100)
+#endif
+
 // MARK: create, init, dealloc
 Sprite* Sprite::createWithTexture(Texture2D *texture)
 {
@@ -367,6 +372,7 @@ void Sprite::setTexture(Texture2D *texture)
         CC_SAFE_RELEASE(_texture);
         _texture = texture;
         updateBlendFunc();
+        invalidateVisitCache();
     }
 }
 
@@ -428,6 +434,8 @@ void Sprite::setTextureRect(const Rect& rect, bool rotated, const Size& untrimme
     }
     
     _polyInfo.setQuad(&_quad);
+    // the vertices changed, StaticBatchNode has to bake them again
+    invalidateVisitCache();
 }
 
 // override this method to generate "double scale" sprites
@@ -914,6 +922,8 @@ void Sprite::setFlippedX(bool flippedX)
         if (_textureAtlas) {
             setDirty(true);
         }
+        // StaticBatchNode has to bake the flipped vertices again
+        invalidateVisitCache();
     }
 }
 
@@ -934,6 +944,8 @@ void Sprite::setFlippedY(bool flippedY)
         if (_textureAtlas) {
             setDirty(true);
         }
+        // StaticBatchNode has to bake the flipped vertices again
+        invalidateVisitCache();
     }
 }
 
@@ -978,7 +990,8 @@ void Sprite::updateColor(void)
     }
 
     // self render
-    // do nothing
+    // vertex colors are read when drawing, but StaticBatchNode has to bake them again
+    invalidateVisitCache();
 }
 
 void Sprite::setOpacityModifyRGB(bool modify)
@@ -1138,6 +1151,7 @@ PolygonInfo Sprite::getPolygonInfo() const
 void Sprite::setPolygonInfo(const PolygonInfo& info)
 {
     _polyInfo = info;
+    invalidateVisitCache();
 }
 
 NS_CC_END
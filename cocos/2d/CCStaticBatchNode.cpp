@@ -0,0 +1,264 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "2d/CCStaticBatchNode.h"
+#include "2d/CCSprite.h"
+#include "base/CCDirector.h"
+#include "renderer/CCTextureCache.h"
+#include "renderer/CCRenderer.h"
+#include "renderer/CCGLProgramState.h"
+
+#include "deprecated/CCString.h" // For StringUtils::format
+
+NS_CC_BEGIN
+
+static const int STATIC_BATCH_DEFAULT_CAPACITY = 29;
+
+StaticBatchNode* StaticBatchNode::createWithTexture(Texture2D* tex)
+{
+    StaticBatchNode *batchNode = new (std::nothrow) StaticBatchNode();
+    if (batchNode && batchNode->initWithTexture(tex))
+    {
+        batchNode->autorelease();
+        return batchNode;
+    }
+    CC_SAFE_DELETE(batchNode);
+    return nullptr;
+}
+
+StaticBatchNode* StaticBatchNode::create(const std::string& fileImage)
+{
+    StaticBatchNode *batchNode = new (std::nothrow) StaticBatchNode();
+    if (batchNode && batchNode->initWithFile(fileImage))
+    {
+        batchNode->autorelease();
+        return batchNode;
+    }
+    CC_SAFE_DELETE(batchNode);
+    return nullptr;
+}
+
+StaticBatchNode::StaticBatchNode()
+: _textureAtlas(nullptr)
+{
+}
+
+StaticBatchNode::~StaticBatchNode()
+{
+    CC_SAFE_RELEASE(_textureAtlas);
+}
+
+bool StaticBatchNode::initWithTexture(Texture2D *tex)
+{
+    CCASSERT(tex, "Invalid texture for StaticBatchNode");
+
+    _textureAtlas = new (std::nothrow) TextureAtlas();
+    _textureAtlas->initWithTexture(tex, STATIC_BATCH_DEFAULT_CAPACITY);
+
+    updateBlendFunc();
+
+    // changes under this node invalidate the cache, which tells when to bake again
+    setVisitCacheEnabled(true);
+
+    setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR));
+    return true;
+}
+
+bool StaticBatchNode::init()
+{
+    Texture2D * texture = new (std::nothrow) Texture2D();
+    texture->autorelease();
+    return this->initWithTexture(texture);
+}
+
+bool StaticBatchNode::initWithFile(const std::string& fileImage)
+{
+    Texture2D *texture2D = Director::getInstance()->getTextureCache()->addImage(fileImage);
+    if (texture2D == nullptr)
+    {
+        CCLOG("cocos2d: StaticBatchNode: can't load texture '%s'", fileImage.c_str());
+        return false;
+    }
+    return initWithTexture(texture2D);
+}
+
+// don't call visit on the children, their quads are baked
+void StaticBatchNode::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t parentFlags)
+{
+    if (! _visible)
+    {
+        return;
+    }
+
+    uint32_t flags = processParentFlags(parentTransform, parentFlags);
+
+    if (! isVisitCacheValid())
+    {
+        bake();
+    }
+
+    if (isVisitableByVisitingCamera())
+    {
+        // IMPORTANT:
+        // To ease the migration to v3.0, we still support the Mat4 stack,
+        // but it is deprecated and your code should not rely on it
+        Director* director = Director::getInstance();
+        director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+
+        draw(renderer, _modelViewTransform, flags);
+
+        director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    }
+}
+
+void StaticBatchNode::draw(Renderer *renderer, const Mat4 &transform, uint32_t flags)
+{
+    if (_textureAtlas->getTotalQuads() == 0)
+    {
+        return;
+    }
+
+    _batchCommand.init(_globalZOrder, getGLProgram(), _blendFunc, _textureAtlas, transform, flags);
+    renderer->addCommand(&_batchCommand);
+}
+
+void StaticBatchNode::bake()
+{
+    // changes made from now on bake again on the next visit
+    if (isVisitCacheEnabled())
+    {
+        markVisitCacheValid();
+    }
+
+    _bakedQuads.clear();
+    bakeChildren(this, Mat4::IDENTITY);
+
+    ssize_t count = _bakedQuads.size();
+    if (count > _textureAtlas->getCapacity())
+    {
+        _textureAtlas->resizeCapacity(count);
+    }
+
+    // the whole buffer is uploaded again by the next draw
+    _textureAtlas->removeAllQuads();
+    if (count > 0)
+    {
+        _textureAtlas->insertQuads(_bakedQuads.data(), 0, count);
+    }
+}
+
+// same order as a visit: children with a negative z order, the parent, then the other children
+void StaticBatchNode::bakeChildren(Node* parent, const Mat4& parentToBatchTransform)
+{
+    parent->sortAllChildren();
+
+    Sprite* sprite = (parent == this) ? nullptr : dynamic_cast<Sprite*>(parent);
+    bool parentBaked = (sprite == nullptr);
+
+    for (const auto& child : parent->getChildren())
+    {
+        if (! parentBaked && child->getLocalZOrder() >= 0)
+        {
+            bakeSprite(sprite, parentToBatchTransform);
+            parentBaked = true;
+        }
+
+        if (child->isVisible())
+        {
+            bakeChildren(child, parentToBatchTransform * child->getNodeToParentTransform());
+        }
+    }
+
+    if (! parentBaked)
+    {
+        bakeSprite(sprite, parentToBatchTransform);
+    }
+}
+
+void StaticBatchNode::bakeSprite(Sprite* sprite, const Mat4& spriteToBatchTransform)
+{
+    // sprites of a SpriteBatchNode have their quads in the space of their batch node
+    if (sprite->getBatchNode() != nullptr)
+    {
+        return;
+    }
+
+    if (sprite->getTexture() != _textureAtlas->getTexture())
+    {
+        CCLOG("cocos2d: StaticBatchNode: sprite %p doesn't use the texture of the batch node, skipped", sprite);
+        return;
+    }
+
+    V3F_C4B_T2F_Quad quad = sprite->getQuad();
+    spriteToBatchTransform.transformPoint(&quad.bl.vertices);
+    spriteToBatchTransform.transformPoint(&quad.br.vertices);
+    spriteToBatchTransform.transformPoint(&quad.tl.vertices);
+    spriteToBatchTransform.transformPoint(&quad.tr.vertices);
+    _bakedQuads.push_back(quad);
+}
+
+void StaticBatchNode::updateBlendFunc()
+{
+    if (! _textureAtlas->getTexture()->hasPremultipliedAlpha())
+    {
+        _blendFunc = BlendFunc::ALPHA_NON_PREMULTIPLIED;
+        setOpacityModifyRGB(false);
+    }
+    else
+    {
+        _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
+        setOpacityModifyRGB(true);
+    }
+}
+
+void StaticBatchNode::setBlendFunc(const BlendFunc &blendFunc)
+{
+    _blendFunc = blendFunc;
+}
+
+const BlendFunc& StaticBatchNode::getBlendFunc() const
+{
+    return _blendFunc;
+}
+
+Texture2D* StaticBatchNode::getTexture() const
+{
+    return _textureAtlas->getTexture();
+}
+
+void StaticBatchNode::setTexture(Texture2D *texture)
+{
+    _textureAtlas->setTexture(texture);
+    updateBlendFunc();
+    invalidateVisitCache();
+}
+
+std::string StaticBatchNode::getDescription() const
+{
+    return StringUtils::format("<StaticBatchNode | tag = %d>", _tag);
+}
+
+NS_CC_END
@@ -0,0 +1,167 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#ifndef __CC_STATIC_BATCH_NODE_H__
+#define __CC_STATIC_BATCH_NODE_H__
+
+#include <vector>
+
+#include "2d/CCNode.h"
+#include "base/CCProtocols.h"
+#include "renderer/CCTextureAtlas.h"
+#include "renderer/CCBatchCommand.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+class Sprite;
+
+/** StaticBatchNode draws a subtree of Sprites that don't move in a single draw call.
+ *
+ * The quads of all the descendant Sprites are transformed into the space of the StaticBatchNode once and kept
+ * in one vertex buffer. The descendants are not visited: drawing costs one BatchCommand per frame, whatever the
+ * number of Sprites. The quads are baked again on the next frame after anything under the node changed, see
+ * `Node::invalidateVisitCache()`: moving, adding, removing, hiding, recoloring or changing the frame of a descendant.
+ *
+ * Unlike SpriteBatchNode, the descendants are plain Sprites that can be nested in any Node, and the quads are not
+ * updated on every frame. Move the parent of the StaticBatchNode rather than the node itself, since changing its own
+ * transform bakes the quads again too.
+ *
+ * Limitations:
+ *  - Only the quads of Sprites using the texture of the StaticBatchNode are drawn. Other nodes are ignored.
+ *  - Polygon sprites are drawn with their quad.
+ *
+ * @since v3.9
+ */
+class CC_DLL StaticBatchNode : public Node, public TextureProtocol
+{
+public:
+    /** Creates a StaticBatchNode with a texture2d.
+     *
+     * @param tex The texture used by the Sprites.
+     * @return Return an autorelease object.
+     */
+    static StaticBatchNode* createWithTexture(Texture2D* tex);
+
+    /** Creates a StaticBatchNode with a file image (.png, .jpeg, .pvr, etc).
+     * The file will be loaded using the TextureMgr.
+     *
+     * @param fileImage A file image (.png, .jpeg, .pvr, etc).
+     * @return Return an autorelease object.
+     */
+    static StaticBatchNode* create(const std::string& fileImage);
+
+    /** Returns the TextureAtlas holding the baked quads.
+     *
+     * @return The TextureAtlas object.
+     */
+    TextureAtlas* getTextureAtlas() const { return _textureAtlas; }
+
+    /** Returns the number of quads baked the last time.
+     *
+     * @return The number of quads.
+     */
+    ssize_t getBakedQuadsCount() const { return _textureAtlas->getTotalQuads(); }
+
+    /** Bakes the quads of the descendants now instead of waiting for the next visit. */
+    void bake();
+
+    //
+    // Overrides
+    //
+    // TextureProtocol
+    virtual Texture2D* getTexture() const override;
+    virtual void setTexture(Texture2D *texture) override;
+    /**
+    *@code
+    * When this function bound into js or lua,the parameter will be changed.
+    * In js: var setBlendFunc(var src, var dst).
+    * @endcode
+    * @lua NA
+    */
+    virtual void setBlendFunc(const BlendFunc &blendFunc) override;
+    /**
+    * @lua NA
+    */
+    virtual const BlendFunc& getBlendFunc() const override;
+
+    /**
+     * @js NA
+     */
+    virtual void visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t parentFlags) override;
+    /**
+    * @js NA
+    */
+    virtual void draw(Renderer *renderer, const Mat4 &transform, uint32_t flags) override;
+    /**
+    * @js NA
+    */
+    virtual std::string getDescription() const override;
+
+CC_CONSTRUCTOR_ACCESS:
+    /**
+     * @js ctor
+     */
+    StaticBatchNode();
+    /**
+     * @js NA
+     * @lua NA
+     */
+    virtual ~StaticBatchNode();
+
+    /** initializes a StaticBatchNode with a texture2d. */
+    bool initWithTexture(Texture2D *tex);
+    /** initializes a StaticBatchNode with a file image (.png, .jpeg, .pvr, etc).
+     * @js init
+     * @lua init
+     */
+    bool initWithFile(const std::string& fileImage);
+    bool init() override;
+
+protected:
+    void bakeChildren(Node* parent, const Mat4& parentToBatchTransform);
+    void bakeSprite(Sprite* sprite, const Mat4& spriteToBatchTransform);
+    void updateBlendFunc();
+
+    TextureAtlas* _textureAtlas;
+    BlendFunc _blendFunc;
+    BatchCommand _batchCommand;
+    // quads collected while baking, reused between bakes
+    std::vector<V3F_C4B_T2F_Quad> _bakedQuads;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(StaticBatchNode);
+};
+
+// end of _2d group
+/** @} */
+
+NS_CC_END
+
+#endif // __CC_STATIC_BATCH_NODE_H__
@@ -1038,7 +1038,7 @@ bool Bundle3D::loadJson(const std::string& path)
 {
     clear();
 
-    Data data = FileUtils::getInstance()->getDataFromFile(path);
+    MappedFile data = FileUtils::getInstance()->mapFile(path);
     ssize_t size = data.getSize();
 
     // json need null-terminated string.
@@ -1068,8 +1068,7 @@ bool Bundle3D::loadBinary(const std::string& path)
     
     // get file data
     CC_SAFE_DELETE(_binaryBuffer);
-    _binaryBuffer = new (std::nothrow) Data();
-    *_binaryBuffer = FileUtils::getInstance()->getDataFromFile(path);
+    _binaryBuffer = new (std::nothrow) MappedFile(FileUtils::getInstance()->mapFile(path));
     if (_binaryBuffer->isNull())
     {
         clear();
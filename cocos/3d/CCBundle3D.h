@@ -38,6 +38,7 @@ NS_CC_BEGIN
 
 class Animation3D;
 class Data;
+class MappedFile;
 
 /**
  * @brief Defines a bundle file that contains a collection of assets. Mesh, Material, MeshSkin, Animation
@@ -181,7 +182,8 @@ protected:
     rapidjson::Document _jsonReader;
 
     // for binary reading
-    Data* _binaryBuffer;
+    // the c3b file is parsed in place
+    MappedFile* _binaryBuffer;
     BundleReader _binaryReader;
     unsigned int _referenceCount;
     Reference* _references;
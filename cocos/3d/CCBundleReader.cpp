@@ -93,7 +93,8 @@ char* BundleReader::readLine(int num,char* line)
     char* p = line;
     char c;
     ssize_t readNum = 0;
-    while((c=*buffer) != 10 && readNum < (ssize_t)num && _position < _length)
+    // check the position first, the buffer may end at the last byte of a mapped file
+    while(_position < _length && readNum < (ssize_t)num && (c=*buffer) != 10)
     {
         *p = c;
         p++;
@@ -47,8 +47,8 @@ Skybox::Skybox()
 
 Skybox::~Skybox()
 {
-    glDeleteBuffers(1, &_vertexBuffer);
-    glDeleteBuffers(1, &_indexBuffer);
+    GL::deleteBuffers(1, &_vertexBuffer);
+    GL::deleteBuffers(1, &_indexBuffer);
 
     _vertexBuffer = 0;
     _indexBuffer = 0;
@@ -118,7 +118,7 @@ void Skybox::initBuffers()
     };
 
     glGenBuffers(1, &_vertexBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vexBuf), vexBuf, GL_STATIC_DRAW);
 
     // init index buffer object
@@ -131,7 +131,7 @@ void Skybox::initBuffers()
     };
 
     glGenBuffers(1, &_indexBuffer);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(idxBuf), idxBuf, GL_STATIC_DRAW);
 
     if (Configuration::getInstance()->supportsShareableVAO())
@@ -166,19 +166,19 @@ void Skybox::onDraw(const Mat4& transform, uint32_t flags)
     cameraModelMat.m[12] = cameraModelMat.m[13] = cameraModelMat.m[14] = 0;
     state->setUniformMat4("u_cameraRot", cameraModelMat);
 
-    glEnable(GL_DEPTH_TEST);
+    GL::enable(GL_DEPTH_TEST);
     RenderState::StateBlock::_defaultState->setDepthTest(true);
 
-    glDepthFunc(GL_LEQUAL);
+    GL::depthFunc(GL_LEQUAL);
     RenderState::StateBlock::_defaultState->setDepthFunction(RenderState::DEPTH_LEQUAL);
 
-    glEnable(GL_CULL_FACE);
+    GL::enable(GL_CULL_FACE);
     RenderState::StateBlock::_defaultState->setCullFace(true);
 
-    glCullFace(GL_BACK);
+    GL::cullFace(GL_BACK);
     RenderState::StateBlock::_defaultState->setCullFaceSide(RenderState::CULL_FACE_SIDE_BACK);
     
-    glDisable(GL_BLEND);
+    GL::disable(GL_BLEND);
     RenderState::StateBlock::_defaultState->setBlend(false);
 
     if (Configuration::getInstance()->supportsShareableVAO())
@@ -189,10 +189,10 @@ void Skybox::onDraw(const Mat4& transform, uint32_t flags)
     {
         GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POSITION);
 
-        glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+        GL::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
         glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(Vec3), nullptr);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
     }
 
     glDrawElements(GL_TRIANGLES, (GLsizei)36, GL_UNSIGNED_BYTE, nullptr);
@@ -203,8 +203,8 @@ void Skybox::onDraw(const Mat4& transform, uint32_t flags)
     }
     else
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 
     CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, 8);
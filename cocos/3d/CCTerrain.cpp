@@ -213,7 +213,7 @@ void Terrain::onDraw(const Mat4 &transform, uint32_t flags)
     {
         _isCameraViewChanged = false;
     }
-    glActiveTexture(GL_TEXTURE0);
+    GL::activeTexture(GL_TEXTURE0);
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
     if(_isDrawWire)//reset state.
@@ -501,12 +501,12 @@ Terrain::~Terrain()
 
     for(size_t i =0;i<_chunkLodIndicesSet.size();i++)
     {
-        glDeleteBuffers(1,&(_chunkLodIndicesSet[i]._chunkIndices._indices));
+        GL::deleteBuffers(1,&(_chunkLodIndicesSet[i]._chunkIndices._indices));
     }
 
     for(size_t i =0;i<_chunkLodIndicesSkirtSet.size();i++)
     {
-        glDeleteBuffers(1,&(_chunkLodIndicesSkirtSet[i]._chunkIndices._indices));
+        GL::deleteBuffers(1,&(_chunkLodIndicesSkirtSet[i]._chunkIndices._indices));
     }
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID || CC_TARGET_PLATFORM == CC_PLATFORM_WINRT)
@@ -750,7 +750,7 @@ Terrain::ChunkIndices Terrain::insertIndicesLOD(int neighborLod[4], int selfLod,
     lodIndices._relativeLod[4] = selfLod;
     lodIndices._chunkIndices._size = size;
     glGenBuffers(1,&(lodIndices._chunkIndices._indices));
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lodIndices._chunkIndices._indices);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, lodIndices._chunkIndices._indices);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER,sizeof(GLushort)*size,indices,GL_STATIC_DRAW);
     this->_chunkLodIndicesSet.push_back(lodIndices);
     return lodIndices._chunkIndices;
@@ -785,7 +785,7 @@ Terrain::ChunkIndices Terrain::insertIndicesLODSkirt(int selfLod, GLushort * ind
     skirtIndices._selfLod = selfLod;
     skirtIndices._chunkIndices._size = size;
     glGenBuffers(1,&(skirtIndices._chunkIndices._indices));
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, skirtIndices._chunkIndices._indices);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, skirtIndices._chunkIndices._indices);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER,sizeof(GLushort)*size,indices,GL_STATIC_DRAW);
     this->_chunkLodIndicesSkirtSet.push_back(skirtIndices);
     return skirtIndices._chunkIndices;
@@ -929,10 +929,10 @@ void Terrain::Chunk::finish()
     glGenBuffers(1,&_vbo);
 
     //only set for vertices vbo
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(TerrainVertexData)*_originalVertices.size(), &_originalVertices[0], GL_STREAM_DRAW);
 
-    glBindBuffer(GL_ARRAY_BUFFER,0);
+    GL::bindBuffer(GL_ARRAY_BUFFER,0);
 
     calculateSlope();
 
@@ -949,7 +949,7 @@ void Terrain::Chunk::finish()
 
 void Terrain::Chunk::bindAndDraw()
 {
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
     if(_terrain->_isCameraViewChanged || _oldLod <0)
     {
         switch (_terrain->_crackFixedType)
@@ -966,7 +966,7 @@ void Terrain::Chunk::bindAndDraw()
             break;
         }
     }
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,_chunkIndices._indices);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER,_chunkIndices._indices);
     unsigned long offset = 0;
     //position
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainVertexData), (GLvoid *)offset);
@@ -1385,7 +1385,7 @@ void Terrain::Chunk::updateVerticesForLOD()
 
 Terrain::Chunk::~Chunk()
 {
-    glDeleteBuffers(1,&_vbo);
+    GL::deleteBuffers(1,&_vbo);
 }
 
 void Terrain::Chunk::updateIndicesLODSkirt()
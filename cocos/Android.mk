@@ -76,6 +76,7 @@ cocos2d.cpp \
 2d/CCScene.cpp \
 2d/CCSprite.cpp \
 2d/CCSpriteBatchNode.cpp \
+2d/CCStaticBatchNode.cpp \
 2d/CCSpriteFrame.cpp \
 2d/CCSpriteFrameCache.cpp \
 2d/CCTMXLayer.cpp \
@@ -95,6 +96,8 @@ platform/CCFileUtils.cpp \
 platform/CCGLView.cpp \
 platform/CCImage.cpp \
 platform/CCSAXParser.cpp \
+platform/CCPackFile.cpp \
+platform/CCMappedFile.cpp \
 platform/CCThread.cpp \
 $(MATHNEONFILE) \
 math/CCAffineTransform.cpp \
@@ -108,6 +111,7 @@ math/Vec3.cpp \
 math/Vec4.cpp \
 base/CCNinePatchImageParser.cpp \
 base/CCAsyncTaskPool.cpp \
+base/CCJobSystem.cpp \
 base/CCAutoreleasePool.cpp \
 base/CCConfiguration.cpp \
 base/CCConsole.cpp \
@@ -175,10 +179,12 @@ renderer/CCPrimitive.cpp \
 renderer/CCPrimitiveCommand.cpp \
 renderer/CCQuadCommand.cpp \
 renderer/CCRenderCommand.cpp \
+renderer/CCRenderCommandRecorder.cpp \
 renderer/CCRenderState.cpp \
 renderer/CCRenderer.cpp \
 renderer/CCTechnique.cpp \
 renderer/CCTexture2D.cpp \
+renderer/CCPixelConversion.cpp \
 renderer/CCTextureAtlas.cpp \
 renderer/CCTextureCache.cpp \
 renderer/CCTextureCube.cpp \
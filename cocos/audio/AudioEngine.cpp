@@ -29,8 +29,10 @@
 #include "audio/include/AudioEngine.h"
 #include <condition_variable>
 #include <queue>
+#include <algorithm>
 #include "platform/CCFileUtils.h"
 #include "base/ccUtils.h"
+#include "base/CCJobSystem.h"
 
 #if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
 #include "android/AudioEngine-inl.h"
@@ -68,76 +70,41 @@ AudioEngine::AudioEngineThreadPool* AudioEngine::s_threadPool = nullptr;
 class AudioEngine::AudioEngineThreadPool
 {
 public:
-    AudioEngineThreadPool(bool detach, int threads = 4)
+    // The tasks run on the JobSystem. When detached, the pool does not wait
+    // for the running tasks when it is destroyed.
+    AudioEngineThreadPool(bool detach)
         : _detach(detach)
-        , _stop(false)
     {
-        for (int index = 0; index < threads; ++index)
-        {
-            _workers.emplace_back(std::thread(std::bind(&AudioEngineThreadPool::threadFunc, this)));
-            if (_detach)
-            {
-                _workers[index].detach();
-            }
-        }
     }
 
     void addTask(const std::function<void()> &task){
-        std::unique_lock<std::mutex> lk(_queueMutex);
-        _taskQueue.emplace(task);
-        _taskCondition.notify_one();
+        std::unique_lock<std::mutex> lk(_jobsMutex);
+        _jobs.erase(std::remove_if(_jobs.begin(), _jobs.end(), [](const JobSystem::JobHandle& job){ return job->isDone(); }), _jobs.end());
+        _jobs.push_back(JobSystem::getInstance()->schedule(task));
     }
 
     ~AudioEngineThreadPool()
     {
+        std::unique_lock<std::mutex> lk(_jobsMutex);
+        for (auto& job : _jobs)
         {
-            std::unique_lock<std::mutex> lk(_queueMutex);
-            _stop = true;
-            _taskCondition.notify_all();
+            job->cancel();
         }
 
         if (!_detach)
         {
-            for (auto&& worker : _workers) {
-                worker.join();
-            }
-        }
-    }
-
-private:
-    void threadFunc()
-    {
-        while (true) {
-            std::function<void()> task = nullptr;
+            for (auto& job : _jobs)
             {
-                std::unique_lock<std::mutex> lk(_queueMutex);
-                if (_stop)
-                {
-                    break;
-                }
-                if (!_taskQueue.empty())
-                {
-                    task = std::move(_taskQueue.front());
-                    _taskQueue.pop();
-                }
-                else
-                {
-                    _taskCondition.wait(lk);
-                    continue;
-                }
+                JobSystem::getInstance()->wait(job);
             }
-
-            task();
         }
     }
 
-    std::vector<std::thread>  _workers;
-    std::queue< std::function<void()> > _taskQueue;
-
-    std::mutex _queueMutex;
-    std::condition_variable _taskCondition;
+private:
+    // jobs that may not be done
+    std::vector<JobSystem::JobHandle> _jobs;
+    std::mutex _jobsMutex;
     bool _detach;
-    bool _stop;
 };
 
 void AudioEngine::end()
@@ -25,6 +25,8 @@ THE SOFTWARE.
 
 #include "base/CCAsyncTaskPool.h"
 
+#include <algorithm>
+
 NS_CC_BEGIN
 
 AsyncTaskPool* AsyncTaskPool::s_asyncTaskPool = nullptr;
@@ -50,6 +52,42 @@ AsyncTaskPool::AsyncTaskPool()
 
 AsyncTaskPool::~AsyncTaskPool()
 {
+    // drop the tasks that did not start and wait for the running ones, they may use the pool owner
+    auto jobSystem = JobSystem::getInstance();
+    for (auto& jobs : _jobs)
+    {
+        for (auto& job : jobs)
+        {
+            job->cancel();
+        }
+        for (auto& job : jobs)
+        {
+            jobSystem->wait(job);
+        }
+    }
+}
+
+void AsyncTaskPool::stopTasks(TaskType type)
+{
+    std::lock_guard<std::mutex> lock(_jobsMutex);
+    auto& jobs = _jobs[(int)type];
+    for (auto& job : jobs)
+    {
+        job->cancel();
+    }
+    // the running jobs are kept until they are done, the destructor waits for them
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [](const JobSystem::JobHandle& j){ return j->isDone(); }), jobs.end());
+}
+
+void AsyncTaskPool::enqueueJob(TaskType type, const std::function<void()>& task, const std::function<void()>& continuation)
+{
+    auto priority = type == TaskType::TASK_OTHER ? JobSystem::Priority::LOW : JobSystem::Priority::NORMAL;
+    auto job = JobSystem::getInstance()->schedule(task, continuation, priority);
+    
+    std::lock_guard<std::mutex> lock(_jobsMutex);
+    auto& jobs = _jobs[(int)type];
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [](const JobSystem::JobHandle& j){ return j->isDone(); }), jobs.end());
+    jobs.push_back(job);
 }
 
 NS_CC_END
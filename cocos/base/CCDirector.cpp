@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include "2d/CCActionManager.h"
 #include "2d/CCFontFNT.h"
 #include "2d/CCFontAtlasCache.h"
+#include "2d/CCFontAtlas.h"
 #include "2d/CCAnimationCache.h"
 #include "2d/CCTransition.h"
 #include "2d/CCFontFreeType.h"
@@ -47,6 +48,7 @@ THE SOFTWARE.
 #include "renderer/CCTextureCache.h"
 #include "renderer/ccGLStateCache.h"
 #include "renderer/CCRenderer.h"
+#include "renderer/CCRenderCommandRecorder.h"
 #include "renderer/CCRenderState.h"
 #include "renderer/CCFrameBuffer.h"
 #include "2d/CCCamera.h"
@@ -60,6 +62,7 @@ THE SOFTWARE.
 #include "base/CCAutoreleasePool.h"
 #include "base/CCConfiguration.h"
 #include "base/CCAsyncTaskPool.h"
+#include "base/CCJobSystem.h"
 #include "platform/CCApplication.h"
 
 #if CC_ENABLE_SCRIPT_BINDING
@@ -305,6 +308,10 @@ void Director::drawScene()
     {
         showStats();
     }
+
+    // upload the letters added to the font atlases during this frame, once per page
+    FontAtlas::updatePendingTextures();
+
     _renderer->render();
 
     _eventDispatcher->dispatchEvent(_eventAfterDraw);
@@ -467,11 +474,18 @@ void Director::resetMatrixStack()
     initMatrixStack();
 }
 
+std::stack<Mat4>& Director::getModelViewMatrixStack()
+{
+    // nodes visited in parallel use the matrix stack of their recorder
+    auto recorder = RenderCommandRecorder::getCurrent();
+    return recorder ? recorder->getModelViewMatrixStack() : _modelViewMatrixStack;
+}
+
 void Director::popMatrix(MATRIX_STACK_TYPE type)
 {
     if(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.pop();
+        getModelViewMatrixStack().pop();
     }
     else if(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -491,7 +505,7 @@ void Director::loadIdentityMatrix(MATRIX_STACK_TYPE type)
 {
     if(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() = Mat4::IDENTITY;
+        getModelViewMatrixStack().top() = Mat4::IDENTITY;
     }
     else if(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -511,7 +525,7 @@ void Director::loadMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
     if(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() = mat;
+        getModelViewMatrixStack().top() = mat;
     }
     else if(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -531,7 +545,7 @@ void Director::multiplyMatrix(MATRIX_STACK_TYPE type, const Mat4& mat)
 {
     if(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW == type)
     {
-        _modelViewMatrixStack.top() *= mat;
+        getModelViewMatrixStack().top() *= mat;
     }
     else if(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION == type)
     {
@@ -551,7 +565,7 @@ void Director::pushMatrix(MATRIX_STACK_TYPE type)
 {
     if(type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
-        _modelViewMatrixStack.push(_modelViewMatrixStack.top());
+        getModelViewMatrixStack().push(getModelViewMatrixStack().top());
     }
     else if(type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
     {
@@ -571,7 +585,7 @@ const Mat4& Director::getMatrix(MATRIX_STACK_TYPE type)
 {
     if(type == MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW)
     {
-        return _modelViewMatrixStack.top();
+        return getModelViewMatrixStack().top();
     }
     else if(type == MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION)
     {
@@ -583,7 +597,7 @@ const Mat4& Director::getMatrix(MATRIX_STACK_TYPE type)
     }
 
     CCASSERT(false, "unknow matrix stack type, will return modelview matrix instead");
-    return  _modelViewMatrixStack.top();
+    return  getModelViewMatrixStack().top();
 }
 
 void Director::setProjection(Projection projection)
@@ -971,6 +985,8 @@ void Director::reset()
     SpriteFrameCache::destroyInstance();
     GLProgramCache::destroyInstance();
     GLProgramStateCache::destroyInstance();
+    // the released font atlases may still be writing their disk cache with FileUtils
+    FontAtlas::waitForDiskCacheWrites();
     FileUtils::destroyInstance();
     AsyncTaskPool::destoryInstance();
     
@@ -982,6 +998,9 @@ void Director::reset()
     RenderState::finalize();
     
     destroyTextureCache();
+
+    // after the texture cache and the task pool, which wait for their jobs
+    JobSystem::destroyInstance();
 }
 
 void Director::purgeDirector()
@@ -519,6 +519,9 @@ protected:
     void destroyTextureCache();
 
     void initMatrixStack();
+    
+    // the modelview matrix stack of the calling thread
+    std::stack<Mat4>& getModelViewMatrixStack();
 
     std::stack<Mat4> _modelViewMatrixStack;
     std::stack<Mat4> _projectionMatrixStack;
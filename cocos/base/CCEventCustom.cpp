@@ -24,14 +24,65 @@
 
 #include "base/CCEventCustom.h"
 #include "base/CCEvent.h"
+#include "base/ccMacros.h"
+
+#include <unordered_map>
+#include <vector>
 
 NS_CC_BEGIN
 
+namespace
+{
+    struct InternedEventNames
+    {
+        std::unordered_map<std::string, EventCustom::ID> ids;
+        // the keys of ids, which never move, indexed by id - 1
+        std::vector<const std::string*> names;
+    };
+    
+    InternedEventNames& getInternedEventNames()
+    {
+        static InternedEventNames s_internedEventNames;
+        return s_internedEventNames;
+    }
+}
+
 EventCustom::EventCustom(const std::string& eventName)
 : Event(Type::CUSTOM)
 , _userData(nullptr)
 , _eventName(eventName)
+, _eventID(0)
+{
+}
+
+EventCustom::EventCustom(ID eventID)
+: Event(Type::CUSTOM)
+, _userData(nullptr)
+, _eventID(eventID)
+{
+    CCASSERT(eventID != 0, "Invalid interned event name!");
+}
+
+EventCustom::ID EventCustom::internEventName(const std::string& eventName)
+{
+    auto& interned = getInternedEventNames();
+    auto iter = interned.ids.find(eventName);
+    if (iter != interned.ids.end())
+    {
+        return iter->second;
+    }
+    
+    ID eventID = static_cast<ID>(interned.names.size() + 1);
+    auto inserted = interned.ids.insert(std::make_pair(eventName, eventID));
+    interned.names.push_back(&inserted.first->first);
+    return eventID;
+}
+
+const std::string& EventCustom::getInternedEventName(ID eventID)
 {
+    auto& interned = getInternedEventNames();
+    CCASSERT(eventID != 0 && eventID <= interned.names.size(), "Invalid interned event name!");
+    return *interned.names[eventID - 1];
 }
 
 NS_CC_END
@@ -41,6 +41,11 @@ NS_CC_BEGIN
 class CC_DLL EventCustom : public Event
 {
 public:
+    /** An interned event name, 0 is used by the events constructed with a name.
+     * @since v3.9
+     */
+    typedef unsigned int ID;
+    
     /** Constructor.
      *
      * @param eventName A given name of the custom event.
@@ -48,6 +53,34 @@ public:
      */
     EventCustom(const std::string& eventName);
     
+    /** Constructor with an interned event name, the name isn't copied.
+     *
+     * @param eventID An id returned by EventCustom::internEventName().
+     * @js NA
+     * @since v3.9
+     */
+    explicit EventCustom(ID eventID);
+    
+    /** Interns an event name, the same name always gets the same id.
+     * Interned events are dispatched without hashing or copying their name.
+     * It isn't thread safe, call it from the thread which dispatches the events.
+     *
+     * @param eventName A given name of the custom event.
+     * @return The id of the name, never 0.
+     * @js NA
+     * @since v3.9
+     */
+    static ID internEventName(const std::string& eventName);
+    
+    /** Gets the name of an interned event.
+     *
+     * @param eventID An id returned by EventCustom::internEventName().
+     * @return The name of the event.
+     * @js NA
+     * @since v3.9
+     */
+    static const std::string& getInternedEventName(ID eventID);
+    
     /** Sets user data.
      *
      * @param data The user data pointer, it's a void*.
@@ -64,10 +97,19 @@ public:
      *
      * @return The name of the event.
      */
-    inline const std::string& getEventName() const { return _eventName; };
+    inline const std::string& getEventName() const { return _eventID != 0 ? getInternedEventName(_eventID) : _eventName; };
+    
+    /** Gets the interned event name.
+     *
+     * @return The id of the event name, 0 if the event was constructed with a name.
+     * @js NA
+     * @since v3.9
+     */
+    inline ID getEventID() const { return _eventID; };
 protected:
     void* _userData;       ///< User data
     std::string _eventName;
+    ID _eventID;           ///< Interned name, 0 if _eventName is used
 };
 
 NS_CC_END
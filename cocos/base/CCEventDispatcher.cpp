@@ -23,6 +23,9 @@
  ****************************************************************************/
 #include "base/CCEventDispatcher.h"
 #include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <mutex>
 
 #include "base/CCEventCustom.h"
 #include "base/CCEventListenerTouch.h"
@@ -38,6 +41,7 @@
 #include "base/CCDirector.h"
 #include "base/CCEventType.h"
 #include "2d/CCCamera.h"
+#include "base/CCTouch.h"
 
 #define DUMP_LISTENER_ITEM_PRIORITY_INFO 0
 
@@ -66,6 +70,60 @@ private:
 
 NS_CC_BEGIN
 
+/** Compares the nodes the way visitTarget() numbers them, without walking the whole scene graph. */
+class SceneGraphPriorityOrder
+{
+public:
+    explicit SceneGraphPriorityOrder(Node* rootNode)
+    : _rootNode(rootNode)
+    {
+    }
+    
+    /** Whether n1 gets a higher priority than n2, the nodes outside of the scene share the lowest one. */
+    bool isDrawnAfter(Node* n1, Node* n2)
+    {
+        if (n1 == n2)
+            return false;
+        
+        bool inScene1 = getPath(n1, &_path1);
+        bool inScene2 = getPath(n2, &_path2);
+        if (!inScene1 || !inScene2)
+            return inScene1 && !inScene2;
+        
+        if (n1->getGlobalZOrder() != n2->getGlobalZOrder())
+            return n1->getGlobalZOrder() > n2->getGlobalZOrder();
+        
+        // below their common ancestor, a child with a negative local z order is visited before its parent
+        size_t i = 1;
+        while (i < _path1.size() && i < _path2.size() && _path1[i] == _path2[i])
+            ++i;
+        
+        if (i == _path1.size())
+            return _path2[i]->getLocalZOrder() < 0;
+        if (i == _path2.size())
+            return _path1[i]->getLocalZOrder() >= 0;
+        
+        return nodeComparisonLess(_path2[i], _path1[i]);
+    }
+    
+private:
+    // Fills the ancestors from the root node down to the node, returns false if the node isn't under the root node
+    bool getPath(Node* node, std::vector<Node*>* path)
+    {
+        path->clear();
+        for (; node != nullptr; node = node->getParent())
+        {
+            path->push_back(node);
+        }
+        std::reverse(path->begin(), path->end());
+        return !path->empty() && path->front() == _rootNode;
+    }
+    
+    Node* _rootNode;
+    std::vector<Node*> _path1;
+    std::vector<Node*> _path2;
+};
+
 static EventListener::ListenerID __getListenerID(Event* event)
 {
     EventListener::ListenerID ret;
@@ -110,7 +168,8 @@ static EventListener::ListenerID __getListenerID(Event* event)
 EventDispatcher::EventListenerVector::EventListenerVector() :
  _fixedListeners(nullptr),
  _sceneGraphListeners(nullptr),
- _gt0Index(0)
+ _gt0Index(0),
+ _sceneGraphRootNode(nullptr)
 {
 }
 
@@ -198,10 +257,418 @@ void EventDispatcher::EventListenerVector::clear()
 }
 
 
+/**
+ * Uniform grid over the window, in the same GL coordinates as Touch::getLocation(), holding the
+ * projected bounds of the nodes whose one by one touch listeners are bounded by their node.
+ * The listener order is recorded as indexes into the sorted scene graph listeners, so a query
+ * returns the listeners which may claim a touch in the order they would be called.
+ */
+class EventDispatcher::TouchBoundsIndex
+{
+public:
+    TouchBoundsIndex();
+    ~TouchBoundsIndex();
+
+    /** The scene graph listeners were sorted, the recorded listener orders have to be rebuilt. */
+    void setOrdersDirty() { _ordersDirty = true; }
+
+    /** Called from Node::processParentFlags(), possibly on a worker thread. */
+    void setNodeDirty(Node* node);
+
+    /** The node lost all its listeners, it may be destroyed right after. */
+    void removeNode(Node* node);
+
+    /** Collects the listeners which may claim a touch at location, seen through camera.
+     *  Returns false if the index can't answer, then every listener has to be tried.
+     */
+    bool query(std::vector<EventListener*>* sceneGraphListeners, const Camera* camera, const Vec2& location, std::vector<EventListener*>* result);
+
+private:
+    typedef std::pair<ssize_t, EventListener*> OrderedListener;
+
+    struct Entry
+    {
+        Node* node;
+        float minX, minY, maxX, maxY;
+        int cellX0, cellY0, cellX1, cellY1;     // inclusive, empty if cellX1 < cellX0
+        unsigned int stamp;
+        std::vector<OrderedListener> listeners;
+    };
+
+    static const int GRID_SIZE = 16;
+
+    void rebuild(std::vector<EventListener*>* sceneGraphListeners);
+    int addEntry(Node* node);
+    void removeEntry(int index);
+    void updateBounds(int index);
+    void insertIntoCells(int index);
+    void removeFromCells(int index);
+    void resetGrid(const Size& winSize);
+
+    std::vector<Entry> _entries;
+    std::vector<int> _freeEntries;
+    std::unordered_map<Node*, int> _nodeEntries;
+
+    std::vector<std::vector<int>> _cells;
+    Size _winSize;
+    float _cellWidth;
+    float _cellHeight;
+    Mat4 _viewProjection;
+
+    std::vector<OrderedListener> _unboundedListeners;
+    std::vector<EventListener*>* _sceneGraphListeners;
+    bool _ordersDirty;
+
+    std::vector<OrderedListener> _candidates;
+    unsigned int _stamp;
+
+    std::mutex _dirtyNodesMutex;
+    std::vector<Node*> _dirtyNodes;
+};
+
+EventDispatcher::TouchBoundsIndex::TouchBoundsIndex()
+: _cellWidth(0)
+, _cellHeight(0)
+, _sceneGraphListeners(nullptr)
+, _ordersDirty(true)
+, _stamp(0)
+{
+}
+
+EventDispatcher::TouchBoundsIndex::~TouchBoundsIndex()
+{
+    for (auto& e : _nodeEntries)
+    {
+        e.first->_touchBoundsTracked = false;
+        e.first->_touchBoundsDirty = false;
+    }
+}
+
+void EventDispatcher::TouchBoundsIndex::setNodeDirty(Node* node)
+{
+    std::lock_guard<std::mutex> lock(_dirtyNodesMutex);
+    _dirtyNodes.push_back(node);
+}
+
+void EventDispatcher::TouchBoundsIndex::removeNode(Node* node)
+{
+    auto iter = _nodeEntries.find(node);
+    if (iter == _nodeEntries.end())
+        return;
+
+    removeEntry(iter->second);
+    _ordersDirty = true;
+}
+
+int EventDispatcher::TouchBoundsIndex::addEntry(Node* node)
+{
+    int index;
+    if (_freeEntries.empty())
+    {
+        index = static_cast<int>(_entries.size());
+        _entries.push_back(Entry());
+    }
+    else
+    {
+        index = _freeEntries.back();
+        _freeEntries.pop_back();
+    }
+
+    auto& entry = _entries[index];
+    entry.node = node;
+    entry.cellX0 = entry.cellY0 = 0;
+    entry.cellX1 = entry.cellY1 = -1;
+    entry.stamp = 0;
+    entry.listeners.clear();
+    _nodeEntries[node] = index;
+
+    node->_touchBoundsTracked = true;
+    node->_touchBoundsDirty = false;
+    updateBounds(index);
+    return index;
+}
+
+void EventDispatcher::TouchBoundsIndex::removeEntry(int index)
+{
+    auto& entry = _entries[index];
+    removeFromCells(index);
+
+    if (entry.node->_touchBoundsDirty)
+    {
+        std::lock_guard<std::mutex> lock(_dirtyNodesMutex);
+        _dirtyNodes.erase(std::remove(_dirtyNodes.begin(), _dirtyNodes.end(), entry.node), _dirtyNodes.end());
+    }
+    entry.node->_touchBoundsTracked = false;
+    entry.node->_touchBoundsDirty = false;
+
+    _nodeEntries.erase(entry.node);
+    entry.node = nullptr;
+    entry.listeners.clear();
+    _freeEntries.push_back(index);
+}
+
+void EventDispatcher::TouchBoundsIndex::rebuild(std::vector<EventListener*>* sceneGraphListeners)
+{
+    for (auto& entry : _entries)
+    {
+        entry.listeners.clear();
+    }
+    _unboundedListeners.clear();
+
+    ssize_t count = static_cast<ssize_t>(sceneGraphListeners->size());
+    for (ssize_t i = 0; i < count; ++i)
+    {
+        auto listener = static_cast<EventListenerTouchOneByOne*>(sceneGraphListeners->at(i));
+        if (!listener->isRegistered())
+            continue;
+
+        if (listener->isHitAreaBoundedByNode())
+        {
+            auto node = listener->getAssociatedNode();
+            auto iter = _nodeEntries.find(node);
+            int index = (iter != _nodeEntries.end()) ? iter->second : addEntry(node);
+            _entries[index].listeners.push_back(std::make_pair(i, listener));
+        }
+        else
+        {
+            _unboundedListeners.push_back(std::make_pair(i, listener));
+        }
+    }
+
+    // the nodes whose bounded listeners were all removed still have other listeners, so they are alive
+    for (int i = 0; i < static_cast<int>(_entries.size()); ++i)
+    {
+        if (_entries[i].node && _entries[i].listeners.empty())
+        {
+            removeEntry(i);
+        }
+    }
+
+    _sceneGraphListeners = sceneGraphListeners;
+    _ordersDirty = false;
+}
+
+void EventDispatcher::TouchBoundsIndex::resetGrid(const Size& winSize)
+{
+    for (auto& entry : _entries)
+    {
+        entry.cellX0 = entry.cellY0 = 0;
+        entry.cellX1 = entry.cellY1 = -1;
+    }
+    _cells.clear();
+    _cells.resize(GRID_SIZE * GRID_SIZE);
+
+    _winSize = winSize;
+    _cellWidth = winSize.width / GRID_SIZE;
+    _cellHeight = winSize.height / GRID_SIZE;
+}
+
+void EventDispatcher::TouchBoundsIndex::updateBounds(int index)
+{
+    auto& entry = _entries[index];
+    auto& size = entry.node->getContentSize();
+
+    int cellX0 = 0, cellY0 = 0, cellX1 = -1, cellY1 = -1;
+    if (size.width > 0 && size.height > 0 && _cellWidth > 0 && _cellHeight > 0)
+    {
+        // same projection as Camera::projectGL(), a corner behind the camera makes the bounds unlimited
+        Mat4 transform = _viewProjection * entry.node->getNodeToWorldTransform();
+        const Vec2 corners[4] = { Vec2::ZERO, Vec2(size.width, 0), Vec2(0, size.height), Vec2(size.width, size.height) };
+        bool unlimited = false;
+
+        entry.minX = entry.minY = FLT_MAX;
+        entry.maxX = entry.maxY = -FLT_MAX;
+        for (const auto& corner : corners)
+        {
+            Vec4 clipPos;
+            transform.transformVector(Vec4(corner.x, corner.y, 0.0f, 1.0f), &clipPos);
+            if (clipPos.w <= 0.0f)
+            {
+                unlimited = true;
+                break;
+            }
+            float x = (clipPos.x / clipPos.w + 1.0f) * 0.5f * _winSize.width;
+            float y = (clipPos.y / clipPos.w + 1.0f) * 0.5f * _winSize.height;
+            entry.minX = std::min(entry.minX, x);
+            entry.minY = std::min(entry.minY, y);
+            entry.maxX = std::max(entry.maxX, x);
+            entry.maxY = std::max(entry.maxY, y);
+        }
+
+        if (unlimited)
+        {
+            entry.minX = entry.minY = -FLT_MAX;
+            entry.maxX = entry.maxY = FLT_MAX;
+        }
+        else
+        {
+            // hitTest() computes the other way around, don't lose touches on the edges to rounding
+            entry.minX -= 1.0f;
+            entry.minY -= 1.0f;
+            entry.maxX += 1.0f;
+            entry.maxY += 1.0f;
+        }
+
+        if (entry.maxX >= 0 && entry.maxY >= 0 && entry.minX < _winSize.width && entry.minY < _winSize.height)
+        {
+            cellX0 = std::max(0, static_cast<int>(entry.minX / _cellWidth));
+            cellY0 = std::max(0, static_cast<int>(entry.minY / _cellHeight));
+            cellX1 = std::min(GRID_SIZE - 1, static_cast<int>(std::min(entry.maxX / _cellWidth, (float)GRID_SIZE)));
+            cellY1 = std::min(GRID_SIZE - 1, static_cast<int>(std::min(entry.maxY / _cellHeight, (float)GRID_SIZE)));
+        }
+    }
+
+    if (cellX0 != entry.cellX0 || cellY0 != entry.cellY0 || cellX1 != entry.cellX1 || cellY1 != entry.cellY1)
+    {
+        removeFromCells(index);
+        entry.cellX0 = cellX0;
+        entry.cellY0 = cellY0;
+        entry.cellX1 = cellX1;
+        entry.cellY1 = cellY1;
+        insertIntoCells(index);
+    }
+}
+
+void EventDispatcher::TouchBoundsIndex::insertIntoCells(int index)
+{
+    const auto& entry = _entries[index];
+    for (int y = entry.cellY0; y <= entry.cellY1; ++y)
+    {
+        for (int x = entry.cellX0; x <= entry.cellX1; ++x)
+        {
+            _cells[y * GRID_SIZE + x].push_back(index);
+        }
+    }
+}
+
+void EventDispatcher::TouchBoundsIndex::removeFromCells(int index)
+{
+    const auto& entry = _entries[index];
+    for (int y = entry.cellY0; y <= entry.cellY1; ++y)
+    {
+        for (int x = entry.cellX0; x <= entry.cellX1; ++x)
+        {
+            auto& cell = _cells[y * GRID_SIZE + x];
+            auto iter = std::find(cell.begin(), cell.end(), index);
+            if (iter != cell.end())
+            {
+                *iter = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+bool EventDispatcher::TouchBoundsIndex::query(std::vector<EventListener*>* sceneGraphListeners, const Camera* camera, const Vec2& location, std::vector<EventListener*>* result)
+{
+    if (_ordersDirty || sceneGraphListeners != _sceneGraphListeners)
+    {
+        rebuild(sceneGraphListeners);
+    }
+
+    // a new window size or camera moves every bounds
+    auto winSize = Director::getInstance()->getWinSize();
+    const Mat4& viewProjection = camera->getViewProjectionMatrix();
+    bool allDirty = false;
+    if (!winSize.equals(_winSize) || _cells.empty())
+    {
+        resetGrid(winSize);
+        allDirty = true;
+    }
+    if (memcmp(viewProjection.m, _viewProjection.m, sizeof(_viewProjection.m)) != 0)
+    {
+        _viewProjection = viewProjection;
+        allDirty = true;
+    }
+
+    std::vector<Node*> dirtyNodes;
+    {
+        std::lock_guard<std::mutex> lock(_dirtyNodesMutex);
+        dirtyNodes.swap(_dirtyNodes);
+    }
+    for (auto node : dirtyNodes)
+    {
+        node->_touchBoundsDirty = false;
+        if (!allDirty)
+        {
+            auto iter = _nodeEntries.find(node);
+            if (iter != _nodeEntries.end())
+            {
+                updateBounds(iter->second);
+            }
+        }
+    }
+    if (allDirty)
+    {
+        for (const auto& e : _nodeEntries)
+        {
+            updateBounds(e.second);
+        }
+    }
+
+    if (location.x < 0 || location.y < 0 || location.x >= _winSize.width || location.y >= _winSize.height)
+        return false;
+
+    if (++_stamp == 0)
+    {
+        for (auto& entry : _entries)
+        {
+            entry.stamp = 0;
+        }
+        _stamp = 1;
+    }
+
+    _candidates.clear();
+    int cellX = std::min(GRID_SIZE - 1, static_cast<int>(location.x / _cellWidth));
+    int cellY = std::min(GRID_SIZE - 1, static_cast<int>(location.y / _cellHeight));
+    for (auto index : _cells[cellY * GRID_SIZE + cellX])
+    {
+        auto& entry = _entries[index];
+        if (entry.stamp == _stamp)
+            continue;
+        entry.stamp = _stamp;
+
+        if (location.x >= entry.minX && location.x <= entry.maxX && location.y >= entry.minY && location.y <= entry.maxY)
+        {
+            _candidates.insert(_candidates.end(), entry.listeners.begin(), entry.listeners.end());
+        }
+    }
+    _candidates.insert(_candidates.end(), _unboundedListeners.begin(), _unboundedListeners.end());
+
+    // listeners removed without sorting shift the orders, see removeEventListenersForListenerID()
+    ssize_t count = static_cast<ssize_t>(sceneGraphListeners->size());
+    for (const auto& candidate : _candidates)
+    {
+        if (candidate.first >= count || sceneGraphListeners->at(candidate.first) != candidate.second)
+        {
+            _ordersDirty = true;
+            return query(sceneGraphListeners, camera, location, result);
+        }
+    }
+
+    std::sort(_candidates.begin(), _candidates.end(), [](const OrderedListener& a, const OrderedListener& b) {
+        return a.first < b.first;
+    });
+
+    result->clear();
+    for (const auto& candidate : _candidates)
+    {
+        auto l = candidate.second;
+        if (l->isEnabled() && !l->isPaused() && l->isRegistered())
+        {
+            result->push_back(l);
+        }
+    }
+    return true;
+}
+
+
 EventDispatcher::EventDispatcher()
 : _inDispatch(0)
 , _isEnabled(false)
 , _nodePriorityIndex(0)
+, _touchBoundsIndex(nullptr)
+, _listenerIDsVersion(1)
 {
     _toAddedListeners.reserve(50);
     
@@ -218,6 +685,7 @@ EventDispatcher::~EventDispatcher()
     // so removeAllEventListeners would clean internal custom listeners.
     _internalCustomListenerIDs.clear();
     removeAllEventListeners();
+    CC_SAFE_DELETE(_touchBoundsIndex);
 }
 
 void EventDispatcher::visitTarget(Node* node, bool isRootNode)
@@ -299,6 +767,9 @@ void EventDispatcher::pauseEventListenersForTarget(Node* target, bool recursive/
         {
             l->setPaused(true);
         }
+        
+        // The node may be leaving the scene graph, its listeners have to be placed again
+        _dirtyNodes.insert(target);
     }
 
     for (auto& listener : _toAddedListeners)
@@ -435,6 +906,11 @@ void EventDispatcher::dissociateNodeAndEventListener(Node* node, EventListener*
         {
             _nodeListenersMap.erase(found);
             delete listeners;
+            
+            if (_touchBoundsIndex)
+            {
+                _touchBoundsIndex->removeNode(node);
+            }
         }
     }
 }
@@ -463,6 +939,7 @@ void EventDispatcher::forceAddEventListener(EventListener* listener)
         
         listeners = new (std::nothrow) EventListenerVector();
         _listenerMap.insert(std::make_pair(listenerID, listeners));
+        ++_listenerIDsVersion;
     }
     else
     {
@@ -473,6 +950,7 @@ void EventDispatcher::forceAddEventListener(EventListener* listener)
     
     if (listener->getFixedPriority() == 0)
     {
+        listener->_sceneGraphPriorityDirty = true;
         setDirty(listenerID, DirtyFlag::SCENE_GRAPH_PRIORITY);
         
         auto node = listener->getAssociatedNode();
@@ -593,6 +1071,12 @@ EventListenerCustom* EventDispatcher::addCustomEventListener(const std::string &
     return listener;
 }
 
+EventListenerCustom* EventDispatcher::addCustomEventListener(EventCustom::ID eventID, const std::function<void(EventCustom*)>& callback)
+{
+    CCASSERT(eventID != 0, "Invalid interned event id!");
+    return addCustomEventListener(EventCustom::getInternedEventName(eventID), callback);
+}
+
 void EventDispatcher::removeEventListener(EventListener* listener)
 {
     if (listener == nullptr)
@@ -668,6 +1152,7 @@ void EventDispatcher::removeEventListener(EventListener* listener)
             auto list = iter->second;
             iter = _listenerMap.erase(iter);
             CC_SAFE_DELETE(list);
+            ++_listenerIDsVersion;
         }
         else
         {
@@ -786,6 +1271,11 @@ void EventDispatcher::dispatchEventToListeners(EventListenerVector* listeners, c
 }
 
 void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listeners, const std::function<bool(EventListener*)>& onEvent)
+{
+    dispatchTouchEventToListeners(listeners, onEvent, nullptr);
+}
+
+void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listeners, const std::function<bool(EventListener*)>& onEvent, Touch* beganTouch)
 {
     bool shouldStopPropagation = false;
     auto fixedPriorityListeners = listeners->getFixedPriorityListeners();
@@ -820,13 +1310,12 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
             
             // first, get all enabled, unPaused and registered listeners
             std::vector<EventListener*> sceneListeners;
-            for (auto& l : *sceneGraphPriorityListeners)
-            {
-                if (l->isEnabled() && !l->isPaused() && l->isRegistered())
-                {
-                    sceneListeners.push_back(l);
-                }
-            }
+            bool sceneListenersCollected = false;
+            
+            // only the listeners whose bounds contain a began touch can claim it
+            std::vector<EventListener*> hitListeners;
+            bool useTouchBoundsIndex = (beganTouch && listeners == getListeners(EventListenerTouchOneByOne::LISTENER_ID));
+            
             // second, for all camera call all listeners
             // get a copy of cameras, prevent it's been modified in linstener callback
             // if camera's depth is greater, process it earler
@@ -840,9 +1329,27 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
                     continue;
                 }
                 
+                std::vector<EventListener*>* cameraListeners = &sceneListeners;
+                if (useTouchBoundsIndex && _touchBoundsIndex && camera == scene->getDefaultCamera()
+                    && _touchBoundsIndex->query(sceneGraphPriorityListeners, camera, beganTouch->getLocation(), &hitListeners))
+                {
+                    cameraListeners = &hitListeners;
+                }
+                else if (!sceneListenersCollected)
+                {
+                    for (auto& l : *sceneGraphPriorityListeners)
+                    {
+                        if (l->isEnabled() && !l->isPaused() && l->isRegistered())
+                        {
+                            sceneListeners.push_back(l);
+                        }
+                    }
+                    sceneListenersCollected = true;
+                }
+                
                 Camera::_visitingCamera = camera;
                 auto cameraFlag = (unsigned short)camera->getCameraFlag();
-                for (auto& l : sceneListeners)
+                for (auto& l : *cameraListeners)
                 {
                     if (0 == (l->getAssociatedNode()->getCameraMask() & cameraFlag))
                     {
@@ -899,6 +1406,12 @@ void EventDispatcher::dispatchEvent(Event* event)
         return;
     }
     
+    if (event->getType() == Event::Type::CUSTOM && static_cast<EventCustom*>(event)->getEventID() != 0)
+    {
+        dispatchInternedCustomEvent(static_cast<EventCustom*>(event));
+        return;
+    }
+    
     auto listenerID = __getListenerID(event);
     
     sortEventListeners(listenerID);
@@ -931,6 +1444,62 @@ void EventDispatcher::dispatchCustomEvent(const std::string &eventName, void *op
     dispatchEvent(&ev);
 }
 
+void EventDispatcher::dispatchCustomEvent(EventCustom::ID eventID, void *optionalUserData)
+{
+    CCASSERT(eventID != 0, "Invalid interned event id!");
+    EventCustom ev(eventID);
+    ev.setUserData(optionalUserData);
+    dispatchEvent(&ev);
+}
+
+const EventDispatcher::InternedListeners& EventDispatcher::getInternedListeners(EventCustom::ID eventID)
+{
+    if (eventID > _internedListeners.size())
+    {
+        InternedListeners empty = { 0, nullptr, nullptr };
+        _internedListeners.resize(eventID, empty);
+    }
+    
+    auto& interned = _internedListeners[eventID - 1];
+    if (interned.version != _listenerIDsVersion)
+    {
+        const auto& eventName = EventCustom::getInternedEventName(eventID);
+        
+        auto listenersIter = _listenerMap.find(eventName);
+        interned.listeners = listenersIter != _listenerMap.end() ? listenersIter->second : nullptr;
+        
+        auto dirtyIter = _priorityDirtyFlagMap.find(eventName);
+        interned.dirtyFlag = dirtyIter != _priorityDirtyFlagMap.end() ? &dirtyIter->second : nullptr;
+        
+        interned.version = _listenerIDsVersion;
+    }
+    return interned;
+}
+
+void EventDispatcher::dispatchInternedCustomEvent(EventCustom* event)
+{
+    // Copied, since dispatching may add or remove listener IDs.
+    InternedListeners interned = getInternedListeners(event->getEventID());
+    
+    if (interned.dirtyFlag != nullptr && *interned.dirtyFlag != DirtyFlag::NONE)
+    {
+        sortEventListeners(event->getEventName());
+    }
+    
+    if (interned.listeners != nullptr)
+    {
+        auto onEvent = [&event](EventListener* listener) -> bool{
+            event->setCurrentTarget(listener->getAssociatedNode());
+            listener->_onEvent(event);
+            return event->isStopped();
+        };
+        
+        dispatchEventToListeners(interned.listeners, onEvent);
+    }
+    
+    updateListeners(event);
+}
+
 
 void EventDispatcher::dispatchTouchEvent(EventTouch* event)
 {
@@ -1050,7 +1619,8 @@ void EventDispatcher::dispatchTouchEvent(EventTouch* event)
             };
             
             //
-            dispatchTouchEventToListeners(oneByOneListeners, onTouchEvent);
+            dispatchTouchEventToListeners(oneByOneListeners, onTouchEvent,
+                                          event->getEventCode() == EventTouch::EventCode::BEGAN ? *touchesIter : nullptr);
             if (event->isStopped())
             {
                 return;
@@ -1133,14 +1703,8 @@ void EventDispatcher::updateListeners(Event* event)
     if (_inDispatch > 1)
         return;
 
-    auto onUpdateListeners = [this](const EventListener::ListenerID& listenerID)
+    auto purgeListeners = [](EventListenerVector* listeners)
     {
-        auto listenersIter = _listenerMap.find(listenerID);
-        if (listenersIter == _listenerMap.end())
-            return;
-
-        auto listeners = listenersIter->second;
-        
         auto fixedPriorityListeners = listeners->getFixedPriorityListeners();
         auto sceneGraphPriorityListeners = listeners->getSceneGraphPriorityListeners();
         
@@ -1188,30 +1752,64 @@ void EventDispatcher::updateListeners(Event* event)
             listeners->clearFixedListeners();
         }
     };
-
-    if (event->getType() == Event::Type::TOUCH)
+    
+    auto onUpdateListeners = [this, &purgeListeners](const EventListener::ListenerID& listenerID)
     {
-        onUpdateListeners(EventListenerTouchOneByOne::LISTENER_ID);
-        onUpdateListeners(EventListenerTouchAllAtOnce::LISTENER_ID);
-    }
-    else
+        auto listenersIter = _listenerMap.find(listenerID);
+        if (listenersIter == _listenerMap.end())
+            return;
+        
+        purgeListeners(listenersIter->second);
+    };
+    
+    if (event->getType() == Event::Type::CUSTOM && static_cast<EventCustom*>(event)->getEventID() != 0)
     {
-        onUpdateListeners(__getListenerID(event));
+        CCASSERT(_inDispatch == 1, "_inDispatch should be 1 here.");
+        
+        // Only the listeners of the dispatched event were purged, so no other
+        // vector could become empty and the listener map doesn't need to be swept.
+        auto customEvent = static_cast<EventCustom*>(event);
+        auto interned = getInternedListeners(customEvent->getEventID());
+        if (interned.listeners != nullptr)
+        {
+            purgeListeners(interned.listeners);
+            
+            if (interned.listeners->empty())
+            {
+                _priorityDirtyFlagMap.erase(customEvent->getEventName());
+                _listenerMap.erase(customEvent->getEventName());
+                delete interned.listeners;
+                ++_listenerIDsVersion;
+            }
+        }
     }
-    
-    CCASSERT(_inDispatch == 1, "_inDispatch should be 1 here.");
-    
-    for (auto iter = _listenerMap.begin(); iter != _listenerMap.end();)
+    else
     {
-        if (iter->second->empty())
+        if (event->getType() == Event::Type::TOUCH)
         {
-            _priorityDirtyFlagMap.erase(iter->first);
-            delete iter->second;
-            iter = _listenerMap.erase(iter);
+            onUpdateListeners(EventListenerTouchOneByOne::LISTENER_ID);
+            onUpdateListeners(EventListenerTouchAllAtOnce::LISTENER_ID);
         }
         else
         {
-            ++iter;
+            onUpdateListeners(__getListenerID(event));
+        }
+        
+        CCASSERT(_inDispatch == 1, "_inDispatch should be 1 here.");
+        
+        for (auto iter = _listenerMap.begin(); iter != _listenerMap.end();)
+        {
+            if (iter->second->empty())
+            {
+                _priorityDirtyFlagMap.erase(iter->first);
+                delete iter->second;
+                iter = _listenerMap.erase(iter);
+                ++_listenerIDsVersion;
+            }
+            else
+            {
+                ++iter;
+            }
         }
     }
     
@@ -1236,6 +1834,7 @@ void EventDispatcher::updateDirtyFlagForSceneGraph()
             {
                 for (auto& l : *iter->second)
                 {
+                    l->_sceneGraphPriorityDirty = true;
                     setDirty(l->getListenerID(), DirtyFlag::SCENE_GRAPH_PRIORITY);
                 }
             }
@@ -1291,16 +1890,46 @@ void EventDispatcher::sortEventListenersOfSceneGraphPriority(const EventListener
     if (sceneGraphListeners == nullptr)
         return;
 
-    // Reset priority index
-    _nodePriorityIndex = 0;
-    _nodePriorityMap.clear();
+    size_t dirtyCount = 0;
+    for (auto& l : *sceneGraphListeners)
+    {
+        if (l->_sceneGraphPriorityDirty)
+            ++dirtyCount;
+    }
+    
+    // The listeners whose nodes didn't move keep their order, so only the dirty ones are placed again.
+    // Walking the whole scene graph is left for a new scene or when most of the nodes moved.
+    if (listeners->getSceneGraphRootNode() == rootNode && dirtyCount <= sceneGraphListeners->size() / 2)
+    {
+        if (dirtyCount == 0)
+            return;
+        
+        sortDirtyEventListenersOfSceneGraphPriority(sceneGraphListeners, rootNode, dirtyCount);
+    }
+    else
+    {
+        // Reset priority index
+        _nodePriorityIndex = 0;
+        _nodePriorityMap.clear();
 
-    visitTarget(rootNode, true);
+        visitTarget(rootNode, true);
+        
+        // After sort: priority < 0, > 0
+        std::sort(sceneGraphListeners->begin(), sceneGraphListeners->end(), [this](const EventListener* l1, const EventListener* l2) {
+            return _nodePriorityMap[l1->getAssociatedNode()] > _nodePriorityMap[l2->getAssociatedNode()];
+        });
+        
+        for (auto& l : *sceneGraphListeners)
+        {
+            l->_sceneGraphPriorityDirty = false;
+        }
+        listeners->setSceneGraphRootNode(rootNode);
+    }
     
-    // After sort: priority < 0, > 0
-    std::sort(sceneGraphListeners->begin(), sceneGraphListeners->end(), [this](const EventListener* l1, const EventListener* l2) {
-        return _nodePriorityMap[l1->getAssociatedNode()] > _nodePriorityMap[l2->getAssociatedNode()];
-    });
+    if (_touchBoundsIndex && listenerID == EventListenerTouchOneByOne::LISTENER_ID)
+    {
+        _touchBoundsIndex->setOrdersDirty();
+    }
     
 #if DUMP_LISTENER_ITEM_PRIORITY_INFO
     log("-----------------------------------");
@@ -1311,6 +1940,46 @@ void EventDispatcher::sortEventListenersOfSceneGraphPriority(const EventListener
 #endif
 }
 
+void EventDispatcher::sortDirtyEventListenersOfSceneGraphPriority(std::vector<EventListener*>* sceneGraphListeners, Node* rootNode, size_t dirtyCount)
+{
+    std::vector<EventListener*> dirtyListeners;
+    std::vector<EventListener*> sortedListeners;
+    dirtyListeners.reserve(dirtyCount);
+    sortedListeners.reserve(sceneGraphListeners->size() - dirtyCount);
+    
+    for (auto& l : *sceneGraphListeners)
+    {
+        if (l->_sceneGraphPriorityDirty)
+        {
+            l->_sceneGraphPriorityDirty = false;
+            dirtyListeners.push_back(l);
+        }
+        else
+        {
+            sortedListeners.push_back(l);
+        }
+    }
+    
+    SceneGraphPriorityOrder order(rootNode);
+    auto isCalledBefore = [&order](const EventListener* l1, const EventListener* l2) {
+        return order.isDrawnAfter(l1->getAssociatedNode(), l2->getAssociatedNode());
+    };
+    
+    std::stable_sort(dirtyListeners.begin(), dirtyListeners.end(), isCalledBefore);
+    
+    // Merge them back, the dirty listeners go after the clean ones of the same priority
+    sceneGraphListeners->clear();
+    auto from = sortedListeners.begin();
+    for (auto& l : dirtyListeners)
+    {
+        auto to = std::upper_bound(from, sortedListeners.end(), l, isCalledBefore);
+        sceneGraphListeners->insert(sceneGraphListeners->end(), from, to);
+        sceneGraphListeners->push_back(l);
+        from = to;
+    }
+    sceneGraphListeners->insert(sceneGraphListeners->end(), from, sortedListeners.end());
+}
+
 void EventDispatcher::sortEventListenersOfFixedPriority(const EventListener::ListenerID& listenerID)
 {
     auto listeners = getListeners(listenerID);
@@ -1407,6 +2076,7 @@ void EventDispatcher::removeEventListenersForListenerID(const EventListener::Lis
             delete listeners;
             _listenerMap.erase(listenerItemIter);
         }
+        ++_listenerIDsVersion;
     }
     
     for (auto iter = _toAddedListeners.begin(); iter != _toAddedListeners.end();)
@@ -1482,6 +2152,7 @@ void EventDispatcher::removeAllEventListeners()
     if (!_inDispatch && cleanMap)
     {
         _listenerMap.clear();
+        ++_listenerIDsVersion;
     }
 }
 
@@ -1495,6 +2166,29 @@ bool EventDispatcher::isEnabled() const
     return _isEnabled;
 }
 
+void EventDispatcher::setTouchBoundsIndexEnabled(bool enabled)
+{
+    if (enabled == (_touchBoundsIndex != nullptr))
+        return;
+    
+    if (enabled)
+    {
+        _touchBoundsIndex = new (std::nothrow) TouchBoundsIndex();
+    }
+    else
+    {
+        CC_SAFE_DELETE(_touchBoundsIndex);
+    }
+}
+
+void EventDispatcher::setTouchBoundsDirtyForNode(Node* node)
+{
+    if (_touchBoundsIndex)
+    {
+        _touchBoundsIndex->setNodeDirty(node);
+    }
+}
+
 void EventDispatcher::setDirtyForNode(Node* node)
 {
     // Mark the node dirty only when there is an eventlistener associated with it. 
@@ -1517,6 +2211,7 @@ void EventDispatcher::setDirty(const EventListener::ListenerID& listenerID, Dirt
     if (iter == _priorityDirtyFlagMap.end())
     {
         _priorityDirtyFlagMap.insert(std::make_pair(listenerID, flag));
+        ++_listenerIDsVersion;
     }
     else
     {
@@ -34,6 +34,7 @@
 #include "platform/CCPlatformMacros.h"
 #include "base/CCEventListener.h"
 #include "base/CCEvent.h"
+#include "base/CCEventCustom.h"
 #include "platform/CCStdC.h"
 
 /**
@@ -45,6 +46,7 @@ NS_CC_BEGIN
 
 class Event;
 class EventTouch;
+class Touch;
 class Node;
 class EventCustom;
 class EventListenerCustom;
@@ -88,6 +90,16 @@ public:
      */
     EventListenerCustom* addCustomEventListener(const std::string &eventName, const std::function<void(EventCustom*)>& callback);
 
+    /** Adds a Custom event listener for an interned event name.
+     It will use a fixed priority of 1.
+     * @param eventID An id returned by EventCustom::internEventName().
+     * @param callback A given callback method that associated the event name.
+     * @return the generated event. Needed in order to remove the event from the dispather
+     * @js NA
+     * @since v3.9
+     */
+    EventListenerCustom* addCustomEventListener(EventCustom::ID eventID, const std::function<void(EventCustom*)>& callback);
+
     /////////////////////////////////////////////
     
     // Removes event listener
@@ -160,6 +172,24 @@ public:
      */
     bool isEnabled() const;
 
+    /** Whether to keep a screen-space index of the bounds of the nodes whose one by one touch
+     * listeners are bounded by their node (see EventListenerTouchOneByOne::setHitAreaBoundedByNode()).
+     * A began touch is then only offered to those listeners whose bounds contain it, instead of
+     * calling every listener. The bounds follow the transform dirty flags of the visited scene,
+     * and only the default camera of the running scene is accelerated.
+     *
+     * @param enabled True to maintain the index, the default value is false.
+     * @since v3.9
+     */
+    void setTouchBoundsIndexEnabled(bool enabled);
+
+    /** Checks whether the touch bounds index is maintained.
+     *
+     * @return True if the touch bounds index is enabled.
+     * @since v3.9
+     */
+    bool isTouchBoundsIndexEnabled() const { return _touchBoundsIndex != nullptr; }
+
     /////////////////////////////////////////////
     
     /** Dispatches the event.
@@ -177,6 +207,15 @@ public:
      */
     void dispatchCustomEvent(const std::string &eventName, void *optionalUserData = nullptr);
 
+    /** Dispatches a Custom Event with an interned event name, without hashing the name or allocating memory.
+     *
+     * @param eventID An id returned by EventCustom::internEventName().
+     * @param optionalUserData The optional user data, it's a void*, the default value is nullptr.
+     * @js NA
+     * @since v3.9
+     */
+    void dispatchCustomEvent(EventCustom::ID eventID, void *optionalUserData = nullptr);
+
     /////////////////////////////////////////////
     
     /** Constructor of EventDispatcher.
@@ -202,6 +241,11 @@ protected:
     /** Sets the dirty flag for a node. */
     void setDirtyForNode(Node* node);
     
+    /** Marks the touch bounds of a node as changed, it's safe to call from parallel visits. */
+    void setTouchBoundsDirtyForNode(Node* node);
+    
+    class TouchBoundsIndex;
+    
     /**
      *  The vector to store event listeners with scene graph based priority and fixed priority.
      */
@@ -222,10 +266,13 @@ protected:
         inline std::vector<EventListener*>* getSceneGraphPriorityListeners() const { return _sceneGraphListeners; };
         inline ssize_t getGt0Index() const { return _gt0Index; };
         inline void setGt0Index(ssize_t index) { _gt0Index = index; };
+        inline Node* getSceneGraphRootNode() const { return _sceneGraphRootNode; };
+        inline void setSceneGraphRootNode(Node* rootNode) { _sceneGraphRootNode = rootNode; };
     private:
         std::vector<EventListener*>* _fixedListeners;
         std::vector<EventListener*>* _sceneGraphListeners;
         ssize_t _gt0Index;
+        Node* _sceneGraphRootNode;  // the scene the scene graph listeners were sorted against
     };
     
     /** Adds an event listener with item
@@ -255,6 +302,9 @@ protected:
     /** Sorts the listeners of specified type by scene graph priority */
     void sortEventListenersOfSceneGraphPriority(const EventListener::ListenerID& listenerID, Node* rootNode);
     
+    /** Moves the listeners whose nodes are dirty to their place among the others, which are still sorted */
+    void sortDirtyEventListenersOfSceneGraphPriority(std::vector<EventListener*>* sceneGraphListeners, Node* rootNode, size_t dirtyCount);
+    
     /** Sorts the listeners of specified type by fixed priority */
     void sortEventListenersOfFixedPriority(const EventListener::ListenerID& listenerID);
     
@@ -267,6 +317,9 @@ protected:
     /** Touch event needs to be processed different with other events since it needs support ALL_AT_ONCE and ONE_BY_NONE mode. */
     void dispatchTouchEvent(EventTouch* event);
     
+    /** Dispatches a custom event created with an interned name, it finds the listeners without hashing the name */
+    void dispatchInternedCustomEvent(EventCustom* event);
+    
     /** Associates node with event listener */
     void associateNodeAndEventListener(Node* node, EventListener* listener);
     
@@ -286,6 +339,9 @@ protected:
      */
     void dispatchTouchEventToListeners(EventListenerVector* listeners, const std::function<bool(EventListener*)>& onEvent);
     
+    /** Dispatches a touch, if beganTouch is set the touch bounds index may skip the listeners which can't claim it. */
+    void dispatchTouchEventToListeners(EventListenerVector* listeners, const std::function<bool(EventListener*)>& onEvent, Touch* beganTouch);
+    
     /// Priority dirty flag
     enum class DirtyFlag
     {
@@ -298,6 +354,17 @@ protected:
     /** Sets the dirty flag for a specified listener ID */
     void setDirty(const EventListener::ListenerID& listenerID, DirtyFlag flag);
     
+    /** The listeners and dirty flag of an interned custom event name, valid while _listenerIDsVersion doesn't change */
+    struct InternedListeners
+    {
+        unsigned int version;
+        EventListenerVector* listeners;
+        DirtyFlag* dirtyFlag;
+    };
+    
+    /** Gets the listeners of an interned custom event name, it only looks them up after listener IDs were added or removed */
+    const InternedListeners& getInternedListeners(EventCustom::ID eventID);
+    
     /** Walks though scene graph to get the draw order for each node, it's called before sorting event listener with scene graph priority */
     void visitTarget(Node* node, bool isRootNode);
     
@@ -331,6 +398,15 @@ protected:
     int _nodePriorityIndex;
     
     std::set<std::string> _internalCustomListenerIDs;
+    
+    /** Screen-space bounds of the nodes of bounded one by one touch listeners, nullptr if disabled */
+    TouchBoundsIndex* _touchBoundsIndex;
+    
+    /** Indexed by interned custom event name */
+    std::vector<InternedListeners> _internedListeners;
+    
+    /** Incremented whenever a key is added to or removed from _listenerMap or _priorityDirtyFlagMap */
+    unsigned int _listenerIDsVersion;
 };
 
 
@@ -173,6 +173,7 @@ protected:
     Node* _node;            // scene graph based priority
     bool _paused;           // Whether the listener is paused
     bool _isEnabled;        // Whether the listener is enabled
+    bool _sceneGraphPriorityDirty;  // Whether the node moved in the scene graph since the listeners were sorted
     friend class EventDispatcher;
 };
 
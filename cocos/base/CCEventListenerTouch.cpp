@@ -39,6 +39,7 @@ EventListenerTouchOneByOne::EventListenerTouchOneByOne()
 , onTouchEnded(nullptr)
 , onTouchCancelled(nullptr)
 , _needSwallow(false)
+, _hitAreaBoundedByNode(false)
 {
 }
 
@@ -67,6 +68,12 @@ bool EventListenerTouchOneByOne::isSwallowTouches()
     return _needSwallow;
 }
 
+void EventListenerTouchOneByOne::setHitAreaBoundedByNode(bool bounded)
+{
+    CCASSERT(!isRegistered(), "The hit area has to be declared before the listener is added.");
+    _hitAreaBoundedByNode = bounded;
+}
+
 EventListenerTouchOneByOne* EventListenerTouchOneByOne::create()
 {
     auto ret = new (std::nothrow) EventListenerTouchOneByOne();
@@ -108,6 +115,7 @@ EventListenerTouchOneByOne* EventListenerTouchOneByOne::clone()
         
         ret->_claimedTouches = _claimedTouches;
         ret->_needSwallow = _needSwallow;
+        ret->_hitAreaBoundedByNode = _hitAreaBoundedByNode;
     }
     else
     {
@@ -67,6 +67,22 @@ public:
      * @return True if needs to swall touches.
      */
     bool isSwallowTouches();
+
+    /** Declares that 'onTouchBegan' never claims a touch which starts outside the content
+     * rectangle of the associated node. When EventDispatcher::setTouchBoundsIndexEnabled() is on,
+     * such listeners are only offered touches which start inside the node's screen-space bounds.
+     * It has to be set before the listener is added to the EventDispatcher.
+     *
+     * @param bounded True if the node's content rectangle bounds the touchable area.
+     * @since v3.9
+     */
+    void setHitAreaBoundedByNode(bool bounded);
+    /** Whether the touchable area is bounded by the associated node's content rectangle.
+     *
+     * @return True if touches outside the node's content rectangle are never claimed.
+     * @since v3.9
+     */
+    bool isHitAreaBoundedByNode() const { return _hitAreaBoundedByNode; }
     
     /// Overrides
     virtual EventListenerTouchOneByOne* clone() override;
@@ -90,6 +106,7 @@ CC_CONSTRUCTOR_ACCESS:
 private:
     std::vector<Touch*> _claimedTouches;
     bool _needSwallow;
+    bool _hitAreaBoundedByNode;
     
     friend class EventDispatcher;
 };
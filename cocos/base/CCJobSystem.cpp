@@ -0,0 +1,303 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "base/CCJobSystem.h"
+
+#include <algorithm>
+
+#include "base/CCDirector.h"
+#include "base/CCScheduler.h"
+#include "base/ccMacros.h"
+
+NS_CC_BEGIN
+
+std::atomic<JobSystem*> JobSystem::s_jobSystem(nullptr);
+std::mutex JobSystem::s_instanceMutex;
+
+JobSystem::Job::Job()
+: _priority(Priority::NORMAL)
+, _pendingDependencies(1)
+, _cancelled(false)
+, _done(false)
+{
+}
+
+bool JobSystem::Job::isDone() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _done;
+}
+
+JobSystem* JobSystem::getInstance()
+{
+    // jobs may be scheduled from any thread, the first call creates the instance only once
+    JobSystem* jobSystem = s_jobSystem.load(std::memory_order_acquire);
+    if (jobSystem == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(s_instanceMutex);
+        jobSystem = s_jobSystem.load(std::memory_order_relaxed);
+        if (jobSystem == nullptr)
+        {
+            // hardware_concurrency() may return 0 if it is not computable.
+            // Keep two threads at least, tasks blocked on IO should not stop the others.
+            int cores = (int)std::thread::hardware_concurrency();
+            jobSystem = new (std::nothrow) JobSystem(std::max(cores - 1, 2));
+            s_jobSystem.store(jobSystem, std::memory_order_release);
+        }
+    }
+    return jobSystem;
+}
+
+void JobSystem::destroyInstance()
+{
+    JobSystem* jobSystem = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(s_instanceMutex);
+        jobSystem = s_jobSystem.exchange(nullptr);
+    }
+    // deleted without the lock, it waits for the running tasks
+    delete jobSystem;
+}
+
+JobSystem::JobSystem(int workerCount)
+: _nextWorker(0)
+, _queuedJobs(0)
+, _stop(false)
+{
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers.push_back(std::unique_ptr<Worker>(new (std::nothrow) Worker()));
+    }
+    // start the threads once all the workers exist, they steal from each other
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop = true;
+    }
+    _sleepCondition.notify_all();
+    for (auto& worker : _workers)
+    {
+        worker->thread.join();
+    }
+    
+    // Cancel the jobs left, finishing them enqueues their dependents which are cancelled in turn.
+    // Nothing runs anymore, so the queues can be accessed without locking.
+    bool found = true;
+    while (found)
+    {
+        found = false;
+        for (auto& worker : _workers)
+        {
+            for (auto& queue : worker->queues)
+            {
+                while (!queue.empty())
+                {
+                    auto job = queue.front();
+                    queue.pop_front();
+                    job->cancel();
+                    finish(job);
+                    found = true;
+                }
+            }
+        }
+    }
+}
+
+JobSystem::JobHandle JobSystem::schedule(const std::function<void()>& task,
+                                         const std::function<void()>& continuation,
+                                         Priority priority,
+                                         const std::vector<JobHandle>& dependencies)
+{
+    CCASSERT(task, "JobSystem::schedule: task must be non-nullptr");
+    
+    JobHandle job(new (std::nothrow) Job());
+    job->_task = task;
+    job->_continuation = continuation;
+    job->_priority = priority;
+    
+    for (const auto& dependency : dependencies)
+    {
+        std::lock_guard<std::mutex> lock(dependency->_mutex);
+        if (!dependency->_done)
+        {
+            ++job->_pendingDependencies;
+            dependency->_dependents.push_back(job);
+        }
+    }
+    
+    // release the reference held while scheduling
+    if (--job->_pendingDependencies == 0)
+    {
+        enqueue(job);
+    }
+    return job;
+}
+
+void JobSystem::wait(const JobHandle& job)
+{
+    CCASSERT(getCurrentWorkerIndex() < 0, "JobSystem::wait should not be called from a task");
+    
+    std::unique_lock<std::mutex> lock(job->_mutex);
+    job->_doneCondition.wait(lock, [&job]{ return job->_done; });
+}
+
+int JobSystem::getCurrentWorkerIndex() const
+{
+    const auto threadId = std::this_thread::get_id();
+    for (size_t i = 0; i < _workers.size(); ++i)
+    {
+        if (_workers[i]->thread.get_id() == threadId)
+            return (int)i;
+    }
+    return -1;
+}
+
+void JobSystem::enqueue(const JobHandle& job)
+{
+    // jobs scheduled from a task stay on its thread, unless they get stolen
+    int index = getCurrentWorkerIndex();
+    if (index < 0)
+    {
+        index = (int)(_nextWorker++ % _workers.size());
+    }
+    
+    auto& worker = *_workers[index];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queues[(int)job->_priority].push_back(job);
+    }
+    {
+        // counting under the lock makes sure a worker going to sleep sees the job
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        ++_queuedJobs;
+    }
+    _sleepCondition.notify_one();
+}
+
+JobSystem::JobHandle JobSystem::pickJob(int workerIndex)
+{
+    if (_queuedJobs <= 0)
+        return nullptr;
+    
+    const int workerCount = (int)_workers.size();
+    for (int priority = 0; priority < (int)Priority::COUNT; ++priority)
+    {
+        // its own queue first, in order, then steal the most recent job of another worker
+        for (int i = 0; i < workerCount; ++i)
+        {
+            auto& worker = *_workers[(workerIndex + i) % workerCount];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            auto& queue = worker.queues[priority];
+            if (!queue.empty())
+            {
+                JobHandle job;
+                if (i == 0)
+                {
+                    job = std::move(queue.front());
+                    queue.pop_front();
+                }
+                else
+                {
+                    job = std::move(queue.back());
+                    queue.pop_back();
+                }
+                --_queuedJobs;
+                return job;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::workerLoop(int workerIndex)
+{
+    for (;;)
+    {
+        // once stopping, the jobs left in the queues are cancelled by the destructor
+        if (_stop)
+            return;
+        
+        auto job = pickJob(workerIndex);
+        if (job)
+        {
+            run(job);
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepCondition.wait(lock, [this]{ return _stop || _queuedJobs > 0; });
+        if (_stop)
+            return;
+    }
+}
+
+void JobSystem::run(const JobHandle& job)
+{
+    if (!job->_cancelled)
+    {
+        job->_task();
+    }
+    // release what the task captured now, the handle may be kept for a long time
+    job->_task = nullptr;
+    
+    finish(job);
+}
+
+void JobSystem::finish(const JobHandle& job)
+{
+    std::vector<JobHandle> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->_mutex);
+        job->_done = true;
+        dependents.swap(job->_dependents);
+    }
+    job->_doneCondition.notify_all();
+    
+    if (job->_continuation)
+    {
+        if (!job->_cancelled)
+        {
+            Director::getInstance()->getScheduler()->performFunctionInCocosThread(job->_continuation);
+        }
+        job->_continuation = nullptr;
+    }
+    
+    for (const auto& dependent : dependents)
+    {
+        if (--dependent->_pendingDependencies == 0)
+        {
+            enqueue(dependent);
+        }
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,181 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#ifndef __CCJOB_SYSTEM_H_
+#define __CCJOB_SYSTEM_H_
+
+#include "platform/CCPlatformMacros.h"
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/**
+* @addtogroup base
+* @{
+*/
+NS_CC_BEGIN
+
+/**
+ * @class JobSystem
+ * @brief Runs background jobs on a thread per core. Every thread has its own queues, and steals jobs
+ * from the other threads when they are empty, so a burst of jobs is spread over all the cores.
+ * Jobs have a priority, can depend on other jobs, and can have a continuation performed in the cocos thread.
+ * AsyncTaskPool, the asynchronous texture loading and the audio preloading run on it.
+ * @js NA
+ * @lua NA
+ */
+class CC_DLL JobSystem
+{
+public:
+    /** Jobs of higher priority are picked first, jobs of the same priority in the order they were scheduled. */
+    enum class Priority
+    {
+        HIGH,
+        NORMAL,
+        LOW,
+        COUNT,
+    };
+    
+    /**
+     * @class Job
+     * @brief A job scheduled with JobSystem::schedule.
+     */
+    class CC_DLL Job
+    {
+    public:
+        /** Returns true once the task ran or was skipped because the job was cancelled. */
+        bool isDone() const;
+        
+        /**
+         * Cancels the job: its task is skipped if it did not start yet, and its continuation is not performed.
+         * The jobs depending on it still run once it is done.
+         */
+        void cancel() { _cancelled = true; }
+        
+        /** Returns true if the job was cancelled. */
+        bool isCancelled() const { return _cancelled; }
+        
+    CC_CONSTRUCTOR_ACCESS:
+        Job();
+        
+    protected:
+        friend class JobSystem;
+        
+        std::function<void()> _task;
+        std::function<void()> _continuation;
+        Priority _priority;
+        // dependencies not done yet, plus one while the job is being scheduled
+        std::atomic<int> _pendingDependencies;
+        std::atomic<bool> _cancelled;
+        
+        // protected by _mutex
+        std::vector<std::shared_ptr<Job>> _dependents;
+        bool _done;
+        mutable std::mutex _mutex;
+        std::condition_variable _doneCondition;
+    };
+    
+    typedef std::shared_ptr<Job> JobHandle;
+    
+    /**
+     * Returns the shared instance of the job system, it has one thread less than the number of cores, and at least two.
+     */
+    static JobSystem* getInstance();
+    
+    /**
+     * Destroys the job system. The jobs that did not start are cancelled, the running ones are waited for.
+     */
+    static void destroyInstance();
+    
+    /** Returns the number of threads running the jobs. */
+    int getWorkerCount() const { return (int)_workers.size(); }
+    
+    /**
+     * Schedules a task. It can be called from any thread, including from a task.
+     *
+     * @param task The function run on one of the job threads.
+     * @param continuation Function performed in the cocos thread once the task ran, can be nullptr.
+     * @param priority Priority of the job.
+     * @param dependencies Jobs that must be done before the task starts.
+     * @return The job, to cancel it, wait for it or to depend on it.
+     */
+    JobHandle schedule(const std::function<void()>& task,
+                       const std::function<void()>& continuation = nullptr,
+                       Priority priority = Priority::NORMAL,
+                       const std::vector<JobHandle>& dependencies = std::vector<JobHandle>());
+    
+    /**
+     * Blocks until the job is done. It should not be called from a task.
+     */
+    void wait(const JobHandle& job);
+    
+CC_CONSTRUCTOR_ACCESS:
+    JobSystem(int workerCount);
+    ~JobSystem();
+    
+protected:
+    struct Worker
+    {
+        // one queue per priority, protected by mutex
+        std::deque<JobHandle> queues[(int)Priority::COUNT];
+        std::mutex mutex;
+        std::thread thread;
+    };
+    
+    void workerLoop(int workerIndex);
+    // queues a job whose dependencies are done
+    void enqueue(const JobHandle& job);
+    // pops a job from the queues of the worker, or steals one from the other workers
+    JobHandle pickJob(int workerIndex);
+    void run(const JobHandle& job);
+    // marks the job done and enqueues the dependents that were waiting for it
+    void finish(const JobHandle& job);
+    // index of the worker running on the calling thread, -1 if it is not a job thread
+    int getCurrentWorkerIndex() const;
+    
+    std::vector<std::unique_ptr<Worker>> _workers;
+    // jobs scheduled from other threads are spread over the workers
+    std::atomic<unsigned int> _nextWorker;
+    // jobs in the queues, never more than the actual number
+    std::atomic<int> _queuedJobs;
+    
+    // idle workers sleep on _sleepCondition
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+    std::atomic<bool> _stop;
+    
+    static std::atomic<JobSystem*> s_jobSystem;
+    static std::mutex s_instanceMutex;
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CCJOB_SYSTEM_H_
@@ -26,47 +26,26 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "base/CCScheduler.h"
+
+#include <algorithm>
+
 #include "base/ccMacros.h"
 #include "base/CCDirector.h"
-#include "base/utlist.h"
-#include "base/ccCArray.h"
 #include "base/CCScriptSupport.h"
 
 NS_CC_BEGIN
 
-// data structures
-
-// A list double-linked list used for "updates with priority"
-typedef struct _listEntry
-{
-    struct _listEntry   *prev, *next;
-    ccSchedulerFunc     callback;
-    void                *target;
-    int                 priority;
-    bool                paused;
-    bool                markedForDeletion; // selector will no longer be called and entry will be removed at end of the next tick
-} tListEntry;
-
-typedef struct _hashUpdateEntry
-{
-    tListEntry          **list;        // Which list does it belong to ?
-    tListEntry          *entry;        // entry in the list
-    void                *target;
-    ccSchedulerFunc     callback;
-    UT_hash_handle      hh;
-} tHashUpdateEntry;
-
-// Hash Element used for "selectors with interval"
-typedef struct _hashSelectorEntry
-{
-    ccArray             *timers;
-    void                *target;
-    int                 timerIndex;
-    Timer               *currentTimer;
-    bool                currentTimerSalvaged;
-    bool                paused;
-    UT_hash_handle      hh;
-} tHashTimerEntry;
+// Timers whose next trigger is at least this far away, in seconds, are moved to the timing wheel
+static const float TIMER_WHEEL_MIN_DELAY = 0.25f;
+// Duration of a timing wheel tick, in seconds
+static const double TIMER_WHEEL_TICK = 1.0 / 64;
+static const int TIMER_WHEEL_BITS = 6;
+static const int TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_BITS;
+static const int TIMER_WHEEL_LEVELS = 4;
+static const int TIMER_WHEEL_IMMINENT_BUCKET = TIMER_WHEEL_SLOTS * TIMER_WHEEL_LEVELS;
+// Timer::_wheelBucket values when the timer is not in a bucket
+static const int TIMER_NOT_IN_WHEEL = -1;
+static const int TIMER_WHEEL_FIRING = -2;
 
 // implementation Timer
 
@@ -79,6 +58,10 @@ Timer::Timer()
 , _repeat(0)
 , _delay(0.0f)
 , _interval(0.0f)
+, _wheelBucket(TIMER_NOT_IN_WHEEL)
+, _wheelIndex(0)
+, _wheelDueTime(0.0)
+, _wheelLastUpdate(0.0)
 {
 }
 
@@ -144,6 +127,21 @@ void Timer::update(float dt)
     }
 }
 
+float Timer::getTimeToNextTrigger() const
+{
+    if (_elapsed == -1)
+    {
+        return 0.0f;
+    }
+
+    if (_useDelay)
+    {
+        return _delay - _elapsed;
+    }
+
+    return (_interval > 0) ? _interval - _elapsed : 0.0f;
+}
+
 // TimerTargetSelector
 
 TimerTargetSelector::TimerTargetSelector()
@@ -245,86 +243,339 @@ const int Scheduler::PRIORITY_NON_SYSTEM_MIN = PRIORITY_SYSTEM + 1;
 
 Scheduler::Scheduler(void)
 : _timeScale(1.0f)
-, _updatesNegList(nullptr)
-, _updates0List(nullptr)
-, _updatesPosList(nullptr)
-, _hashForUpdates(nullptr)
-, _hashForTimers(nullptr)
-, _currentTarget(nullptr)
-, _currentTargetSalvaged(false)
+, _updatesMarkedForDeletion(0)
+, _timerWheel(TIMER_WHEEL_IMMINENT_BUCKET + 1)
+, _timerWheelTime(0.0)
+, _timerWheelTick(0)
 , _updateHashLocked(false)
 #if CC_ENABLE_SCRIPT_BINDING
 , _scriptHandlerEntries(20)
 #endif
 {
-    // I don't expect to have more than 30 functions to all per frame
-    _functionsToPerform.reserve(30);
+    _performTail = new (std::nothrow) PerformNode();
+    _performHead.store(_performTail);
+    _performQueueDepth.store(0);
+    _performBudget = 0;
+    _performTimeBudget = 0;
+    _performStats = { 0, 0, 0, 0 };
 }
 
 Scheduler::~Scheduler(void)
 {
     unscheduleAll();
+
+    // functions not performed yet are dropped
+    while (_performTail)
+    {
+        auto next = _performTail->next.load(std::memory_order_acquire);
+        delete _performTail;
+        _performTail = next;
+    }
 }
 
-void Scheduler::removeHashElement(_hashSelectorEntry *element)
+Scheduler::SlotIndex Scheduler::getTimerTargetSlot(void *target, bool paused)
 {
-    ccArrayFree(element->timers);
-    HASH_DEL(_hashForTimers, element);
-    free(element);
+    auto iter = _timerSlotsByTarget.find(target);
+    if (iter != _timerSlotsByTarget.end())
+    {
+        CCASSERT(_timerTargets[iter->second].paused == paused, "element's paused should be paused!");
+        return iter->second;
+    }
+
+    SlotIndex slot;
+    if (_freeTimerTargetSlots.empty())
+    {
+        slot = static_cast<SlotIndex>(_timerTargets.size());
+        _timerTargets.emplace_back();
+    }
+    else
+    {
+        slot = _freeTimerTargetSlots.back();
+        _freeTimerTargetSlots.pop_back();
+    }
+
+    auto& element = _timerTargets[slot];
+    element.target = target;
+    // Is this the 1st element ? Then set the pause level to all the selectors of this target
+    element.wheelTimers = 0;
+    element.paused = paused;
+    element.hasRemovedTimers = false;
+
+    _timerSlotsByTarget.emplace(target, slot);
+    return slot;
 }
 
-void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, bool paused, const std::string& key)
+void Scheduler::removeTimerAt(SlotIndex slot, size_t index)
 {
-    this->schedule(callback, target, interval, CC_REPEAT_FOREVER, 0.0f, paused, key);
+    auto& element = _timerTargets[slot];
+    Timer* timer = element.timers[index];
+
+    if (timer->_wheelBucket != TIMER_NOT_IN_WHEEL)
+    {
+        removeFromTimerWheel(timer, slot, false);
+    }
+
+    if (_updateHashLocked)
+    {
+        // The timer may be the one being ticked, keep it alive and leave a hole
+        // so the indices used by the tick loop stay valid.
+        element.timers[index] = nullptr;
+        _salvagedTimers.push_back(timer);
+
+        if (!element.hasRemovedTimers)
+        {
+            element.hasRemovedTimers = true;
+            _timerTargetsToCompact.push_back(slot);
+        }
+    }
+    else
+    {
+        element.timers.erase(element.timers.begin() + index);
+        if (element.timers.empty())
+        {
+            removeTimerTarget(slot);
+        }
+
+        // last, releasing the timer may add targets
+        timer->release();
+    }
 }
 
-void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, unsigned int repeat, float delay, bool paused, const std::string& key)
+void Scheduler::removeTimerTarget(SlotIndex slot)
 {
-    CCASSERT(target, "Argument target must be non-nullptr");
-    CCASSERT(!key.empty(), "key should not be empty!");
+    auto& element = _timerTargets[slot];
+    _timerSlotsByTarget.erase(element.target);
+
+    element.timers.clear();
+    element.target = nullptr;
+    element.paused = false;
+    element.hasRemovedTimers = false;
+    _freeTimerTargetSlots.push_back(slot);
+}
 
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
+void Scheduler::removeSalvagedTimers()
+{
+    for (const auto slot : _timerTargetsToCompact)
+    {
+        auto& element = _timerTargets[slot];
+        element.hasRemovedTimers = false;
+        element.timers.erase(std::remove(element.timers.begin(), element.timers.end(), nullptr), element.timers.end());
+
+        // only delete the target if no timers were scheduled during the cycle (issue #481)
+        if (element.timers.empty())
+        {
+            removeTimerTarget(slot);
+        }
+    }
+    _timerTargetsToCompact.clear();
 
-    if (! element)
+    // The timers told the scheduler to remove them during their step. Now that
+    // the step is done, it's safe to release them.
+    auto salvaged = std::move(_salvagedTimers);
+    _salvagedTimers.clear();
+    for (auto timer : salvaged)
     {
-        element = (tHashTimerEntry *)calloc(sizeof(*element), 1);
-        element->target = target;
+        timer->release();
+    }
+}
 
-        HASH_ADD_PTR(_hashForTimers, target, element);
+void Scheduler::insertInTimerWheel(Timer *timer, SlotIndex targetSlot)
+{
+    timer->_wheelLastUpdate = _timerWheelTime;
+    timer->_wheelDueTime = _timerWheelTime + timer->getTimeToNextTrigger();
+    addToTimerWheelBucket({timer, targetSlot});
+    ++_timerTargets[targetSlot].wheelTimers;
+}
+
+void Scheduler::addToTimerWheelBucket(const TimerWheelEntry& entry)
+{
+    Timer* timer = entry.timer;
+    uint64_t dueTick = static_cast<uint64_t>(timer->_wheelDueTime / TIMER_WHEEL_TICK);
+    int bucket = TIMER_WHEEL_IMMINENT_BUCKET;
+
+    if (dueTick > _timerWheelTick)
+    {
+        const uint64_t maxDelta = (static_cast<uint64_t>(1) << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1;
+        uint64_t delta = dueTick - _timerWheelTick;
+        if (delta > maxDelta)
+        {
+            // farther than the wheel can hold, it will be cascaded again when reached
+            delta = maxDelta;
+            dueTick = _timerWheelTick + delta;
+        }
 
-        // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        element->paused = paused;
+        int level = 0;
+        while ((delta >> (TIMER_WHEEL_BITS * (level + 1))) != 0)
+        {
+            ++level;
+        }
+        bucket = level * TIMER_WHEEL_SLOTS + static_cast<int>((dueTick >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
     }
-    else
+
+    auto& entries = _timerWheel[bucket];
+    timer->_wheelBucket = bucket;
+    timer->_wheelIndex = static_cast<unsigned int>(entries.size());
+    entries.push_back(entry);
+}
+
+void Scheduler::removeFromTimerWheel(Timer *timer, SlotIndex targetSlot, bool keepElapsed)
+{
+    if (timer->_wheelBucket >= 0)
     {
-        CCASSERT(element->paused == paused, "element's paused should be paused!");
+        auto& entries = _timerWheel[timer->_wheelBucket];
+        const unsigned int index = timer->_wheelIndex;
+        entries[index] = entries.back();
+        entries[index].timer->_wheelIndex = index;
+        entries.pop_back();
     }
+    // else the timer is in _dueTimers, advanceTimerWheel skips it
 
-    if (element->timers == nullptr)
+    if (keepElapsed)
     {
-        element->timers = ccArrayNew(10);
+        timer->_elapsed += static_cast<float>(_timerWheelTime - timer->_wheelLastUpdate);
     }
-    else 
+
+    timer->_wheelBucket = TIMER_NOT_IN_WHEEL;
+    --_timerTargets[targetSlot].wheelTimers;
+}
+
+void Scheduler::removeTargetFromTimerWheel(SlotIndex targetSlot)
+{
+    auto& element = _timerTargets[targetSlot];
+    for (size_t i = 0; element.wheelTimers > 0 && i < element.timers.size(); ++i)
     {
-        for (int i = 0; i < element->timers->num; ++i)
+        Timer* timer = element.timers[i];
+        if (timer && timer->_wheelBucket != TIMER_NOT_IN_WHEEL)
         {
-            TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(element->timers->arr[i]);
+            removeFromTimerWheel(timer, targetSlot, true);
+        }
+    }
+}
 
-            if (timer && key == timer->getKey())
+void Scheduler::advanceTimerWheel()
+{
+    const uint64_t currentTick = static_cast<uint64_t>(_timerWheelTime / TIMER_WHEEL_TICK);
+
+    auto collectDue = [this](std::vector<TimerWheelEntry>& entries) {
+        for (const auto& entry : entries)
+        {
+            if (entry.timer->_wheelDueTime <= _timerWheelTime)
             {
-                CCLOG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
-                timer->setInterval(interval);
-                return;
-            }        
+                entry.timer->_wheelBucket = TIMER_WHEEL_FIRING;
+                _dueTimers.push_back(entry);
+            }
+            else
+            {
+                addToTimerWheelBucket(entry);
+            }
+        }
+    };
+
+    std::vector<TimerWheelEntry> entries;
+    while (_timerWheelTick < currentTick)
+    {
+        ++_timerWheelTick;
+
+        // when a level wraps, move the timers of the next bucket of the level above to the lower levels
+        int level = 1;
+        while (level < TIMER_WHEEL_LEVELS
+               && (_timerWheelTick & ((static_cast<uint64_t>(1) << (TIMER_WHEEL_BITS * level)) - 1)) == 0)
+        {
+            ++level;
+        }
+        for (--level; level > 0; --level)
+        {
+            const int slot = static_cast<int>((_timerWheelTick >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
+            entries.clear();
+            entries.swap(_timerWheel[level * TIMER_WHEEL_SLOTS + slot]);
+            for (const auto& entry : entries)
+            {
+                addToTimerWheelBucket(entry);
+            }
+        }
+
+        // timers of the bucket are due in this tick, but maybe later than _timerWheelTime
+        entries.clear();
+        entries.swap(_timerWheel[_timerWheelTick & (TIMER_WHEEL_SLOTS - 1)]);
+        collectDue(entries);
+    }
+
+    if (!_timerWheel[TIMER_WHEEL_IMMINENT_BUCKET].empty())
+    {
+        entries.clear();
+        entries.swap(_timerWheel[TIMER_WHEEL_IMMINENT_BUCKET]);
+        collectDue(entries);
+    }
+
+    // callbacks may unschedule or pause the timers that are still to be fired,
+    // removeFromTimerWheel() resets their bucket
+    entries.clear();
+    entries.swap(_dueTimers);
+    for (const auto& entry : entries)
+    {
+        Timer* timer = entry.timer;
+        if (timer->_wheelBucket != TIMER_WHEEL_FIRING)
+        {
+            continue;
+        }
+
+        timer->update(static_cast<float>(_timerWheelTime - timer->_wheelLastUpdate));
+
+        if (timer->_wheelBucket != TIMER_WHEEL_FIRING)
+        {
+            // unscheduled by its callback
+            continue;
+        }
+
+        if (timer->getTimeToNextTrigger() >= TIMER_WHEEL_MIN_DELAY)
+        {
+            timer->_wheelLastUpdate = _timerWheelTime;
+            timer->_wheelDueTime = _timerWheelTime + timer->getTimeToNextTrigger();
+            addToTimerWheelBucket(entry);
+        }
+        else
+        {
+            // the interval was changed, update it every frame again
+            timer->_wheelBucket = TIMER_NOT_IN_WHEEL;
+            --_timerTargets[entry.targetSlot].wheelTimers;
         }
-        ccArrayEnsureExtraCapacity(element->timers, 1);
     }
+}
+
+void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, bool paused, const std::string& key)
+{
+    this->schedule(callback, target, interval, CC_REPEAT_FOREVER, 0.0f, paused, key);
+}
+
+void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, unsigned int repeat, float delay, bool paused, const std::string& key)
+{
+    CCASSERT(target, "Argument target must be non-nullptr");
+    CCASSERT(!key.empty(), "key should not be empty!");
+
+    const SlotIndex slot = getTimerTargetSlot(target, paused);
+    auto& element = _timerTargets[slot];
+
+    for (auto t : element.timers)
+    {
+        TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(t);
 
+        if (timer && key == timer->getKey())
+        {
+            CCLOG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
+            timer->setInterval(interval);
+            if (timer->_wheelBucket != TIMER_NOT_IN_WHEEL)
+            {
+                // its due time changed
+                removeFromTimerWheel(timer, slot, true);
+            }
+            return;
+        }
+    }
+
+    // the store owns the reference returned by new
     TimerTargetCallback *timer = new (std::nothrow) TimerTargetCallback();
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
-    ccArrayAppendObject(element->timers, timer);
-    timer->release();
+    element.timers.push_back(timer);
 }
 
 void Scheduler::unschedule(const std::string &key, void *target)
@@ -335,173 +586,140 @@ void Scheduler::unschedule(const std::string &key, void *target)
         return;
     }
 
-    //CCASSERT(target);
-    //CCASSERT(selector);
-
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-
-    if (element)
+    auto iter = _timerSlotsByTarget.find(target);
+    if (iter != _timerSlotsByTarget.end())
     {
-        for (int i = 0; i < element->timers->num; ++i)
+        auto& timers = _timerTargets[iter->second].timers;
+        for (size_t i = 0, count = timers.size(); i < count; ++i)
         {
-            TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(element->timers->arr[i]);
+            TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(timers[i]);
 
             if (timer && key == timer->getKey())
             {
-                if (timer == element->currentTimer && (! element->currentTimerSalvaged))
-                {
-                    element->currentTimer->retain();
-                    element->currentTimerSalvaged = true;
-                }
-
-                ccArrayRemoveObjectAtIndex(element->timers, i, true);
-
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (element->timerIndex >= i)
-                {
-                    element->timerIndex--;
-                }
-
-                if (element->timers->num == 0)
-                {
-                    if (_currentTarget == element)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        removeHashElement(element);
-                    }
-                }
-
+                removeTimerAt(iter->second, i);
                 return;
             }
         }
     }
 }
 
-void Scheduler::priorityIn(tListEntry **list, const ccSchedulerFunc& callback, void *target, int priority, bool paused)
+void Scheduler::insertUpdateInOrder(SlotIndex slot)
 {
-    tListEntry *listElement = new tListEntry();
+    const int priority = _updateEntries[slot].priority;
 
-    listElement->callback = callback;
-    listElement->target = target;
-    listElement->priority = priority;
-    listElement->paused = paused;
-    listElement->next = listElement->prev = nullptr;
-    listElement->markedForDeletion = false;
+    // most of the updates are going to be 0 and are appended at the end of their priority range
+    auto position = std::upper_bound(_updateOrder.begin(), _updateOrder.end(), priority,
+                                     [this](int p, SlotIndex other) { return p < _updateEntries[other].priority; });
+    _updateOrder.insert(position, slot);
+}
+
+void Scheduler::freeUpdateSlot(SlotIndex slot)
+{
+    auto& entry = _updateEntries[slot];
 
-    // empty list ?
-    if (! *list)
+    // the target may have been scheduled again in a new slot
+    auto iter = _updateSlotsByTarget.find(entry.target);
+    if (iter != _updateSlotsByTarget.end() && iter->second == slot)
     {
-        DL_APPEND(*list, listElement);
+        _updateSlotsByTarget.erase(iter);
     }
-    else
-    {
-        bool added = false;
 
-        for (tListEntry *element = *list; element; element = element->next)
-        {
-            if (priority < element->priority)
-            {
-                if (element == *list)
-                {
-                    DL_PREPEND(*list, listElement);
-                }
-                else
-                {
-                    listElement->next = element;
-                    listElement->prev = element->prev;
-
-                    element->prev->next = listElement;
-                    element->prev = listElement;
-                }
+    entry.callback = nullptr;
+    entry.target = nullptr;
+    _freeUpdateSlots.push_back(slot);
+}
 
-                added = true;
-                break;
-            }
+void Scheduler::removeMarkedUpdates()
+{
+    // releasing a callback may schedule other updates, don't iterate the member directly
+    std::vector<SlotIndex> slotsToInsert;
+    slotsToInsert.swap(_updatesToInsert);
+    for (const auto slot : slotsToInsert)
+    {
+        if (_updateEntries[slot].markedForDeletion)
+        {
+            freeUpdateSlot(slot);
+            --_updatesMarkedForDeletion;
         }
-
-        // Not added? priority has the higher value. Append it.
-        if (! added)
+        else
         {
-            DL_APPEND(*list, listElement);
+            insertUpdateInOrder(slot);
         }
     }
 
-    // update hash entry for quick access
-    tHashUpdateEntry *hashElement = (tHashUpdateEntry *)calloc(sizeof(*hashElement), 1);
-    hashElement->target = target;
-    hashElement->list = list;
-    hashElement->entry = listElement;
-    HASH_ADD_PTR(_hashForUpdates, target, hashElement);
-}
-
-void Scheduler::appendIn(_listEntry **list, const ccSchedulerFunc& callback, void *target, bool paused)
-{
-    tListEntry *listElement = new tListEntry();
-
-    listElement->callback = callback;
-    listElement->target = target;
-    listElement->paused = paused;
-    listElement->priority = 0;
-    listElement->markedForDeletion = false;
-
-    DL_APPEND(*list, listElement);
-
-    // update hash entry for quicker access
-    tHashUpdateEntry *hashElement = (tHashUpdateEntry *)calloc(sizeof(*hashElement), 1);
-    hashElement->target = target;
-    hashElement->list = list;
-    hashElement->entry = listElement;
-    HASH_ADD_PTR(_hashForUpdates, target, hashElement);
+    if (_updatesMarkedForDeletion > 0)
+    {
+        auto last = std::remove_if(_updateOrder.begin(), _updateOrder.end(), [this](SlotIndex slot) {
+            if (!_updateEntries[slot].markedForDeletion)
+                return false;
+
+            freeUpdateSlot(slot);
+            --_updatesMarkedForDeletion;
+            return true;
+        });
+        _updateOrder.erase(last, _updateOrder.end());
+    }
 }
 
 void Scheduler::schedulePerFrame(const ccSchedulerFunc& callback, void *target, int priority, bool paused)
 {
-    tHashUpdateEntry *hashElement = nullptr;
-    HASH_FIND_PTR(_hashForUpdates, &target, hashElement);
-    if (hashElement)
+    auto iter = _updateSlotsByTarget.find(target);
+    if (iter != _updateSlotsByTarget.end())
     {
+        auto& entry = _updateEntries[iter->second];
+
         // check if priority has changed
-        if ((*hashElement->list)->priority != priority)
+        if (entry.priority != priority && !_updateHashLocked)
+        {
+            // will be added again below
+            unscheduleUpdate(target);
+        }
+        else
         {
-            if (_updateHashLocked)
+            if (entry.priority != priority)
             {
                 CCLOG("warning: you CANNOT change update priority in scheduled function");
-                hashElement->entry->markedForDeletion = false;
-                hashElement->entry->paused = paused;
-                return;
             }
-            else
+
+            if (entry.markedForDeletion)
             {
-            	// will be added again outside if (hashElement).
-                unscheduleUpdate(target);
+                entry.markedForDeletion = false;
+                --_updatesMarkedForDeletion;
             }
-        }
-        else
-        {
-            hashElement->entry->markedForDeletion = false;
-            hashElement->entry->paused = paused;
+            entry.paused = paused;
             return;
         }
     }
 
-    // most of the updates are going to be 0, that's way there
-    // is an special list for updates with priority 0
-    if (priority == 0)
+    SlotIndex slot;
+    if (_freeUpdateSlots.empty())
+    {
+        slot = static_cast<SlotIndex>(_updateEntries.size());
+        _updateEntries.emplace_back();
+    }
+    else
     {
-        appendIn(&_updates0List, callback, target, paused);
+        slot = _freeUpdateSlots.back();
+        _freeUpdateSlots.pop_back();
     }
-    else if (priority < 0)
+
+    auto& entry = _updateEntries[slot];
+    entry.callback = callback;
+    entry.target = target;
+    entry.priority = priority;
+    entry.paused = paused;
+    entry.markedForDeletion = false;
+
+    _updateSlotsByTarget[target] = slot;
+
+    if (_updateHashLocked)
     {
-        priorityIn(&_updatesNegList, callback, target, priority, paused);
+        // _updateOrder is being iterated, the entry will be called from the next tick
+        _updatesToInsert.push_back(slot);
     }
     else
     {
-        // priority > 0
-        priorityIn(&_updatesPosList, callback, target, priority, paused);
+        insertUpdateInOrder(slot);
     }
 }
 
@@ -509,52 +727,24 @@ bool Scheduler::isScheduled(const std::string& key, void *target)
 {
     CCASSERT(!key.empty(), "Argument key must not be empty");
     CCASSERT(target, "Argument target must be non-nullptr");
-    
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    
-    if (!element)
-    {
-        return false;
-    }
-    
-    if (element->timers == nullptr)
+
+    auto iter = _timerSlotsByTarget.find(target);
+    if (iter == _timerSlotsByTarget.end())
     {
         return false;
     }
-    else
+
+    for (auto t : _timerTargets[iter->second].timers)
     {
-        for (int i = 0; i < element->timers->num; ++i)
+        TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(t);
+
+        if (timer && key == timer->getKey())
         {
-            TimerTargetCallback *timer = dynamic_cast<TimerTargetCallback*>(element->timers->arr[i]);
-            
-            if (timer && key == timer->getKey())
-            {
-                return true;
-            }
+            return true;
         }
-        
-        return false;
     }
-    
-    return false;  // should never get here
-}
-
-void Scheduler::removeUpdateFromHash(struct _listEntry *entry)
-{
-    tHashUpdateEntry *element = nullptr;
-
-    HASH_FIND_PTR(_hashForUpdates, &entry->target, element);
-    if (element)
-    {
-        // list entry
-        DL_DELETE(*element->list, element->entry);
-        CC_SAFE_DELETE(element->entry);
 
-        // hash entry
-        HASH_DEL(_hashForUpdates, element);
-        free(element);
-    }
+    return false;
 }
 
 void Scheduler::unscheduleUpdate(void *target)
@@ -564,17 +754,25 @@ void Scheduler::unscheduleUpdate(void *target)
         return;
     }
 
-    tHashUpdateEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForUpdates, &target, element);
-    if (element)
+    auto iter = _updateSlotsByTarget.find(target);
+    if (iter != _updateSlotsByTarget.end())
     {
-        if (_updateHashLocked)
+        auto& entry = _updateEntries[iter->second];
+        if (entry.markedForDeletion)
         {
-            element->entry->markedForDeletion = true;
+            return;
         }
-        else
+
+        // The slot is only reclaimed at the end of the next tick, so this is O(1).
+        entry.markedForDeletion = true;
+        ++_updatesMarkedForDeletion;
+
+        if (!_updateHashLocked)
         {
-            this->removeUpdateFromHash(element->entry);
+            // Not iterating: the target can be forgotten right away, scheduling
+            // it again will use a new slot.
+            entry.callback = nullptr;
+            _updateSlotsByTarget.erase(iter);
         }
     }
 }
@@ -587,45 +785,35 @@ void Scheduler::unscheduleAll(void)
 void Scheduler::unscheduleAllWithMinPriority(int minPriority)
 {
     // Custom Selectors
-    tHashTimerEntry *element = nullptr;
-    tHashTimerEntry *nextElement = nullptr;
-    for (element = _hashForTimers; element != nullptr;)
+    // slots are never destroyed, only freed, so indices stay valid while targets are removed
+    for (SlotIndex slot = 0; slot < _timerTargets.size(); ++slot)
     {
-        // element may be removed in unscheduleAllSelectorsForTarget
-        nextElement = (tHashTimerEntry *)element->hh.next;
-        unscheduleAllForTarget(element->target);
-
-        element = nextElement;
+        if (_timerTargets[slot].target)
+        {
+            unscheduleAllForTarget(_timerTargets[slot].target);
+        }
     }
 
     // Updates selectors
-    tListEntry *entry, *tmp;
-    if(minPriority < 0)
-    {
-        DL_FOREACH_SAFE(_updatesNegList, entry, tmp)
+    // releasing a callback may schedule another update, so iterate by index
+    auto unscheduleIn = [this, minPriority](const std::vector<SlotIndex>& slots) {
+        for (size_t i = 0; i < slots.size(); ++i)
         {
-            if(entry->priority >= minPriority)
+            const auto& entry = _updateEntries[slots[i]];
+            if (entry.target && !entry.markedForDeletion && entry.priority >= minPriority)
             {
-                unscheduleUpdate(entry->target);
+                unscheduleUpdate(entry.target);
             }
         }
-    }
+    };
+    unscheduleIn(_updateOrder);
+    unscheduleIn(_updatesToInsert);
 
-    if(minPriority <= 0)
+    if (!_updateHashLocked)
     {
-        DL_FOREACH_SAFE(_updates0List, entry, tmp)
-        {
-            unscheduleUpdate(entry->target);
-        }
+        removeMarkedUpdates();
     }
 
-    DL_FOREACH_SAFE(_updatesPosList, entry, tmp)
-    {
-        if(entry->priority >= minPriority)
-        {
-            unscheduleUpdate(entry->target);
-        }
-    }
 #if CC_ENABLE_SCRIPT_BINDING
     _scriptHandlerEntries.clear();
 #endif
@@ -640,26 +828,24 @@ void Scheduler::unscheduleAllForTarget(void *target)
     }
 
     // Custom Selectors
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-
-    if (element)
+    auto iter = _timerSlotsByTarget.find(target);
+    if (iter != _timerSlotsByTarget.end())
     {
-        if (ccArrayContainsObject(element->timers, element->currentTimer)
-            && (! element->currentTimerSalvaged))
-        {
-            element->currentTimer->retain();
-            element->currentTimerSalvaged = true;
-        }
-        ccArrayRemoveAllObjects(element->timers);
+        const SlotIndex slot = iter->second;
 
-        if (_currentTarget == element)
+        // remove from the back so the indices are not shifted when not ticking
+        for (size_t i = _timerTargets[slot].timers.size(); i > 0; --i)
         {
-            _currentTargetSalvaged = true;
+            if (_timerTargets[slot].timers[i - 1])
+            {
+                removeTimerAt(slot, i - 1);
+            }
         }
-        else
+
+        // the target may have no live timers left and still be in the store while ticking
+        if (!_updateHashLocked && _timerTargets[slot].target == target)
         {
-            removeHashElement(element);
+            removeTimerTarget(slot);
         }
     }
 
@@ -695,20 +881,17 @@ void Scheduler::resumeTarget(void *target)
     CCASSERT(target != nullptr, "target can't be nullptr!");
 
     // custom selectors
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    if (element)
+    auto timerIter = _timerSlotsByTarget.find(target);
+    if (timerIter != _timerSlotsByTarget.end())
     {
-        element->paused = false;
+        _timerTargets[timerIter->second].paused = false;
     }
 
     // update selector
-    tHashUpdateEntry *elementUpdate = nullptr;
-    HASH_FIND_PTR(_hashForUpdates, &target, elementUpdate);
-    if (elementUpdate)
+    auto updateIter = _updateSlotsByTarget.find(target);
+    if (updateIter != _updateSlotsByTarget.end())
     {
-        CCASSERT(elementUpdate->entry != nullptr, "elementUpdate's entry can't be nullptr!");
-        elementUpdate->entry->paused = false;
+        _updateEntries[updateIter->second].paused = false;
     }
 }
 
@@ -717,20 +900,19 @@ void Scheduler::pauseTarget(void *target)
     CCASSERT(target != nullptr, "target can't be nullptr!");
 
     // custom selectors
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    if (element)
+    auto timerIter = _timerSlotsByTarget.find(target);
+    if (timerIter != _timerSlotsByTarget.end())
     {
-        element->paused = true;
+        _timerTargets[timerIter->second].paused = true;
+        // paused timers don't consume time, they are updated again when the target is resumed
+        removeTargetFromTimerWheel(timerIter->second);
     }
 
     // update selector
-    tHashUpdateEntry *elementUpdate = nullptr;
-    HASH_FIND_PTR(_hashForUpdates, &target, elementUpdate);
-    if (elementUpdate)
+    auto updateIter = _updateSlotsByTarget.find(target);
+    if (updateIter != _updateSlotsByTarget.end())
     {
-        CCASSERT(elementUpdate->entry != nullptr, "elementUpdate's entry can't be nullptr!");
-        elementUpdate->entry->paused = true;
+        _updateEntries[updateIter->second].paused = true;
     }
 }
 
@@ -739,21 +921,19 @@ bool Scheduler::isTargetPaused(void *target)
     CCASSERT( target != nullptr, "target must be non nil" );
 
     // Custom selectors
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    if( element )
+    auto timerIter = _timerSlotsByTarget.find(target);
+    if (timerIter != _timerSlotsByTarget.end())
     {
-        return element->paused;
+        return _timerTargets[timerIter->second].paused;
     }
-    
+
     // We should check update selectors if target does not have custom selectors
-	tHashUpdateEntry *elementUpdate = nullptr;
-	HASH_FIND_PTR(_hashForUpdates, &target, elementUpdate);
-	if ( elementUpdate )
+    auto updateIter = _updateSlotsByTarget.find(target);
+    if (updateIter != _updateSlotsByTarget.end())
     {
-		return elementUpdate->entry->paused;
+        return _updateEntries[updateIter->second].paused;
     }
-    
+
     return false;  // should never get here
 }
 
@@ -767,44 +947,32 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     std::set<void*> idsWithSelectors;
 
     // Custom Selectors
-    for(tHashTimerEntry *element = _hashForTimers; element != nullptr;
-        element = (tHashTimerEntry*)element->hh.next)
+    for (SlotIndex slot = 0; slot < _timerTargets.size(); ++slot)
     {
-        element->paused = true;
-        idsWithSelectors.insert(element->target);
+        auto& element = _timerTargets[slot];
+        if (element.target)
+        {
+            element.paused = true;
+            removeTargetFromTimerWheel(slot);
+            idsWithSelectors.insert(element.target);
+        }
     }
 
     // Updates selectors
-    tListEntry *entry, *tmp;
-    if(minPriority < 0)
-    {
-        DL_FOREACH_SAFE( _updatesNegList, entry, tmp ) 
+    auto pauseIn = [this, minPriority, &idsWithSelectors](const std::vector<SlotIndex>& slots) {
+        for (const auto slot : slots)
         {
-            if(entry->priority >= minPriority)
+            auto& entry = _updateEntries[slot];
+            // unscheduled targets keep their slot until the next tick, they may be deallocated already
+            if (entry.target && !entry.markedForDeletion && entry.priority >= minPriority)
             {
-                entry->paused = true;
-                idsWithSelectors.insert(entry->target);
+                entry.paused = true;
+                idsWithSelectors.insert(entry.target);
             }
         }
-    }
-
-    if(minPriority <= 0)
-    {
-        DL_FOREACH_SAFE( _updates0List, entry, tmp )
-        {
-            entry->paused = true;
-            idsWithSelectors.insert(entry->target);
-        }
-    }
-
-    DL_FOREACH_SAFE( _updatesPosList, entry, tmp ) 
-    {
-        if(entry->priority >= minPriority) 
-        {
-            entry->paused = true;
-            idsWithSelectors.insert(entry->target);
-        }
-    }
+    };
+    pauseIn(_updateOrder);
+    pauseIn(_updatesToInsert);
 
     return idsWithSelectors;
 }
@@ -818,11 +986,74 @@ void Scheduler::resumeTargets(const std::set<void*>& targetsToResume)
 
 void Scheduler::performFunctionInCocosThread(const std::function<void ()> &function)
 {
-    _performMutex.lock();
+    auto node = new (std::nothrow) PerformNode();
+    node->function = function;
+    node->queuedAt = std::chrono::steady_clock::now();
+
+    // The node is the new head once exchanged, but the cocos thread only sees it
+    // when the previous head links it.
+    auto previous = _performHead.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+    _performQueueDepth.fetch_add(1, std::memory_order_release);
+}
+
+void Scheduler::setPerformFunctionBudget(unsigned int maxFunctions, float maxTime)
+{
+    _performBudget = maxFunctions;
+    _performTimeBudget = maxTime;
+}
+
+Scheduler::PerformFunctionStats Scheduler::getPerformFunctionStats() const
+{
+    auto stats = _performStats;
+    stats.queueDepth = _performQueueDepth.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Scheduler::performQueuedFunctions(unsigned int count)
+{
+    if (_performBudget > 0 && count > _performBudget)
+    {
+        count = _performBudget;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    float totalLatency = 0;
+    float maxLatency = 0;
+    unsigned int performed = 0;
+
+    while (performed < count)
+    {
+        auto node = _performTail->next.load(std::memory_order_acquire);
+        if (node == nullptr)
+        {
+            // a producer has not linked its node yet, it will be performed next frame
+            break;
+        }
+
+        // the previous tail was performed already, node becomes the tail once its function is moved out
+        delete _performTail;
+        _performTail = node;
+        _performQueueDepth.fetch_sub(1, std::memory_order_relaxed);
 
-    _functionsToPerform.push_back(function);
+        auto now = std::chrono::steady_clock::now();
+        float latency = std::chrono::duration<float>(now - node->queuedAt).count();
+        totalLatency += latency;
+        maxLatency = std::max(maxLatency, latency);
+        ++performed;
 
-    _performMutex.unlock();
+        auto function = std::move(node->function);
+        function();
+
+        if (_performTimeBudget > 0 && std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() >= _performTimeBudget)
+        {
+            break;
+        }
+    }
+
+    _performStats.performed = performed;
+    _performStats.averageLatency = performed > 0 ? totalLatency / performed : 0;
+    _performStats.maxLatency = maxLatency;
 }
 
 // main loop
@@ -839,105 +1070,57 @@ void Scheduler::update(float dt)
     // Selector callbacks
     //
 
-    // Iterate over all the Updates' selectors
-    tListEntry *entry, *tmp;
-
-    // updates with priority < 0
-    DL_FOREACH_SAFE(_updatesNegList, entry, tmp)
+    // Iterate over all the Updates' selectors, sorted by priority.
+    // _updateOrder doesn't change during the tick, and entries never move.
+    for (const auto slot : _updateOrder)
     {
-        if ((! entry->paused) && (! entry->markedForDeletion))
+        auto& entry = _updateEntries[slot];
+        if ((! entry.paused) && (! entry.markedForDeletion))
         {
-            entry->callback(dt);
+            entry.callback(dt);
         }
     }
 
-    // updates with priority == 0
-    DL_FOREACH_SAFE(_updates0List, entry, tmp)
-    {
-        if ((! entry->paused) && (! entry->markedForDeletion))
-        {
-            entry->callback(dt);
-        }
-    }
+    // Iterate over all the custom selectors
+    // the timers in the timing wheel are skipped, the wheel updates them when they are due
+    _timerWheelTime += dt;
 
-    // updates with priority > 0
-    DL_FOREACH_SAFE(_updatesPosList, entry, tmp)
+    // targets added during the tick are appended or reuse a free slot, they may be ticked too
+    for (SlotIndex slot = 0; slot < _timerTargets.size(); ++slot)
     {
-        if ((! entry->paused) && (! entry->markedForDeletion))
+        const auto& element = _timerTargets[slot];
+        if (element.target == nullptr || element.paused || element.wheelTimers == element.timers.size())
         {
-            entry->callback(dt);
+            continue;
         }
-    }
-
-    // Iterate over all the custom selectors
-    for (tHashTimerEntry *elt = _hashForTimers; elt != nullptr; )
-    {
-        _currentTarget = elt;
-        _currentTargetSalvaged = false;
 
-        if (! _currentTarget->paused)
+        // The 'timers' array may grow while inside this loop, removed timers are set to nullptr.
+        // Callbacks may add targets too, so the element is fetched again after each update.
+        for (size_t i = 0; i < _timerTargets[slot].timers.size(); ++i)
         {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers->num; ++(elt->timerIndex))
+            Timer* timer = _timerTargets[slot].timers[i];
+            if (timer && timer->_wheelBucket == TIMER_NOT_IN_WHEEL)
             {
-                elt->currentTimer = (Timer*)(elt->timers->arr[elt->timerIndex]);
-                elt->currentTimerSalvaged = false;
-
-                elt->currentTimer->update(dt);
+                timer->update(dt);
 
-                if (elt->currentTimerSalvaged)
+                // still scheduled, and not due soon
+                const auto& current = _timerTargets[slot];
+                if (current.timers[i] == timer && !current.paused
+                    && timer->getTimeToNextTrigger() >= TIMER_WHEEL_MIN_DELAY)
                 {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
+                    insertInTimerWheel(timer, slot);
                 }
-
-                elt->currentTimer = nullptr;
             }
         }
-
-        // elt, at this moment, is still valid
-        // so it is safe to ask this here (issue #490)
-        elt = (tHashTimerEntry *)elt->hh.next;
-
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers->num == 0)
-        {
-            removeHashElement(_currentTarget);
-        }
     }
 
-    // delete all updates that are marked for deletion
-    // updates with priority < 0
-    DL_FOREACH_SAFE(_updatesNegList, entry, tmp)
-    {
-        if (entry->markedForDeletion)
-        {
-            this->removeUpdateFromHash(entry);
-        }
-    }
+    advanceTimerWheel();
 
-    // updates with priority == 0
-    DL_FOREACH_SAFE(_updates0List, entry, tmp)
-    {
-        if (entry->markedForDeletion)
-        {
-            this->removeUpdateFromHash(entry);
-        }
-    }
-
-    // updates with priority > 0
-    DL_FOREACH_SAFE(_updatesPosList, entry, tmp)
-    {
-        if (entry->markedForDeletion)
-        {
-            this->removeUpdateFromHash(entry);
-        }
-    }
+    // delete all timers and updates that were removed during the tick
+    removeSalvagedTimers();
+    removeMarkedUpdates();
 
     _updateHashLocked = false;
-    _currentTarget = nullptr;
 
 #if CC_ENABLE_SCRIPT_BINDING
     //
@@ -965,18 +1148,19 @@ void Scheduler::update(float dt)
     // Functions allocated from another thread
     //
 
-    // Testing size is faster than locking / unlocking.
-    // And almost never there will be functions scheduled to be called.
-    if( !_functionsToPerform.empty() ) {
-        _performMutex.lock();
-        // fixed #4123: Save the callback functions, they must be invoked after '_performMutex.unlock()', otherwise if new functions are added in callback, it will cause thread deadlock.
-        auto temp = _functionsToPerform;
-        _functionsToPerform.clear();
-        _performMutex.unlock();
-        for( const auto &function : temp ) {
-            function();
-        }
-        
+    // Almost never there will be functions scheduled to be called.
+    // Only the functions queued before this point are performed: functions queued by
+    // the callbacks wait for the next frame (#4123).
+    const unsigned int functionsToPerform = _performQueueDepth.load(std::memory_order_acquire);
+    if (functionsToPerform > 0)
+    {
+        performQueuedFunctions(functionsToPerform);
+    }
+    else
+    {
+        _performStats.performed = 0;
+        _performStats.averageLatency = 0;
+        _performStats.maxLatency = 0;
     }
 }
 
@@ -984,48 +1168,30 @@ void Scheduler::schedule(SEL_SCHEDULE selector, Ref *target, float interval, uns
 {
     CCASSERT(target, "Argument target must be non-nullptr");
     
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
+    const SlotIndex slot = getTimerTargetSlot(target, paused);
+    auto& element = _timerTargets[slot];
     
-    if (! element)
+    for (auto t : element.timers)
     {
-        element = (tHashTimerEntry *)calloc(sizeof(*element), 1);
-        element->target = target;
-        
-        HASH_ADD_PTR(_hashForTimers, target, element);
+        TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(t);
         
-        // Is this the 1st element ? Then set the pause level to all the selectors of this target
-        element->paused = paused;
-    }
-    else
-    {
-        CCASSERT(element->paused == paused, "element's paused should be paused.");
-    }
-    
-    if (element->timers == nullptr)
-    {
-        element->timers = ccArrayNew(10);
-    }
-    else
-    {
-        for (int i = 0; i < element->timers->num; ++i)
+        if (timer && selector == timer->getSelector())
         {
-            TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(element->timers->arr[i]);
-            
-            if (timer && selector == timer->getSelector())
+            CCLOG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
+            timer->setInterval(interval);
+            if (timer->_wheelBucket != TIMER_NOT_IN_WHEEL)
             {
-                CCLOG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
-                timer->setInterval(interval);
-                return;
+                // its due time changed
+                removeFromTimerWheel(timer, slot, true);
             }
+            return;
         }
-        ccArrayEnsureExtraCapacity(element->timers, 1);
     }
     
+    // the store owns the reference returned by new
     TimerTargetSelector *timer = new (std::nothrow) TimerTargetSelector();
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
-    ccArrayAppendObject(element->timers, timer);
-    timer->release();
+    element.timers.push_back(timer);
 }
 
 void Scheduler::schedule(SEL_SCHEDULE selector, Ref *target, float interval, bool paused)
@@ -1038,34 +1204,23 @@ bool Scheduler::isScheduled(SEL_SCHEDULE selector, Ref *target)
     CCASSERT(selector, "Argument selector must be non-nullptr");
     CCASSERT(target, "Argument target must be non-nullptr");
     
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    
-    if (!element)
+    auto iter = _timerSlotsByTarget.find(target);
+    if (iter == _timerSlotsByTarget.end())
     {
         return false;
     }
     
-    if (element->timers == nullptr)
-    {
-        return false;
-    }
-    else
+    for (auto t : _timerTargets[iter->second].timers)
     {
-        for (int i = 0; i < element->timers->num; ++i)
+        TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(t);
+        
+        if (timer && selector == timer->getSelector())
         {
-            TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(element->timers->arr[i]);
-            
-            if (timer && selector == timer->getSelector())
-            {
-                return true;
-            }
+            return true;
         }
-        
-        return false;
     }
     
-    return false;  // should never get here
+    return false;
 }
 
 void Scheduler::unschedule(SEL_SCHEDULE selector, Ref *target)
@@ -1076,46 +1231,17 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Ref *target)
         return;
     }
     
-    //CCASSERT(target);
-    //CCASSERT(selector);
-    
-    tHashTimerEntry *element = nullptr;
-    HASH_FIND_PTR(_hashForTimers, &target, element);
-    
-    if (element)
+    auto iter = _timerSlotsByTarget.find(target);
+    if (iter != _timerSlotsByTarget.end())
     {
-        for (int i = 0; i < element->timers->num; ++i)
+        auto& timers = _timerTargets[iter->second].timers;
+        for (size_t i = 0, count = timers.size(); i < count; ++i)
         {
-            TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(element->timers->arr[i]);
+            TimerTargetSelector *timer = dynamic_cast<TimerTargetSelector*>(timers[i]);
             
             if (timer && selector == timer->getSelector())
             {
-                if (timer == element->currentTimer && (! element->currentTimerSalvaged))
-                {
-                    element->currentTimer->retain();
-                    element->currentTimerSalvaged = true;
-                }
-                
-                ccArrayRemoveObjectAtIndex(element->timers, i, true);
-                
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (element->timerIndex >= i)
-                {
-                    element->timerIndex--;
-                }
-                
-                if (element->timers->num == 0)
-                {
-                    if (_currentTarget == element)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        removeHashElement(element);
-                    }
-                }
-                
+                removeTimerAt(iter->second, i);
                 return;
             }
         }
@@ -28,13 +28,17 @@ THE SOFTWARE.
 #ifndef __CCSCHEDULER_H__
 #define __CCSCHEDULER_H__
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "base/CCRef.h"
 #include "base/CCVector.h"
-#include "base/uthash.h"
 
 NS_CC_BEGIN
 
@@ -62,8 +66,12 @@ public:
     
     /** triggers the timer */
     void update(float dt);
+
+    /** time left before the next trigger, in seconds. 0 if the timer was never updated or runs every frame */
+    float getTimeToNextTrigger() const;
     
 protected:
+    friend class Scheduler;
     
     Scheduler* _scheduler; // weak ref
     float _elapsed;
@@ -73,6 +81,12 @@ protected:
     unsigned int _repeat; //0 = once, 1 is 2 x executed
     float _delay;
     float _interval;
+
+    // timing wheel bookkeeping, owned by the Scheduler
+    int _wheelBucket;           // bucket of the Scheduler timing wheel, negative when not in a bucket
+    unsigned int _wheelIndex;   // index in the bucket
+    double _wheelDueTime;       // scheduler time of the next trigger
+    double _wheelLastUpdate;    // scheduler time of the last update
 };
 
 
@@ -141,10 +155,6 @@ private:
  * @{
  */
 
-struct _listEntry;
-struct _hashSelectorEntry;
-struct _hashUpdateEntry;
-
 #if CC_ENABLE_SCRIPT_BINDING
 class SchedulerScriptHandlerEntry;
 #endif
@@ -429,6 +439,37 @@ public:
      @js NA
      */
     void performFunctionInCocosThread( const std::function<void()> &function);
+
+    /** Statistics of the functions queued with performFunctionInCocosThread.
+     @since v3.9
+     @js NA
+     @lua NA
+     */
+    struct PerformFunctionStats
+    {
+        unsigned int queueDepth;    // functions waiting to be performed
+        unsigned int performed;     // functions performed in the last frame
+        float averageLatency;       // seconds between queuing and performing, for the functions performed in the last frame
+        float maxLatency;
+    };
+
+    /** Limits the work done each frame for the functions queued with performFunctionInCocosThread.
+     The functions that don't fit in the budget are performed in the next frames, in order.
+     Functions queued while performing are never performed in the same frame.
+     @param maxFunctions The maximum number of functions performed in a frame, 0 means no limit.
+     @param maxTime The time in seconds after which no more functions are performed in a frame, 0 means no limit.
+     @since v3.9
+     @js NA
+     @lua NA
+     */
+    void setPerformFunctionBudget(unsigned int maxFunctions, float maxTime = 0);
+
+    /** Returns the depth of the "perform function" queue and the latency of the functions performed in the last frame.
+     @since v3.9
+     @js NA
+     @lua NA
+     */
+    PerformFunctionStats getPerformFunctionStats() const;
     
     /////////////////////////////////////
     
@@ -499,39 +540,121 @@ protected:
      */
     void schedulePerFrame(const ccSchedulerFunc& callback, void *target, int priority, bool paused);
     
-    void removeHashElement(struct _hashSelectorEntry *element);
-    void removeUpdateFromHash(struct _listEntry *entry);
+    // Index of an entry in one of the slot arrays below. A slot keeps its index while it is in use,
+    // so it can be stored in the lookup maps and in _updateOrder.
+    typedef unsigned int SlotIndex;
+
+    // "updates with priority" entry
+    struct UpdateEntry
+    {
+        ccSchedulerFunc callback;
+        void *target;               // nullptr when the slot is free
+        int priority;
+        bool paused;
+        bool markedForDeletion;     // callback will no longer be called and entry will be removed at end of the next tick
+    };
+
+    // "selectors with interval" entry, one per target
+    struct TimerTargetEntry
+    {
+        std::vector<Timer*> timers; // retained; set to nullptr when unscheduled during a tick
+        void *target;               // nullptr when the slot is free
+        size_t wheelTimers;         // timers in the timing wheel, they are not updated every frame
+        bool paused;
+        bool hasRemovedTimers;      // some timers were unscheduled during the tick, compact it at the end of the tick
+    };
+
+    struct TimerWheelEntry
+    {
+        Timer *timer;
+        SlotIndex targetSlot;
+    };
+
+    // node of the "perform function" queue
+    struct PerformNode
+    {
+        PerformNode() : next(nullptr) {}
+
+        std::function<void()> function;
+        std::chrono::steady_clock::time_point queuedAt;
+        std::atomic<PerformNode*> next;
+    };
 
     // update specific
 
-    void priorityIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, int priority, bool paused);
-    void appendIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, bool paused);
+    void insertUpdateInOrder(SlotIndex slot);
+    void freeUpdateSlot(SlotIndex slot);
+    void removeMarkedUpdates();
+
+    // timers specific
+
+    SlotIndex getTimerTargetSlot(void *target, bool paused);
+    void removeTimerAt(SlotIndex slot, size_t index);
+    void removeTimerTarget(SlotIndex slot);
+    void removeSalvagedTimers();
+
+    // timing wheel specific
+
+    void insertInTimerWheel(Timer *timer, SlotIndex targetSlot);
+    void addToTimerWheelBucket(const TimerWheelEntry& entry);
+    // puts the timer back in the per frame updates, keepElapsed adds the time elapsed since its last update
+    void removeFromTimerWheel(Timer *timer, SlotIndex targetSlot, bool keepElapsed);
+    void removeTargetFromTimerWheel(SlotIndex targetSlot);
+    // updates the timers that are due
+    void advanceTimerWheel();
 
+    // performs up to count queued functions, within the budget
+    void performQueuedFunctions(unsigned int count);
 
     float _timeScale;
 
     //
     // "updates with priority" stuff
     //
-    struct _listEntry *_updatesNegList;        // list of priority < 0
-    struct _listEntry *_updates0List;            // list priority == 0
-    struct _listEntry *_updatesPosList;        // list priority > 0
-    struct _hashUpdateEntry *_hashForUpdates; // hash used to fetch quickly the list entries for pause,delete,etc
+    // entries live in a deque so they never move while their callback runs, free slots are reused
+    std::deque<UpdateEntry> _updateEntries;
+    std::vector<SlotIndex> _freeUpdateSlots;
+    // slots sorted by priority, entries with the same priority are called in scheduling order
+    std::vector<SlotIndex> _updateOrder;
+    // slots scheduled during a tick, added to _updateOrder at the end of the tick
+    std::vector<SlotIndex> _updatesToInsert;
+    std::unordered_map<void*, SlotIndex> _updateSlotsByTarget;
+    // number of entries marked for deletion still referenced by _updateOrder or _updatesToInsert
+    size_t _updatesMarkedForDeletion;
 
     // Used for "selectors with interval"
-    struct _hashSelectorEntry *_hashForTimers;
-    struct _hashSelectorEntry *_currentTarget;
-    bool _currentTargetSalvaged;
-    // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
+    // unlike update entries, these may move when a target is added: the timers themselves are heap allocated
+    std::vector<TimerTargetEntry> _timerTargets;
+    std::vector<SlotIndex> _freeTimerTargetSlots;
+    std::unordered_map<void*, SlotIndex> _timerSlotsByTarget;
+    // timers unscheduled during a tick, released at the end of the tick
+    std::vector<Timer*> _salvagedTimers;
+    std::vector<SlotIndex> _timerTargetsToCompact;
+
+    // Hierarchical timing wheel holding the timers whose next trigger is far away,
+    // so only the timers that are due are updated in a frame.
+    // Levels of 64 buckets of 1, 64, 64^2 and 64^3 ticks, then a bucket of timers due in the current tick.
+    std::vector<std::vector<TimerWheelEntry>> _timerWheel;
+    std::vector<TimerWheelEntry> _dueTimers;
+    double _timerWheelTime;
+    uint64_t _timerWheelTick;
+    // If true unschedule will not remove anything from the stores. Elements will only be marked for deletion.
     bool _updateHashLocked;
     
 #if CC_ENABLE_SCRIPT_BINDING
     Vector<SchedulerScriptHandlerEntry*> _scriptHandlerEntries;
 #endif
     
-    // Used for "perform Function"
-    std::vector<std::function<void()>> _functionsToPerform;
-    std::mutex _performMutex;
+    // Used for "perform Function": a lock free multiple producers / single consumer queue.
+    // Other threads link their node after _performHead. The cocos thread pops from _performTail,
+    // which is the dummy node or the last node performed, and the only node it deletes.
+    std::atomic<PerformNode*> _performHead;
+    PerformNode* _performTail;
+    // nodes linked and not performed yet, may lag behind the links
+    std::atomic<unsigned int> _performQueueDepth;
+    unsigned int _performBudget;
+    float _performTimeBudget;
+    PerformFunctionStats _performStats;
 };
 
 // end of base group
@@ -27,6 +27,8 @@
 #define CC_ALLOCATOR_MACROS_H
 /// @cond DO_NOT_SHOW
 
+#include <new>
+
 #include "base/ccConfig.h"
 #include "platform/CCPlatformMacros.h"
 
@@ -87,6 +89,49 @@
             A.deallocate((T*)object, size); \
         }
 
+    // @brief declares class specific new/delete for a class allocated from a pool.
+    // Use it in the public section of the class and CC_DEFINE_ALLOCATOR_POOL in its
+    // translation unit, so the pool itself does not need to be visible from the header.
+    #define CC_DECLARE_ALLOCATOR_POOL \
+        static void* operator new (size_t size); \
+        static void* operator new (size_t size, const std::nothrow_t&) throw(); \
+        static void operator delete (void* object, size_t size); \
+        static void operator delete (void* object, const std::nothrow_t&) throw();
+
+    // @brief defines the pool and the new/delete operators declared by CC_DECLARE_ALLOCATOR_POOL.
+    // The pool is created on first use, after the configuration file had a chance to set
+    // its page size, and it is never destroyed so objects can still be released at exit.
+    // Subclasses of T inherit the operators, their allocations fall back to the global allocator.
+    #define CC_DEFINE_ALLOCATOR_POOL(T, pageSize) \
+        static NS_CC_ALLOCATOR::AllocatorStrategyPool<T, NS_CC_ALLOCATOR::StorageTraits<T>>& T##AllocatorPool() \
+        { \
+            typedef NS_CC_ALLOCATOR::AllocatorStrategyPool<T, NS_CC_ALLOCATOR::StorageTraits<T>> tPool; \
+            static tPool* pool = nullptr; \
+            if (nullptr == pool) \
+            { \
+                pool = (tPool*)NS_CC_ALLOCATOR::ccAllocatorGlobal.allocate(sizeof(tPool)); \
+                new (pool) tPool(#T, pageSize); \
+            } \
+            return *pool; \
+        } \
+        void* T::operator new (size_t size) \
+        { \
+            return T##AllocatorPool().allocate(size); \
+        } \
+        void* T::operator new (size_t size, const std::nothrow_t&) throw() \
+        { \
+            return T##AllocatorPool().allocate(size); \
+        } \
+        void T::operator delete (void* object, size_t size) \
+        { \
+            T##AllocatorPool().deallocate(object, size); \
+        } \
+        void T::operator delete (void* object, const std::nothrow_t&) throw() \
+        { \
+            auto& pool = T##AllocatorPool(); \
+            pool.deallocate(object, pool.owns(object) ? sizeof(T) : 0); \
+        }
+
 #else
 
     // macros for new/delete
@@ -104,6 +149,8 @@
 
     // throw these away if not enabled
     #define CC_USE_ALLOCATOR_POOL(...)
+    #define CC_DECLARE_ALLOCATOR_POOL
+    #define CC_DEFINE_ALLOCATOR_POOL(...)
     #define CC_OVERRIDE_GLOBAL_NEWDELETE_WITH_ALLOCATOR(...)
 
 #endif
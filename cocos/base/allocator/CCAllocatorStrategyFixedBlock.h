@@ -78,6 +78,8 @@ public:
     {
 #if CC_ENABLE_ALLOCATOR_DIAGNOSTICS
         _highestCount = 0;
+        _hits = 0;
+        _misses = 0;
         AllocatorDiagnostics::instance()->trackAllocator(this);
         AllocatorBase::setTag(tag ? tag : typeid(AllocatorStrategyFixedBlock).name());
 #endif
@@ -160,10 +162,14 @@ public:
     std::string diagnostics() const
     {
         std::stringstream s;
-        s << AllocatorBase::tag() << " initial:" << _pageSize << " count:" << _allocated << " highest:" << _highestCount << "\n";
+        s << AllocatorBase::tag() << " initial:" << _pageSize << " count:" << _allocated << " highest:" << _highestCount << " hits:" << _hits << " misses:" << _misses << "\n";
         return s.str();
     }
     size_t _highestCount;
+    // @brief number of blocks handed out from the free list, and number of
+    // requests that had to grow the pool or go to the global allocator.
+    size_t _hits;
+    size_t _misses;
 #endif
     
 protected:
@@ -202,6 +208,12 @@ protected:
     // for the number of blocks of this size being allocated.
     CC_ALLOCATOR_INLINE void* pop_front()
     {
+#if CC_ENABLE_ALLOCATOR_DIAGNOSTICS
+        if (nullptr == _list)
+            ++_misses;
+        else
+            ++_hits;
+#endif
         if (nullptr == _list)
         {
             allocatePage();
@@ -81,6 +81,43 @@ public:
     }
 };
 
+/**
+ * StorageTraits describes the raw storage of an object.
+ *
+ * Use it for pools that back class specific new/delete operators, where the
+ * new and delete expressions already run the constructor and the destructor.
+ *
+ * @param T Type of object.
+ * @param _alignment Alignment of object T.
+ * @see CC_DEFINE_ALLOCATOR_POOL
+ */
+template <typename T, size_t _alignment = 16>
+class StorageTraits
+{
+public:
+    
+    typedef T value_type;
+    
+    static const size_t alignment = _alignment;
+    
+    virtual ~StorageTraits()
+    {}
+    
+    /** Does nothing, the new expression constructs the object.*/
+    void construct(T* address)
+    {}
+    
+    /** Does nothing, the delete expression destroys the object.*/
+    void destroy(T* address)
+    {}
+    
+    /** Returns the name of this object type T.*/
+    const char* name() const
+    {
+        return typeid(T).name();
+    }
+};
+
 /**
  * Fixed sized pool allocator strategy for objects of type T.
  *
@@ -128,6 +165,11 @@ public:
         else
         {
             object = (T*)ccAllocatorGlobal.allocate(size);
+#if CC_ENABLE_ALLOCATOR_DIAGNOSTICS
+            locking_traits::lock();
+            ++tParentStrategy::_misses;
+            locking_traits::unlock();
+#endif
         }
         O::construct(object);
         return object;
@@ -159,7 +201,7 @@ public:
     std::string diagnostics() const
     {
         std::stringstream s;
-        s << AllocatorBase::tag() << " initial:" << tParentStrategy::_pageSize << " count:" << tParentStrategy::_allocated << " highest:" << tParentStrategy::_highestCount << "\n";
+        s << AllocatorBase::tag() << " initial:" << tParentStrategy::_pageSize << " count:" << tParentStrategy::_allocated << " highest:" << tParentStrategy::_highestCount << " hits:" << tParentStrategy::_hits << " misses:" << tParentStrategy::_misses << "\n";
         return s.str();
     }    
 #endif
@@ -362,6 +362,32 @@ THE SOFTWARE.
 # define CC_ENABLE_ALLOCATOR_GLOBAL_NEW_DELETE 0
 # endif//CC_ENABLE_ALLOCATOR_GLOBAL_NEW_DELETE
 
+/** @def CC_ENABLE_ACTION_POOL
+ * Allocate the common actions (MoveBy, ScaleTo, Sequence, CallFunc...) from per class
+ * pools, so that actions released by the ActionManager are recycled instead of freed.
+ * Needs CC_ENABLE_ALLOCATOR. The number of actions per page can be set in the
+ * configuration file using the class name as key, for example "MoveBy".
+ */
+#ifndef CC_ENABLE_ACTION_POOL
+# define CC_ENABLE_ACTION_POOL 0
+#endif
+
+/** @def CC_ENABLE_SPRITE_POOL
+ * Allocate Sprite instances from a pool. Subclasses of Sprite keep using the global allocator.
+ * Needs CC_ENABLE_ALLOCATOR. The page size can be set in the configuration file with the "Sprite" key.
+ */
+#ifndef CC_ENABLE_SPRITE_POOL
+# define CC_ENABLE_SPRITE_POOL 0
+#endif
+
+/** @def CC_ENABLE_RENDER_COMMAND_POOL
+ * Allocate the render commands that are created on the heap (GroupCommand, MeshCommand) from pools.
+ * Needs CC_ENABLE_ALLOCATOR.
+ */
+#ifndef CC_ENABLE_RENDER_COMMAND_POOL
+# define CC_ENABLE_RENDER_COMMAND_POOL 0
+#endif
+
 /** @def CC_ALLOCATOR_GLOBAL
  * Specify allocator to use for global allocator.
  */
@@ -39,6 +39,7 @@ THE SOFTWARE.
 
 // base
 #include "base/CCAsyncTaskPool.h"
+#include "base/CCJobSystem.h"
 #include "base/CCAutoreleasePool.h"
 #include "base/CCConfiguration.h"
 #include "base/CCConsole.h"
@@ -154,11 +155,13 @@ THE SOFTWARE.
 #include "renderer/CCGroupCommand.h"
 #include "renderer/CCMaterial.h"
 #include "renderer/CCPass.h"
+#include "renderer/CCPixelConversion.h"
 #include "renderer/CCPrimitive.h"
 #include "renderer/CCPrimitiveCommand.h"
 #include "renderer/CCQuadCommand.h"
 #include "renderer/CCRenderCommand.h"
 #include "renderer/CCRenderCommandPool.h"
+#include "renderer/CCRenderCommandRecorder.h"
 #include "renderer/CCRenderState.h"
 #include "renderer/CCRenderer.h"
 #include "renderer/CCTechnique.h"
@@ -237,7 +240,12 @@ THE SOFTWARE.
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
     #include "platform/linux/CCApplication-linux.h"
+#if CC_USE_NULL_GL
+    #include "platform/linux/CCGLViewImpl-null.h"
+    #include "platform/linux/CCGL-null.h"
+#else
     #include "platform/desktop/CCGLViewImpl-desktop.h"
+#endif
     #include "platform/linux/CCGL-linux.h"
     #include "platform/linux/CCStdC-linux.h"
 #endif // CC_TARGET_PLATFORM == CC_PLATFORM_LINUX
@@ -258,6 +266,7 @@ THE SOFTWARE.
 #include "2d/CCSprite.h"
 #include "2d/CCAutoPolygon.h"
 #include "2d/CCSpriteBatchNode.h"
+#include "2d/CCStaticBatchNode.h"
 #include "2d/CCSpriteFrame.h"
 #include "2d/CCSpriteFrameCache.h"
 
@@ -82,7 +82,7 @@ NavMeshDebugDraw::~NavMeshDebugDraw()
     for (auto iter : _primitiveList){
         delete iter;
     }
-    glDeleteBuffers(1, &_vbo);
+    GL::deleteBuffers(1, &_vbo);
 }
 
 void NavMeshDebugDraw::depthMask(bool state)
@@ -139,7 +139,7 @@ void NavMeshDebugDraw::drawImplement(const cocos2d::Mat4& transform, uint32_t fl
     _program->use();
     _program->setUniformsForBuiltins(transform);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
     GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POSITION | GL::VERTEX_ATTRIB_FLAG_COLOR);
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4F), (GLvoid *)offsetof(V3F_C4F, position));
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof(V3F_C4F), (GLvoid *)offsetof(V3F_C4F, color));
@@ -159,7 +159,7 @@ void NavMeshDebugDraw::drawImplement(const cocos2d::Mat4& transform, uint32_t fl
         glDrawArrays(iter->type, iter->start, iter->end - iter->start);
         CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, iter->end - iter->start);
     }
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void NavMeshDebugDraw::draw(Renderer* renderer)
@@ -111,7 +111,7 @@ Physics3DDebugDrawer::~Physics3DDebugDrawer()
     }
     if (_vbo)
     {
-        glDeleteBuffers(1, &_vbo);
+        GL::deleteBuffers(1, &_vbo);
         _vbo = 0;
     }
 }
@@ -131,13 +131,13 @@ void Physics3DDebugDrawer::drawImplementation( const Mat4 &transform, uint32_t f
 {
     _program->use();
     _program->setUniformsForBuiltins(transform);
-    glEnable(GL_DEPTH_TEST);
+    GL::enable(GL_DEPTH_TEST);
 
     GL::blendFunc(_blendFunc.src, _blendFunc.dst);
 
     if (_dirty)
     {
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+        GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
         glBufferData(GL_ARRAY_BUFFER, sizeof(V3F_V4F) * _bufferCapacity, _buffer, GL_STREAM_DRAW);
         _dirty = false;
     }
@@ -149,7 +149,7 @@ void Physics3DDebugDrawer::drawImplementation( const Mat4 &transform, uint32_t f
     {
         GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POSITION | GL::VERTEX_ATTRIB_FLAG_COLOR);
 
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+        GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
         // vertex
         glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_V4F), (GLvoid *)offsetof(V3F_V4F, vertex));
         // color
@@ -157,11 +157,11 @@ void Physics3DDebugDrawer::drawImplementation( const Mat4 &transform, uint32_t f
     }
 
     glDrawArrays(GL_LINES, 0, _bufferCount);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
 
     CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1,_bufferCount);
 
-    glDisable(GL_DEPTH_TEST);
+    GL::disable(GL_DEPTH_TEST);
     RenderState::StateBlock::_defaultState->setDepthTest(false);
 }
 
@@ -178,7 +178,7 @@ void Physics3DDebugDrawer::init()
     }
 
     glGenBuffers(1, &_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(V3F_V4F)* _bufferCapacity, _buffer, GL_STREAM_DRAW);
 
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
@@ -187,7 +187,7 @@ void Physics3DDebugDrawer::init()
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_COLOR);
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_FLOAT, GL_FALSE, sizeof(V3F_V4F), (GLvoid *)offsetof(V3F_V4F, color));
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
 
     if (Configuration::getInstance()->supportsShareableVAO())
     {
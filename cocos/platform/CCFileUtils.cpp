@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "CCFileUtils.h"
 
 #include <stack>
+#include <algorithm>
 
 #include "base/CCData.h"
 #include "base/ccMacros.h"
@@ -555,6 +556,7 @@ void FileUtils::setDelegate(FileUtils *delegate)
 
 FileUtils::FileUtils()
     : _writablePath("")
+    , _fileMappingEnabled(false)
 {
 }
 
@@ -630,6 +632,12 @@ static Data getData(const std::string& filename, bool forString)
     {
         // Read the file from hardware
         std::string fullPath = fileutils->fullPathForFilename(filename);
+        std::string entryName;
+        if (auto packFile = fileutils->getPackFileForPath(fullPath, &entryName))
+        {
+            return packFile->getData(entryName, forString);
+        }
+
         FILE *fp = fopen(fileutils->getSuitableFOpen(fullPath).c_str(), mode);
         CC_BREAK_IF(!fp);
         fseek(fp,0,SEEK_END);
@@ -682,6 +690,36 @@ Data FileUtils::getDataFromFile(const std::string& filename)
     return getData(filename, false);
 }
 
+MappedFile FileUtils::mapFile(const std::string& filename)
+{
+    MappedFile file;
+    if (filename.empty())
+    {
+        return file;
+    }
+
+    // the data may be transformed by a subclass, like decrypted
+    if (!_fileMappingEnabled)
+    {
+        return MappedFile(getDataFromFile(filename));
+    }
+
+    std::string fullPath = fullPathForFilename(filename);
+    std::string entryName;
+    if (auto packFile = getPackFileForPath(fullPath, &entryName))
+    {
+        return packFile->map(entryName);
+    }
+
+    if (isAbsolutePath(fullPath) && file.map(getSuitableFOpen(fullPath)))
+    {
+        return file;
+    }
+
+    // not a plain file on disk, or it can't be mapped
+    return MappedFile(getDataFromFile(filename));
+}
+
 unsigned char* FileUtils::getFileData(const std::string& filename, const char* mode, ssize_t *size)
 {
     unsigned char * buffer = nullptr;
@@ -691,6 +729,17 @@ unsigned char* FileUtils::getFileData(const std::string& filename, const char* m
     {
         // read the file from hardware
         const std::string fullPath = fullPathForFilename(filename);
+        std::string entryName;
+        if (auto packFile = getPackFileForPath(fullPath, &entryName))
+        {
+            Data data = packFile->getData(entryName);
+            buffer = data.getBytes();
+            *size = data.getSize();
+            // the caller owns the buffer
+            data.fastSet(nullptr, 0);
+            break;
+        }
+
         FILE *fp = fopen(getSuitableFOpen(fullPath).c_str(), mode);
         CC_BREAK_IF(!fp);
 
@@ -797,6 +846,69 @@ std::string FileUtils::getPathForFilename(const std::string& filename, const std
     return path;
 }
 
+std::string FileUtils::getPathForFilenameInPackFile(const std::string& filename, const std::string& resolutionDirectory, const std::string& searchPath, const PackFile& packFile) const
+{
+    // file_path + resourceDirectory + file, like getPathForFilename()
+    std::string entryName;
+    size_t pos = filename.find_last_of("/");
+    if (pos != std::string::npos)
+    {
+        entryName = filename.substr(0, pos+1);
+        entryName += resolutionDirectory;
+        entryName += filename.substr(pos+1);
+    }
+    else
+    {
+        entryName = resolutionDirectory + filename;
+    }
+
+    if (!packFile.hasEntry(entryName))
+    {
+        return "";
+    }
+    return searchPath + entryName;
+}
+
+std::shared_ptr<PackFile> FileUtils::getPackFileForPath(const std::string& fullPath, std::string* entryName) const
+{
+    for (const auto& iter : _packFiles)
+    {
+        // the search paths of pack files end with '/'
+        const std::string& searchPath = iter.first;
+        if (fullPath.size() > searchPath.size() && fullPath.compare(0, searchPath.size(), searchPath) == 0)
+        {
+            if (entryName)
+            {
+                *entryName = fullPath.substr(searchPath.size());
+            }
+            return iter.second;
+        }
+    }
+    return nullptr;
+}
+
+void FileUtils::openPackFileForSearchPath(const std::string& searchPath)
+{
+    const size_t extensionLength = strlen(PackFile::EXTENSION);
+    // without the '/' added to search paths
+    std::string path = searchPath.substr(0, searchPath.size() - 1);
+    if (path.size() <= extensionLength || path.compare(path.size() - extensionLength, extensionLength, PackFile::EXTENSION) != 0
+        || _packFiles.find(searchPath) != _packFiles.end())
+    {
+        return;
+    }
+
+    auto packFile = PackFile::open(path);
+    if (packFile)
+    {
+        _packFiles[searchPath] = packFile;
+    }
+    else
+    {
+        CCLOG("cocos2d: FileUtils: can't open the pack file %s", path.c_str());
+    }
+}
+
 std::string FileUtils::fullPathForFilename(const std::string &filename) const
 {
     if (filename.empty())
@@ -823,9 +935,18 @@ std::string FileUtils::fullPathForFilename(const std::string &filename) const
 
     for (const auto& searchIt : _searchPathArray)
     {
+        // pack files are searched in their index, without checking the file system
+        auto packIt = _packFiles.empty() ? _packFiles.end() : _packFiles.find(searchIt);
         for (const auto& resolutionIt : _searchResolutionsOrderArray)
         {
-            fullpath = this->getPathForFilename(newFilename, resolutionIt, searchIt);
+            if (packIt != _packFiles.end())
+            {
+                fullpath = getPathForFilenameInPackFile(newFilename, resolutionIt, searchIt, *packIt->second);
+            }
+            else
+            {
+                fullpath = this->getPathForFilename(newFilename, resolutionIt, searchIt);
+            }
 
             if (!fullpath.empty())
             {
@@ -935,6 +1056,7 @@ void FileUtils::setSearchPaths(const std::vector<std::string>& searchPaths)
             existDefaultRootPath = true;
         }
         _searchPathArray.push_back(path);
+        openPackFileForSearchPath(path);
     }
 
     if (!existDefaultRootPath)
@@ -942,6 +1064,19 @@ void FileUtils::setSearchPaths(const std::vector<std::string>& searchPaths)
         //CCLOG("Default root path doesn't exist, adding it.");
         _searchPathArray.push_back(_defaultResRootPath);
     }
+
+    // close the pack files which aren't searched anymore
+    for (auto iter = _packFiles.begin(); iter != _packFiles.end();)
+    {
+        if (std::find(_searchPathArray.begin(), _searchPathArray.end(), iter->first) == _searchPathArray.end())
+        {
+            iter = _packFiles.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
 }
 
 void FileUtils::addSearchPath(const std::string &searchpath,const bool front)
@@ -960,6 +1095,7 @@ void FileUtils::addSearchPath(const std::string &searchpath,const bool front)
     } else {
         _searchPathArray.push_back(path);
     }
+    openPackFileForSearchPath(path);
 }
 
 void FileUtils::setFilenameLookupDictionary(const ValueMap& filenameLookupDict)
@@ -1008,6 +1144,11 @@ bool FileUtils::isFileExist(const std::string& filename) const
 {
     if (isAbsolutePath(filename))
     {
+        std::string entryName;
+        if (auto packFile = getPackFileForPath(filename, &entryName))
+        {
+            return packFile->hasEntry(entryName);
+        }
         return isFileExistInternal(filename);
     }
     else
@@ -1250,6 +1391,12 @@ long FileUtils::getFileSize(const std::string &filepath)
             return 0;
     }
 
+    std::string entryName;
+    if (auto packFile = getPackFileForPath(fullpath, &entryName))
+    {
+        return (long)packFile->getEntrySize(entryName);
+    }
+
     struct stat info;
     // Get data associated with "crt_stat.c":
     int result = stat( fullpath.c_str(), &info );
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #ifndef __CC_FILEUTILS_H__
 #define __CC_FILEUTILS_H__
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -33,6 +34,8 @@ THE SOFTWARE.
 #include "base/ccTypes.h"
 #include "base/CCValue.h"
 #include "base/CCData.h"
+#include "platform/CCMappedFile.h"
+#include "platform/CCPackFile.h"
 
 NS_CC_BEGIN
 
@@ -99,6 +102,38 @@ public:
      */
     virtual Data getDataFromFile(const std::string& filename);
 
+    /**
+     *  Gets a read-only view of the content of a file, without copying it when possible.
+     *  By default it is the data returned by getDataFromFile(). If setFileMappingEnabled(true) was called, files on disk
+     *  and in pack files are memory mapped instead, the other files (like assets in the apk on Android) are still read
+     *  with getDataFromFile().
+     *  Use it for data which is only parsed, the view must outlive the uses of its bytes.
+     *
+     *  @return A MappedFile, null if the file can't be read.
+     *  @since v3.9
+     *  @js NA
+     *  @lua NA
+     */
+    virtual MappedFile mapFile(const std::string& filename);
+
+    /**
+     *  Sets whether mapFile() memory maps the files instead of reading them with getDataFromFile().
+     *  It is disabled by default, since the mapped bytes don't go through a getDataFromFile() overridden
+     *  to transform the data, like decrypting it. Enable it if the files are used as they are.
+     *  @since v3.9
+     *  @js NA
+     *  @lua NA
+     */
+    void setFileMappingEnabled(bool enabled) { _fileMappingEnabled = enabled; }
+
+    /**
+     *  Returns whether mapFile() memory maps the files, see setFileMappingEnabled().
+     *  @since v3.9
+     *  @js NA
+     *  @lua NA
+     */
+    bool isFileMappingEnabled() const { return _fileMappingEnabled; }
+
     /**
      *  Gets resource file data
      *
@@ -279,10 +314,25 @@ public:
     /**
       * Add search path.
       *
+      * A search path ending with PackFile::EXTENSION (".cpk") is opened as a pack file,
+      * its entries are found without checking the file system, see PackFile.
+      *
       * @since v2.1
       */
     void addSearchPath(const std::string & path, const bool front=false);
 
+    /**
+     *  Gets the pack file containing a full path.
+     *
+     *  @param fullPath A full path, as returned by fullPathForFilename().
+     *  @param entryName If not null, set to the name of the entry in the pack file.
+     *  @return The pack file, nullptr if the path isn't in a pack file added as a search path.
+     *  @since v3.9
+     *  @js NA
+     *  @lua NA
+     */
+    std::shared_ptr<PackFile> getPackFileForPath(const std::string& fullPath, std::string* entryName = nullptr) const;
+
     /**
      *  Gets the array of search paths.
      *
@@ -538,6 +588,19 @@ protected:
      */
     virtual std::string getFullPathForDirectoryAndFilename(const std::string& directory, const std::string& filename) const;
 
+    /**
+     *  Gets full path for filename, resolution directory and the search path of a pack file.
+     *  The entry is looked up in the index of the pack file.
+     *
+     *  @return The full path of the entry, or an empty string if it isn't in the pack file.
+     */
+    std::string getPathForFilenameInPackFile(const std::string& filename, const std::string& resolutionDirectory, const std::string& searchPath, const PackFile& packFile) const;
+
+    /**
+     *  Opens the pack file of a search path if it has the extension of pack files.
+     */
+    void openPackFileForSearchPath(const std::string& searchPath);
+
     /** Dictionary used to lookup filenames based on a key.
      *  It is used internally by the following methods:
      *
@@ -559,6 +622,16 @@ protected:
      */
     std::vector<std::string> _searchPathArray;
 
+    /**
+     * The pack files in the search paths, by search path.
+     */
+    std::unordered_map<std::string, std::shared_ptr<PackFile>> _packFiles;
+
+    /**
+     * Whether mapFile() maps the files, false by default.
+     */
+    bool _fileMappingEnabled;
+
     /**
      *  The default root path of resources.
      *  If the default root path of resources needs to be changed, do it in the `init` method of FileUtils's subclass.
@@ -27,6 +27,8 @@ THE SOFTWARE.
 #include "platform/CCImage.h"
 
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <ctype.h>
 
 #include "base/CCData.h"
@@ -81,6 +83,7 @@ extern "C"
 #include "base/ccMacros.h"
 #include "CCCommon.h"
 #include "CCStdC.h"
+#include "renderer/CCPixelConversion.h"
 #include "CCFileUtils.h"
 #include "base/CCConfiguration.h"
 #include "base/ccUtils.h"
@@ -428,7 +431,72 @@ namespace
             png_error(png_ptr, "pngReaderCallback failed");
         }
     }
+
+    // sets up the transforms to 8 bits per channel, returns the color type of the rows that are read
+    static png_uint_32 pngSetupTransforms(png_structp png_ptr, png_infop info_ptr, Texture2D::PixelFormat* renderFormat)
+    {
+        png_byte bit_depth = png_get_bit_depth(png_ptr, info_ptr);
+        png_uint_32 color_type = png_get_color_type(png_ptr, info_ptr);
+
+        //CCLOG("color type %u", color_type);
+
+        // force palette images to be expanded to 24-bit RGB
+        // it may include alpha channel
+        if (color_type == PNG_COLOR_TYPE_PALETTE)
+        {
+            png_set_palette_to_rgb(png_ptr);
+        }
+        // low-bit-depth grayscale images are to be expanded to 8 bits
+        if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
+        {
+            bit_depth = 8;
+            png_set_expand_gray_1_2_4_to_8(png_ptr);
+        }
+        // expand any tRNS chunk data into a full alpha channel
+        if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
+        {
+            png_set_tRNS_to_alpha(png_ptr);
+        }  
+        // reduce images with 16-bit samples to 8 bits
+        if (bit_depth == 16)
+        {
+            png_set_strip_16(png_ptr);            
+        } 
+
+        // Expanded earlier for grayscale, now take care of palette and rgb
+        if (bit_depth < 8)
+        {
+            png_set_packing(png_ptr);
+        }
+        // update info
+        png_read_update_info(png_ptr, info_ptr);
+        color_type = png_get_color_type(png_ptr, info_ptr);
+
+        switch (color_type)
+        {
+        case PNG_COLOR_TYPE_GRAY:
+            *renderFormat = Texture2D::PixelFormat::I8;
+            break;
+        case PNG_COLOR_TYPE_GRAY_ALPHA:
+            *renderFormat = Texture2D::PixelFormat::AI88;
+            break;
+        case PNG_COLOR_TYPE_RGB:
+            *renderFormat = Texture2D::PixelFormat::RGB888;
+            break;
+        case PNG_COLOR_TYPE_RGB_ALPHA:
+            *renderFormat = Texture2D::PixelFormat::RGBA8888;
+            break;
+        default:
+            break;
+        }
+        return color_type;
+    }
 #endif //CC_USE_PNG
+
+    static void premultiplyAlphaRGBA8888(unsigned char* data, ssize_t pixelCount)
+    {
+        PixelConversion::premultiplyAlpha(data, pixelCount * 4);
+    }
 }
 
 Texture2D::PixelFormat getDevicePixelFormat(Texture2D::PixelFormat format)
@@ -1043,61 +1111,7 @@ bool Image::initWithPngData(const unsigned char * data, ssize_t dataLen)
 
         _width = png_get_image_width(png_ptr, info_ptr);
         _height = png_get_image_height(png_ptr, info_ptr);
-        png_byte bit_depth = png_get_bit_depth(png_ptr, info_ptr);
-        png_uint_32 color_type = png_get_color_type(png_ptr, info_ptr);
-
-        //CCLOG("color type %u", color_type);
-
-        // force palette images to be expanded to 24-bit RGB
-        // it may include alpha channel
-        if (color_type == PNG_COLOR_TYPE_PALETTE)
-        {
-            png_set_palette_to_rgb(png_ptr);
-        }
-        // low-bit-depth grayscale images are to be expanded to 8 bits
-        if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
-        {
-            bit_depth = 8;
-            png_set_expand_gray_1_2_4_to_8(png_ptr);
-        }
-        // expand any tRNS chunk data into a full alpha channel
-        if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
-        {
-            png_set_tRNS_to_alpha(png_ptr);
-        }  
-        // reduce images with 16-bit samples to 8 bits
-        if (bit_depth == 16)
-        {
-            png_set_strip_16(png_ptr);            
-        } 
-
-        // Expanded earlier for grayscale, now take care of palette and rgb
-        if (bit_depth < 8)
-        {
-            png_set_packing(png_ptr);
-        }
-        // update info
-        png_read_update_info(png_ptr, info_ptr);
-        bit_depth = png_get_bit_depth(png_ptr, info_ptr);
-        color_type = png_get_color_type(png_ptr, info_ptr);
-
-        switch (color_type)
-        {
-        case PNG_COLOR_TYPE_GRAY:
-            _renderFormat = Texture2D::PixelFormat::I8;
-            break;
-        case PNG_COLOR_TYPE_GRAY_ALPHA:
-            _renderFormat = Texture2D::PixelFormat::AI88;
-            break;
-        case PNG_COLOR_TYPE_RGB:
-            _renderFormat = Texture2D::PixelFormat::RGB888;
-            break;
-        case PNG_COLOR_TYPE_RGB_ALPHA:
-            _renderFormat = Texture2D::PixelFormat::RGBA8888;
-            break;
-        default:
-            break;
-        }
+        png_uint_32 color_type = pngSetupTransforms(png_ptr, info_ptr, &_renderFormat);
 
         // read png data
         png_size_t rowbytes;
@@ -1153,6 +1167,217 @@ bool Image::initWithPngData(const unsigned char * data, ssize_t dataLen)
 #endif //CC_USE_PNG
 }
 
+bool Image::initWithImageFileInBands(const std::string& path, int bandHeight, const RowBandCallback& callback)
+{
+    CCASSERT(bandHeight > 0, "Invalid band height");
+
+    bool ret = false;
+    _filePath = FileUtils::getInstance()->fullPathForFilename(path);
+
+    // the compressed file is small compared to the decoded image
+    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    if (data.isNull())
+    {
+        return false;
+    }
+
+    _fileType = detectFormat(data.getBytes(), data.getSize());
+    switch (_fileType)
+    {
+    case Format::PNG:
+        ret = initWithPngDataInBands(data.getBytes(), data.getSize(), bandHeight, callback);
+        break;
+    case Format::JPG:
+        ret = initWithJpgDataInBands(data.getBytes(), data.getSize(), bandHeight, callback);
+        break;
+    default:
+        CCLOG("cocos2d: Image: only PNG and JPEG files can be decoded in bands: %s", _filePath.c_str());
+        break;
+    }
+
+    return ret;
+}
+
+bool Image::decodeBandsFromData(int bandHeight, const RowBandCallback& callback)
+{
+    ssize_t rowBytes = _dataLen / _height;
+    bool ret = true;
+    for (int y = 0; y < _height && ret; y += bandHeight)
+    {
+        ret = callback(_data + y * rowBytes, y, std::min(bandHeight, _height - y));
+    }
+
+    free(_data);
+    _data = nullptr;
+    _dataLen = 0;
+    return ret;
+}
+
+bool Image::initWithPngDataInBands(const unsigned char * data, ssize_t dataLen, int bandHeight, const RowBandCallback& callback)
+{
+#if CC_USE_WIC
+    CCLOG("cocos2d: Image: decoding in bands isn't supported with WIC, the whole image is decoded");
+    return initWithPngData(data, dataLen) && decodeBandsFromData(bandHeight, callback);
+#elif CC_USE_PNG
+    bool ret = false;
+    png_structp     png_ptr     =   0;
+    png_infop       info_ptr    = 0;
+    std::vector<unsigned char> band;
+    std::vector<png_bytep> rowPointers;
+    bool interlaced = false;
+
+    do 
+    {
+        CC_BREAK_IF(!isPng(data, dataLen));
+
+        png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, 0, 0, 0);
+        CC_BREAK_IF(! png_ptr);
+
+        info_ptr = png_create_info_struct(png_ptr);
+        CC_BREAK_IF(!info_ptr);
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_BADA && CC_TARGET_PLATFORM != CC_PLATFORM_NACL)
+        CC_BREAK_IF(setjmp(png_jmpbuf(png_ptr)));
+#endif
+
+        tImageSource imageSource;
+        imageSource.data    = (unsigned char*)data;
+        imageSource.size    = dataLen;
+        imageSource.offset  = 0;
+        png_set_read_fn(png_ptr, &imageSource, pngReadCallback);
+
+        png_read_info(png_ptr, info_ptr);
+
+        // the rows of an interlaced image are only complete after the last pass
+        if (png_get_interlace_type(png_ptr, info_ptr) != PNG_INTERLACE_NONE)
+        {
+            interlaced = true;
+            break;
+        }
+
+        _width = png_get_image_width(png_ptr, info_ptr);
+        _height = png_get_image_height(png_ptr, info_ptr);
+        png_uint_32 color_type = pngSetupTransforms(png_ptr, info_ptr, &_renderFormat);
+        _hasPremultipliedAlpha = (color_type == PNG_COLOR_TYPE_RGB_ALPHA);
+
+        png_size_t rowbytes = png_get_rowbytes(png_ptr, info_ptr);
+        band.resize(rowbytes * bandHeight);
+        rowPointers.resize(bandHeight);
+        for (int i = 0; i < bandHeight; ++i)
+        {
+            rowPointers[i] = band.data() + i * rowbytes;
+        }
+
+        bool stopped = false;
+        for (int y = 0; y < _height && !stopped; y += bandHeight)
+        {
+            int rows = std::min(bandHeight, _height - y);
+            png_read_rows(png_ptr, rowPointers.data(), nullptr, rows);
+
+            if (_hasPremultipliedAlpha)
+            {
+                premultiplyAlphaRGBA8888(band.data(), (ssize_t)_width * rows);
+            }
+            stopped = !callback(band.data(), y, rows);
+        }
+        CC_BREAK_IF(stopped);
+
+        png_read_end(png_ptr, nullptr);
+
+        ret = true;
+    } while (0);
+
+    if (png_ptr)
+    {
+        png_destroy_read_struct(&png_ptr, (info_ptr) ? &info_ptr : 0, 0);
+    }
+
+    if (interlaced)
+    {
+        CCLOG("cocos2d: Image: %s is an interlaced PNG, the whole image is decoded", _filePath.c_str());
+        ret = initWithPngData(data, dataLen) && decodeBandsFromData(bandHeight, callback);
+    }
+    return ret;
+#else
+    CCLOG("png is not enabled, please enable it in ccConfig.h");
+    return false;
+#endif //CC_USE_PNG
+}
+
+bool Image::initWithJpgDataInBands(const unsigned char * data, ssize_t dataLen, int bandHeight, const RowBandCallback& callback)
+{
+#if CC_USE_WIC
+    CCLOG("cocos2d: Image: decoding in bands isn't supported with WIC, the whole image is decoded");
+    return initWithJpgData(data, dataLen) && decodeBandsFromData(bandHeight, callback);
+#elif CC_USE_JPEG
+    struct jpeg_decompress_struct cinfo;
+    struct MyErrorMgr jerr;
+    std::vector<unsigned char> band;
+    JSAMPROW row_pointer[1] = {0};
+
+    bool ret = false;
+    do 
+    {
+        cinfo.err = jpeg_std_error(&jerr.pub);
+        jerr.pub.error_exit = myErrorExit;
+        if (setjmp(jerr.setjmp_buffer))
+        {
+            jpeg_destroy_decompress(&cinfo);
+            break;
+        }
+
+        jpeg_create_decompress( &cinfo );
+
+#ifndef CC_TARGET_QT5
+        jpeg_mem_src(&cinfo, const_cast<unsigned char*>(data), dataLen);
+#endif /* CC_TARGET_QT5 */
+
+        jpeg_read_header(&cinfo, TRUE);
+
+        // we only support RGB or grayscale
+        if (cinfo.jpeg_color_space == JCS_GRAYSCALE)
+        {
+            _renderFormat = Texture2D::PixelFormat::I8;
+        }else
+        {
+            cinfo.out_color_space = JCS_RGB;
+            _renderFormat = Texture2D::PixelFormat::RGB888;
+        }
+
+        jpeg_start_decompress( &cinfo );
+
+        _width  = cinfo.output_width;
+        _height = cinfo.output_height;
+        _hasPremultipliedAlpha = false;
+
+        size_t rowBytes = cinfo.output_width*cinfo.output_components;
+        band.resize(rowBytes * bandHeight);
+
+        bool stopped = false;
+        while (cinfo.output_scanline < cinfo.output_height && !stopped)
+        {
+            int y = cinfo.output_scanline;
+            int rows = std::min(bandHeight, _height - y);
+            for (int i = 0; i < rows; ++i)
+            {
+                row_pointer[0] = band.data() + i * rowBytes;
+                jpeg_read_scanlines(&cinfo, row_pointer, 1);
+            }
+            stopped = !callback(band.data(), y, rows);
+        }
+
+        // see initWithJpgData, jpeg_finish_decompress() isn't needed
+        jpeg_destroy_decompress( &cinfo );
+        ret = !stopped;
+    } while (0);
+
+    return ret;
+#else
+    CCLOG("jpeg is not enabled, please enable it in ccConfig.h");
+    return false;
+#endif // CC_USE_JPEG
+}
+
 #if CC_USE_TIFF
 namespace
 {
@@ -2451,12 +2676,7 @@ void Image::premultipliedAlpha()
 {
     CCASSERT(_renderFormat == Texture2D::PixelFormat::RGBA8888, "The pixel format should be RGBA8888!");
     
-    unsigned int* fourBytes = (unsigned int*)_data;
-    for(int i = 0; i < _width * _height; i++)
-    {
-        unsigned char* p = _data + i * 4;
-        fourBytes[i] = CC_RGB_PREMULTIPLY_ALPHA(p[0], p[1], p[2], p[3]);
-    }
+    premultiplyAlphaRGBA8888(_data, _width * _height);
     
     _hasPremultipliedAlpha = true;
 }
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #define __CC_IMAGE_H__
 /// @cond DO_NOT_SHOW
 
+#include <functional>
 #include "base/CCRef.h"
 #include "renderer/CCTexture2D.h"
 
@@ -117,6 +118,26 @@ public:
     */
     bool initWithImageData(const unsigned char * data, ssize_t dataLen);
 
+    /** Called by initWithImageFileInBands with each band of decoded rows.
+     * @param data The pixels of the rows, in the render format of the image. RGBA8888 pixels have premultiplied alpha.
+     * @param y The index of the first row of the band.
+     * @param rows The number of rows in the band.
+     * @return false to stop decoding.
+     */
+    typedef std::function<bool(const unsigned char* data, int y, int rows)> RowBandCallback;
+
+    /**
+    @brief Decodes a PNG or JPEG file a band of rows at a time, so the whole image is never decoded in memory.
+    The width, height and render format are known when the callback is first called. The image keeps no pixel data.
+    Interlaced PNG files can't be decoded by rows, they are decoded entirely first.
+    @param path   the file path.
+    @param bandHeight   the number of rows decoded before each call of the callback, the last band may have less.
+    @param callback   called with each band of rows, from top to bottom.
+    @return true if the whole image was decoded.
+    @since v3.9
+    */
+    bool initWithImageFileInBands(const std::string& path, int bandHeight, const RowBandCallback& callback);
+
     // @warning kFmtRawData only support RGBA8888
     bool initWithRawData(const unsigned char * data, ssize_t dataLen, int width, int height, int bitsPerComponent, bool preMulti = false);
 
@@ -160,6 +181,10 @@ protected:
 #endif
     bool initWithJpgData(const unsigned char *  data, ssize_t dataLen);
     bool initWithPngData(const unsigned char * data, ssize_t dataLen);
+    bool initWithJpgDataInBands(const unsigned char * data, ssize_t dataLen, int bandHeight, const RowBandCallback& callback);
+    bool initWithPngDataInBands(const unsigned char * data, ssize_t dataLen, int bandHeight, const RowBandCallback& callback);
+    // calls the callback with the bands of _data, then frees it
+    bool decodeBandsFromData(int bandHeight, const RowBandCallback& callback);
     bool initWithTiffData(const unsigned char * data, ssize_t dataLen);
     bool initWithWebpData(const unsigned char * data, ssize_t dataLen);
     bool initWithPVRData(const unsigned char * data, ssize_t dataLen);
@@ -0,0 +1,218 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "platform/CCMappedFile.h"
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+#include <windows.h>
+#elif CC_TARGET_PLATFORM != CC_PLATFORM_WINRT
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+NS_CC_BEGIN
+
+MappedFile::MappedFile()
+: _bytes(nullptr)
+, _size(0)
+, _mapping(nullptr)
+, _mapped(false)
+{
+}
+
+MappedFile::MappedFile(Data&& data)
+: _bytes(nullptr)
+, _size(0)
+, _mapping(nullptr)
+, _mapped(false)
+, _data(std::move(data))
+{
+    _bytes = _data.getBytes();
+    _size = _data.getSize();
+}
+
+MappedFile::MappedFile(const unsigned char* bytes, ssize_t size, const std::shared_ptr<const void>& owner, bool mapped)
+: _bytes(bytes)
+, _size(size)
+, _mapping(nullptr)
+, _mapped(mapped)
+, _owner(owner)
+{
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+: _bytes(nullptr)
+, _size(0)
+, _mapping(nullptr)
+, _mapped(false)
+{
+    move(other);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile& MappedFile::operator= (MappedFile&& other)
+{
+    if (this != &other)
+    {
+        close();
+        move(other);
+    }
+    return *this;
+}
+
+void MappedFile::move(MappedFile& other)
+{
+    _bytes = other._bytes;
+    _size = other._size;
+    _mapping = other._mapping;
+    _mapped = other._mapped;
+    _data = std::move(other._data);
+    _owner = std::move(other._owner);
+
+    other._bytes = nullptr;
+    other._size = 0;
+    other._mapping = nullptr;
+    other._mapped = false;
+}
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+
+bool MappedFile::map(const std::string& path)
+{
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    void* view = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+        HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping)
+        {
+            // the view keeps the mapping alive
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+
+    if (view == nullptr)
+        return false;
+
+    _mapping = view;
+    _mapped = true;
+    _bytes = (const unsigned char*)view;
+    _size = (ssize_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_mapping)
+    {
+        UnmapViewOfFile(_mapping);
+        _mapping = nullptr;
+    }
+    _mapped = false;
+    _data.clear();
+    _owner.reset();
+    _bytes = nullptr;
+    _size = 0;
+}
+
+#elif CC_TARGET_PLATFORM == CC_PLATFORM_WINRT
+
+bool MappedFile::map(const std::string& path)
+{
+    // not supported, FileUtils::mapFile() reads the file instead
+    close();
+    return false;
+}
+
+void MappedFile::close()
+{
+    _mapped = false;
+    _data.clear();
+    _owner.reset();
+    _bytes = nullptr;
+    _size = 0;
+}
+
+#else
+
+bool MappedFile::map(const std::string& path)
+{
+    close();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    void* view = MAP_FAILED;
+    // mapping 0 bytes fails
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // the mapping stays valid after the file is closed
+    ::close(fd);
+
+    if (view == MAP_FAILED)
+        return false;
+
+    _mapping = view;
+    _mapped = true;
+    _bytes = (const unsigned char*)view;
+    _size = (ssize_t)st.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_mapping)
+    {
+        munmap(_mapping, (size_t)_size);
+        _mapping = nullptr;
+    }
+    _mapped = false;
+    _data.clear();
+    _owner.reset();
+    _bytes = nullptr;
+    _size = 0;
+}
+
+#endif
+
+NS_CC_END
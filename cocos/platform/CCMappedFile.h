@@ -0,0 +1,127 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#ifndef __CC_MAPPED_FILE_H__
+#define __CC_MAPPED_FILE_H__
+
+#include <memory>
+#include <string>
+
+#include "platform/CCPlatformMacros.h"
+#include "base/CCData.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * A read-only view of the content of a file.
+ *
+ * Files on disk are memory mapped, so their content is paged in by the OS on demand and never copied
+ * to the heap. Files which can't be mapped, like the assets in the apk on Android, are read into memory
+ * instead, which can be checked with isMapped(). Get one with FileUtils::mapFile().
+ *
+ * MappedFile can be moved but not copied, the view is unmapped when the MappedFile is destroyed.
+ * @since v3.9
+ * @js NA
+ * @lua NA
+ */
+class CC_DLL MappedFile
+{
+public:
+    /** Constructs a null MappedFile. */
+    MappedFile();
+
+    /** Constructs a MappedFile viewing data read into memory, it takes the ownership of the bytes of data. */
+    explicit MappedFile(Data&& data);
+
+    /**
+     * Constructs a MappedFile viewing bytes owned by another object, like an entry of a PackFile.
+     *
+     * @param owner Kept alive until the MappedFile is closed.
+     * @param mapped Whether the bytes are memory mapped.
+     */
+    MappedFile(const unsigned char* bytes, ssize_t size, const std::shared_ptr<const void>& owner, bool mapped);
+
+    /** Move constructor of MappedFile. */
+    MappedFile(MappedFile&& other);
+
+    /** Unmaps the file. */
+    ~MappedFile();
+
+    /** Move assignment of MappedFile. */
+    MappedFile& operator= (MappedFile&& other);
+
+    /**
+     * Maps a file read-only, the previous view is closed.
+     *
+     * @param path The path of the file, as passed to fopen, see FileUtils::getSuitableFOpen().
+     * @return True if the file is mapped, false if it doesn't exist, is empty or can't be mapped on this platform.
+     */
+    bool map(const std::string& path);
+
+    /** Unmaps the file or frees the data, the MappedFile is null after this. */
+    void close();
+
+    /**
+     * Gets the bytes of the file, they are valid until the MappedFile is closed or destroyed.
+     * The bytes are read-only, writing them crashes when the file is mapped.
+     */
+    const unsigned char* getBytes() const { return _bytes; }
+
+    /** Gets the size of the file in bytes. */
+    ssize_t getSize() const { return _size; }
+
+    /** Whether the MappedFile has no content. */
+    bool isNull() const { return _bytes == nullptr || _size == 0; }
+
+    /** Whether the content is memory mapped, false if it was read into memory. */
+    bool isMapped() const { return _mapped; }
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(MappedFile);
+
+    void move(MappedFile& other);
+
+    const unsigned char* _bytes;
+    ssize_t _size;
+    // the mapped view, nullptr if not mapped
+    void* _mapping;
+    bool _mapped;
+    // the content when it was read into memory
+    Data _data;
+    // the owner of the bytes when they are viewed in another object
+    std::shared_ptr<const void> _owner;
+};
+
+// end of platform group
+/** @} */
+
+NS_CC_END
+
+#endif // __CC_MAPPED_FILE_H__
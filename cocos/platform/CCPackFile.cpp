@@ -0,0 +1,263 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "platform/CCPackFile.h"
+
+#include <string.h>
+#include <zlib.h>
+
+#include "platform/CCFileUtils.h"
+#include "base/ccMacros.h"
+
+NS_CC_BEGIN
+
+namespace
+{
+    const char PACK_MAGIC[4] = { 'C', 'C', 'P', 'K' };
+    const uint32_t PACK_VERSION = 1;
+    const uint32_t NO_ENTRY = 0xFFFFFFFF;
+
+    // how the data of an entry is stored
+    enum PackCompression : uint8_t
+    {
+        PACK_COMPRESSION_NONE = 0,
+        PACK_COMPRESSION_ZLIB = 1,
+    };
+
+    struct PackHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t bucketCount;
+        uint32_t namesOffset;
+        uint32_t reserved[3];
+    };
+    static_assert(sizeof(PackHeader) == 32, "the pack header is 32 bytes");
+}
+
+struct PackFile::Entry
+{
+    uint32_t hash;
+    uint32_t next;
+    uint32_t nameOffset;
+    uint16_t nameLength;
+    uint8_t compression;
+    uint8_t reserved;
+    uint64_t dataOffset;
+    uint32_t storedSize;
+    uint32_t size;
+};
+
+const char* PackFile::EXTENSION = ".cpk";
+
+std::shared_ptr<PackFile> PackFile::open(const std::string& filename)
+{
+    std::shared_ptr<PackFile> pack(new (std::nothrow) PackFile());
+    if (pack && pack->init(filename))
+    {
+        return pack;
+    }
+    return nullptr;
+}
+
+uint32_t PackFile::hashName(const char* name, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+PackFile::PackFile()
+: _entryCount(0)
+, _bucketMask(0)
+, _buckets(nullptr)
+, _entries(nullptr)
+, _names(nullptr)
+{
+}
+
+PackFile::~PackFile()
+{
+}
+
+bool PackFile::init(const std::string& filename)
+{
+    static_assert(sizeof(Entry) == 32, "the pack entries are 32 bytes");
+
+    _path = filename;
+    // the pack format is read as it is, the archive is mapped even if FileUtils doesn't map the files
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isAbsolutePath(filename) || !_file.map(fileUtils->getSuitableFOpen(filename)))
+    {
+        _file = fileUtils->mapFile(filename);
+    }
+    if (_file.isNull())
+    {
+        CCLOG("cocos2d: PackFile: can't read %s", filename.c_str());
+        return false;
+    }
+
+    const unsigned char* bytes = _file.getBytes();
+    uint64_t fileSize = (uint64_t)_file.getSize();
+    const PackHeader* header = (const PackHeader*)bytes;
+    if (fileSize < sizeof(PackHeader) || memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || header->version != PACK_VERSION)
+    {
+        CCLOG("cocos2d: PackFile: %s isn't a pack file of version %u", filename.c_str(), PACK_VERSION);
+        return false;
+    }
+
+    uint64_t bucketCount = header->bucketCount;
+    uint64_t entriesOffset = sizeof(PackHeader) + bucketCount * sizeof(uint32_t);
+    uint64_t namesEnd = entriesOffset + (uint64_t)header->entryCount * sizeof(Entry);
+    // the buckets are a power of 2, and an even count keeps the entries 8 byte aligned
+    if (bucketCount < 2 || (bucketCount & (bucketCount - 1)) != 0
+        || header->namesOffset != namesEnd || namesEnd > fileSize)
+    {
+        CCLOG("cocos2d: PackFile: %s has an invalid index", filename.c_str());
+        return false;
+    }
+
+    _entryCount = header->entryCount;
+    _bucketMask = (uint32_t)bucketCount - 1;
+    _buckets = (const uint32_t*)(bytes + sizeof(PackHeader));
+    _entries = (const Entry*)(bytes + entriesOffset);
+    _names = (const char*)(bytes + header->namesOffset);
+
+    for (ssize_t i = 0; i < _entryCount; ++i)
+    {
+        const Entry& entry = _entries[i];
+        if (header->namesOffset + (uint64_t)entry.nameOffset + entry.nameLength > fileSize
+            || entry.dataOffset + entry.storedSize > fileSize
+            || (entry.next != NO_ENTRY && entry.next >= (uint32_t)_entryCount)
+            || (entry.compression != PACK_COMPRESSION_NONE && entry.compression != PACK_COMPRESSION_ZLIB)
+            || (entry.compression == PACK_COMPRESSION_NONE && entry.storedSize != entry.size))
+        {
+            CCLOG("cocos2d: PackFile: %s has an invalid entry %d", filename.c_str(), (int)i);
+            return false;
+        }
+    }
+    for (uint64_t i = 0; i < bucketCount; ++i)
+    {
+        if (_buckets[i] != NO_ENTRY && _buckets[i] >= (uint32_t)_entryCount)
+        {
+            CCLOG("cocos2d: PackFile: %s has an invalid bucket %d", filename.c_str(), (int)i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const PackFile::Entry* PackFile::findEntry(const std::string& name) const
+{
+    uint32_t hash = hashName(name.c_str(), name.size());
+    // the chains are built by the pack builder, don't loop forever on a corrupted one
+    ssize_t steps = 0;
+    for (uint32_t index = _buckets[hash & _bucketMask]; index != NO_ENTRY && steps < _entryCount; index = _entries[index].next, ++steps)
+    {
+        const Entry& entry = _entries[index];
+        if (entry.hash == hash && entry.nameLength == name.size()
+            && memcmp(_names + entry.nameOffset, name.c_str(), name.size()) == 0)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool PackFile::hasEntry(const std::string& name) const
+{
+    return findEntry(name) != nullptr;
+}
+
+ssize_t PackFile::getEntrySize(const std::string& name) const
+{
+    const Entry* entry = findEntry(name);
+    return entry ? (ssize_t)entry->size : -1;
+}
+
+Data PackFile::getData(const std::string& name, bool nullTerminated) const
+{
+    Data ret;
+    const Entry* entry = findEntry(name);
+    if (entry == nullptr)
+    {
+        CCLOG("cocos2d: PackFile: no entry %s in %s", name.c_str(), _path.c_str());
+        return ret;
+    }
+
+    size_t size = entry->size;
+    unsigned char* buffer = (unsigned char*)malloc(size + (nullTerminated ? 1 : 0));
+    if (buffer == nullptr)
+    {
+        return ret;
+    }
+
+    const unsigned char* stored = _file.getBytes() + entry->dataOffset;
+    if (entry->compression == PACK_COMPRESSION_NONE)
+    {
+        memcpy(buffer, stored, size);
+    }
+    else
+    {
+        uLongf destLen = (uLongf)size;
+        int err = uncompress(buffer, &destLen, stored, (uLong)entry->storedSize);
+        if (err != Z_OK || destLen != size)
+        {
+            CCLOG("cocos2d: PackFile: can't decompress %s in %s, error %d", name.c_str(), _path.c_str(), err);
+            free(buffer);
+            return ret;
+        }
+    }
+
+    if (nullTerminated)
+    {
+        buffer[size] = '\0';
+    }
+    ret.fastSet(buffer, size);
+    return ret;
+}
+
+MappedFile PackFile::map(const std::string& name) const
+{
+    const Entry* entry = findEntry(name);
+    if (entry == nullptr)
+    {
+        return MappedFile();
+    }
+
+    if (entry->compression == PACK_COMPRESSION_NONE)
+    {
+        return MappedFile(_file.getBytes() + entry->dataOffset, entry->size, shared_from_this(), _file.isMapped());
+    }
+    return MappedFile(getData(name));
+}
+
+NS_CC_END
@@ -0,0 +1,142 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#ifndef __CC_PACK_FILE_H__
+#define __CC_PACK_FILE_H__
+
+#include <memory>
+#include <string>
+
+#include "platform/CCPlatformMacros.h"
+#include "base/ccConfig.h"
+#include "platform/CCMappedFile.h"
+#include "base/CCData.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * A read-only archive of resources, with a prebuilt hash index of its entries.
+ *
+ * Pack files are built from a resources directory with tools/pack-builder/build_pack.py. Adding a pack file
+ * as a search path with FileUtils::addSearchPath() makes its entries readable like the files of a directory,
+ * e.g. "images/hero.png" in "res.cpk" has the full path "<search paths>/res.cpk/images/hero.png".
+ * Looking up an entry hashes its name once instead of checking the file system for every search path and
+ * resolution directory.
+ *
+ * The pack file is memory mapped, entries stored uncompressed are returned as views of the mapping by map(),
+ * entries compressed with zlib are decompressed when read.
+ *
+ * The layout of a pack file, all integers are little endian:
+ * - Header: "CCPK", version, entry count, bucket count (a power of 2), offset of the names.
+ * - Buckets: bucket count uint32, the index of the first entry whose hash falls in the bucket, or 0xFFFFFFFF.
+ * - Entries: FNV-1a hash of the name, index of the next entry of the bucket, name offset, name length (16 bits),
+ *   compression method (8 bits, 0 for stored and 1 for zlib), a reserved byte, data offset, stored size and size.
+ * - Names, then the data of the entries, aligned to 16 bytes.
+ *
+ * A PackFile can be used from any thread once opened.
+ * @since v3.9
+ * @js NA
+ * @lua NA
+ */
+class CC_DLL PackFile : public std::enable_shared_from_this<PackFile>
+{
+public:
+    /** The extension of pack files, FileUtils::addSearchPath() opens search paths with this extension as pack files. */
+    static const char* EXTENSION;
+
+    /**
+     * Opens a pack file.
+     *
+     * @param filename The pack file, see FileUtils::mapFile().
+     * @return The pack file, or nullptr if it can't be read or isn't a valid pack file.
+     */
+    static std::shared_ptr<PackFile> open(const std::string& filename);
+
+    /** Whether the pack file has an entry. The name is relative to the pack file, with '/' separators. */
+    bool hasEntry(const std::string& name) const;
+
+    /** Gets the size of an entry once decompressed, -1 if there is no such entry. */
+    ssize_t getEntrySize(const std::string& name) const;
+
+    /**
+     * Reads an entry, decompressing it if needed.
+     *
+     * @param nullTerminated Whether to add a '\0' after the data, which isn't counted in its size.
+     * @return The data of the entry, null if there is no such entry or it can't be decompressed.
+     */
+    Data getData(const std::string& name, bool nullTerminated = false) const;
+
+    /**
+     * Gets a view of an entry. Entries stored uncompressed aren't copied, the view keeps the pack file open.
+     * Compressed entries are decompressed into the returned MappedFile.
+     */
+    MappedFile map(const std::string& name) const;
+
+    /** Gets the number of entries. */
+    ssize_t getEntryCount() const { return _entryCount; }
+
+    /** Gets the path of the pack file, as passed to open(). */
+    const std::string& getPath() const { return _path; }
+
+    /** Hashes an entry name, with FNV-1a. */
+    static uint32_t hashName(const char* name, size_t length);
+
+    /** Unmaps the pack file. */
+    ~PackFile();
+
+CC_CONSTRUCTOR_ACCESS:
+    PackFile();
+
+    bool init(const std::string& filename);
+
+protected:
+    struct Entry;
+
+    // the entry of a name, nullptr if there is no such entry
+    const Entry* findEntry(const std::string& name) const;
+
+    std::string _path;
+    MappedFile _file;
+    ssize_t _entryCount;
+    uint32_t _bucketMask;
+    const uint32_t* _buckets;
+    const Entry* _entries;
+    const char* _names;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(PackFile);
+};
+
+// end of platform group
+/** @} */
+
+NS_CC_END
+
+#endif // __CC_PACK_FILE_H__
@@ -266,6 +266,12 @@ Data FileUtilsAndroid::getData(const std::string& filename, bool forString)
     string fullPath = fullPathForFilename(filename);
     cocosplay::updateAssets(fullPath);
 
+    string entryName;
+    if (auto packFile = getPackFileForPath(fullPath, &entryName))
+    {
+        return packFile->getData(entryName, forString);
+    }
+
     if (fullPath[0] != '/')
     {
         string relativePath = string();
@@ -389,6 +395,17 @@ unsigned char* FileUtilsAndroid::getFileData(const std::string& filename, const
     string fullPath = fullPathForFilename(filename);
     cocosplay::updateAssets(fullPath);
 
+    string entryName;
+    if (auto packFile = getPackFileForPath(fullPath, &entryName))
+    {
+        Data packData = packFile->getData(entryName);
+        data = packData.getBytes();
+        *size = packData.getSize();
+        // the caller owns the buffer
+        packData.fastSet(nullptr, 0);
+        return data;
+    }
+
     if (fullPath[0] != '/')
     {
         string relativePath = string();
@@ -444,6 +444,12 @@ std::string FileUtilsApple::getFullPathForDirectoryAndFilename(const std::string
 ValueMap FileUtilsApple::getValueMapFromFile(const std::string& filename)
 {
     std::string fullPath = fullPathForFilename(filename);
+    if (getPackFileForPath(fullPath))
+    {
+        MappedFile file = mapFile(fullPath);
+        return getValueMapFromData((const char*)file.getBytes(), (int)file.getSize());
+    }
+
     NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
     NSDictionary* dict = [NSDictionary dictionaryWithContentsOfFile:path];
 
@@ -525,8 +531,22 @@ ValueVector FileUtilsApple::getValueVectorFromFile(const std::string& filename)
     //    pPath = [[NSBundle mainBundle] pathForResource:pPath ofType:pathExtension];
     //    fixing cannot read data using Array::createWithContentsOfFile
     std::string fullPath = fullPathForFilename(filename);
-    NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
-    NSArray* array = [NSArray arrayWithContentsOfFile:path];
+    NSArray* array = nil;
+    if (getPackFileForPath(fullPath))
+    {
+        MappedFile file = mapFile(fullPath);
+        NSData* data = [NSData dataWithBytesNoCopy:(void*)file.getBytes() length:file.getSize() freeWhenDone:NO];
+        id plist = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:nil error:nil];
+        if ([plist isKindOfClass:[NSArray class]])
+        {
+            array = plist;
+        }
+    }
+    else
+    {
+        NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
+        array = [NSArray arrayWithContentsOfFile:path];
+    }
 
     ValueVector ret;
 
@@ -28,7 +28,14 @@ THE SOFTWARE.
 #include "platform/CCPlatformConfig.h"
 #if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX
 
+#if CC_USE_NULL_GL
+// the null backend implements the GL entry points itself, see CCGL-null.h
+#define GL_GLEXT_PROTOTYPES 1
+#include <GL/gl.h>
+#include <GL/glext.h>
+#else
 #include "GL/glew.h"
+#endif
 
 #define CC_GL_DEPTH24_STENCIL8      GL_DEPTH24_STENCIL8
 
@@ -0,0 +1,961 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/CCPlatformConfig.h"
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX && CC_USE_NULL_GL
+
+#include "platform/linux/CCGL-null.h"
+#include "platform/CCGL.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+NS_CC_BEGIN
+
+NullGLStats::NullGLStats()
+: frames(0)
+, calls(0)
+, drawCalls(0)
+, vertices(0)
+, stateChanges(0)
+, uniformUpdates(0)
+, bufferUploads(0)
+, bufferBytes(0)
+, textureUploads(0)
+{
+}
+
+namespace {
+
+// GL is only used from the cocos thread, so the backend state is not guarded
+NullGLStats s_frameStats;
+NullGLStats s_totalStats;
+
+struct ShaderVariable
+{
+    std::string name;
+    GLint size;
+    GLenum type;
+    GLint location;
+};
+
+struct NullProgram
+{
+    std::vector<GLuint> shaders;
+    std::unordered_map<std::string, GLint> boundAttribs;
+    std::vector<ShaderVariable> attribs;
+    std::vector<ShaderVariable> uniforms;
+};
+
+GLuint s_lastName = 0;
+std::unordered_set<GLuint> s_buffers;
+std::unordered_set<GLuint> s_renderbuffers;
+std::unordered_map<GLuint, std::string> s_shaderSources;
+std::unordered_map<GLuint, NullProgram> s_programs;
+std::unordered_set<GLenum> s_enabledCaps;
+
+// sizes of the buffer objects, only used to back glMapBuffer
+std::unordered_map<GLuint, GLsizeiptr> s_bufferSizes;
+std::vector<char> s_mappedStorage;
+
+GLuint s_arrayBuffer = 0;
+GLuint s_elementBuffer = 0;
+GLuint s_framebuffer = 0;
+GLuint s_renderbuffer = 0;
+GLuint s_program = 0;
+GLuint s_texture = 0;
+GLint s_viewport[4] = {0, 0, 0, 0};
+GLint s_scissor[4] = {0, 0, 0, 0};
+GLfloat s_clearColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+GLfloat s_clearDepth = 1.0f;
+GLboolean s_depthMask = GL_TRUE;
+
+inline void countCall()
+{
+    ++s_frameStats.calls;
+}
+
+inline void countStateChange()
+{
+    ++s_frameStats.calls;
+    ++s_frameStats.stateChanges;
+}
+
+inline void countUniform()
+{
+    ++s_frameStats.calls;
+    ++s_frameStats.uniformUpdates;
+}
+
+inline void countDraw(GLsizei count)
+{
+    ++s_frameStats.calls;
+    ++s_frameStats.drawCalls;
+    s_frameStats.vertices += count;
+}
+
+void genNames(GLsizei n, GLuint* names, std::unordered_set<GLuint>* live)
+{
+    countCall();
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        names[i] = ++s_lastName;
+        if (live)
+            live->insert(names[i]);
+    }
+}
+
+void deleteNames(GLsizei n, const GLuint* names, std::unordered_set<GLuint>* live)
+{
+    countCall();
+    if (live)
+    {
+        for (GLsizei i = 0; i < n; ++i)
+            live->erase(names[i]);
+    }
+}
+
+void copyString(const std::string& str, GLsizei bufSize, GLsizei* length, GLchar* dst)
+{
+    GLsizei written = 0;
+    if (bufSize > 0)
+    {
+        written = std::min((GLsizei)str.size(), bufSize - 1);
+        memcpy(dst, str.c_str(), written);
+        dst[written] = '\0';
+    }
+    if (length)
+        *length = written;
+}
+
+GLenum glslType(const std::string& type)
+{
+    static const std::unordered_map<std::string, GLenum> types = {
+        {"float", GL_FLOAT}, {"vec2", GL_FLOAT_VEC2}, {"vec3", GL_FLOAT_VEC3}, {"vec4", GL_FLOAT_VEC4},
+        {"int", GL_INT}, {"ivec2", GL_INT_VEC2}, {"ivec3", GL_INT_VEC3}, {"ivec4", GL_INT_VEC4},
+        {"bool", GL_BOOL}, {"bvec2", GL_BOOL_VEC2}, {"bvec3", GL_BOOL_VEC3}, {"bvec4", GL_BOOL_VEC4},
+        {"mat2", GL_FLOAT_MAT2}, {"mat3", GL_FLOAT_MAT3}, {"mat4", GL_FLOAT_MAT4},
+        {"sampler2D", GL_SAMPLER_2D}, {"samplerCube", GL_SAMPLER_CUBE},
+    };
+    auto it = types.find(type);
+    return it != types.end() ? it->second : GL_FLOAT;
+}
+
+// splits GLSL source in identifiers, numbers and single punctuation characters, skipping comments and preprocessor lines
+std::vector<std::string> tokenize(const std::string& src)
+{
+    std::vector<std::string> tokens;
+    size_t i = 0;
+    bool lineStart = true;
+    while (i < src.size())
+    {
+        char c = src[i];
+        if (c == '\n')
+        {
+            lineStart = true;
+            ++i;
+        }
+        else if (isspace((unsigned char)c))
+        {
+            ++i;
+        }
+        else if (lineStart && c == '#')
+        {
+            while (i < src.size() && src[i] != '\n')
+                ++i;
+        }
+        else if (c == '/' && i + 1 < src.size() && src[i + 1] == '/')
+        {
+            while (i < src.size() && src[i] != '\n')
+                ++i;
+        }
+        else if (c == '/' && i + 1 < src.size() && src[i + 1] == '*')
+        {
+            size_t end = src.find("*/", i + 2);
+            i = (end == std::string::npos) ? src.size() : end + 2;
+        }
+        else if (isalnum((unsigned char)c) || c == '_')
+        {
+            size_t start = i;
+            while (i < src.size() && (isalnum((unsigned char)src[i]) || src[i] == '_'))
+                ++i;
+            tokens.push_back(src.substr(start, i - start));
+            lineStart = false;
+        }
+        else
+        {
+            tokens.push_back(std::string(1, c));
+            lineStart = false;
+            ++i;
+        }
+    }
+    return tokens;
+}
+
+void addVariable(std::vector<ShaderVariable>& vars, const std::string& name, GLint size, GLenum type)
+{
+    for (const auto& var : vars)
+    {
+        if (var.name == name)
+            return;
+    }
+    ShaderVariable var;
+    var.name = name;
+    var.size = size;
+    var.type = type;
+    var.location = -1;
+    vars.push_back(var);
+}
+
+// collects the "attribute" and "uniform" declarations, which is what a GLSL ES 1.0 linker would report as active
+void parseDeclarations(const std::string& src, NullProgram& program)
+{
+    auto tokens = tokenize(src);
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        bool isAttrib = tokens[i] == "attribute";
+        if (!isAttrib && tokens[i] != "uniform")
+            continue;
+
+        size_t t = i + 1;
+        while (t < tokens.size() && (tokens[t] == "lowp" || tokens[t] == "mediump" || tokens[t] == "highp"))
+            ++t;
+        if (t >= tokens.size())
+            break;
+        GLenum type = glslType(tokens[t++]);
+
+        while (t < tokens.size() && tokens[t] != ";")
+        {
+            const std::string& name = tokens[t++];
+            GLint size = 1;
+            bool isArray = false;
+            if (t + 2 < tokens.size() && tokens[t] == "[")
+            {
+                // the size may be a macro, which is not expanded
+                size = std::max(1, atoi(tokens[t + 1].c_str()));
+                isArray = true;
+                t += 3;
+            }
+            if (isAttrib)
+                addVariable(program.attribs, name, size, type);
+            else
+                addVariable(program.uniforms, isArray ? name + "[0]" : name, size, type);
+
+            if (t < tokens.size() && tokens[t] == ",")
+                ++t;
+        }
+        i = t;
+    }
+}
+
+NullProgram* findProgram(GLuint program)
+{
+    auto it = s_programs.find(program);
+    return it != s_programs.end() ? &it->second : nullptr;
+}
+
+GLint getIntegerState(GLenum pname)
+{
+    switch (pname)
+    {
+        case GL_MAX_TEXTURE_SIZE:
+        case GL_MAX_RENDERBUFFER_SIZE:
+            return 4096;
+        case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_VERTEX_ATTRIBS:
+            return 16;
+        case GL_MAX_SAMPLES:
+            return 4;
+        case GL_DEPTH_BITS:
+            return 24;
+        case GL_STENCIL_BITS:
+        case GL_RED_BITS:
+        case GL_GREEN_BITS:
+        case GL_BLUE_BITS:
+        case GL_ALPHA_BITS:
+            return 8;
+        case GL_PACK_ALIGNMENT:
+        case GL_UNPACK_ALIGNMENT:
+            return 4;
+        case GL_FRAMEBUFFER_BINDING:
+            return s_framebuffer;
+        case GL_RENDERBUFFER_BINDING:
+            return s_renderbuffer;
+        case GL_CURRENT_PROGRAM:
+            return s_program;
+        case GL_ARRAY_BUFFER_BINDING:
+            return s_arrayBuffer;
+        case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+            return s_elementBuffer;
+        case GL_TEXTURE_BINDING_2D:
+            return s_texture;
+        case GL_DEPTH_WRITEMASK:
+            return s_depthMask;
+        default:
+            return s_enabledCaps.count(pname) ? 1 : 0;
+    }
+}
+
+} // namespace
+
+namespace NullGL {
+
+const NullGLStats& getFrameStats()
+{
+    return s_frameStats;
+}
+
+const NullGLStats& getTotalStats()
+{
+    return s_totalStats;
+}
+
+void endFrame()
+{
+    ++s_totalStats.frames;
+    s_totalStats.calls += s_frameStats.calls;
+    s_totalStats.drawCalls += s_frameStats.drawCalls;
+    s_totalStats.vertices += s_frameStats.vertices;
+    s_totalStats.stateChanges += s_frameStats.stateChanges;
+    s_totalStats.uniformUpdates += s_frameStats.uniformUpdates;
+    s_totalStats.bufferUploads += s_frameStats.bufferUploads;
+    s_totalStats.bufferBytes += s_frameStats.bufferBytes;
+    s_totalStats.textureUploads += s_frameStats.textureUploads;
+
+    s_frameStats = NullGLStats();
+}
+
+} // namespace NullGL
+
+NS_CC_END
+
+USING_NS_CC;
+
+extern "C" {
+
+// Queries
+
+GLenum glGetError(void)
+{
+    countCall();
+    return GL_NO_ERROR;
+}
+
+const GLubyte* glGetString(GLenum name)
+{
+    countCall();
+    switch (name)
+    {
+        case GL_VENDOR:
+            return (const GLubyte*)"cocos2d-x";
+        case GL_RENDERER:
+            return (const GLubyte*)"null";
+        case GL_VERSION:
+            return (const GLubyte*)"2.1 null";
+        case GL_SHADING_LANGUAGE_VERSION:
+            return (const GLubyte*)"1.20";
+        case GL_EXTENSIONS:
+            return (const GLubyte*)"GL_ARB_vertex_array_object GL_ARB_framebuffer_object GL_EXT_texture_compression_s3tc";
+        default:
+            return (const GLubyte*)"";
+    }
+}
+
+void glGetIntegerv(GLenum pname, GLint* params)
+{
+    countCall();
+    switch (pname)
+    {
+        case GL_VIEWPORT:
+            memcpy(params, s_viewport, sizeof(s_viewport));
+            break;
+        case GL_SCISSOR_BOX:
+            memcpy(params, s_scissor, sizeof(s_scissor));
+            break;
+        default:
+            *params = getIntegerState(pname);
+            break;
+    }
+}
+
+void glGetFloatv(GLenum pname, GLfloat* params)
+{
+    countCall();
+    switch (pname)
+    {
+        case GL_COLOR_CLEAR_VALUE:
+            memcpy(params, s_clearColor, sizeof(s_clearColor));
+            break;
+        case GL_DEPTH_CLEAR_VALUE:
+            *params = s_clearDepth;
+            break;
+        case GL_VIEWPORT:
+        case GL_SCISSOR_BOX:
+            for (int i = 0; i < 4; ++i)
+                params[i] = (GLfloat)(pname == GL_VIEWPORT ? s_viewport[i] : s_scissor[i]);
+            break;
+        default:
+            *params = (GLfloat)getIntegerState(pname);
+            break;
+    }
+}
+
+void glGetBooleanv(GLenum pname, GLboolean* params)
+{
+    countCall();
+    *params = getIntegerState(pname) ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean glIsEnabled(GLenum cap)
+{
+    countCall();
+    return s_enabledCaps.count(cap) ? GL_TRUE : GL_FALSE;
+}
+
+void glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* pixels)
+{
+    countCall();
+    size_t components = (format == GL_RGBA) ? 4 : (format == GL_RGB) ? 3 : 1;
+    size_t componentSize = (type == GL_UNSIGNED_BYTE) ? 1 : 4;
+    memset(pixels, 0, (size_t)width * height * components * componentSize);
+}
+
+// State
+
+void glEnable(GLenum cap)
+{
+    countStateChange();
+    s_enabledCaps.insert(cap);
+}
+
+void glDisable(GLenum cap)
+{
+    countStateChange();
+    s_enabledCaps.erase(cap);
+}
+
+void glEnableClientState(GLenum cap)
+{
+    countStateChange();
+}
+
+void glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    countStateChange();
+    s_viewport[0] = x;
+    s_viewport[1] = y;
+    s_viewport[2] = width;
+    s_viewport[3] = height;
+}
+
+void glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    countStateChange();
+    s_scissor[0] = x;
+    s_scissor[1] = y;
+    s_scissor[2] = width;
+    s_scissor[3] = height;
+}
+
+void glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+    countStateChange();
+    s_clearColor[0] = red;
+    s_clearColor[1] = green;
+    s_clearColor[2] = blue;
+    s_clearColor[3] = alpha;
+}
+
+void glClearDepth(GLclampd depth)
+{
+    countStateChange();
+    s_clearDepth = (GLfloat)depth;
+}
+
+void glDepthMask(GLboolean flag)
+{
+    countStateChange();
+    s_depthMask = flag;
+}
+
+void glClearStencil(GLint s) { countStateChange(); }
+void glBlendFunc(GLenum sfactor, GLenum dfactor) { countStateChange(); }
+void glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) { countStateChange(); }
+void glBlendEquation(GLenum mode) { countStateChange(); }
+void glDepthFunc(GLenum func) { countStateChange(); }
+void glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) { countStateChange(); }
+void glStencilFunc(GLenum func, GLint ref, GLuint mask) { countStateChange(); }
+void glStencilMask(GLuint mask) { countStateChange(); }
+void glStencilOp(GLenum fail, GLenum zfail, GLenum zpass) { countStateChange(); }
+void glCullFace(GLenum mode) { countStateChange(); }
+void glFrontFace(GLenum mode) { countStateChange(); }
+void glAlphaFunc(GLenum func, GLclampf ref) { countStateChange(); }
+void glPolygonMode(GLenum face, GLenum mode) { countStateChange(); }
+void glLineWidth(GLfloat width) { countStateChange(); }
+void glPointSize(GLfloat size) { countStateChange(); }
+void glHint(GLenum target, GLenum mode) { countStateChange(); }
+void glPixelStorei(GLenum pname, GLint param) { countStateChange(); }
+void glActiveTexture(GLenum texture) { countStateChange(); }
+
+// Drawing
+
+void glClear(GLbitfield mask) { countCall(); }
+void glFlush(void) { countCall(); }
+
+void glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    countDraw(count);
+}
+
+void glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
+{
+    countDraw(count);
+}
+
+// Buffers and vertex arrays
+
+void glGenBuffers(GLsizei n, GLuint* buffers)
+{
+    genNames(n, buffers, &s_buffers);
+}
+
+void glDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    deleteNames(n, buffers, &s_buffers);
+    for (GLsizei i = 0; i < n; ++i)
+        s_bufferSizes.erase(buffers[i]);
+}
+
+GLboolean glIsBuffer(GLuint buffer)
+{
+    countCall();
+    return s_buffers.count(buffer) ? GL_TRUE : GL_FALSE;
+}
+
+void glBindBuffer(GLenum target, GLuint buffer)
+{
+    countStateChange();
+    if (target == GL_ARRAY_BUFFER)
+        s_arrayBuffer = buffer;
+    else if (target == GL_ELEMENT_ARRAY_BUFFER)
+        s_elementBuffer = buffer;
+}
+
+void glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    countCall();
+    ++s_frameStats.bufferUploads;
+    if (data)
+        s_frameStats.bufferBytes += size;
+    s_bufferSizes[target == GL_ARRAY_BUFFER ? s_arrayBuffer : s_elementBuffer] = size;
+}
+
+void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    countCall();
+    ++s_frameStats.bufferUploads;
+    s_frameStats.bufferBytes += size;
+}
+
+void* glMapBuffer(GLenum target, GLenum access)
+{
+    countCall();
+    auto size = s_bufferSizes[target == GL_ARRAY_BUFFER ? s_arrayBuffer : s_elementBuffer];
+    if (s_mappedStorage.size() < (size_t)size)
+        s_mappedStorage.resize(size);
+    return s_mappedStorage.data();
+}
+
+GLboolean glUnmapBuffer(GLenum target)
+{
+    countCall();
+    ++s_frameStats.bufferUploads;
+    s_frameStats.bufferBytes += s_bufferSizes[target == GL_ARRAY_BUFFER ? s_arrayBuffer : s_elementBuffer];
+    return GL_TRUE;
+}
+
+void glGenVertexArrays(GLsizei n, GLuint* arrays)
+{
+    genNames(n, arrays, nullptr);
+}
+
+void glDeleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+    deleteNames(n, arrays, nullptr);
+}
+
+void glBindVertexArray(GLuint array)
+{
+    countStateChange();
+}
+
+void glEnableVertexAttribArray(GLuint index) { countStateChange(); }
+void glDisableVertexAttribArray(GLuint index) { countStateChange(); }
+void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer) { countStateChange(); }
+
+// Textures
+
+void glGenTextures(GLsizei n, GLuint* textures)
+{
+    genNames(n, textures, nullptr);
+}
+
+void glDeleteTextures(GLsizei n, const GLuint* textures)
+{
+    deleteNames(n, textures, nullptr);
+}
+
+void glBindTexture(GLenum target, GLuint texture)
+{
+    countStateChange();
+    if (target == GL_TEXTURE_2D)
+        s_texture = texture;
+}
+
+void glTexParameteri(GLenum target, GLenum pname, GLint param) { countStateChange(); }
+void glGenerateMipmap(GLenum target) { countCall(); }
+
+void glTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    countCall();
+    ++s_frameStats.textureUploads;
+}
+
+void glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels)
+{
+    countCall();
+    ++s_frameStats.textureUploads;
+}
+
+void glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data)
+{
+    countCall();
+    ++s_frameStats.textureUploads;
+}
+
+// Framebuffers
+
+void glGenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+    genNames(n, framebuffers, nullptr);
+}
+
+void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+    deleteNames(n, framebuffers, nullptr);
+}
+
+void glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    countStateChange();
+    s_framebuffer = framebuffer;
+}
+
+void glGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+{
+    genNames(n, renderbuffers, &s_renderbuffers);
+}
+
+void glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+{
+    deleteNames(n, renderbuffers, &s_renderbuffers);
+}
+
+GLboolean glIsRenderbuffer(GLuint renderbuffer)
+{
+    countCall();
+    return s_renderbuffers.count(renderbuffer) ? GL_TRUE : GL_FALSE;
+}
+
+void glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    countStateChange();
+    s_renderbuffer = renderbuffer;
+}
+
+void glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) { countCall(); }
+void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) { countStateChange(); }
+void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) { countStateChange(); }
+
+GLenum glCheckFramebufferStatus(GLenum target)
+{
+    countCall();
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+// Shaders and programs
+
+GLuint glCreateShader(GLenum type)
+{
+    countCall();
+    GLuint shader = ++s_lastName;
+    s_shaderSources[shader];
+    return shader;
+}
+
+void glDeleteShader(GLuint shader)
+{
+    countCall();
+    s_shaderSources.erase(shader);
+}
+
+void glShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+{
+    countCall();
+    std::string& source = s_shaderSources[shader];
+    source.clear();
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (length && length[i] >= 0)
+            source.append(string[i], length[i]);
+        else
+            source.append(string[i]);
+    }
+}
+
+void glCompileShader(GLuint shader) { countCall(); }
+
+void glGetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+    countCall();
+    switch (pname)
+    {
+        case GL_COMPILE_STATUS:
+            *params = GL_TRUE;
+            break;
+        case GL_SHADER_SOURCE_LENGTH:
+            *params = (GLint)s_shaderSources[shader].size() + 1;
+            break;
+        default:
+            *params = 0;
+            break;
+    }
+}
+
+void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    countCall();
+    copyString("", bufSize, length, infoLog);
+}
+
+void glGetShaderSource(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* source)
+{
+    countCall();
+    copyString(s_shaderSources[shader], bufSize, length, source);
+}
+
+GLuint glCreateProgram(void)
+{
+    countCall();
+    GLuint program = ++s_lastName;
+    s_programs[program];
+    return program;
+}
+
+void glDeleteProgram(GLuint program)
+{
+    countCall();
+    s_programs.erase(program);
+}
+
+void glAttachShader(GLuint program, GLuint shader)
+{
+    countCall();
+    if (auto p = findProgram(program))
+        p->shaders.push_back(shader);
+}
+
+void glBindAttribLocation(GLuint program, GLuint index, const GLchar* name)
+{
+    countCall();
+    if (auto p = findProgram(program))
+        p->boundAttribs[name] = index;
+}
+
+void glLinkProgram(GLuint program)
+{
+    countCall();
+    auto p = findProgram(program);
+    if (!p)
+        return;
+
+    p->attribs.clear();
+    p->uniforms.clear();
+    for (auto shader : p->shaders)
+        parseDeclarations(s_shaderSources[shader], *p);
+
+    // bound attributes keep their index, the others take the lowest free ones
+    std::unordered_set<GLint> used;
+    for (auto& attrib : p->attribs)
+    {
+        auto it = p->boundAttribs.find(attrib.name);
+        if (it != p->boundAttribs.end())
+        {
+            attrib.location = it->second;
+            used.insert(attrib.location);
+        }
+    }
+    GLint next = 0;
+    for (auto& attrib : p->attribs)
+    {
+        if (attrib.location < 0)
+        {
+            while (used.count(next))
+                ++next;
+            attrib.location = next++;
+        }
+    }
+    for (size_t i = 0; i < p->uniforms.size(); ++i)
+        p->uniforms[i].location = (GLint)i;
+}
+
+void glGetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+    countCall();
+    auto p = findProgram(program);
+    *params = 0;
+    switch (pname)
+    {
+        case GL_LINK_STATUS:
+        case GL_VALIDATE_STATUS:
+            *params = p ? GL_TRUE : GL_FALSE;
+            break;
+        case GL_ACTIVE_ATTRIBUTES:
+            *params = p ? (GLint)p->attribs.size() : 0;
+            break;
+        case GL_ACTIVE_UNIFORMS:
+            *params = p ? (GLint)p->uniforms.size() : 0;
+            break;
+        case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:
+        case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+            if (p)
+            {
+                for (const auto& var : (pname == GL_ACTIVE_ATTRIBUTE_MAX_LENGTH) ? p->attribs : p->uniforms)
+                    *params = std::max(*params, (GLint)var.name.size() + 1);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+{
+    countCall();
+    copyString("", bufSize, length, infoLog);
+}
+
+void glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    countCall();
+    auto p = findProgram(program);
+    if (p && index < p->attribs.size())
+    {
+        const auto& var = p->attribs[index];
+        *size = var.size;
+        *type = var.type;
+        copyString(var.name, bufSize, length, name);
+    }
+}
+
+void glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    countCall();
+    auto p = findProgram(program);
+    if (p && index < p->uniforms.size())
+    {
+        const auto& var = p->uniforms[index];
+        *size = var.size;
+        *type = var.type;
+        copyString(var.name, bufSize, length, name);
+    }
+}
+
+GLint glGetAttribLocation(GLuint program, const GLchar* name)
+{
+    countCall();
+    if (auto p = findProgram(program))
+    {
+        for (const auto& var : p->attribs)
+        {
+            if (var.name == name)
+                return var.location;
+        }
+    }
+    return -1;
+}
+
+GLint glGetUniformLocation(GLuint program, const GLchar* name)
+{
+    countCall();
+    if (auto p = findProgram(program))
+    {
+        std::string arrayName = std::string(name) + "[0]";
+        for (const auto& var : p->uniforms)
+        {
+            if (var.name == name || var.name == arrayName)
+                return var.location;
+        }
+    }
+    return -1;
+}
+
+void glUseProgram(GLuint program)
+{
+    countStateChange();
+    s_program = program;
+}
+
+// Uniforms
+
+void glUniform1f(GLint location, GLfloat v0) { countUniform(); }
+void glUniform2f(GLint location, GLfloat v0, GLfloat v1) { countUniform(); }
+void glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) { countUniform(); }
+void glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) { countUniform(); }
+void glUniform1i(GLint location, GLint v0) { countUniform(); }
+void glUniform2i(GLint location, GLint v0, GLint v1) { countUniform(); }
+void glUniform3i(GLint location, GLint v0, GLint v1, GLint v2) { countUniform(); }
+void glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) { countUniform(); }
+void glUniform1fv(GLint location, GLsizei count, const GLfloat* value) { countUniform(); }
+void glUniform2fv(GLint location, GLsizei count, const GLfloat* value) { countUniform(); }
+void glUniform3fv(GLint location, GLsizei count, const GLfloat* value) { countUniform(); }
+void glUniform4fv(GLint location, GLsizei count, const GLfloat* value) { countUniform(); }
+void glUniform1iv(GLint location, GLsizei count, const GLint* value) { countUniform(); }
+void glUniform2iv(GLint location, GLsizei count, const GLint* value) { countUniform(); }
+void glUniform3iv(GLint location, GLsizei count, const GLint* value) { countUniform(); }
+void glUniform4iv(GLint location, GLsizei count, const GLint* value) { countUniform(); }
+void glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) { countUniform(); }
+void glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) { countUniform(); }
+void glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) { countUniform(); }
+
+} // extern "C"
+
+#endif // CC_TARGET_PLATFORM == CC_PLATFORM_LINUX && CC_USE_NULL_GL
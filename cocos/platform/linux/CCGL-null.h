@@ -0,0 +1,90 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CCGL_NULL_H__
+#define __CCGL_NULL_H__
+
+#include "platform/CCPlatformConfig.h"
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX && CC_USE_NULL_GL
+
+#include "platform/CCPlatformMacros.h"
+#include <stddef.h>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/**
+ * The counters of the null GL backend.
+ * When cocos2d-x is built with USE_NULL_GL the GL entry points are implemented by the engine:
+ * nothing is drawn, but every call is counted, so the CPU side of a frame can be measured on machines without a GPU.
+ */
+struct CC_DLL NullGLStats
+{
+    NullGLStats();
+
+    /** Number of frames, only meaningful for the accumulated stats. */
+    unsigned int frames;
+    /** Number of GL calls of any kind. */
+    unsigned int calls;
+    /** Number of glDrawArrays and glDrawElements calls. */
+    unsigned int drawCalls;
+    /** Number of vertices (or indices) passed to the draw calls. */
+    size_t vertices;
+    /** Number of calls changing the GL state: capabilities, blending, depth, bindings, programs, viewport... */
+    unsigned int stateChanges;
+    /** Number of glUniform* calls. */
+    unsigned int uniformUpdates;
+    /** Number of glBufferData and glBufferSubData calls. */
+    unsigned int bufferUploads;
+    /** Number of bytes passed to glBufferData and glBufferSubData. */
+    size_t bufferBytes;
+    /** Number of glTexImage2D, glTexSubImage2D and glCompressedTexImage2D calls. */
+    unsigned int textureUploads;
+};
+
+namespace NullGL {
+
+/** Returns the counters of the current frame. */
+CC_DLL const NullGLStats& getFrameStats();
+
+/** Returns the counters accumulated over all the finished frames. */
+CC_DLL const NullGLStats& getTotalStats();
+
+/** Adds the counters of the current frame to the accumulated ones, and clears them. Called by the null GLView when swapping buffers. */
+CC_DLL void endFrame();
+
+} // namespace NullGL
+
+// end of platform group
+/// @}
+
+NS_CC_END
+
+#endif // CC_TARGET_PLATFORM == CC_PLATFORM_LINUX && CC_USE_NULL_GL
+
+#endif // __CCGL_NULL_H__
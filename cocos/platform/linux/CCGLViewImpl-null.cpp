@@ -0,0 +1,147 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "platform/CCPlatformConfig.h"
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX && CC_USE_NULL_GL
+
+#include "platform/linux/CCGLViewImpl-null.h"
+#include "platform/linux/CCGL-null.h"
+#include "base/CCDirector.h"
+#include "renderer/ccGLStateCache.h"
+#include "renderer/CCRenderer.h"
+
+#include <stdlib.h>
+
+NS_CC_BEGIN
+
+GLViewImpl::GLViewImpl()
+: _frameZoomFactor(1.0f)
+, _shouldClose(false)
+, _isFrameStatsLogEnabled(true)
+, _frameLimit(0)
+, _frames(0)
+{
+    _viewName = "cocos2dx";
+
+    const char* frames = getenv("CC_NULL_GL_FRAMES");
+    if (frames)
+    {
+        _frameLimit = (unsigned int)atoi(frames);
+    }
+}
+
+GLViewImpl::~GLViewImpl()
+{
+    CCLOGINFO("deallocing GLViewImpl: %p", this);
+
+    auto& total = NullGL::getTotalStats();
+    if (total.frames > 0)
+    {
+        log("null GL: %u frames, %.1f draw calls, %.1f vertices, %.1f state changes, %.1f uniform updates, %.1f buffer uploads per frame",
+            total.frames,
+            (double)total.drawCalls / total.frames,
+            (double)total.vertices / total.frames,
+            (double)total.stateChanges / total.frames,
+            (double)total.uniformUpdates / total.frames,
+            (double)total.bufferUploads / total.frames);
+    }
+}
+
+GLViewImpl* GLViewImpl::create(const std::string& viewName)
+{
+    auto ret = new (std::nothrow) GLViewImpl;
+    if(ret && ret->initWithRect(viewName, Rect(0, 0, 960, 640), 1)) {
+        ret->autorelease();
+        return ret;
+    }
+
+    return nullptr;
+}
+
+GLViewImpl* GLViewImpl::createWithRect(const std::string& viewName, Rect rect, float frameZoomFactor)
+{
+    auto ret = new (std::nothrow) GLViewImpl;
+    if(ret && ret->initWithRect(viewName, rect, frameZoomFactor)) {
+        ret->autorelease();
+        return ret;
+    }
+
+    return nullptr;
+}
+
+GLViewImpl* GLViewImpl::createWithFullScreen(const std::string& viewName)
+{
+    // there is no monitor, use the default window size
+    return create(viewName);
+}
+
+bool GLViewImpl::initWithRect(const std::string& viewName, Rect rect, float frameZoomFactor)
+{
+    setViewName(viewName);
+
+    _frameZoomFactor = frameZoomFactor;
+
+    setFrameSize(rect.size.width, rect.size.height);
+
+    return true;
+}
+
+bool GLViewImpl::windowShouldClose()
+{
+    return _shouldClose || (_frameLimit > 0 && _frames >= _frameLimit);
+}
+
+void GLViewImpl::end()
+{
+    _shouldClose = true;
+    release();
+}
+
+void GLViewImpl::swapBuffers()
+{
+    ++_frames;
+
+    if (_isFrameStatsLogEnabled)
+    {
+        auto& stats = NullGL::getFrameStats();
+        log("null GL frame %u: %u draw calls, %zu vertices, %u state changes (%u cached ones skipped), %u uniform updates, %u buffer uploads (%zu bytes), %u texture uploads, %u GL calls, %zd visited nodes",
+            _frames,
+            stats.drawCalls,
+            stats.vertices,
+            stats.stateChanges,
+            GL::getSkippedStateChanges(),
+            stats.uniformUpdates,
+            stats.bufferUploads,
+            stats.bufferBytes,
+            stats.textureUploads,
+            stats.calls,
+            Director::getInstance()->getRenderer()->getVisitedNodes());
+    }
+
+    NullGL::endFrame();
+}
+
+NS_CC_END // end of namespace cocos2d;
+
+#endif // CC_TARGET_PLATFORM == CC_PLATFORM_LINUX && CC_USE_NULL_GL
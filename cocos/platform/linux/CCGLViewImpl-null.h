@@ -0,0 +1,92 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CC_GLVIEWIMPL_NULL_H__
+#define __CC_GLVIEWIMPL_NULL_H__
+
+#include "platform/CCPlatformConfig.h"
+#if CC_TARGET_PLATFORM == CC_PLATFORM_LINUX && CC_USE_NULL_GL
+
+#include "base/CCRef.h"
+#include "platform/CCCommon.h"
+#include "platform/CCGLView.h"
+
+NS_CC_BEGIN
+
+/**
+ * @brief GLView of the null GL backend, used instead of the GLFW one when cocos2d-x is built with USE_NULL_GL.
+ * No window nor GL context is created, so Director and Renderer run full frames headlessly.
+ * The GL calls of every frame are counted, see NullGLStats, and can be logged when swapping buffers.
+ */
+class CC_DLL GLViewImpl : public GLView
+{
+public:
+    static GLViewImpl* create(const std::string& viewName);
+    static GLViewImpl* createWithRect(const std::string& viewName, Rect size, float frameZoomFactor = 1.0f);
+    static GLViewImpl* createWithFullScreen(const std::string& viewName);
+
+    float getFrameZoomFactor() const override { return _frameZoomFactor; }
+    void setFrameZoomFactor(float zoomFactor) override { _frameZoomFactor = zoomFactor; }
+
+    bool windowShouldClose() override;
+    void pollEvents() override {}
+
+    /* override functions */
+    virtual bool isOpenGLReady() override { return true; }
+    virtual void end() override;
+    virtual void swapBuffers() override;
+    virtual void setIMEKeyboardState(bool bOpen) override {}
+
+    /**
+     * Sets the number of frames to run before windowShouldClose() returns true, 0 runs until end() is called.
+     * The default value is read from the CC_NULL_GL_FRAMES environment variable.
+     */
+    void setFrameLimit(unsigned int frames) { _frameLimit = frames; }
+    unsigned int getFrameLimit() const { return _frameLimit; }
+
+    /** Whether the GL counters of each frame are logged when swapping buffers. Enabled by default. */
+    void setFrameStatsLogEnabled(bool enabled) { _isFrameStatsLogEnabled = enabled; }
+    bool isFrameStatsLogEnabled() const { return _isFrameStatsLogEnabled; }
+
+protected:
+    GLViewImpl();
+    virtual ~GLViewImpl();
+
+    bool initWithRect(const std::string& viewName, Rect rect, float frameZoomFactor);
+
+    float _frameZoomFactor;
+    bool _shouldClose;
+    bool _isFrameStatsLogEnabled;
+    unsigned int _frameLimit;
+    unsigned int _frames;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(GLViewImpl);
+};
+
+NS_CC_END   // end of namespace   cocos2d
+
+#endif // CC_TARGET_PLATFORM == CC_PLATFORM_LINUX && CC_USE_NULL_GL
+
+#endif  // end of __CC_GLVIEWIMPL_NULL_H__
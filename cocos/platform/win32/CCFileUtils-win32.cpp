@@ -279,6 +279,11 @@ static Data getData(const std::string& filename, bool forString)
     {
         // read the file from hardware
         std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
+        std::string entryName;
+        if (auto packFile = FileUtils::getInstance()->getPackFileForPath(fullPath, &entryName))
+        {
+            return packFile->getData(entryName, forString);
+        }
 
         // check if the filename uses correct case characters
         checkFileName(fullPath, filename);
@@ -361,6 +366,16 @@ unsigned char* FileUtilsWin32::getFileData(const std::string& filename, const ch
     {
         // read the file from hardware
         std::string fullPath = fullPathForFilename(filename);
+        std::string entryName;
+        if (auto packFile = getPackFileForPath(fullPath, &entryName))
+        {
+            Data data = packFile->getData(entryName);
+            pBuffer = data.getBytes();
+            *size = data.getSize();
+            // the caller owns the buffer
+            data.fastSet(nullptr, 0);
+            break;
+        }
 
          // check if the filename uses correct case characters
         checkFileName(fullPath, filename);
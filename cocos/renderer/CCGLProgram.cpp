@@ -181,6 +181,7 @@ GLProgram::GLProgram()
 , _vertShader(0)
 , _fragShader(0)
 , _flags()
+, _uniformsStateId(0)
 {
     _director = Director::getInstance();
     CCASSERT(nullptr != _director, "Director is null when init a GLProgram");
@@ -213,6 +214,7 @@ GLProgram::~GLProgram()
         free(e.second.first);
     }
     _hashForUniforms.clear();
+    _uniformsStateId = 0;
 }
 
 bool GLProgram::initWithByteArrays(const GLchar* vShaderByteArray, const GLchar* fShaderByteArray)
@@ -672,6 +674,24 @@ bool GLProgram::updateUniformLocation(GLint location, const GLvoid* data, unsign
         }
     }
 
+    GL::recordStateChange(updated);
+
+    // a user uniform was changed outside of the GLProgramState that owns the cached values
+    if (updated && _uniformsStateId != 0)
+    {
+        bool builtIn = false;
+        for (int i = 0; i < UNIFORM_MAX; ++i)
+        {
+            if (_builtInUniforms[i] == location)
+            {
+                builtIn = true;
+                break;
+            }
+        }
+        if (!builtIn)
+            _uniformsStateId = 0;
+    }
+
     return updated;
 }
 
@@ -933,6 +953,9 @@ void GLProgram::reset()
     }
 
     _hashForUniforms.clear();
+
+    // the new program has none of the user uniforms of the last GLProgramState
+    _uniformsStateId = 0;
 }
 
 NS_CC_END
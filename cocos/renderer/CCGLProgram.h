@@ -519,6 +519,8 @@ protected:
     std::unordered_map<std::string, VertexAttrib> _vertexAttribs;
     /**Hash value of uniforms for quick access.*/
     std::unordered_map<GLint, std::pair<GLvoid*, unsigned int>> _hashForUniforms;
+    /**Id of the GLProgramState whose uniform values were the last ones uploaded, 0 if unknown.*/
+    uint32_t _uniformsStateId;
     //cached director pointer for calling
     Director* _director;
 };
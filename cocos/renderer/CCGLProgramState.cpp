@@ -41,6 +41,8 @@ THE SOFTWARE.
 #include "2d/CCCamera.h"
 #include "deprecated/CCString.h"
 
+#include "xxhash.h"
+
 NS_CC_BEGIN
 
 // static vector with all the registered custom binding resolvers
@@ -56,14 +58,20 @@ UniformValue::UniformValue()
 : _uniform(nullptr)
 , _glprogram(nullptr)
 , _type(Type::VALUE)
+, _dirty(true)
 {
+    // the whole union is hashed and compared by GLProgramState::getShared(), not only the bytes of the value
+    memset(&_value, 0, sizeof(_value));
 }
 
 UniformValue::UniformValue(Uniform *uniform, GLProgram* glprogram)
 : _uniform(uniform)
 , _glprogram(glprogram)
 , _type(Type::VALUE)
+, _dirty(true)
 {
+    // the whole union is hashed and compared by GLProgramState::getShared(), not only the bytes of the value
+    memset(&_value, 0, sizeof(_value));
 }
 
 UniformValue::~UniformValue()
@@ -74,6 +82,8 @@ UniformValue::~UniformValue()
 
 void UniformValue::apply()
 {
+    _dirty = false;
+
     if (_type == Type::CALLBACK_FN)
     {
         (*_value.callback)(_glprogram, _uniform);
@@ -159,6 +169,8 @@ void UniformValue::setCallback(const std::function<void(GLProgram*, Uniform*)> &
 	*_value.callback = callback;
 
     _type = Type::CALLBACK_FN;
+
+    _dirty = true;
 }
 
 void UniformValue::setTexture(GLuint textureId, GLuint textureUnit)
@@ -167,12 +179,14 @@ void UniformValue::setTexture(GLuint textureId, GLuint textureUnit)
     _value.tex.textureId = textureId;
     _value.tex.textureUnit = textureUnit;
     _type = Type::VALUE;
+    _dirty = true;
 }
 void UniformValue::setInt(int value)
 {
     CCASSERT(_uniform->type == GL_INT, "Wrong type: expecting GL_INT");
     _value.intValue = value;
     _type = Type::VALUE;
+    _dirty = true;
 }
 
 void UniformValue::setFloat(float value)
@@ -180,6 +194,7 @@ void UniformValue::setFloat(float value)
     CCASSERT(_uniform->type == GL_FLOAT, "Wrong type: expecting GL_FLOAT");
     _value.floatValue = value;
     _type = Type::VALUE;
+    _dirty = true;
 }
 
 void UniformValue::setFloatv(ssize_t size, const float* pointer)
@@ -188,6 +203,7 @@ void UniformValue::setFloatv(ssize_t size, const float* pointer)
     _value.floatv.pointer = (const float*)pointer;
     _value.floatv.size = (GLsizei)size;
     _type = Type::POINTER;
+    _dirty = true;
 }
 
 void UniformValue::setVec2(const Vec2& value)
@@ -195,6 +211,7 @@ void UniformValue::setVec2(const Vec2& value)
     CCASSERT(_uniform->type == GL_FLOAT_VEC2, "Wrong type: expecting GL_FLOAT_VEC2");
 	memcpy(_value.v2Value, &value, sizeof(_value.v2Value));
     _type = Type::VALUE;
+    _dirty = true;
 }
 
 void UniformValue::setVec2v(ssize_t size, const Vec2* pointer)
@@ -203,6 +220,7 @@ void UniformValue::setVec2v(ssize_t size, const Vec2* pointer)
     _value.v2f.pointer = (const float*)pointer;
     _value.v2f.size = (GLsizei)size;
     _type = Type::POINTER;
+    _dirty = true;
 }
 
 void UniformValue::setVec3(const Vec3& value)
@@ -210,6 +228,7 @@ void UniformValue::setVec3(const Vec3& value)
     CCASSERT(_uniform->type == GL_FLOAT_VEC3, "Wrong type: expecting GL_FLOAT_VEC3");
 	memcpy(_value.v3Value, &value, sizeof(_value.v3Value));
     _type = Type::VALUE;
+    _dirty = true;
 
 }
 
@@ -219,6 +238,7 @@ void UniformValue::setVec3v(ssize_t size, const Vec3* pointer)
     _value.v3f.pointer = (const float*)pointer;
     _value.v3f.size = (GLsizei)size;
     _type = Type::POINTER;
+    _dirty = true;
 
 }
 
@@ -227,6 +247,7 @@ void UniformValue::setVec4(const Vec4& value)
     CCASSERT (_uniform->type == GL_FLOAT_VEC4, "Wrong type: expecting GL_FLOAT_VEC4");
 	memcpy(_value.v4Value, &value, sizeof(_value.v4Value));
     _type = Type::VALUE;
+    _dirty = true;
 }
 
 void UniformValue::setVec4v(ssize_t size, const Vec4* pointer)
@@ -235,6 +256,7 @@ void UniformValue::setVec4v(ssize_t size, const Vec4* pointer)
     _value.v4f.pointer = (const float*)pointer;
     _value.v4f.size = (GLsizei)size;
     _type = Type::POINTER;
+    _dirty = true;
 }
 
 void UniformValue::setMat4(const Mat4& value)
@@ -242,6 +264,7 @@ void UniformValue::setMat4(const Mat4& value)
     CCASSERT(_uniform->type == GL_FLOAT_MAT4, "_uniform's type should be equal GL_FLOAT_MAT4.");
 	memcpy(_value.matrixValue, &value, sizeof(_value.matrixValue));
     _type = Type::VALUE;
+    _dirty = true;
 }
 
 //
@@ -364,6 +387,12 @@ GLProgramState::GLProgramState()
 , _glprogram(nullptr)
 , _nodeBinding(nullptr)
 {
+    // 0 is reserved for "no state", see GLProgram::_uniformsStateId
+    static uint32_t s_lastStateId = 0;
+    if (++s_lastStateId == 0)
+        ++s_lastStateId;
+    _stateId = s_lastStateId;
+
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID || CC_TARGET_PLATFORM == CC_PLATFORM_WINRT)
     /** listen the event that renderer was recreated on Android/WP8 */
     CCLOG("create rendererRecreatedListener for GLProgramState");
@@ -418,6 +447,64 @@ GLProgramState* GLProgramState::clone() const
     return glprogramstate;
 }
 
+GLProgramState* GLProgramState::getShared(GLProgramState* glprogramstate)
+{
+    return GLProgramStateCache::getInstance()->getSharedGLProgramState(glprogramstate);
+}
+
+bool GLProgramState::isShareable() const
+{
+    if (_nodeBinding || !_autoBindings.empty() || _vertexAttribsFlags != 0)
+        return false;
+
+    for (const auto& attribute : _attributes)
+    {
+        if (attribute.second._enabled)
+            return false;
+    }
+
+    return !hasUniformCallbacks();
+}
+
+bool GLProgramState::hasUniformCallbacks() const
+{
+    for (const auto& uniform : _uniforms)
+    {
+        if (uniform.second._type == UniformValue::Type::CALLBACK_FN)
+            return true;
+    }
+    return false;
+}
+
+uint32_t GLProgramState::getUniformValuesHash() const
+{
+    // summed so that the hash does not depend on the iteration order of _uniforms
+    uint32_t hash = 0;
+    for (const auto& uniform : _uniforms)
+    {
+        hash += XXH32(&uniform.second._value, sizeof(uniform.second._value), (unsigned int)uniform.first);
+    }
+    return hash;
+}
+
+bool GLProgramState::hasSameUniformValues(const GLProgramState* other) const
+{
+    if (_glprogram != other->_glprogram || _uniforms.size() != other->_uniforms.size())
+        return false;
+
+    for (const auto& uniform : _uniforms)
+    {
+        const auto& itr = other->_uniforms.find(uniform.first);
+        if (itr == other->_uniforms.end()
+            || itr->second._type != uniform.second._type
+            || memcmp(&itr->second._value, &uniform.second._value, sizeof(uniform.second._value)) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool GLProgramState::init(GLProgram* glprogram)
 {
     CCASSERT(glprogram, "invalid shader");
@@ -511,9 +598,22 @@ void GLProgramState::applyUniforms()
 {
     // set uniforms
     updateUniformsAndAttributes();
+
+    // uniforms that did not change since this state was applied the last time are still
+    // current in the program, unless another state used the same program in between.
+    // Textures are always applied since their texture units can be rebound by anyone.
+    bool valuesApplied = (_glprogram->_uniformsStateId == _stateId);
     for(auto& uniform : _uniforms) {
-        uniform.second.apply();
+        auto& value = uniform.second;
+        if (valuesApplied && !value._dirty && value._type == UniformValue::Type::VALUE
+            && value._uniform->type != GL_SAMPLER_2D && value._uniform->type != GL_SAMPLER_CUBE)
+        {
+            GL::recordStateChange(false);
+            continue;
+        }
+        value.apply();
     }
+    _glprogram->_uniformsStateId = _stateId;
 }
 
 void GLProgramState::setGLProgram(GLProgram *glprogram)
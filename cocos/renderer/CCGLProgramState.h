@@ -121,6 +121,8 @@ protected:
     GLProgram* _glprogram;
     /** What kind of type is the Uniform */
     Type _type;
+    /** Whether the value changed since it was last applied */
+    bool _dirty;
 
     /**
      @name Uniform Value Uniform
@@ -257,6 +259,15 @@ public:
     /** Returns a new copy of the GLProgramState. The GLProgram is reused */
     GLProgramState* clone() const;
 
+    /**
+     Returns a cached GLProgramState that has the same GLProgram and the same uniform values as `glprogramstate`,
+     so that nodes using identical materials share one state and their commands can be batched together.
+     States with callbacks, vertex attributes, auto bindings or a node binding are not shared and are returned as is.
+     The returned state must not be modified afterwards, since it can be used by other nodes; clone it instead.
+     @since v3.9
+     */
+    static GLProgramState* getShared(GLProgramState* glprogramstate);
+
     /**
      Apply GLProgram, attributes and uniforms.
      @param modelView The applied modelView matrix to shader.
@@ -298,6 +309,12 @@ public:
     
     /**Get the number of user defined uniform count.*/
     ssize_t getUniformCount() const { return _uniforms.size(); }
+
+    /**Whether any user defined uniform is set with a callback. @since v3.9*/
+    bool hasUniformCallbacks() const;
+
+    /**Unique id of this GLProgramState, used by the renderer to batch commands sharing the same state. @since v3.9*/
+    uint32_t getStateId() const { return _stateId; }
     
     /** @{
      Setting user defined uniforms by uniform string name in the shader.
@@ -444,6 +461,9 @@ protected:
     VertexAttribValue* getVertexAttribValue(const std::string& attributeName);
     UniformValue* getUniformValue(const std::string& uniformName);
     UniformValue* getUniformValue(GLint uniformLocation);
+    bool isShareable() const;
+    uint32_t getUniformValuesHash() const;
+    bool hasSameUniformValues(const GLProgramState* other) const;
 
 
     bool _uniformAttributeValueDirty;
@@ -455,6 +475,8 @@ protected:
     int _textureUnitIndex;
     uint32_t _vertexAttribsFlags;
     GLProgram* _glprogram;
+    // the GLProgram skips uploading clean uniforms when this state was the last one applied
+    uint32_t _stateId;
 
     Node* _nodeBinding; // weak ref
 
@@ -27,6 +27,8 @@ THE SOFTWARE.
 #include "renderer/CCGLProgramState.h"
 #include "renderer/CCGLProgram.h"
 
+#include "xxhash.h"
+
 
 NS_CC_BEGIN
 
@@ -39,6 +41,7 @@ GLProgramStateCache::GLProgramStateCache()
 GLProgramStateCache::~GLProgramStateCache()
 {
     _glProgramStates.clear();
+    _sharedGLProgramStates.clear();
 }
 
 GLProgramStateCache* GLProgramStateCache::getInstance()
@@ -73,6 +76,27 @@ GLProgramState* GLProgramStateCache::getGLProgramState(GLProgram* glprogram)
     return ret;
 }
 
+GLProgramState* GLProgramStateCache::getSharedGLProgramState(GLProgramState* glprogramstate)
+{
+    CCASSERT(glprogramstate, "Invalid GLProgramState");
+
+    if (!glprogramstate->isShareable())
+        return glprogramstate;
+
+    GLProgram* glprogram = glprogramstate->getGLProgram();
+    uint32_t hash = XXH32(&glprogram, sizeof(glprogram), glprogramstate->getUniformValuesHash());
+
+    auto& candidates = _sharedGLProgramStates[hash];
+    for (const auto& candidate : candidates)
+    {
+        if (candidate == glprogramstate || candidate->hasSameUniformValues(glprogramstate))
+            return candidate;
+    }
+
+    candidates.pushBack(glprogramstate);
+    return glprogramstate;
+}
+
 void GLProgramStateCache::removeUnusedGLProgramState()
 {
     for( auto it=_glProgramStates.cbegin(); it!=_glProgramStates.cend(); /* nothing */) {
@@ -86,11 +110,25 @@ void GLProgramStateCache::removeUnusedGLProgramState()
             ++it;
         }
     }
+
+    for (auto it = _sharedGLProgramStates.begin(); it != _sharedGLProgramStates.end(); /* nothing */) {
+        auto& states = it->second;
+        for (ssize_t i = states.size() - 1; i >= 0; --i) {
+            if (states.at(i)->getReferenceCount() == 1)
+                states.erase(i);
+        }
+
+        if (states.empty())
+            it = _sharedGLProgramStates.erase(it);
+        else
+            ++it;
+    }
 }
 
 void GLProgramStateCache::removeAllGLProgramState()
 {
     _glProgramStates.clear();
+    _sharedGLProgramStates.clear();
 }
 
 NS_CC_END
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "base/ccTypes.h"
 #include "base/CCVector.h"
 #include "base/CCMap.h"
+#include <unordered_map>
 #include "math/Vec2.h"
 #include "math/Vec3.h"
 #include "math/Vec4.h"
@@ -57,6 +58,12 @@ public:
     
     /**Get the shared GLProgramState by the owner GLProgram.*/
     GLProgramState* getGLProgramState(GLProgram* program);
+    /**
+     Get a cached GLProgramState with the same GLProgram and uniform values as `glprogramstate`.
+     If there is none yet, `glprogramstate` is cached and returned. @see GLProgramState::getShared
+     @since v3.9
+     */
+    GLProgramState* getSharedGLProgramState(GLProgramState* glprogramstate);
     /**Remove all the cached GLProgramState.*/
 	void removeAllGLProgramState();
     /**Remove unused GLProgramState.*/
@@ -67,6 +74,8 @@ protected:
     ~GLProgramStateCache();
     
     Map<GLProgram*, GLProgramState*> _glProgramStates;
+    // shared states, by hash of their program and uniform values
+    std::unordered_map<uint32_t, Vector<GLProgramState*>> _sharedGLProgramStates;
     static GLProgramStateCache* s_instance;
 };
 
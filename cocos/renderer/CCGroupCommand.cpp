@@ -26,9 +26,14 @@
 #include "renderer/CCGroupCommand.h"
 #include "renderer/CCRenderer.h"
 #include "base/CCDirector.h"
+#include "base/allocator/CCAllocatorStrategyPool.h"
 
 NS_CC_BEGIN
 
+#if CC_ENABLE_RENDER_COMMAND_POOL
+CC_DEFINE_ALLOCATOR_POOL(GroupCommand, 32)
+#endif
+
 GroupCommandManager::GroupCommandManager()
 {
 
@@ -48,6 +53,8 @@ bool GroupCommandManager::init()
 
 int GroupCommandManager::getGroupID()
 {
+    std::lock_guard<std::mutex> lock(_mutex);
+    
     //Reuse old id
     if (!_unusedIDs.empty())
     {
@@ -67,6 +74,7 @@ int GroupCommandManager::getGroupID()
 
 void GroupCommandManager::releaseGroupID(int groupID)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     _groupMapping[groupID] = false;
     _unusedIDs.push_back(groupID);
 }
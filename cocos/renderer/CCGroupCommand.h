@@ -28,8 +28,10 @@
 
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 
 #include "base/CCRef.h"
+#include "base/allocator/CCAllocatorMacros.h"
 #include "CCRenderCommand.h"
 
 /**
@@ -53,6 +55,8 @@ protected:
     bool init();
     std::unordered_map<int, bool> _groupMapping;
     std::vector<int> _unusedIDs;
+    // group commands may be initialized while nodes are visited in parallel
+    std::mutex _mutex;
 };
 
 /**
@@ -62,6 +66,10 @@ protected:
 class CC_DLL GroupCommand : public RenderCommand
 {
 public:
+#if CC_ENABLE_RENDER_COMMAND_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
+
     /**@{
      Constructor and Destructor.
      */
@@ -41,10 +41,15 @@
 #include "renderer/CCTechnique.h"
 #include "renderer/CCMaterial.h"
 #include "renderer/CCPass.h"
+#include "base/allocator/CCAllocatorStrategyPool.h"
 #include "xxhash.h"
 
 NS_CC_BEGIN
 
+#if CC_ENABLE_RENDER_COMMAND_POOL
+CC_DEFINE_ALLOCATOR_POOL(MeshCommand, 32)
+#endif
+
 
 MeshCommand::MeshCommand()
 : _textureID(0)
@@ -200,14 +205,14 @@ void MeshCommand::preBatchDraw()
         }
         else
         {
-            glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+            GL::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
 
             // FIXME: Assumes that all the passes in the Material share the same Vertex Attribs
             GLProgramState* programState = _material
                                             ? _material->_currentTechnique->_passes.at(0)->getGLProgramState()
                                             : _glProgramState;
             programState->applyAttributes();
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+            GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
         }
     }
 }
@@ -249,8 +254,8 @@ void MeshCommand::postBatchDraw()
         }
         else
         {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            GL::bindBuffer(GL_ARRAY_BUFFER, 0);
         }
 
         // restore the default state since we don't know
@@ -262,8 +267,8 @@ void MeshCommand::postBatchDraw()
 void MeshCommand::execute()
 {
     // Draw without VAO
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
 
     if (_material)
     {
@@ -290,8 +295,8 @@ void MeshCommand::execute()
         CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, _indexCount);
     }
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void MeshCommand::buildVAO()
@@ -304,7 +309,7 @@ void MeshCommand::buildVAO()
     releaseVAO();
     glGenVertexArrays(1, &_vao);
     GL::bindVAO(_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
     auto flags = programState->getVertexAttribsFlags();
     for (int i = 0; flags > 0; i++) {
         int flag = 1 << i;
@@ -314,11 +319,11 @@ void MeshCommand::buildVAO()
     }
     programState->applyAttributes(false);
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
     
     GL::bindVAO(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 void MeshCommand::releaseVAO()
 {
@@ -30,6 +30,7 @@
 #include "renderer/CCGLProgram.h"
 #include "renderer/CCRenderState.h"
 #include "math/CCMath.h"
+#include "base/allocator/CCAllocatorMacros.h"
 
 NS_CC_BEGIN
 
@@ -42,6 +43,9 @@ class Material;
 class CC_DLL MeshCommand : public RenderCommand
 {
 public:
+#if CC_ENABLE_RENDER_COMMAND_POOL
+    CC_DECLARE_ALLOCATOR_POOL
+#endif
 
     MeshCommand();
     virtual ~MeshCommand();
@@ -0,0 +1,971 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#include "renderer/CCPixelConversion.h"
+#include "platform/CCImage.h"
+
+//#define USE_SSE2      : SSE2 conversions used
+//#define USE_NEON      : NEON conversions used
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined (__ARM_NEON__) || defined (__ARM_NEON) || defined (__aarch64__)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+NS_CC_BEGIN
+
+namespace
+{
+#if defined (USE_SSE2) || defined (USE_NEON)
+    bool s_simdEnabled = true;
+#else
+    bool s_simdEnabled = false;
+#endif
+
+    // The SIMD conversions convert whole blocks of pixels and return the number of input bytes converted,
+    // the conversions of PixelConversion convert the pixels left.
+
+#define CC_NO_SIMD_CONVERSION(Src, Dst) \
+    inline ssize_t simd##Src##To##Dst(const unsigned char*, ssize_t, unsigned char*) { return 0; }
+
+#if defined (USE_SSE2)
+
+    // packs the low 16 bits of the 32 bit lanes of a and b
+    inline __m128i pack32To16(__m128i a, __m128i b)
+    {
+        // _mm_packs_epi32 saturates signed values, sign extend the low 16 bits first
+        a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+        b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+        return _mm_packs_epi32(a, b);
+    }
+
+    inline __m128i mask32(int mask)
+    {
+        return _mm_set1_epi32(mask);
+    }
+
+    // (R*299 + G*587 + B*114 + 500) / 1000, for RGBA8888 pixels in 32 bit lanes
+    inline __m128i luminance(__m128i v)
+    {
+        const __m128i rbWeights = _mm_set1_epi32((114 << 16) | 299);
+        const __m128i gWeight = _mm_set1_epi32(587);
+        __m128i rb = _mm_and_si128(v, mask32(0x00FF00FF));
+        __m128i g = _mm_and_si128(_mm_srli_epi32(v, 8), mask32(0xFF));
+        __m128i sum = _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rb, rbWeights), _mm_madd_epi16(g, gWeight)), mask32(500));
+        // the division of floats is correctly rounded, which can't reach the next integer here
+        return _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(sum), _mm_set1_ps(1000.0f)));
+    }
+
+    // RGBA8888 pixels in 32 bit lanes to the 16 or 8 bit destination format
+    struct RGB565Lanes
+    {
+        static const int bytes = 2;
+        static __m128i convert(__m128i v)
+        {
+            return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(v, mask32(0xF8)), 8),
+                                             _mm_srli_epi32(_mm_and_si128(v, mask32(0xFC00)), 5)),
+                                _mm_srli_epi32(_mm_and_si128(v, mask32(0xF80000)), 19));
+        }
+    };
+
+    struct RGBA4444Lanes
+    {
+        static const int bytes = 2;
+        static __m128i convert(__m128i v)
+        {
+            return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(v, mask32(0xF0)), 8),
+                                             _mm_srli_epi32(_mm_and_si128(v, mask32(0xF000)), 4)),
+                                _mm_or_si128(_mm_srli_epi32(_mm_and_si128(v, mask32(0xF00000)), 16),
+                                             _mm_srli_epi32(v, 28)));
+        }
+    };
+
+    struct RGB5A1Lanes
+    {
+        static const int bytes = 2;
+        static __m128i convert(__m128i v)
+        {
+            return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(v, mask32(0xF8)), 8),
+                                             _mm_srli_epi32(_mm_and_si128(v, mask32(0xF800)), 5)),
+                                _mm_or_si128(_mm_srli_epi32(_mm_and_si128(v, mask32(0xF80000)), 18),
+                                             _mm_srli_epi32(v, 31)));
+        }
+    };
+
+    struct AI88Lanes
+    {
+        static const int bytes = 2;
+        static __m128i convert(__m128i v)
+        {
+            return _mm_or_si128(luminance(v), _mm_slli_epi32(_mm_srli_epi32(v, 24), 8));
+        }
+    };
+
+    struct I8Lanes
+    {
+        static const int bytes = 1;
+        static __m128i convert(__m128i v)
+        {
+            return luminance(v);
+        }
+    };
+
+    struct A8Lanes
+    {
+        static const int bytes = 1;
+        static __m128i convert(__m128i v)
+        {
+            return _mm_srli_epi32(v, 24);
+        }
+    };
+
+    // 8 RGBA8888 pixels at a time
+    template <typename Dst>
+    ssize_t convertRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+    {
+        ssize_t i = 0;
+        for (; i + 32 <= dataLen; i += 32)
+        {
+            __m128i lo = Dst::convert(_mm_loadu_si128((const __m128i*)(data + i)));
+            __m128i hi = Dst::convert(_mm_loadu_si128((const __m128i*)(data + i + 16)));
+            unsigned char* out = outData + i / 4 * Dst::bytes;
+            if (Dst::bytes == 2)
+            {
+                _mm_storeu_si128((__m128i*)out, pack32To16(lo, hi));
+            }
+            else
+            {
+                // the lanes are bytes
+                __m128i words = _mm_packs_epi32(lo, hi);
+                _mm_storel_epi64((__m128i*)out, _mm_packus_epi16(words, words));
+            }
+        }
+        return i;
+    }
+
+    // 8 I8 or AI88 pixels at a time, as gray levels and alphas in 16 bit lanes
+    struct I8Gray
+    {
+        static const int bytes = 1;
+        static void load(const unsigned char* data, __m128i& gray, __m128i& alpha)
+        {
+            gray = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)data), _mm_setzero_si128());
+            alpha = _mm_set1_epi16(0xFF);
+        }
+    };
+
+    struct AI88Gray
+    {
+        static const int bytes = 2;
+        static void load(const unsigned char* data, __m128i& gray, __m128i& alpha)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)data);
+            gray = _mm_and_si128(v, _mm_set1_epi16(0xFF));
+            alpha = _mm_srli_epi16(v, 8);
+        }
+    };
+
+    struct RGBA8888FromGray
+    {
+        static const int bytes = 4;
+        static void store(__m128i gray, __m128i alpha, unsigned char* out)
+        {
+            __m128i gg = _mm_or_si128(gray, _mm_slli_epi16(gray, 8));
+            __m128i ga = _mm_or_si128(gray, _mm_slli_epi16(alpha, 8));
+            _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi16(gg, ga));
+            _mm_storeu_si128((__m128i*)(out + 16), _mm_unpackhi_epi16(gg, ga));
+        }
+    };
+
+    struct RGB565FromGray
+    {
+        static const int bytes = 2;
+        static void store(__m128i gray, __m128i alpha, unsigned char* out)
+        {
+            __m128i g5 = _mm_and_si128(gray, _mm_set1_epi16(0xF8));
+            __m128i g6 = _mm_and_si128(gray, _mm_set1_epi16(0xFC));
+            _mm_storeu_si128((__m128i*)out, _mm_or_si128(_mm_or_si128(_mm_slli_epi16(g5, 8), _mm_slli_epi16(g6, 3)), _mm_srli_epi16(g5, 3)));
+        }
+    };
+
+    struct RGBA4444FromGray
+    {
+        static const int bytes = 2;
+        static void store(__m128i gray, __m128i alpha, unsigned char* out)
+        {
+            __m128i g4 = _mm_and_si128(gray, _mm_set1_epi16(0xF0));
+            __m128i a4 = _mm_srli_epi16(_mm_and_si128(alpha, _mm_set1_epi16(0xF0)), 4);
+            _mm_storeu_si128((__m128i*)out, _mm_or_si128(_mm_or_si128(_mm_slli_epi16(g4, 8), _mm_slli_epi16(g4, 4)), _mm_or_si128(g4, a4)));
+        }
+    };
+
+    struct RGB5A1FromGray
+    {
+        static const int bytes = 2;
+        static void store(__m128i gray, __m128i alpha, unsigned char* out)
+        {
+            __m128i g5 = _mm_and_si128(gray, _mm_set1_epi16(0xF8));
+            __m128i a1 = _mm_srli_epi16(_mm_and_si128(alpha, _mm_set1_epi16(0x80)), 7);
+            _mm_storeu_si128((__m128i*)out, _mm_or_si128(_mm_or_si128(_mm_slli_epi16(g5, 8), _mm_slli_epi16(g5, 3)), _mm_or_si128(_mm_srli_epi16(g5, 2), a1)));
+        }
+    };
+
+    struct AI88FromGray
+    {
+        static const int bytes = 2;
+        static void store(__m128i gray, __m128i alpha, unsigned char* out)
+        {
+            _mm_storeu_si128((__m128i*)out, _mm_or_si128(gray, _mm_slli_epi16(alpha, 8)));
+        }
+    };
+
+    struct I8FromGray
+    {
+        static const int bytes = 1;
+        static void store(__m128i gray, __m128i alpha, unsigned char* out)
+        {
+            _mm_storel_epi64((__m128i*)out, _mm_packus_epi16(gray, gray));
+        }
+    };
+
+    struct A8FromGray
+    {
+        static const int bytes = 1;
+        static void store(__m128i gray, __m128i alpha, unsigned char* out)
+        {
+            _mm_storel_epi64((__m128i*)out, _mm_packus_epi16(alpha, alpha));
+        }
+    };
+
+    template <typename Src, typename Dst>
+    ssize_t convertGray(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+    {
+        ssize_t i = 0;
+        for (; i + 8 * Src::bytes <= dataLen; i += 8 * Src::bytes)
+        {
+            __m128i gray, alpha;
+            Src::load(data + i, gray, alpha);
+            Dst::store(gray, alpha, outData + i / Src::bytes * Dst::bytes);
+        }
+        return i;
+    }
+
+    ssize_t simdPremultiplyAlpha(unsigned char* data, ssize_t dataLen)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi16(1);
+        const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+        ssize_t i = 0;
+        for (; i + 16 <= dataLen; i += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+            __m128i halves[2] = { _mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero) };
+            for (int h = 0; h < 2; ++h)
+            {
+                // c * (a + 1) >> 8, like CC_RGB_PREMULTIPLY_ALPHA, and keep the alpha
+                __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(halves[h], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                __m128i premultiplied = _mm_srli_epi16(_mm_mullo_epi16(halves[h], _mm_add_epi16(alpha, one)), 8);
+                halves[h] = _mm_or_si128(_mm_andnot_si128(alphaMask, premultiplied), _mm_and_si128(alphaMask, halves[h]));
+            }
+            _mm_storeu_si128((__m128i*)(data + i), _mm_packus_epi16(halves[0], halves[1]));
+        }
+        return i;
+    }
+
+#define CC_SIMD_RGBA8888_CONVERSION(Dst) \
+    inline ssize_t simdRGBA8888To##Dst(const unsigned char* data, ssize_t dataLen, unsigned char* outData) \
+    { return convertRGBA8888<Dst##Lanes>(data, dataLen, outData); }
+
+#define CC_SIMD_GRAY_CONVERSION(Src, Dst) \
+    inline ssize_t simd##Src##To##Dst(const unsigned char* data, ssize_t dataLen, unsigned char* outData) \
+    { return convertGray<Src##Gray, Dst##FromGray>(data, dataLen, outData); }
+
+    CC_SIMD_RGBA8888_CONVERSION(RGB565)
+    CC_SIMD_RGBA8888_CONVERSION(RGBA4444)
+    CC_SIMD_RGBA8888_CONVERSION(RGB5A1)
+    CC_SIMD_RGBA8888_CONVERSION(AI88)
+    CC_SIMD_RGBA8888_CONVERSION(I8)
+    CC_SIMD_RGBA8888_CONVERSION(A8)
+
+    CC_SIMD_GRAY_CONVERSION(I8, RGBA8888)
+    CC_SIMD_GRAY_CONVERSION(I8, RGB565)
+    CC_SIMD_GRAY_CONVERSION(I8, RGBA4444)
+    CC_SIMD_GRAY_CONVERSION(I8, RGB5A1)
+    CC_SIMD_GRAY_CONVERSION(I8, AI88)
+    CC_SIMD_GRAY_CONVERSION(AI88, RGBA8888)
+    CC_SIMD_GRAY_CONVERSION(AI88, RGB565)
+    CC_SIMD_GRAY_CONVERSION(AI88, RGBA4444)
+    CC_SIMD_GRAY_CONVERSION(AI88, RGB5A1)
+    CC_SIMD_GRAY_CONVERSION(AI88, A8)
+    CC_SIMD_GRAY_CONVERSION(AI88, I8)
+
+    // 3 byte pixels need byte shuffles, which SSE2 doesn't have
+    CC_NO_SIMD_CONVERSION(I8, RGB888)
+    CC_NO_SIMD_CONVERSION(AI88, RGB888)
+    CC_NO_SIMD_CONVERSION(RGB888, RGBA8888)
+    CC_NO_SIMD_CONVERSION(RGB888, RGB565)
+    CC_NO_SIMD_CONVERSION(RGB888, I8)
+    CC_NO_SIMD_CONVERSION(RGB888, AI88)
+    CC_NO_SIMD_CONVERSION(RGB888, RGBA4444)
+    CC_NO_SIMD_CONVERSION(RGB888, RGB5A1)
+    CC_NO_SIMD_CONVERSION(RGBA8888, RGB888)
+
+#elif defined (USE_NEON)
+
+    // 16 pixels, one plane per channel
+    struct Pixels16
+    {
+        uint8x16_t r;
+        uint8x16_t g;
+        uint8x16_t b;
+        uint8x16_t a;
+        // (R*299 + G*587 + B*114 + 500) / 1000, or the gray level of I8 and AI88 pixels
+        uint8x16_t l;
+    };
+
+    // x / 1000 for any 32 bit x, like compilers do it: (x * 274877907) >> 38
+    inline uint32x4_t divideBy1000(uint32x4_t x)
+    {
+        const uint32x2_t m = vdup_n_u32(274877907);
+        uint64x2_t lo = vshrq_n_u64(vmull_u32(vget_low_u32(x), m), 38);
+        uint64x2_t hi = vshrq_n_u64(vmull_u32(vget_high_u32(x), m), 38);
+        return vcombine_u32(vmovn_u64(lo), vmovn_u64(hi));
+    }
+
+    inline uint8x8_t luminance8(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+    {
+        uint16x8_t r16 = vmovl_u8(r);
+        uint16x8_t g16 = vmovl_u8(g);
+        uint16x8_t b16 = vmovl_u8(b);
+        uint32x4_t lo = vmlal_n_u16(vmlal_n_u16(vmlal_n_u16(vdupq_n_u32(500), vget_low_u16(r16), 299), vget_low_u16(g16), 587), vget_low_u16(b16), 114);
+        uint32x4_t hi = vmlal_n_u16(vmlal_n_u16(vmlal_n_u16(vdupq_n_u32(500), vget_high_u16(r16), 299), vget_high_u16(g16), 587), vget_high_u16(b16), 114);
+        return vmovn_u16(vcombine_u16(vmovn_u32(divideBy1000(lo)), vmovn_u32(divideBy1000(hi))));
+    }
+
+    inline uint8x16_t luminance(uint8x16_t r, uint8x16_t g, uint8x16_t b)
+    {
+        return vcombine_u8(luminance8(vget_low_u8(r), vget_low_u8(g), vget_low_u8(b)),
+                           luminance8(vget_high_u8(r), vget_high_u8(g), vget_high_u8(b)));
+    }
+
+    struct I8Pixels
+    {
+        static const int bytes = 1;
+        static void load(const unsigned char* data, Pixels16& p)
+        {
+            p.l = p.r = p.g = p.b = vld1q_u8(data);
+            p.a = vdupq_n_u8(0xFF);
+        }
+        static void store(const Pixels16& p, unsigned char* out)
+        {
+            vst1q_u8(out, p.l);
+        }
+    };
+
+    struct AI88Pixels
+    {
+        static const int bytes = 2;
+        static void load(const unsigned char* data, Pixels16& p)
+        {
+            uint8x16x2_t v = vld2q_u8(data);
+            p.l = p.r = p.g = p.b = v.val[0];
+            p.a = v.val[1];
+        }
+        static void store(const Pixels16& p, unsigned char* out)
+        {
+            uint8x16x2_t v;
+            v.val[0] = p.l;
+            v.val[1] = p.a;
+            vst2q_u8(out, v);
+        }
+    };
+
+    struct RGB888Pixels
+    {
+        static const int bytes = 3;
+        static void load(const unsigned char* data, Pixels16& p)
+        {
+            uint8x16x3_t v = vld3q_u8(data);
+            p.r = v.val[0];
+            p.g = v.val[1];
+            p.b = v.val[2];
+            p.a = vdupq_n_u8(0xFF);
+            p.l = luminance(p.r, p.g, p.b);
+        }
+        static void store(const Pixels16& p, unsigned char* out)
+        {
+            uint8x16x3_t v;
+            v.val[0] = p.r;
+            v.val[1] = p.g;
+            v.val[2] = p.b;
+            vst3q_u8(out, v);
+        }
+    };
+
+    struct RGBA8888Pixels
+    {
+        static const int bytes = 4;
+        static void load(const unsigned char* data, Pixels16& p)
+        {
+            uint8x16x4_t v = vld4q_u8(data);
+            p.r = v.val[0];
+            p.g = v.val[1];
+            p.b = v.val[2];
+            p.a = v.val[3];
+            p.l = luminance(p.r, p.g, p.b);
+        }
+        static void store(const Pixels16& p, unsigned char* out)
+        {
+            uint8x16x4_t v;
+            v.val[0] = p.r;
+            v.val[1] = p.g;
+            v.val[2] = p.b;
+            v.val[3] = p.a;
+            vst4q_u8(out, v);
+        }
+    };
+
+    struct A8Pixels
+    {
+        static const int bytes = 1;
+        static void store(const Pixels16& p, unsigned char* out)
+        {
+            vst1q_u8(out, p.a);
+        }
+    };
+
+    // the 16 bit formats, 8 pixels at a time
+    struct RGB565Pack
+    {
+        static uint16x8_t pack(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a)
+        {
+            return vorrq_u16(vorrq_u16(vshll_n_u8(vand_u8(r, vdup_n_u8(0xF8)), 8), vshll_n_u8(vand_u8(g, vdup_n_u8(0xFC)), 3)),
+                             vmovl_u8(vshr_n_u8(b, 3)));
+        }
+    };
+
+    struct RGBA4444Pack
+    {
+        static uint16x8_t pack(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a)
+        {
+            return vorrq_u16(vorrq_u16(vshll_n_u8(vand_u8(r, vdup_n_u8(0xF0)), 8), vshll_n_u8(vand_u8(g, vdup_n_u8(0xF0)), 4)),
+                             vorrq_u16(vmovl_u8(vand_u8(b, vdup_n_u8(0xF0))), vmovl_u8(vshr_n_u8(a, 4))));
+        }
+    };
+
+    struct RGB5A1Pack
+    {
+        static uint16x8_t pack(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a)
+        {
+            return vorrq_u16(vorrq_u16(vshll_n_u8(vand_u8(r, vdup_n_u8(0xF8)), 8), vshll_n_u8(vand_u8(g, vdup_n_u8(0xF8)), 3)),
+                             vorrq_u16(vshll_n_u8(vshr_n_u8(b, 3), 1), vmovl_u8(vshr_n_u8(a, 7))));
+        }
+    };
+
+    template <typename Pack>
+    struct Pixels16Bits
+    {
+        static const int bytes = 2;
+        static void store(const Pixels16& p, unsigned char* out)
+        {
+            uint16_t* out16 = (uint16_t*)out;
+            vst1q_u16(out16, Pack::pack(vget_low_u8(p.r), vget_low_u8(p.g), vget_low_u8(p.b), vget_low_u8(p.a)));
+            vst1q_u16(out16 + 8, Pack::pack(vget_high_u8(p.r), vget_high_u8(p.g), vget_high_u8(p.b), vget_high_u8(p.a)));
+        }
+    };
+
+    typedef Pixels16Bits<RGB565Pack> RGB565Pixels;
+    typedef Pixels16Bits<RGBA4444Pack> RGBA4444Pixels;
+    typedef Pixels16Bits<RGB5A1Pack> RGB5A1Pixels;
+
+    template <typename Src, typename Dst>
+    ssize_t convertPixels(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+    {
+        ssize_t i = 0;
+        for (; i + 16 * Src::bytes <= dataLen; i += 16 * Src::bytes)
+        {
+            Pixels16 p;
+            Src::load(data + i, p);
+            Dst::store(p, outData + i / Src::bytes * Dst::bytes);
+        }
+        return i;
+    }
+
+    ssize_t simdPremultiplyAlpha(unsigned char* data, ssize_t dataLen)
+    {
+        ssize_t i = 0;
+        for (; i + 64 <= dataLen; i += 64)
+        {
+            uint8x16x4_t v = vld4q_u8(data + i);
+            for (int c = 0; c < 3; ++c)
+            {
+                // c * (a + 1) >> 8, like CC_RGB_PREMULTIPLY_ALPHA
+                uint16x8_t lo = vaddw_u8(vmull_u8(vget_low_u8(v.val[c]), vget_low_u8(v.val[3])), vget_low_u8(v.val[c]));
+                uint16x8_t hi = vaddw_u8(vmull_u8(vget_high_u8(v.val[c]), vget_high_u8(v.val[3])), vget_high_u8(v.val[c]));
+                v.val[c] = vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+            }
+            vst4q_u8(data + i, v);
+        }
+        return i;
+    }
+
+#define CC_SIMD_CONVERSION(Src, Dst) \
+    inline ssize_t simd##Src##To##Dst(const unsigned char* data, ssize_t dataLen, unsigned char* outData) \
+    { return convertPixels<Src##Pixels, Dst##Pixels>(data, dataLen, outData); }
+
+    CC_SIMD_CONVERSION(I8, RGB888)
+    CC_SIMD_CONVERSION(I8, RGBA8888)
+    CC_SIMD_CONVERSION(I8, RGB565)
+    CC_SIMD_CONVERSION(I8, RGBA4444)
+    CC_SIMD_CONVERSION(I8, RGB5A1)
+    CC_SIMD_CONVERSION(I8, AI88)
+    CC_SIMD_CONVERSION(AI88, RGB888)
+    CC_SIMD_CONVERSION(AI88, RGBA8888)
+    CC_SIMD_CONVERSION(AI88, RGB565)
+    CC_SIMD_CONVERSION(AI88, RGBA4444)
+    CC_SIMD_CONVERSION(AI88, RGB5A1)
+    CC_SIMD_CONVERSION(AI88, A8)
+    CC_SIMD_CONVERSION(AI88, I8)
+    CC_SIMD_CONVERSION(RGB888, RGBA8888)
+    CC_SIMD_CONVERSION(RGB888, RGB565)
+    CC_SIMD_CONVERSION(RGB888, I8)
+    CC_SIMD_CONVERSION(RGB888, AI88)
+    CC_SIMD_CONVERSION(RGB888, RGBA4444)
+    CC_SIMD_CONVERSION(RGB888, RGB5A1)
+    CC_SIMD_CONVERSION(RGBA8888, RGB888)
+    CC_SIMD_CONVERSION(RGBA8888, RGB565)
+    CC_SIMD_CONVERSION(RGBA8888, I8)
+    CC_SIMD_CONVERSION(RGBA8888, A8)
+    CC_SIMD_CONVERSION(RGBA8888, AI88)
+    CC_SIMD_CONVERSION(RGBA8888, RGBA4444)
+    CC_SIMD_CONVERSION(RGBA8888, RGB5A1)
+
+#else
+
+    inline ssize_t simdPremultiplyAlpha(unsigned char*, ssize_t) { return 0; }
+
+    CC_NO_SIMD_CONVERSION(I8, RGB888)
+    CC_NO_SIMD_CONVERSION(I8, RGBA8888)
+    CC_NO_SIMD_CONVERSION(I8, RGB565)
+    CC_NO_SIMD_CONVERSION(I8, RGBA4444)
+    CC_NO_SIMD_CONVERSION(I8, RGB5A1)
+    CC_NO_SIMD_CONVERSION(I8, AI88)
+    CC_NO_SIMD_CONVERSION(AI88, RGB888)
+    CC_NO_SIMD_CONVERSION(AI88, RGBA8888)
+    CC_NO_SIMD_CONVERSION(AI88, RGB565)
+    CC_NO_SIMD_CONVERSION(AI88, RGBA4444)
+    CC_NO_SIMD_CONVERSION(AI88, RGB5A1)
+    CC_NO_SIMD_CONVERSION(AI88, A8)
+    CC_NO_SIMD_CONVERSION(AI88, I8)
+    CC_NO_SIMD_CONVERSION(RGB888, RGBA8888)
+    CC_NO_SIMD_CONVERSION(RGB888, RGB565)
+    CC_NO_SIMD_CONVERSION(RGB888, I8)
+    CC_NO_SIMD_CONVERSION(RGB888, AI88)
+    CC_NO_SIMD_CONVERSION(RGB888, RGBA4444)
+    CC_NO_SIMD_CONVERSION(RGB888, RGB5A1)
+    CC_NO_SIMD_CONVERSION(RGBA8888, RGB888)
+    CC_NO_SIMD_CONVERSION(RGBA8888, RGB565)
+    CC_NO_SIMD_CONVERSION(RGBA8888, I8)
+    CC_NO_SIMD_CONVERSION(RGBA8888, A8)
+    CC_NO_SIMD_CONVERSION(RGBA8888, AI88)
+    CC_NO_SIMD_CONVERSION(RGBA8888, RGBA4444)
+    CC_NO_SIMD_CONVERSION(RGBA8888, RGB5A1)
+
+#endif
+}
+
+// the number of input bytes converted by the SIMD conversion, if enabled
+#define CC_SIMD_CONVERT(Src, Dst) (s_simdEnabled ? simd##Src##To##Dst(data, dataLen, outData) : 0)
+
+bool PixelConversion::isSIMDSupported()
+{
+#if defined (USE_SSE2) || defined (USE_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PixelConversion::setSIMDEnabled(bool enabled)
+{
+    s_simdEnabled = enabled && isSIMDSupported();
+}
+
+bool PixelConversion::isSIMDEnabled()
+{
+    return s_simdEnabled;
+}
+
+void PixelConversion::premultiplyAlpha(unsigned char* data, ssize_t dataLen)
+{
+    ssize_t i = s_simdEnabled ? simdPremultiplyAlpha(data, dataLen) : 0;
+    unsigned int* fourBytes = (unsigned int*)data;
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
+    {
+        unsigned char* p = data + i;
+        fourBytes[i / 4] = CC_RGB_PREMULTIPLY_ALPHA(p[0], p[1], p[2], p[3]);
+    }
+}
+
+// IIIIIIII -> RRRRRRRRGGGGGGGGGBBBBBBBB
+void PixelConversion::convertI8ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(I8, RGB888);
+    outData += i * 3;
+    for (; i < dataLen; ++i)
+    {
+        *outData++ = data[i];     //R
+        *outData++ = data[i];     //G
+        *outData++ = data[i];     //B
+    }
+}
+
+// IIIIIIIIAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB
+void PixelConversion::convertAI88ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(AI88, RGB888);
+    outData += i / 2 * 3;
+    for (ssize_t l = dataLen - 1; i < l; i += 2)
+    {
+        *outData++ = data[i];     //R
+        *outData++ = data[i];     //G
+        *outData++ = data[i];     //B
+    }
+}
+
+// IIIIIIII -> RRRRRRRRGGGGGGGGGBBBBBBBBAAAAAAAA
+void PixelConversion::convertI8ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(I8, RGBA8888);
+    outData += i * 4;
+    for (; i < dataLen; ++i)
+    {
+        *outData++ = data[i];     //R
+        *outData++ = data[i];     //G
+        *outData++ = data[i];     //B
+        *outData++ = 0xFF;        //A
+    }
+}
+
+// IIIIIIIIAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
+void PixelConversion::convertAI88ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(AI88, RGBA8888);
+    outData += i * 2;
+    for (ssize_t l = dataLen - 1; i < l; i += 2)
+    {
+        *outData++ = data[i];     //R
+        *outData++ = data[i];     //G
+        *outData++ = data[i];     //B
+        *outData++ = data[i + 1]; //A
+    }
+}
+
+// IIIIIIII -> RRRRRGGGGGGBBBBB
+void PixelConversion::convertI8ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(I8, RGB565);
+    unsigned short* out16 = (unsigned short*)outData + i;
+    for (; i < dataLen; ++i)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8    //R
+            | (data[i] & 0x00FC) << 3         //G
+            | (data[i] & 0x00F8) >> 3;        //B
+    }
+}
+
+// IIIIIIIIAAAAAAAA -> RRRRRGGGGGGBBBBB
+void PixelConversion::convertAI88ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(AI88, RGB565);
+    unsigned short* out16 = (unsigned short*)outData + i / 2;
+    for (ssize_t l = dataLen - 1; i < l; i += 2)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8    //R
+            | (data[i] & 0x00FC) << 3         //G
+            | (data[i] & 0x00F8) >> 3;        //B
+    }
+}
+
+// IIIIIIII -> RRRRGGGGBBBBAAAA
+void PixelConversion::convertI8ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(I8, RGBA4444);
+    unsigned short* out16 = (unsigned short*)outData + i;
+    for (; i < dataLen; ++i)
+    {
+        *out16++ = (data[i] & 0x00F0) << 8    //R
+        | (data[i] & 0x00F0) << 4             //G
+        | (data[i] & 0x00F0)                  //B
+        | 0x000F;                             //A
+    }
+}
+
+// IIIIIIIIAAAAAAAA -> RRRRGGGGBBBBAAAA
+void PixelConversion::convertAI88ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(AI88, RGBA4444);
+    unsigned short* out16 = (unsigned short*)outData + i / 2;
+    for (ssize_t l = dataLen - 1; i < l; i += 2)
+    {
+        *out16++ = (data[i] & 0x00F0) << 8    //R
+        | (data[i] & 0x00F0) << 4             //G
+        | (data[i] & 0x00F0)                  //B
+        | (data[i+1] & 0x00F0) >> 4;          //A
+    }
+}
+
+// IIIIIIII -> RRRRRGGGGGBBBBBA
+void PixelConversion::convertI8ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(I8, RGB5A1);
+    unsigned short* out16 = (unsigned short*)outData + i;
+    for (; i < dataLen; ++i)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8    //R
+            | (data[i] & 0x00F8) << 3         //G
+            | (data[i] & 0x00F8) >> 2         //B
+            | 0x0001;                         //A
+    }
+}
+
+// IIIIIIIIAAAAAAAA -> RRRRRGGGGGBBBBBA
+void PixelConversion::convertAI88ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(AI88, RGB5A1);
+    unsigned short* out16 = (unsigned short*)outData + i / 2;
+    for (ssize_t l = dataLen - 1; i < l; i += 2)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8    //R
+            | (data[i] & 0x00F8) << 3         //G
+            | (data[i] & 0x00F8) >> 2         //B
+            | (data[i + 1] & 0x0080) >> 7;    //A
+    }
+}
+
+// IIIIIIII -> IIIIIIIIAAAAAAAA
+void PixelConversion::convertI8ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(I8, AI88);
+    unsigned short* out16 = (unsigned short*)outData + i;
+    for (; i < dataLen; ++i)
+    {
+        *out16++ = 0xFF00     //A
+        | data[i];            //I
+    }
+}
+
+// IIIIIIIIAAAAAAAA -> AAAAAAAA
+void PixelConversion::convertAI88ToA8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t converted = CC_SIMD_CONVERT(AI88, A8);
+    outData += converted / 2;
+    for (ssize_t i = converted + 1; i < dataLen; i += 2)
+    {
+        *outData++ = data[i]; //A
+    }
+}
+
+// IIIIIIIIAAAAAAAA -> IIIIIIII
+void PixelConversion::convertAI88ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(AI88, I8);
+    outData += i / 2;
+    for (ssize_t l = dataLen - 1; i < l; i += 2)
+    {
+        *outData++ = data[i]; //R
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
+void PixelConversion::convertRGB888ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGB888, RGBA8888);
+    outData += i / 3 * 4;
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
+    {
+        *outData++ = data[i];         //R
+        *outData++ = data[i + 1];     //G
+        *outData++ = data[i + 2];     //B
+        *outData++ = 0xFF;            //A
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB
+void PixelConversion::convertRGBA8888ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGBA8888, RGB888);
+    outData += i / 4 * 3;
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
+    {
+        *outData++ = data[i];         //R
+        *outData++ = data[i + 1];     //G
+        *outData++ = data[i + 2];     //B
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGGBBBBB
+void PixelConversion::convertRGB888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGB888, RGB565);
+    unsigned short* out16 = (unsigned short*)outData + i / 3;
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8    //R
+            | (data[i + 1] & 0x00FC) << 3     //G
+            | (data[i + 2] & 0x00F8) >> 3;    //B
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGGGGGBBBBB
+void PixelConversion::convertRGBA8888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGBA8888, RGB565);
+    unsigned short* out16 = (unsigned short*)outData + i / 4;
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8    //R
+            | (data[i + 1] & 0x00FC) << 3     //G
+            | (data[i + 2] & 0x00F8) >> 3;    //B
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBB -> IIIIIIII
+void PixelConversion::convertRGB888ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGB888, I8);
+    outData += i / 3;
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
+    {
+        *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> IIIIIIII
+void PixelConversion::convertRGBA8888ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGBA8888, I8);
+    outData += i / 4;
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
+    {
+        *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> AAAAAAAA
+void PixelConversion::convertRGBA8888ToA8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGBA8888, A8);
+    outData += i / 4;
+    for (ssize_t l = dataLen -3; i < l; i += 4)
+    {
+        *outData++ = data[i + 3]; //A
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBB -> IIIIIIIIAAAAAAAA
+void PixelConversion::convertRGB888ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGB888, AI88);
+    outData += i / 3 * 2;
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
+    {
+        *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
+        *outData++ = 0xFF;
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> IIIIIIIIAAAAAAAA
+void PixelConversion::convertRGBA8888ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGBA8888, AI88);
+    outData += i / 2;
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
+    {
+        *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
+        *outData++ = data[i + 3];
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRGGGGBBBBAAAA
+void PixelConversion::convertRGB888ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGB888, RGBA4444);
+    unsigned short* out16 = (unsigned short*)outData + i / 3;
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
+    {
+        *out16++ = ((data[i] & 0x00F0) << 8           //R
+                    | (data[i + 1] & 0x00F0) << 4     //G
+                    | (data[i + 2] & 0xF0)            //B
+                    |  0x0F);                         //A
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRGGGGBBBBAAAA
+void PixelConversion::convertRGBA8888ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGBA8888, RGBA4444);
+    unsigned short* out16 = (unsigned short*)outData + i / 4;
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
+    {
+        *out16++ = (data[i] & 0x00F0) << 8    //R
+        | (data[i + 1] & 0x00F0) << 4         //G
+        | (data[i + 2] & 0xF0)                //B
+        |  (data[i + 3] & 0xF0) >> 4;         //A
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGBBBBBA
+void PixelConversion::convertRGB888ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGB888, RGB5A1);
+    unsigned short* out16 = (unsigned short*)outData + i / 3;
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8    //R
+            | (data[i + 1] & 0x00F8) << 3     //G
+            | (data[i + 2] & 0x00F8) >> 2     //B
+            |  0x01;                          //A
+    }
+}
+
+// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGGGGBBBBBA
+void PixelConversion::convertRGBA8888ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
+{
+    ssize_t i = CC_SIMD_CONVERT(RGBA8888, RGB5A1);
+    unsigned short* out16 = (unsigned short*)outData + i / 4;
+    for (ssize_t l = dataLen - 2; i < l; i += 4)
+    {
+        *out16++ = (data[i] & 0x00F8) << 8    //R
+            | (data[i + 1] & 0x00F8) << 3     //G
+            | (data[i + 2] & 0x00F8) >> 2     //B
+            |  (data[i + 3] & 0x0080) >> 7;   //A
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,100 @@
+/****************************************************************************
+Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+
+#ifndef __CC_PIXEL_CONVERSION_H__
+#define __CC_PIXEL_CONVERSION_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "platform/CCStdC.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/**
+ * @brief The pixel format conversions of Texture2D, and the alpha premultiplication of Image.
+ *
+ * Blocks of pixels are converted with SSE2 on x86 and with NEON on ARM when the compiler targets them,
+ * the pixels left are converted one by one. The results are the same with or without SIMD.
+ * On SSE2 the conversions from RGB888 and to RGB888 are not vectorized, they need byte shuffles.
+ *
+ * The data length is in bytes, outData must be large enough for the converted pixels.
+ * @since v3.9
+ */
+class CC_DLL PixelConversion
+{
+public:
+    /** Returns true if the conversions were compiled with SSE2 or NEON. */
+    static bool isSIMDSupported();
+    /** Enables or disables the SIMD conversions, they are enabled by default when supported.
+     * Disabling them is meant to compare them with the scalar versions.
+     */
+    static void setSIMDEnabled(bool enabled);
+    /** Returns true if the SIMD conversions are supported and enabled. */
+    static bool isSIMDEnabled();
+
+    /** Premultiplies the color of RGBA8888 pixels by their alpha, in place. */
+    static void premultiplyAlpha(unsigned char* data, ssize_t dataLen);
+
+    static void convertI8ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertI8ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertI8ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertI8ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertI8ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertI8ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+
+    static void convertAI88ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertAI88ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertAI88ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertAI88ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertAI88ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertAI88ToA8(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertAI88ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+
+    static void convertRGB888ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGB888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGB888ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGB888ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGB888ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGB888ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+
+    static void convertRGBA8888ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGBA8888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGBA8888ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGBA8888ToA8(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGBA8888ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGBA8888ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+    static void convertRGBA8888ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+};
+
+// end of textures group
+/// @}
+
+NS_CC_END
+
+#endif // __CC_PIXEL_CONVERSION_H__
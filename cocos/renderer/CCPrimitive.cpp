@@ -24,6 +24,7 @@
 
 #include "renderer/CCPrimitive.h"
 #include "renderer/CCVertexIndexBuffer.h"
+#include "renderer/ccGLStateCache.h"
 
 NS_CC_BEGIN
 
@@ -95,7 +96,7 @@ void Primitive::draw()
         if(_indices!= nullptr)
         {
             GLenum type = (_indices->getType() == IndexBuffer::IndexType::INDEX_TYPE_SHORT_16) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indices->getVBO());
+            GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indices->getVBO());
             size_t offset = _start * _indices->getSizePerIndex();
             glDrawElements((GLenum)_type, _count, type, (GLvoid*)offset);
         }
@@ -104,8 +105,8 @@ void Primitive::draw()
             glDrawArrays((GLenum)_type, _start, _count);
         }
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
     }
 }
 
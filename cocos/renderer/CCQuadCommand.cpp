@@ -84,12 +84,19 @@ void QuadCommand::generateMaterialID()
 {
     _skipBatching = false;
 
-    if(_glProgramState->getUniformCount() == 0)
+    if(!_glProgramState->hasUniformCallbacks())
     {
         int glProgram = (int)_glProgramState->getGLProgram()->getProgram();
         int intArray[4] = { glProgram, (int)_textureID, (int)_blendType.src, (int)_blendType.dst};
 
         _materialID = XXH32((const void*)intArray, sizeof(intArray), 0);
+
+        // commands using the same state (e.g. from GLProgramState::getShared) share the uniform values too
+        if(_glProgramState->getUniformCount() > 0)
+        {
+            uint32_t stateId = _glProgramState->getStateId();
+            _materialID = XXH32((const void*)&stateId, sizeof(stateId), _materialID);
+        }
     }
     else
     {
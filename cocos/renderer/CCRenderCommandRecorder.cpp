@@ -0,0 +1,142 @@
+/****************************************************************************
+ Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/CCRenderCommandRecorder.h"
+#include "renderer/CCRenderer.h"
+#include "base/ccMacros.h"
+
+#if CC_TARGET_PLATFORM != CC_PLATFORM_WIN32 && CC_TARGET_PLATFORM != CC_PLATFORM_WINRT
+#include <pthread.h>
+#endif
+
+NS_CC_BEGIN
+
+// the recorder active on each thread
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32 || CC_TARGET_PLATFORM == CC_PLATFORM_WINRT
+static __declspec(thread) RenderCommandRecorder* s_currentRecorder = nullptr;
+
+static RenderCommandRecorder* getCurrentRecorder()
+{
+    return s_currentRecorder;
+}
+
+static void setCurrentRecorder(RenderCommandRecorder* recorder)
+{
+    s_currentRecorder = recorder;
+}
+#else
+static pthread_key_t s_currentRecorderKey;
+static pthread_once_t s_currentRecorderKeyOnce = PTHREAD_ONCE_INIT;
+
+static void createCurrentRecorderKey()
+{
+    pthread_key_create(&s_currentRecorderKey, nullptr);
+}
+
+static RenderCommandRecorder* getCurrentRecorder()
+{
+    pthread_once(&s_currentRecorderKeyOnce, createCurrentRecorderKey);
+    return static_cast<RenderCommandRecorder*>(pthread_getspecific(s_currentRecorderKey));
+}
+
+static void setCurrentRecorder(RenderCommandRecorder* recorder)
+{
+    pthread_once(&s_currentRecorderKeyOnce, createCurrentRecorderKey);
+    pthread_setspecific(s_currentRecorderKey, recorder);
+}
+#endif
+
+RenderCommandRecorder::RenderCommandRecorder()
+: _previousRecorder(nullptr)
+{
+}
+
+RenderCommandRecorder* RenderCommandRecorder::getCurrent()
+{
+    return getCurrentRecorder();
+}
+
+void RenderCommandRecorder::begin(int renderQueue, const Mat4& modelViewTransform)
+{
+    CCASSERT(getCurrentRecorder() != this, "The recorder is already active on this thread");
+    
+    _commandGroupStack = std::stack<int>();
+    _commandGroupStack.push(renderQueue);
+    _modelViewMatrixStack = std::stack<Mat4>();
+    _modelViewMatrixStack.push(modelViewTransform);
+    
+    _previousRecorder = getCurrentRecorder();
+    setCurrentRecorder(this);
+}
+
+void RenderCommandRecorder::end()
+{
+    CCASSERT(getCurrentRecorder() == this, "The recorder is not active on this thread");
+    CCASSERT(_commandGroupStack.size() == 1, "pushGroup() and popGroup() calls don't match");
+    
+    setCurrentRecorder(_previousRecorder);
+    _previousRecorder = nullptr;
+}
+
+void RenderCommandRecorder::submit(Renderer* renderer)
+{
+    replay(renderer);
+    _commands.clear();
+}
+
+void RenderCommandRecorder::replay(Renderer* renderer) const
+{
+    for (const auto& recorded : _commands)
+    {
+        renderer->addCommand(recorded.command, recorded.renderQueue);
+    }
+}
+
+void RenderCommandRecorder::clear()
+{
+    _commands.clear();
+}
+
+void RenderCommandRecorder::addCommand(RenderCommand* command)
+{
+    addCommand(command, _commandGroupStack.top());
+}
+
+void RenderCommandRecorder::addCommand(RenderCommand* command, int renderQueue)
+{
+    RecordedCommand recorded = {command, renderQueue};
+    _commands.push_back(recorded);
+}
+
+void RenderCommandRecorder::pushGroup(int renderQueueID)
+{
+    _commandGroupStack.push(renderQueueID);
+}
+
+void RenderCommandRecorder::popGroup()
+{
+    _commandGroupStack.pop();
+}
+
+NS_CC_END
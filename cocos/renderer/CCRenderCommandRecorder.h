@@ -0,0 +1,110 @@
+/****************************************************************************
+ Copyright (c) 2013-2015 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CC_RENDER_COMMAND_RECORDER_H_
+#define __CC_RENDER_COMMAND_RECORDER_H_
+
+#include <vector>
+#include <stack>
+
+#include "platform/CCPlatformMacros.h"
+#include "math/CCMath.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+NS_CC_BEGIN
+
+class RenderCommand;
+class Renderer;
+
+/** Records the render commands added by one thread while nodes are visited in parallel.
+ While a recorder is active on a thread, `Renderer::addCommand()`, `Renderer::pushGroup()` and `Renderer::popGroup()`
+ called from that thread go to the recorder, and the modelview matrix stack of the `Director` is replaced by the one of the recorder.
+ The recorded commands are added to the renderer afterwards from the main thread, in the order they were recorded.
+ Recorders can be nested: when a recorder ends, the one that was active before it on the same thread is active again.
+ */
+class CC_DLL RenderCommandRecorder
+{
+public:
+    /**Constructor.*/
+    RenderCommandRecorder();
+    
+    /**
+     Starts recording the commands added from the calling thread.
+     @param renderQueue The render queue that commands go to when no group is pushed.
+     @param modelViewTransform The initial matrix of the modelview matrix stack.
+     */
+    void begin(int renderQueue, const Mat4& modelViewTransform);
+    /**Stops recording on the calling thread.*/
+    void end();
+    /**Adds the recorded commands to the renderer and clears them. Must be called from the main thread.*/
+    void submit(Renderer* renderer);
+    /**Adds the recorded commands to the renderer, or to the active recorder, and keeps them to be replayed again.*/
+    void replay(Renderer* renderer) const;
+    /**Clears the recorded commands.*/
+    void clear();
+    
+    /**Records a command into the current render queue.*/
+    void addCommand(RenderCommand* command);
+    /**Records a command into a given render queue.*/
+    void addCommand(RenderCommand* command, int renderQueue);
+    /**Pushes a group for the following recorded commands.*/
+    void pushGroup(int renderQueueID);
+    /**Pops a group.*/
+    void popGroup();
+    
+    /**The render queue that commands go to when no group is pushed, or the one of the last pushed group.*/
+    int getCurrentRenderQueue() const { return _commandGroupStack.top(); }
+    
+    /**The modelview matrix stack used instead of the one of the Director while recording.*/
+    std::stack<Mat4>& getModelViewMatrixStack() { return _modelViewMatrixStack; }
+    
+    /**Returns the recorder active on the calling thread, or nullptr.*/
+    static RenderCommandRecorder* getCurrent();
+    
+protected:
+    struct RecordedCommand
+    {
+        RenderCommand* command;
+        int renderQueue;
+    };
+    
+    std::vector<RecordedCommand> _commands;
+    std::stack<int> _commandGroupStack;
+    std::stack<Mat4> _modelViewMatrixStack;
+    // recorder active on the thread before begin(), restored by end()
+    RenderCommandRecorder* _previousRecorder;
+};
+
+NS_CC_END
+
+/**
+ end of support group
+ @}
+ */
+#endif //__CC_RENDER_COMMAND_RECORDER_H_
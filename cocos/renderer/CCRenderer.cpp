@@ -38,6 +38,7 @@
 #include "renderer/CCTechnique.h"
 #include "renderer/CCPass.h"
 #include "renderer/CCRenderState.h"
+#include "renderer/CCRenderCommandRecorder.h"
 #include "renderer/ccGLStateCache.h"
 
 #include "base/CCConfiguration.h"
@@ -61,6 +62,16 @@ static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
     return  a->getDepth() > b->getDepth();
 }
 
+// maps a float to an unsigned integer which has the same ordering, so that it could be radix sorted
+static inline uint32_t floatToSortableBits(float value)
+{
+    // -0.0 and 0.0 compare equal, give them the same key
+    value += 0.0f;
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+}
+
 // queue
 RenderQueue::RenderQueue()
 {
@@ -117,6 +128,67 @@ void RenderQueue::sort()
     std::sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]), compareRenderCommand);
 }
 
+void RenderQueue::radixSort()
+{
+    // Don't sort _queue0, it already comes sorted
+    radixSortSubQueue(_commands[QUEUE_GROUP::TRANSPARENT_3D], true);
+    radixSortSubQueue(_commands[QUEUE_GROUP::GLOBALZ_NEG], false);
+    radixSortSubQueue(_commands[QUEUE_GROUP::GLOBALZ_POS], false);
+}
+
+void RenderQueue::radixSortSubQueue(std::vector<RenderCommand*>& commands, bool descendingDepth)
+{
+    const size_t count = commands.size();
+    if (count < 2)
+        return;
+    
+    // key layout: the order key in the upper 32 bits, the push index in the lower 32 bits
+    _sortKeys.resize(count);
+    _sortKeysTemp.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t orderKey = descendingDepth ? ~floatToSortableBits(commands[i]->getDepth()) : floatToSortableBits(commands[i]->getGlobalOrder());
+        _sortKeys[i] = ((uint64_t)orderKey << 32) | (uint32_t)i;
+    }
+    
+    // the push indices are already in order, so only the upper 32 bits need to be sorted, one byte per pass
+    uint64_t* src = _sortKeys.data();
+    uint64_t* dst = _sortKeysTemp.data();
+    for (int shift = 32; shift < 64; shift += 8)
+    {
+        size_t histogram[256] = {0};
+        for (size_t i = 0; i < count; ++i)
+        {
+            ++histogram[(src[i] >> shift) & 0xFF];
+        }
+        
+        // all the keys share the same byte, nothing to do in this pass
+        if (histogram[(src[0] >> shift) & 0xFF] == count)
+            continue;
+        
+        size_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket)
+        {
+            size_t bucketSize = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketSize;
+        }
+        
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[histogram[(src[i] >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+    
+    _sortedCommands.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        _sortedCommands[i] = commands[(uint32_t)src[i]];
+    }
+    commands.swap(_sortedCommands);
+}
+
 RenderCommand* RenderQueue::operator[](ssize_t index) const
 {
     for(int queIndex = 0; queIndex < QUEUE_GROUP::QUEUE_COUNT; ++queIndex)
@@ -154,9 +226,9 @@ void RenderQueue::realloc(size_t reserveSize)
 
 void RenderQueue::saveRenderState()
 {
-    _isDepthEnabled = glIsEnabled(GL_DEPTH_TEST) != GL_FALSE;
-    _isCullEnabled = glIsEnabled(GL_CULL_FACE) != GL_FALSE;
-    glGetBooleanv(GL_DEPTH_WRITEMASK, &_isDepthWrite);
+    _isDepthEnabled = GL::isEnabled(GL_DEPTH_TEST);
+    _isCullEnabled = GL::isEnabled(GL_CULL_FACE);
+    _isDepthWrite = GL::getDepthMask();
     
     CHECK_GL_ERROR_DEBUG();
 }
@@ -165,28 +237,28 @@ void RenderQueue::restoreRenderState()
 {
     if (_isCullEnabled)
     {
-        glEnable(GL_CULL_FACE);
+        GL::enable(GL_CULL_FACE);
         RenderState::StateBlock::_defaultState->setCullFace(true);
     }
     else
     {
-        glDisable(GL_CULL_FACE);
+        GL::disable(GL_CULL_FACE);
         RenderState::StateBlock::_defaultState->setCullFace(false);
     }
     
     
     if (_isDepthEnabled)
     {
-        glEnable(GL_DEPTH_TEST);
+        GL::enable(GL_DEPTH_TEST);
         RenderState::StateBlock::_defaultState->setDepthTest(true);
     }
     else
     {
-        glDisable(GL_DEPTH_TEST);
+        GL::disable(GL_DEPTH_TEST);
         RenderState::StateBlock::_defaultState->setDepthTest(false);
     }
     
-    glDepthMask(_isDepthWrite);
+    GL::depthMask(_isDepthWrite);
     RenderState::StateBlock::_defaultState->setDepthWrite(_isDepthEnabled);
 
     CHECK_GL_ERROR_DEBUG();
@@ -206,9 +278,20 @@ Renderer::Renderer()
 ,_filledVertex(0)
 ,_filledIndex(0)
 ,_numberQuads(0)
+,_quadWindowStart(-1)
+,_vertexStreamOffset(0)
+,_indexStreamOffset(0)
+,_quadStreamOffset(0)
 ,_glViewAssigned(false)
+,_drawnBatches(0)
+,_drawnVertices(0)
+,_uploadedBytes(0)
+,_bufferUploads(0)
+,_bufferFlushes(0)
+,_visitedNodes(0)
 ,_isRendering(false)
 ,_isDepthTestFor2D(false)
+,_isRadixSortEnabled(false)
 #if CC_ENABLE_CACHE_TEXTURE_DATA
 ,_cacheTextureListener(nullptr)
 #endif
@@ -220,6 +303,7 @@ Renderer::Renderer()
     RenderQueue defaultRenderQueue;
     _renderGroups.push_back(defaultRenderQueue);
     _batchedCommands.reserve(BATCH_QUADCOMMAND_RESEVER_SIZE);
+    _quadVerts.resize(VBO_SIZE);
 
     // default clear color
     _clearColor = Color4F::BLACK;
@@ -230,8 +314,8 @@ Renderer::~Renderer()
     _renderGroups.clear();
     _groupCommandManager->release();
     
-    glDeleteBuffers(2, _buffersVBO);
-    glDeleteBuffers(2, _quadbuffersVBO);
+    GL::deleteBuffers(2, _buffersVBO);
+    GL::deleteBuffers(2, _quadbuffersVBO);
     
     if (Configuration::getInstance()->supportsShareableVAO())
     {
@@ -292,8 +376,8 @@ void Renderer::setupVBOAndVAO()
 
     glGenBuffers(2, &_buffersVBO[0]);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE * STREAM_BUFFER_FRAMES, nullptr, GL_DYNAMIC_DRAW);
 
     // vertices
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
@@ -307,13 +391,13 @@ void Renderer::setupVBOAndVAO()
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_TEX_COORD);
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, texCoords));
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE * STREAM_BUFFER_FRAMES, nullptr, GL_DYNAMIC_DRAW);
 
     // Must unbind the VAO before changing the element buffer.
     GL::bindVAO(0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
 
     //generate vbo and vao for quadCommand
     glGenVertexArrays(1, &_quadVAO);
@@ -321,8 +405,8 @@ void Renderer::setupVBOAndVAO()
     
     glGenBuffers(2, &_quadbuffersVBO[0]);
     
-    glBindBuffer(GL_ARRAY_BUFFER, _quadbuffersVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(_quadVerts[0]) * VBO_SIZE, _quadVerts, GL_DYNAMIC_DRAW);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _quadbuffersVBO[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(_quadVerts[0]) * _quadVerts.size() * STREAM_BUFFER_FRAMES, nullptr, GL_DYNAMIC_DRAW);
     
     // vertices
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
@@ -336,13 +420,15 @@ void Renderer::setupVBOAndVAO()
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_TEX_COORD);
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, texCoords));
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadbuffersVBO[1]);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadbuffersVBO[1]);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_quadIndices[0]) * INDEX_VBO_SIZE, _quadIndices, GL_STATIC_DRAW);
     
     // Must unbind the VAO before changing the element buffer.
     GL::bindVAO(0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    _vertexStreamOffset = _indexStreamOffset = _quadStreamOffset = 0;
     
     CHECK_GL_ERROR_DEBUG();
 }
@@ -359,33 +445,67 @@ void Renderer::mapBuffers()
     // Avoid changing the element buffer for whatever VAO might be bound.
     GL::bindVAO(0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE * STREAM_BUFFER_FRAMES, nullptr, GL_DYNAMIC_DRAW);
     
-    glBindBuffer(GL_ARRAY_BUFFER, _quadbuffersVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(_quadVerts[0]) * VBO_SIZE, _quadVerts, GL_DYNAMIC_DRAW);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _quadbuffersVBO[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(_quadVerts[0]) * _quadVerts.size() * STREAM_BUFFER_FRAMES, nullptr, GL_DYNAMIC_DRAW);
     
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE * STREAM_BUFFER_FRAMES, nullptr, GL_DYNAMIC_DRAW);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadbuffersVBO[1]);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadbuffersVBO[1]);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_quadIndices[0]) * INDEX_VBO_SIZE, _quadIndices, GL_STATIC_DRAW);
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    _vertexStreamOffset = _indexStreamOffset = _quadStreamOffset = 0;
 
     CHECK_GL_ERROR_DEBUG();
 }
 
+void Renderer::setQuadBufferSize(ssize_t vertexCount)
+{
+    CCASSERT(!_isRendering, "Cannot resize the quad buffer while rendering");
+    CCASSERT(vertexCount >= 4, "The quad buffer should hold one quad at least");
+    
+    // whole quads only
+    _quadVerts.resize(vertexCount / 4 * 4);
+    
+    if (_glViewAssigned)
+    {
+        GL::bindBuffer(GL_ARRAY_BUFFER, _quadbuffersVBO[0]);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_quadVerts[0]) * _quadVerts.size() * STREAM_BUFFER_FRAMES, nullptr, GL_DYNAMIC_DRAW);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+        _quadStreamOffset = 0;
+    }
+}
+
 void Renderer::addCommand(RenderCommand* command)
 {
+    // nodes visited in parallel record their commands instead
+    auto recorder = RenderCommandRecorder::getCurrent();
+    if (recorder)
+    {
+        recorder->addCommand(command);
+        return;
+    }
+    
     int renderQueue =_commandGroupStack.top();
     addCommand(command, renderQueue);
 }
 
 void Renderer::addCommand(RenderCommand* command, int renderQueue)
 {
+    auto recorder = RenderCommandRecorder::getCurrent();
+    if (recorder)
+    {
+        recorder->addCommand(command, renderQueue);
+        return;
+    }
+    
     CCASSERT(!_isRendering, "Cannot add command while rendering");
     CCASSERT(renderQueue >=0, "Invalid render queue");
     CCASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
@@ -395,12 +515,26 @@ void Renderer::addCommand(RenderCommand* command, int renderQueue)
 
 void Renderer::pushGroup(int renderQueueID)
 {
+    auto recorder = RenderCommandRecorder::getCurrent();
+    if (recorder)
+    {
+        recorder->pushGroup(renderQueueID);
+        return;
+    }
+    
     CCASSERT(!_isRendering, "Cannot change render queue while rendering");
     _commandGroupStack.push(renderQueueID);
 }
 
 void Renderer::popGroup()
 {
+    auto recorder = RenderCommandRecorder::getCurrent();
+    if (recorder)
+    {
+        recorder->popGroup();
+        return;
+    }
+    
     CCASSERT(!_isRendering, "Cannot change render queue while rendering");
     _commandGroupStack.pop();
 }
@@ -430,6 +564,8 @@ void Renderer::processRenderCommand(RenderCommand* command)
             CCASSERT(cmd->getVertexCount()>= 0 && cmd->getVertexCount() < VBO_SIZE, "VBO for vertex is not big enough, please break the data down or use customized render command");
             CCASSERT(cmd->getIndexCount()>= 0 && cmd->getIndexCount() < INDEX_VBO_SIZE, "VBO for index is not big enough, please break the data down or use customized render command");
             //Draw batched Triangles if VBO is full
+            if (!cmd->isSkipBatching())
+                _bufferFlushes++;
             drawBatchedTriangles();
         }
         
@@ -454,10 +590,12 @@ void Renderer::processRenderCommand(RenderCommand* command)
         auto cmd = static_cast<QuadCommand*>(command);
         
         //Draw batched quads if necessary
-        if(cmd->isSkipBatching()|| (_numberQuads + cmd->getQuadCount()) * 4 > VBO_SIZE )
+        if(cmd->isSkipBatching()|| (_numberQuads + cmd->getQuadCount()) * 4 > (ssize_t)_quadVerts.size() )
         {
-            CCASSERT(cmd->getQuadCount()>= 0 && cmd->getQuadCount() * 4 < VBO_SIZE, "VBO for vertex is not big enough, please break the data down or use customized render command");
+            CCASSERT(cmd->getQuadCount()>= 0 && cmd->getQuadCount() * 4 <= (ssize_t)_quadVerts.size(), "VBO for vertex is not big enough, please break the data down, use customized render command or call Renderer::setQuadBufferSize()");
             //Draw batched quads if VBO is full
+            if (!cmd->isSkipBatching())
+                _bufferFlushes++;
             drawBatchedQuads();
         }
         
@@ -541,18 +679,18 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
     {
         if(_isDepthTestFor2D)
         {
-            glEnable(GL_DEPTH_TEST);
-            glDepthMask(true);
-            glEnable(GL_BLEND);
+            GL::enable(GL_DEPTH_TEST);
+            GL::depthMask(true);
+            GL::enable(GL_BLEND);
             RenderState::StateBlock::_defaultState->setDepthTest(true);
             RenderState::StateBlock::_defaultState->setDepthWrite(true);
             RenderState::StateBlock::_defaultState->setBlend(true);
         }
         else
         {
-            glDisable(GL_DEPTH_TEST);
-            glDepthMask(false);
-            glEnable(GL_BLEND);
+            GL::disable(GL_DEPTH_TEST);
+            GL::depthMask(false);
+            GL::enable(GL_BLEND);
             RenderState::StateBlock::_defaultState->setDepthTest(false);
             RenderState::StateBlock::_defaultState->setDepthWrite(false);
             RenderState::StateBlock::_defaultState->setBlend(true);
@@ -571,9 +709,9 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
     if (opaqueQueue.size() > 0)
     {
         //Clear depth to achieve layered rendering
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(true);
-        glDisable(GL_BLEND);
+        GL::enable(GL_DEPTH_TEST);
+        GL::depthMask(true);
+        GL::disable(GL_BLEND);
         RenderState::StateBlock::_defaultState->setDepthTest(true);
         RenderState::StateBlock::_defaultState->setDepthWrite(true);
         RenderState::StateBlock::_defaultState->setBlend(false);
@@ -592,9 +730,9 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
     const auto& transQueue = queue.getSubQueue(RenderQueue::QUEUE_GROUP::TRANSPARENT_3D);
     if (transQueue.size() > 0)
     {
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(false);
-        glEnable(GL_BLEND);
+        GL::enable(GL_DEPTH_TEST);
+        GL::depthMask(false);
+        GL::enable(GL_BLEND);
 
         RenderState::StateBlock::_defaultState->setDepthTest(true);
         RenderState::StateBlock::_defaultState->setDepthWrite(false);
@@ -616,9 +754,9 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
     {
         if(_isDepthTestFor2D)
         {
-            glEnable(GL_DEPTH_TEST);
-            glDepthMask(true);
-            glEnable(GL_BLEND);
+            GL::enable(GL_DEPTH_TEST);
+            GL::depthMask(true);
+            GL::enable(GL_BLEND);
 
             RenderState::StateBlock::_defaultState->setDepthTest(true);
             RenderState::StateBlock::_defaultState->setDepthWrite(true);
@@ -627,9 +765,9 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
         }
         else
         {
-            glDisable(GL_DEPTH_TEST);
-            glDepthMask(false);
-            glEnable(GL_BLEND);
+            GL::disable(GL_DEPTH_TEST);
+            GL::depthMask(false);
+            GL::enable(GL_BLEND);
 
             RenderState::StateBlock::_defaultState->setDepthTest(false);
             RenderState::StateBlock::_defaultState->setDepthWrite(false);
@@ -651,9 +789,9 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
     {
         if(_isDepthTestFor2D)
         {
-            glEnable(GL_DEPTH_TEST);
-            glDepthMask(true);
-            glEnable(GL_BLEND);
+            GL::enable(GL_DEPTH_TEST);
+            GL::depthMask(true);
+            GL::enable(GL_BLEND);
             
             RenderState::StateBlock::_defaultState->setDepthTest(true);
             RenderState::StateBlock::_defaultState->setDepthWrite(true);
@@ -662,9 +800,9 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
         }
         else
         {
-            glDisable(GL_DEPTH_TEST);
-            glDepthMask(false);
-            glEnable(GL_BLEND);
+            GL::disable(GL_DEPTH_TEST);
+            GL::depthMask(false);
+            GL::enable(GL_BLEND);
             
             RenderState::StateBlock::_defaultState->setDepthTest(false);
             RenderState::StateBlock::_defaultState->setDepthWrite(false);
@@ -692,11 +830,17 @@ void Renderer::render()
     
     if (_glViewAssigned)
     {
+        // the GL state may have been changed with raw GL calls since the last frame
+        GL::invalidateGLStateCache();
+
         //Process render commands
         //1. Sort render commands based on ID
         for (auto &renderqueue : _renderGroups)
         {
-            renderqueue.sort();
+            if (_isRadixSortEnabled)
+                renderqueue.radixSort();
+            else
+                renderqueue.sort();
         }
         visitRenderQueue(_renderGroups[0]);
     }
@@ -730,21 +874,28 @@ void Renderer::clean()
 void Renderer::clear()
 {
     //Enable Depth mask to make sure glClear clear the depth buffer correctly
-    glDepthMask(true);
+    GL::depthMask(true);
     glClearColor(_clearColor.r, _clearColor.g, _clearColor.b, _clearColor.a);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glDepthMask(false);
+    GL::depthMask(false);
 
     RenderState::StateBlock::_defaultState->setDepthWrite(false);
 }
 
+void Renderer::clearDrawStats()
+{
+    _drawnBatches = _drawnVertices = _uploadedBytes = _bufferUploads = _bufferFlushes = 0;
+    _visitedNodes = 0;
+    GL::resetStateChangeStats();
+}
+
 void Renderer::setDepthTest(bool enable)
 {
     if (enable)
     {
         glClearDepth(1.0f);
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LEQUAL);
+        GL::enable(GL_DEPTH_TEST);
+        GL::depthFunc(GL_LEQUAL);
 
         RenderState::StateBlock::_defaultState->setDepthTest(true);
         RenderState::StateBlock::_defaultState->setDepthFunction(RenderState::DEPTH_LEQUAL);
@@ -753,7 +904,7 @@ void Renderer::setDepthTest(bool enable)
     }
     else
     {
-        glDisable(GL_DEPTH_TEST);
+        GL::disable(GL_DEPTH_TEST);
 
         RenderState::StateBlock::_defaultState->setDepthTest(false);
     }
@@ -798,6 +949,36 @@ void Renderer::fillQuads(const QuadCommand *cmd)
     _numberQuads += cmd->getQuadCount();
 }
 
+GLintptr Renderer::streamBufferData(GLenum target, GLsizeiptr bufferSize, GLintptr& writeOffset, const GLvoid* data, GLsizeiptr size)
+{
+    // the buffer is written as a ring, the GPU may still read the previous batches
+    // so the storage is orphaned instead of being overwritten when the ring wraps
+    if (writeOffset + size > bufferSize)
+    {
+        glBufferData(target, bufferSize, nullptr, GL_DYNAMIC_DRAW);
+        writeOffset = 0;
+    }
+    
+    GLintptr offset = writeOffset;
+    glBufferSubData(target, offset, size, data);
+    writeOffset += size;
+    _uploadedBytes += size;
+    
+    return offset;
+}
+
+void Renderer::setVertexAttribPointers(GLintptr offset)
+{
+    // vertices
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) (offset + offsetof(V3F_C4B_T2F, vertices)));
+    
+    // colors
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) (offset + offsetof(V3F_C4B_T2F, colors)));
+    
+    // tex coords
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) (offset + offsetof(V3F_C4B_T2F, texCoords)));
+}
+
 void Renderer::drawBatchedTriangles()
 {
     //TODO: we can improve the draw performance by insert material switching command before hand.
@@ -815,47 +996,20 @@ void Renderer::drawBatchedTriangles()
     {
         //Bind VAO
         GL::bindVAO(_buffersVAO);
-        //Set VBO data
-        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-
-        // option 1: subdata
-//        glBufferSubData(GL_ARRAY_BUFFER, sizeof(_quads[0])*start, sizeof(_quads[0]) * n , &_quads[start] );
-
-        // option 2: data
-//        glBufferData(GL_ARRAY_BUFFER, sizeof(quads_[0]) * (n-start), &quads_[start], GL_DYNAMIC_DRAW);
-
-        // option 3: orphaning + glMapBuffer
-        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * _filledVertex, nullptr, GL_DYNAMIC_DRAW);
-        void *buf = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-        memcpy(buf, _verts, sizeof(_verts[0])* _filledVertex);
-        glUnmapBuffer(GL_ARRAY_BUFFER);
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
     }
     else
     {
-#define kQuadSize sizeof(_verts[0])
-        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-
-        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * _filledVertex , _verts, GL_DYNAMIC_DRAW);
-
         GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
-
-        // vertices
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, vertices));
-
-        // colors
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, colors));
-
-        // tex coords
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, texCoords));
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
     }
+    
+    //Append the vertices and indices to the streaming buffers
+    GL::bindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+    GLintptr vertexOffset = streamBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE * STREAM_BUFFER_FRAMES, _vertexStreamOffset, _verts, sizeof(_verts[0]) * _filledVertex);
+    setVertexAttribPointers(vertexOffset);
+    
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+    GLintptr indexOffset = streamBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE * STREAM_BUFFER_FRAMES, _indexStreamOffset, _indices, sizeof(_indices[0]) * _filledIndex);
+    _bufferUploads++;
 
     //Start drawing verties in batch
     for(const auto& cmd : _batchedCommands)
@@ -866,7 +1020,7 @@ void Renderer::drawBatchedTriangles()
             //Draw quads
             if(indexToDraw > 0)
             {
-                glDrawElements(GL_TRIANGLES, (GLsizei) indexToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (startIndex*sizeof(_indices[0])) );
+                glDrawElements(GL_TRIANGLES, (GLsizei) indexToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (indexOffset + startIndex*sizeof(_indices[0])) );
                 _drawnBatches++;
                 _drawnVertices += indexToDraw;
 
@@ -885,7 +1039,7 @@ void Renderer::drawBatchedTriangles()
     //Draw any remaining triangles
     if(indexToDraw > 0)
     {
-        glDrawElements(GL_TRIANGLES, (GLsizei) indexToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (startIndex*sizeof(_indices[0])) );
+        glDrawElements(GL_TRIANGLES, (GLsizei) indexToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (indexOffset + startIndex*sizeof(_indices[0])) );
         _drawnBatches++;
         _drawnVertices += indexToDraw;
     }
@@ -897,8 +1051,8 @@ void Renderer::drawBatchedTriangles()
     }
     else
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 
     _batchedCommands.clear();
@@ -906,12 +1060,35 @@ void Renderer::drawBatchedTriangles()
     _filledIndex = 0;
 }
 
+void Renderer::drawQuads(GLintptr vertexOffset, ssize_t startQuad, ssize_t quadCount)
+{
+    // 16 bits indices only address VBO_SIZE vertices from the attribute pointers,
+    // so the pointers are moved forward when the quads go beyond them
+    while (quadCount > 0)
+    {
+        if (_quadWindowStart < 0 || startQuad - _quadWindowStart >= VBO_SIZE / 4)
+        {
+            _quadWindowStart = startQuad;
+            GL::bindBuffer(GL_ARRAY_BUFFER, _quadbuffersVBO[0]);
+            setVertexAttribPointers(vertexOffset + sizeof(_quadVerts[0]) * _quadWindowStart * 4);
+        }
+        
+        ssize_t count = std::min(quadCount, VBO_SIZE / 4 - (startQuad - _quadWindowStart));
+        glDrawElements(GL_TRIANGLES, (GLsizei) count * 6, GL_UNSIGNED_SHORT, (GLvoid*) ((startQuad - _quadWindowStart) * 6 * sizeof(_quadIndices[0])) );
+        _drawnBatches++;
+        _drawnVertices += count * 6;
+        
+        startQuad += count;
+        quadCount -= count;
+    }
+}
+
 void Renderer::drawBatchedQuads()
 {
     //TODO: we can improve the draw performance by insert material switching command before hand.
     
-    ssize_t indexToDraw = 0;
-    int startIndex = 0;
+    ssize_t quadsToDraw = 0;
+    ssize_t startQuad = 0;
     
     //Upload buffer to VBO
     if(_numberQuads <= 0 || _batchQuadCommands.empty())
@@ -923,66 +1100,33 @@ void Renderer::drawBatchedQuads()
     {
         //Bind VAO
         GL::bindVAO(_quadVAO);
-        //Set VBO data
-        glBindBuffer(GL_ARRAY_BUFFER, _quadbuffersVBO[0]);
-        
-        // option 1: subdata
-        //  glBufferSubData(GL_ARRAY_BUFFER, sizeof(_quads[0])*start, sizeof(_quads[0]) * n , &_quads[start] );
-        
-        // option 2: data
-        //  glBufferData(GL_ARRAY_BUFFER, sizeof(quads_[0]) * (n-start), &quads_[start], GL_DYNAMIC_DRAW);
-        
-        // option 3: orphaning + glMapBuffer
-        glBufferData(GL_ARRAY_BUFFER, sizeof(_quadVerts[0]) * _numberQuads * 4, nullptr, GL_DYNAMIC_DRAW);
-        void *buf = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-        memcpy(buf, _quadVerts, sizeof(_quadVerts[0])* _numberQuads * 4);
-        glUnmapBuffer(GL_ARRAY_BUFFER);
-        
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadbuffersVBO[1]);
     }
     else
     {
-#define kQuadSize sizeof(_verts[0])
-        glBindBuffer(GL_ARRAY_BUFFER, _quadbuffersVBO[0]);
-        
-        glBufferData(GL_ARRAY_BUFFER, sizeof(_quadVerts[0]) * _numberQuads * 4 , _quadVerts, GL_DYNAMIC_DRAW);
-        
         GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
-        
-        // vertices
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, vertices));
-        
-        // colors
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, colors));
-        
-        // tex coords
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, texCoords));
-        
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadbuffersVBO[1]);
     }
-
-
-    // FIXME: The logic of this code is confusing, and error prone
-    // Needs refactoring
+    
+    //Append the quads to the streaming buffer, the attribute pointers are set by drawQuads()
+    GL::bindBuffer(GL_ARRAY_BUFFER, _quadbuffersVBO[0]);
+    GLintptr vertexOffset = streamBufferData(GL_ARRAY_BUFFER, sizeof(_quadVerts[0]) * _quadVerts.size() * STREAM_BUFFER_FRAMES, _quadStreamOffset, _quadVerts.data(), sizeof(_quadVerts[0]) * _numberQuads * 4);
+    _bufferUploads++;
+    _quadWindowStart = -1;
+    
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadbuffersVBO[1]);
 
     //Start drawing vertices in batch
     for(const auto& cmd : _batchQuadCommands)
     {
-        bool commandQueued = true;
         auto newMaterialID = cmd->getMaterialID();
         if(_lastMaterialID != newMaterialID || newMaterialID == MATERIAL_ID_DO_NOT_BATCH)
         {
             // flush buffer
-            if(indexToDraw > 0)
+            if(quadsToDraw > 0)
             {
-                glDrawElements(GL_TRIANGLES, (GLsizei) indexToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (startIndex*sizeof(_indices[0])) );
-                _drawnBatches++;
-                _drawnVertices += indexToDraw;
+                drawQuads(vertexOffset, startQuad, quadsToDraw);
                 
-                startIndex += indexToDraw;
-                indexToDraw = 0;
+                startQuad += quadsToDraw;
+                quadsToDraw = 0;
             }
             
             //Use new material
@@ -991,18 +1135,13 @@ void Renderer::drawBatchedQuads()
             cmd->useMaterial();
         }
 
-        if (commandQueued)
-        {
-            indexToDraw += cmd->getQuadCount() * 6;
-        }
+        quadsToDraw += cmd->getQuadCount();
     }
     
     //Draw any remaining quad
-    if(indexToDraw > 0)
+    if(quadsToDraw > 0)
     {
-        glDrawElements(GL_TRIANGLES, (GLsizei) indexToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (startIndex*sizeof(_indices[0])) );
-        _drawnBatches++;
-        _drawnVertices += indexToDraw;
+        drawQuads(vertexOffset, startQuad, quadsToDraw);
     }
     
     if (Configuration::getInstance()->supportsShareableVAO())
@@ -1012,8 +1151,8 @@ void Renderer::drawBatchedQuads()
     }
     else
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
     
     _batchQuadCommands.clear();
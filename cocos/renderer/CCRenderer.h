@@ -28,6 +28,8 @@
 
 #include <vector>
 #include <stack>
+#include <atomic>
+#include <stdint.h>
 
 #include "platform/CCPlatformMacros.h"
 #include "renderer/CCRenderCommand.h"
@@ -51,7 +53,7 @@ class MeshCommand;
  the correct order, the only `RenderCommand` objects that need to be sorted,
  are the ones that have `z < 0` and `z > 0`.
 */
-class RenderQueue {
+class CC_DLL RenderQueue {
 public:
     /**
     RenderCommand will be divided into Queue Groups.
@@ -80,6 +82,11 @@ public:
     ssize_t size() const;
     /**Sort the render commands.*/
     void sort();
+    /**
+     Sort the render commands with a stable LSD radix sort over packed 64 bits keys.
+     The resulting order is the same as `sort()`, commands with equal keys keep the order they were pushed.
+     */
+    void radixSort();
     /**Treat sorted commands as an array, access them one by one.*/
     RenderCommand* operator[](ssize_t index) const;
     /**Clear all rendered commands.*/
@@ -97,9 +104,17 @@ public:
     void restoreRenderState();
     
 protected:
+    /**Radix sort one sub queue by global Z order, or by depth from back to front for transparent 3D commands.*/
+    void radixSortSubQueue(std::vector<RenderCommand*>& commands, bool descendingDepth);
+
     /**The commands in the render queue.*/
     std::vector<RenderCommand*> _commands[QUEUE_COUNT];
     
+    /**Scratch buffers used by radixSort(), kept around to avoid allocations every frame.*/
+    std::vector<uint64_t> _sortKeys;
+    std::vector<uint64_t> _sortKeysTemp;
+    std::vector<RenderCommand*> _sortedCommands;
+    
     /**Cull state.*/
     bool _isCullEnabled;
     /**Depth test enable state.*/
@@ -132,6 +147,8 @@ public:
     static const int BATCH_QUADCOMMAND_RESEVER_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
     static const int MATERIAL_ID_DO_NOT_BATCH = 0;
+    /**The vertex and index buffers are streamed as rings holding the uploads of this number of full batches before being orphaned.*/
+    static const int STREAM_BUFFER_FRAMES = 2;
     /**Constructor.*/
     Renderer();
     /**Destructor.*/
@@ -155,6 +172,9 @@ public:
     /** Creates a render queue and returns its Id */
     int createRenderQueue();
 
+    /** Returns the Id of the render queue that commands are currently added to */
+    int getCurrentRenderQueue() const { return _commandGroupStack.top(); }
+
     /** Renders into the GLView all the queued `RenderCommand` objects */
     void render();
 
@@ -166,6 +186,13 @@ public:
 
     /** set color for clear screen */
     void setClearColor(const Color4F& clearColor);
+    /**
+     * Enable/Disable radix sorting of the render queues.
+     * The order of the render commands is the same as the default comparison sort, but it is faster for big queues.
+     */
+    void setRadixSortEnabled(bool enabled) { _isRadixSortEnabled = enabled; }
+    /** Whether the render queues are sorted with a radix sort or not */
+    bool isRadixSortEnabled() const { return _isRadixSortEnabled; }
     /* returns the number of drawn batches in the last frame */
     ssize_t getDrawnBatches() const { return _drawnBatches; }
     /* RenderCommands (except) QuadCommand should update this value */
@@ -174,8 +201,26 @@ public:
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) QuadCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
-    /* clear draw stats */
-    void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
+    /* returns the number of bytes uploaded to the batching vertex and index buffers in the last frame */
+    ssize_t getUploadedBytes() const { return _uploadedBytes; }
+    /* returns the number of times the batched vertices were uploaded and drawn in the last frame */
+    ssize_t getBufferUploads() const { return _bufferUploads; }
+    /* returns the number of uploads forced because the batching buffers were full in the last frame */
+    ssize_t getBufferFlushes() const { return _bufferFlushes; }
+    /* returns the number of nodes whose transform and commands were evaluated by a visit in the last frame */
+    ssize_t getVisitedNodes() const { return _visitedNodes; }
+    /* Node::visit() updates this value, it can be called from the threads of a parallel visit */
+    void addVisitedNodes(ssize_t number) { _visitedNodes.fetch_add(number, std::memory_order_relaxed); }
+    /* clear draw stats, including the GL state change counters of the GL state cache */
+    void clearDrawStats();
+
+    /**
+     * Sets the number of vertices batched for QuadCommands before they have to be drawn, VBO_SIZE by default.
+     * Batches bigger than VBO_SIZE are uploaded at once and drawn with a draw call every VBO_SIZE vertices.
+     */
+    void setQuadBufferSize(ssize_t vertexCount);
+    /** Returns the number of vertices batched for QuadCommands before they have to be drawn */
+    ssize_t getQuadBufferSize() const { return _quadVerts.size(); }
 
     /**
      * Enable/Disable depth test
@@ -199,6 +244,12 @@ protected:
     void mapBuffers();
     void drawBatchedTriangles();
     void drawBatchedQuads();
+    void drawQuads(GLintptr vertexOffset, ssize_t startQuad, ssize_t quadCount);
+
+    //Appends data to a streaming buffer bound to target, returns the offset it was written at
+    GLintptr streamBufferData(GLenum target, GLsizeiptr bufferSize, GLintptr& writeOffset, const GLvoid* data, GLsizeiptr size);
+    //Points the position, color and tex coord attributes to V3F_C4B_T2F vertices at offset in the bound array buffer
+    void setVertexAttribPointers(GLintptr offset);
 
     //Draw the previews queued quads and flush previous context
     void flush();
@@ -239,22 +290,35 @@ protected:
     int _filledIndex;
     
     //for QuadCommand
-    V3F_C4B_T2F _quadVerts[VBO_SIZE];
+    std::vector<V3F_C4B_T2F> _quadVerts;
     GLushort _quadIndices[INDEX_VBO_SIZE];
     GLuint _quadVAO;
     GLuint _quadbuffersVBO[2]; //0: vertex  1: indices
     int _numberQuads;
+    //first quad addressed by the attribute pointers while drawing quads
+    ssize_t _quadWindowStart;
+
+    //write offsets of the streaming buffers
+    GLintptr _vertexStreamOffset;
+    GLintptr _indexStreamOffset;
+    GLintptr _quadStreamOffset;
     
     bool _glViewAssigned;
 
     // stats
     ssize_t _drawnBatches;
     ssize_t _drawnVertices;
+    ssize_t _uploadedBytes;
+    ssize_t _bufferUploads;
+    ssize_t _bufferFlushes;
+    std::atomic<ssize_t> _visitedNodes;
     //the flag for checking whether renderer is rendering
     bool _isRendering;
     
     bool _isDepthTestFor2D;
     
+    bool _isRadixSortEnabled;
+    
     GroupCommandManager* _groupCommandManager;
     
 #if CC_ENABLE_CACHE_TEXTURE_DATA
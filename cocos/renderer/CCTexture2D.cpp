@@ -45,6 +45,7 @@ THE SOFTWARE.
 #include "renderer/CCGLProgram.h"
 #include "renderer/ccGLStateCache.h"
 #include "renderer/CCGLProgramCache.h"
+#include "renderer/CCPixelConversion.h"
 #include "base/CCNinePatchImageParser.h"
 #include "deprecated/CCString.h"
 
@@ -124,303 +125,136 @@ static Texture2D::PixelFormat g_defaultAlphaPixelFormat = Texture2D::PixelFormat
 //////////////////////////////////////////////////////////////////////////
 //conventer function
 
-// IIIIIIII -> RRRRRRRRGGGGGGGGGBBBBBBBB
 void Texture2D::convertI8ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i=0; i < dataLen; ++i)
-    {
-        *outData++ = data[i];     //R
-        *outData++ = data[i];     //G
-        *outData++ = data[i];     //B
-    }
+    PixelConversion::convertI8ToRGB888(data, dataLen, outData);
 }
 
-// IIIIIIIIAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB
 void Texture2D::convertAI88ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
-    {
-        *outData++ = data[i];     //R
-        *outData++ = data[i];     //G
-        *outData++ = data[i];     //B
-    }
+    PixelConversion::convertAI88ToRGB888(data, dataLen, outData);
 }
 
-// IIIIIIII -> RRRRRRRRGGGGGGGGGBBBBBBBBAAAAAAAA
 void Texture2D::convertI8ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0; i < dataLen; ++i)
-    {
-        *outData++ = data[i];     //R
-        *outData++ = data[i];     //G
-        *outData++ = data[i];     //B
-        *outData++ = 0xFF;        //A
-    }
+    PixelConversion::convertI8ToRGBA8888(data, dataLen, outData);
 }
 
-// IIIIIIIIAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
 void Texture2D::convertAI88ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
-    {
-        *outData++ = data[i];     //R
-        *outData++ = data[i];     //G
-        *outData++ = data[i];     //B
-        *outData++ = data[i + 1]; //A
-    }
+    PixelConversion::convertAI88ToRGBA8888(data, dataLen, outData);
 }
 
-// IIIIIIII -> RRRRRGGGGGGBBBBB
 void Texture2D::convertI8ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (int i = 0; i < dataLen; ++i)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8    //R
-            | (data[i] & 0x00FC) << 3         //G
-            | (data[i] & 0x00F8) >> 3;        //B
-    }
+    PixelConversion::convertI8ToRGB565(data, dataLen, outData);
 }
 
-// IIIIIIIIAAAAAAAA -> RRRRRGGGGGGBBBBB
 void Texture2D::convertAI88ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8    //R
-            | (data[i] & 0x00FC) << 3         //G
-            | (data[i] & 0x00F8) >> 3;        //B
-    }
+    PixelConversion::convertAI88ToRGB565(data, dataLen, outData);
 }
 
-// IIIIIIII -> RRRRGGGGBBBBAAAA
 void Texture2D::convertI8ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0; i < dataLen; ++i)
-    {
-        *out16++ = (data[i] & 0x00F0) << 8    //R
-        | (data[i] & 0x00F0) << 4             //G
-        | (data[i] & 0x00F0)                  //B
-        | 0x000F;                             //A
-    }
+    PixelConversion::convertI8ToRGBA4444(data, dataLen, outData);
 }
 
-// IIIIIIIIAAAAAAAA -> RRRRGGGGBBBBAAAA
 void Texture2D::convertAI88ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
-    {
-        *out16++ = (data[i] & 0x00F0) << 8    //R
-        | (data[i] & 0x00F0) << 4             //G
-        | (data[i] & 0x00F0)                  //B
-        | (data[i+1] & 0x00F0) >> 4;          //A
-    }
+    PixelConversion::convertAI88ToRGBA4444(data, dataLen, outData);
 }
 
-// IIIIIIII -> RRRRRGGGGGBBBBBA
 void Texture2D::convertI8ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (int i = 0; i < dataLen; ++i)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8    //R
-            | (data[i] & 0x00F8) << 3         //G
-            | (data[i] & 0x00F8) >> 2         //B
-            | 0x0001;                         //A
-    }
+    PixelConversion::convertI8ToRGB5A1(data, dataLen, outData);
 }
 
-// IIIIIIIIAAAAAAAA -> RRRRRGGGGGBBBBBA
 void Texture2D::convertAI88ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8    //R
-            | (data[i] & 0x00F8) << 3         //G
-            | (data[i] & 0x00F8) >> 2         //B
-            | (data[i + 1] & 0x0080) >> 7;    //A
-    }
+    PixelConversion::convertAI88ToRGB5A1(data, dataLen, outData);
 }
 
-// IIIIIIII -> IIIIIIIIAAAAAAAA
 void Texture2D::convertI8ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0; i < dataLen; ++i)
-    {
-        *out16++ = 0xFF00     //A
-        | data[i];            //I
-    }
+    PixelConversion::convertI8ToAI88(data, dataLen, outData);
 }
 
-// IIIIIIIIAAAAAAAA -> AAAAAAAA
 void Texture2D::convertAI88ToA8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 1; i < dataLen; i += 2)
-    {
-        *outData++ = data[i]; //A
-    }
+    PixelConversion::convertAI88ToA8(data, dataLen, outData);
 }
 
-// IIIIIIIIAAAAAAAA -> IIIIIIII
 void Texture2D::convertAI88ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
-    {
-        *outData++ = data[i]; //R
-    }
+    PixelConversion::convertAI88ToI8(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
 void Texture2D::convertRGB888ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
-    {
-        *outData++ = data[i];         //R
-        *outData++ = data[i + 1];     //G
-        *outData++ = data[i + 2];     //B
-        *outData++ = 0xFF;            //A
-    }
+    PixelConversion::convertRGB888ToRGBA8888(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB
 void Texture2D::convertRGBA8888ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
-    {
-        *outData++ = data[i];         //R
-        *outData++ = data[i + 1];     //G
-        *outData++ = data[i + 2];     //B
-    }
+    PixelConversion::convertRGBA8888ToRGB888(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGGBBBBB
 void Texture2D::convertRGB888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8    //R
-            | (data[i + 1] & 0x00FC) << 3     //G
-            | (data[i + 2] & 0x00F8) >> 3;    //B
-    }
+    PixelConversion::convertRGB888ToRGB565(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGGGGGBBBBB
 void Texture2D::convertRGBA8888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8    //R
-            | (data[i + 1] & 0x00FC) << 3     //G
-            | (data[i + 2] & 0x00F8) >> 3;    //B
-    }
+    PixelConversion::convertRGBA8888ToRGB565(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBB -> IIIIIIII
 void Texture2D::convertRGB888ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
-    {
-        *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
-    }
+    PixelConversion::convertRGB888ToI8(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> IIIIIIII
 void Texture2D::convertRGBA8888ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
-    {
-        *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
-    }
+    PixelConversion::convertRGBA8888ToI8(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> AAAAAAAA
 void Texture2D::convertRGBA8888ToA8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen -3; i < l; i += 4)
-    {
-        *outData++ = data[i + 3]; //A
-    }
+    PixelConversion::convertRGBA8888ToA8(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBB -> IIIIIIIIAAAAAAAA
 void Texture2D::convertRGB888ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
-    {
-        *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
-        *outData++ = 0xFF;
-    }
+    PixelConversion::convertRGB888ToAI88(data, dataLen, outData);
 }
 
-
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> IIIIIIIIAAAAAAAA
 void Texture2D::convertRGBA8888ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
-    {
-        *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
-        *outData++ = data[i + 3];
-    }
+    PixelConversion::convertRGBA8888ToAI88(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRGGGGBBBBAAAA
 void Texture2D::convertRGB888ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
-    {
-        *out16++ = ((data[i] & 0x00F0) << 8           //R
-                    | (data[i + 1] & 0x00F0) << 4     //G
-                    | (data[i + 2] & 0xF0)            //B
-                    |  0x0F);                         //A
-    }
+    PixelConversion::convertRGB888ToRGBA4444(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRGGGGBBBBAAAA
 void Texture2D::convertRGBA8888ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
-    {
-        *out16++ = (data[i] & 0x00F0) << 8    //R
-        | (data[i + 1] & 0x00F0) << 4         //G
-        | (data[i + 2] & 0xF0)                //B
-        |  (data[i + 3] & 0xF0) >> 4;         //A
-    }
+    PixelConversion::convertRGBA8888ToRGBA4444(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGBBBBBA
 void Texture2D::convertRGB888ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8    //R
-            | (data[i + 1] & 0x00F8) << 3     //G
-            | (data[i + 2] & 0x00F8) >> 2     //B
-            |  0x01;                          //A
-    }
+    PixelConversion::convertRGB888ToRGB5A1(data, dataLen, outData);
 }
 
-// RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGBBBBBA
 void Texture2D::convertRGBA8888ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 4)
-    {
-        *out16++ = (data[i] & 0x00F8) << 8    //R
-            | (data[i + 1] & 0x00F8) << 3     //G
-            | (data[i + 2] & 0x00F8) >> 2     //B
-            |  (data[i + 3] & 0x0080) >> 7;   //A
-    }
+    PixelConversion::convertRGBA8888ToRGB5A1(data, dataLen, outData);
 }
+
 // conventer function end
 //////////////////////////////////////////////////////////////////////////
 
@@ -791,6 +625,74 @@ bool Texture2D::initWithImage(Image *image, PixelFormat format)
     }
 }
 
+bool Texture2D::initWithImageFileInBands(const std::string& path, int bandHeight)
+{
+    return initWithImageFileInBands(path, bandHeight, g_defaultAlphaPixelFormat);
+}
+
+bool Texture2D::initWithImageFileInBands(const std::string& path, int bandHeight, PixelFormat format)
+{
+    Image image;
+    int maxTextureSize = Configuration::getInstance()->getMaxTextureSize();
+    PixelFormat pixelFormat = format;
+    bool textureCreated = false;
+
+    bool ret = image.initWithImageFileInBands(path, bandHeight, [&](const unsigned char* data, int y, int rows)
+    {
+        int imageWidth = image.getWidth();
+        int imageHeight = image.getHeight();
+        PixelFormat renderFormat = image.getRenderFormat();
+        if (!textureCreated)
+        {
+            if (imageWidth > maxTextureSize || imageHeight > maxTextureSize)
+            {
+                CCLOG("cocos2d: WARNING: Image (%u x %u) is bigger than the supported %u x %u", imageWidth, imageHeight, maxTextureSize, maxTextureSize);
+                return false;
+            }
+            if (PixelFormat::NONE == pixelFormat || PixelFormat::AUTO == pixelFormat)
+            {
+                pixelFormat = renderFormat;
+            }
+        }
+
+        // the conversions are done pixel by pixel, a band converts like the whole image
+        unsigned char* outData = nullptr;
+        ssize_t outDataLen = 0;
+        ssize_t dataLen = (ssize_t)imageWidth * rows * _pixelFormatInfoTables.at(renderFormat).bpp / 8;
+        PixelFormat bandFormat = convertDataToFormat(data, dataLen, renderFormat, pixelFormat, &outData, &outDataLen);
+
+        if (!textureCreated)
+        {
+            // allocates the texture without uploading pixels
+            MipmapInfo mipmap;
+            textureCreated = initWithMipmaps(&mipmap, 1, bandFormat, imageWidth, imageHeight);
+            pixelFormat = bandFormat;
+        }
+
+        if (textureCreated)
+        {
+            GL::bindTexture2D(_name);
+            const PixelFormatInfo& info = _pixelFormatInfoTables.at(bandFormat);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, imageWidth, rows, info.format, info.type, outData);
+        }
+
+        if (outData != nullptr && outData != data)
+        {
+            free(outData);
+        }
+        return textureCreated;
+    });
+
+    if (!ret)
+    {
+        CCLOG("cocos2d: Texture2D: Couldn't load %s in bands", path.c_str());
+        return false;
+    }
+
+    _hasPremultipliedAlpha = image.hasPremultipliedAlpha();
+    return true;
+}
+
 Texture2D::PixelFormat Texture2D::convertI8ToFormat(const unsigned char* data, ssize_t dataLen, PixelFormat format, unsigned char** outData, ssize_t* outDataLen)
 {
     switch (format)
@@ -1375,6 +1277,17 @@ unsigned int Texture2D::getBitsPerPixelForFormat() const
 	return this->getBitsPerPixelForFormat(_pixelFormat);
 }
 
+size_t Texture2D::getMemorySize() const
+{
+    size_t bytes = (size_t)_pixelsWide * _pixelsHigh * getBitsPerPixelForFormat() / 8;
+    // the mipmaps down to 1x1 add a third of the base level
+    if (_hasMipmaps)
+    {
+        bytes += bytes / 3;
+    }
+    return bytes;
+}
+
 const Texture2D::PixelFormatInfoMap& Texture2D::getPixelFormatInfoMap()
 {
     return _pixelFormatInfoTables;
@@ -280,6 +280,27 @@ public:
     **/
     bool initWithImage(Image * image, PixelFormat format);
 
+    /**
+    Initializes a texture from a PNG or JPEG file, decoding and uploading it a band of rows at a time.
+    
+    The whole image is never decoded in memory, the peak memory is about bandHeight rows of the image,
+    instead of the full image with initWithImage. Use it for very large images.
+    We will use the format you specified with setDefaultAlphaPixelFormat to convert the image for texture.
+    @param path The PNG or JPEG file.
+    @param bandHeight The number of rows decoded and uploaded at a time.
+    @since v3.9
+    */
+    bool initWithImageFileInBands(const std::string& path, int bandHeight);
+
+    /**
+    Same as initWithImageFileInBands(path, bandHeight), with the texture format.
+    @param path The PNG or JPEG file.
+    @param bandHeight The number of rows decoded and uploaded at a time.
+    @param format Texture pixel formats, PixelFormat::AUTO uses the render format of the image.
+    @since v3.9
+    */
+    bool initWithImageFileInBands(const std::string& path, int bandHeight, PixelFormat format);
+
     /** Initializes a texture from a string with dimensions, alignment, font name and font size. 
      
      @param text A null terminated string.
@@ -363,6 +384,12 @@ public:
     unsigned int getBitsPerPixelForFormat(Texture2D::PixelFormat format) const;
     CC_DEPRECATED_ATTRIBUTE unsigned int bitsPerPixelForFormat(Texture2D::PixelFormat format) const { return getBitsPerPixelForFormat(format); };
 
+    /** Returns the memory used by the OpenGL texture, in bytes.
+     * It is computed from the size and the pixel format, and includes the mipmaps.
+     @since v3.9
+     */
+    size_t getMemorySize() const;
+
     /** Get content size. */
     const Size& getContentSizeInPixels();
 
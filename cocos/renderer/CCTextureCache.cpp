@@ -31,11 +31,14 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <atomic>
+#include <algorithm>
 
 #include "renderer/CCTexture2D.h"
 #include "base/ccMacros.h"
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
+#include "base/CCJobSystem.h"
 #include "platform/CCFileUtils.h"
 #include "base/ccUtils.h"
 
@@ -55,10 +58,25 @@ TextureCache * TextureCache::getInstance()
     return Director::getInstance()->getTextureCache();
 }
 
+struct TextureCache::AsyncStruct
+{
+public:
+    AsyncStruct(const std::string& fn, std::function<void(Texture2D*)> f, int p) : filename(fn), callback(f), priority(p), loadSuccess(false), cancelled(false) {}
+    
+    std::string filename;
+    std::function<void(Texture2D*)> callback;
+    int priority;
+    Image image;
+    bool loadSuccess;
+    std::atomic<bool> cancelled;
+};
+
 TextureCache::TextureCache()
-: _loadingThread(nullptr)
-, _needQuit(false)
-, _asyncRefCount(0)
+: _asyncRefCount(0)
+, _asyncDecodeWorkerCount(0)
+, _runningDecodeJobs(0)
+, _memoryBudget(0)
+, _evictedTextureCount(0)
 {
 }
 
@@ -69,7 +87,9 @@ TextureCache::~TextureCache()
     for( auto it=_textures.begin(); it!=_textures.end(); ++it)
         (it->second)->release();
 
-    CC_SAFE_DELETE(_loadingThread);
+    // the loads left are not running anymore, see waitForQuit
+    for (auto asyncStruct : _asyncStructQueue)
+        delete asyncStruct;
 }
 
 void TextureCache::destroyInstance()
@@ -90,25 +110,14 @@ std::string TextureCache::getDescription() const
     return StringUtils::format("<TextureCache | Number of textures = %d>", static_cast<int>(_textures.size()));
 }
 
-struct TextureCache::AsyncStruct
-{
-public:
-    AsyncStruct(const std::string& fn, std::function<void(Texture2D*)> f) : filename(fn), callback(f), loadSuccess(false) {}
-    
-    std::string filename;
-    std::function<void(Texture2D*)> callback;
-    Image image;
-    bool loadSuccess;
-};
-
 /**
  The addImageAsync logic follow the steps:
- - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (Load thread)
+ - find the image has been add or not, if not add an AsyncStruct to _requestQueue, and start a decode job if there are less than the maximum (GL thread)
+ - decode jobs get the AsyncStruct of highest priority from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (job threads)
  - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL thread)
  
  the Critical Area include these members:
- - _requestQueue: locked by _requestMutex
+ - _requestQueue, the priorities of the AsyncStructs and _runningDecodeJobs: locked by _requestMutex
  - _responseQueue: locked by _responseMutex
  
  the object's life time:
@@ -117,6 +126,7 @@ public:
  
  Note:
  - all AsyncStruct referenced in _asyncStructQueue, for unbind function use.
+ - an unbound AsyncStruct is cancelled: it is not decoded if it did not start yet, and its image is dropped instead of being converted to a texture.
  
  How to deal add image many times?
  - At first, this situation is abnormal, we only ensure the logic is correct.
@@ -128,6 +138,11 @@ public:
  - Convert image to texture faster than load image from disk, so this isn't a problem.
  */
 void TextureCache::addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback)
+{
+    addImageAsync(path, callback, 0);
+}
+
+void TextureCache::addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, int priority)
 {
     Texture2D *texture = nullptr;
 
@@ -139,6 +154,7 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
 
     if (texture != nullptr)
     {
+        touchTexture(fullpath);
         if (callback) callback(texture);
         return;
     }
@@ -149,14 +165,6 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
         return;
     }
 
-    // lazy init
-    if (_loadingThread == nullptr)
-    {
-        // create a new thread to load images
-        _loadingThread = new std::thread(&TextureCache::loadImage, this);
-        _needQuit = false;
-    }
-
     if (0 == _asyncRefCount)
     {
         Director::getInstance()->getScheduler()->schedule(CC_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack), this, 0, false);
@@ -165,7 +173,7 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
     ++_asyncRefCount;
 
     // generate async struct
-    AsyncStruct *data = new (std::nothrow) AsyncStruct(fullpath, callback);
+    AsyncStruct *data = new (std::nothrow) AsyncStruct(fullpath, callback, priority);
     
     // add async struct into queue
     _asyncStructQueue.push_back(data);
@@ -173,64 +181,86 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
     _requestQueue.push_back(data);
     _requestMutex.unlock();
 
-    _sleepCondition.notify_one();
+    startDecodeJobs();
 }
 
-void TextureCache::unbindImageAsync(const std::string& filename)
+void TextureCache::setImageAsyncPriority(const std::string& filename, int priority)
 {
-    if (_asyncStructQueue.empty())
-    {
-        return;
-    }
     std::string fullpath = FileUtils::getInstance()->fullPathForFilename(filename);
-    for (auto it = _asyncStructQueue.begin(); it != _asyncStructQueue.end(); ++it)
+    _requestMutex.lock();
+    for (auto asyncStruct : _requestQueue)
     {
-        if ((*it)->filename == fullpath)
+        if (asyncStruct->filename == fullpath)
         {
-            (*it)->callback = nullptr;
+            asyncStruct->priority = priority;
         }
     }
+    _requestMutex.unlock();
 }
 
-void TextureCache::unbindAllImageAsync()
+void TextureCache::setAsyncDecodeWorkerCount(int count)
 {
-    if (_asyncStructQueue.empty())
-    {
-        return;
+    _asyncDecodeWorkerCount = std::max(count, 0);
+    startDecodeJobs();
+}
 
-    }
-    for (auto it = _asyncStructQueue.begin(); it != _asyncStructQueue.end(); ++it)
+int TextureCache::getAsyncDecodeWorkerCount() const
+{
+    return _asyncDecodeWorkerCount > 0 ? _asyncDecodeWorkerCount : JobSystem::getInstance()->getWorkerCount();
+}
+
+void TextureCache::startDecodeJobs()
+{
+    const int maxJobs = getAsyncDecodeWorkerCount();
+    for (;;)
     {
-        (*it)->callback = nullptr;
+        _requestMutex.lock();
+        bool start = _runningDecodeJobs < maxJobs && _runningDecodeJobs < (int)_requestQueue.size();
+        if (start)
+        {
+            ++_runningDecodeJobs;
+        }
+        _requestMutex.unlock();
+
+        if (!start)
+        {
+            break;
+        }
+
+        _decodeJobs.erase(std::remove_if(_decodeJobs.begin(), _decodeJobs.end(), [](const JobSystem::JobHandle& job){ return job->isDone(); }), _decodeJobs.end());
+        _decodeJobs.push_back(JobSystem::getInstance()->schedule(std::bind(&TextureCache::decodeImages, this)));
     }
 }
 
-void TextureCache::loadImage()
+void TextureCache::decodeImages()
 {
-    AsyncStruct *asyncStruct = nullptr;
-    std::mutex signalMutex;
-    std::unique_lock<std::mutex> signal(signalMutex);
-    while (!_needQuit)
+    for (;;)
     {
-        // pop an AsyncStruct from request queue
+        // pop the AsyncStruct of highest priority from request queue, the oldest one if several have the same priority
         _requestMutex.lock();
-        if(_requestQueue.empty())
+        if (_requestQueue.empty())
         {
-            asyncStruct = nullptr;
-        }else
+            --_runningDecodeJobs;
+            _requestMutex.unlock();
+            return;
+        }
+        auto next = _requestQueue.begin();
+        for (auto it = next + 1; it != _requestQueue.end(); ++it)
         {
-            asyncStruct = _requestQueue.front();
-            _requestQueue.pop_front();
+            if ((*it)->priority > (*next)->priority)
+            {
+                next = it;
+            }
         }
+        AsyncStruct *asyncStruct = *next;
+        _requestQueue.erase(next);
         _requestMutex.unlock();
-        
-        if (nullptr == asyncStruct) {
-            _sleepCondition.wait(signal);
-            continue;
+
+        // load image, unless it was unbound while waiting
+        if (!asyncStruct->cancelled)
+        {
+            asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
         }
-        
-        // load image
-        asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
 
         // push the asyncStruct to response queue
         _responseMutex.lock();
@@ -239,6 +269,37 @@ void TextureCache::loadImage()
     }
 }
 
+void TextureCache::unbindImageAsync(const std::string& filename)
+{
+    if (_asyncStructQueue.empty())
+    {
+        return;
+    }
+    std::string fullpath = FileUtils::getInstance()->fullPathForFilename(filename);
+    for (auto it = _asyncStructQueue.begin(); it != _asyncStructQueue.end(); ++it)
+    {
+        if ((*it)->filename == fullpath)
+        {
+            (*it)->callback = nullptr;
+            (*it)->cancelled = true;
+        }
+    }
+}
+
+void TextureCache::unbindAllImageAsync()
+{
+    if (_asyncStructQueue.empty())
+    {
+        return;
+
+    }
+    for (auto it = _asyncStructQueue.begin(); it != _asyncStructQueue.end(); ++it)
+    {
+        (*it)->callback = nullptr;
+        (*it)->cancelled = true;
+    }
+}
+
 void TextureCache::addImageAsyncCallBack(float dt)
 {
     Texture2D *texture = nullptr;
@@ -255,9 +316,10 @@ void TextureCache::addImageAsyncCallBack(float dt)
             asyncStruct = _responseQueue.front();
             _responseQueue.pop_front();
             
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            CC_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
+            // the images are loaded in parallel, they don't finish in the order they were requested
+            auto it = std::find(_asyncStructQueue.begin(), _asyncStructQueue.end(), asyncStruct);
+            CC_ASSERT(it != _asyncStructQueue.end());
+            _asyncStructQueue.erase(it);
         }
         _responseMutex.unlock();
         
@@ -270,6 +332,12 @@ void TextureCache::addImageAsyncCallBack(float dt)
         if(it != _textures.end())
         {
             texture = it->second;
+            touchTexture(asyncStruct->filename);
+        }
+        else if (asyncStruct->cancelled)
+        {
+            // unbound while it was loading, nobody waits for the texture
+            texture = nullptr;
         }
         else
         {
@@ -290,6 +358,7 @@ void TextureCache::addImageAsyncCallBack(float dt)
                 // cache the texture. retain it, since it is added in the map
                 _textures.insert( std::make_pair(asyncStruct->filename, texture) );
                 texture->retain();
+                touchTexture(asyncStruct->filename);
                 
                 texture->autorelease();
             } else {
@@ -309,6 +378,8 @@ void TextureCache::addImageAsyncCallBack(float dt)
         --_asyncRefCount;
     }
 
+    evictTextures();
+
     if (0 == _asyncRefCount)
     {
         Director::getInstance()->getScheduler()->unschedule(CC_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack), this);
@@ -330,7 +401,10 @@ Texture2D * TextureCache::addImage(const std::string &path)
     }
     auto it = _textures.find(fullpath);
     if( it != _textures.end() )
+    {
         texture = it->second;
+        touchTexture(fullpath);
+    }
 
     if (! texture)
     {
@@ -353,9 +427,12 @@ Texture2D * TextureCache::addImage(const std::string &path)
 #endif
                 // texture already retained, no need to re-retain it
                 _textures.insert( std::make_pair(fullpath, texture) );
+                touchTexture(fullpath);
 
                 //parse 9-patch info
                 this->parseNinePatchImage(image, texture, path);
+
+                evictTextures();
             }
             else
             {
@@ -404,6 +481,9 @@ Texture2D* TextureCache::addImage(Image *image, const std::string &key)
             texture->retain();
 
             texture->autorelease();
+
+            // not loaded from a file, it can't be evicted but counts in the budget
+            evictTextures();
         }
         else
         {
@@ -466,6 +546,8 @@ void TextureCache::removeAllTextures()
         (it->second)->release();
     }
     _textures.clear();
+    _lruKeys.clear();
+    _lruEntries.clear();
 }
 
 void TextureCache::removeUnusedTextures()
@@ -476,6 +558,7 @@ void TextureCache::removeUnusedTextures()
             CCLOG("cocos2d: TextureCache: removing unused texture: %s", it->first.c_str());
 
             tex->release();
+            removeFromLRU(it->first);
             _textures.erase(it++);
         } else {
             ++it;
@@ -494,6 +577,7 @@ void TextureCache::removeTexture(Texture2D* texture)
     for( auto it=_textures.cbegin(); it!=_textures.cend(); /* nothing */ ) {
         if( it->second == texture ) {
             texture->release();
+            removeFromLRU(it->first);
             _textures.erase(it++);
             break;
         } else
@@ -513,7 +597,86 @@ void TextureCache::removeTextureForKey(const std::string &textureKeyName)
 
     if( it != _textures.end() ) {
         (it->second)->release();
+        removeFromLRU(it->first);
+        _textures.erase(it);
+    }
+}
+
+void TextureCache::touchTexture(const std::string& key)
+{
+    unsigned int frame = Director::getInstance()->getTotalFrames();
+    auto it = _lruEntries.find(key);
+    if (it != _lruEntries.end())
+    {
+        _lruKeys.splice(_lruKeys.end(), _lruKeys, it->second.position);
+        it->second.lastUsedFrame = frame;
+    }
+    else
+    {
+        LRUEntry entry;
+        entry.position = _lruKeys.insert(_lruKeys.end(), key);
+        entry.lastUsedFrame = frame;
+        _lruEntries.insert(std::make_pair(key, entry));
+    }
+}
+
+void TextureCache::removeFromLRU(const std::string& key)
+{
+    auto it = _lruEntries.find(key);
+    if (it != _lruEntries.end())
+    {
+        _lruKeys.erase(it->second.position);
+        _lruEntries.erase(it);
+    }
+}
+
+void TextureCache::setMemoryBudget(size_t bytes)
+{
+    _memoryBudget = bytes;
+    evictTextures();
+}
+
+size_t TextureCache::getTotalTextureMemory() const
+{
+    size_t totalBytes = 0;
+    for (auto& item : _textures)
+    {
+        totalBytes += item.second->getMemorySize();
+    }
+    return totalBytes;
+}
+
+void TextureCache::evictTextures()
+{
+    if (_memoryBudget == 0)
+        return;
+
+    size_t totalBytes = getTotalTextureMemory();
+    unsigned int frame = Director::getInstance()->getTotalFrames();
+    auto lruIt = _lruKeys.begin();
+    while (totalBytes > _memoryBudget && lruIt != _lruKeys.end())
+    {
+        auto& lruEntry = _lruEntries.at(*lruIt);
+        // the textures returned in this frame may not be retained yet, and the next ones are more recent
+        if (lruEntry.lastUsedFrame == frame)
+            break;
+
+        auto it = _textures.find(*lruIt);
+        CC_ASSERT(it != _textures.end());
+        Texture2D* tex = it->second;
+        if (tex->getReferenceCount() != 1)
+        {
+            ++lruIt;
+            continue;
+        }
+
+        CCLOG("cocos2d: TextureCache: evicting texture: %s", it->first.c_str());
+        totalBytes -= tex->getMemorySize();
+        ++_evictedTextureCount;
+        tex->release();
         _textures.erase(it);
+        _lruEntries.erase(*lruIt);
+        lruIt = _lruKeys.erase(lruIt);
     }
 }
 
@@ -555,10 +718,12 @@ const std::string TextureCache::getTextureFilePath( cocos2d::Texture2D *texture
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
-    _needQuit = true;
-    _sleepCondition.notify_one();
-    if (_loadingThread) _loadingThread->join();
+    // the decode jobs skip the loads left, wait for them to finish
+    for (auto asyncStruct : _asyncStructQueue)
+        asyncStruct->cancelled = true;
+    for (auto& job : _decodeJobs)
+        JobSystem::getInstance()->wait(job);
+    _decodeJobs.clear();
 }
 
 std::string TextureCache::getCachedTextureInfo() const
@@ -567,7 +732,7 @@ std::string TextureCache::getCachedTextureInfo() const
     char buftmp[4096];
 
     unsigned int count = 0;
-    unsigned int totalBytes = 0;
+    size_t totalBytes = 0;
 
     for( auto it = _textures.begin(); it != _textures.end(); ++it ) {
 
@@ -576,8 +741,8 @@ std::string TextureCache::getCachedTextureInfo() const
 
         Texture2D* tex = it->second;
         unsigned int bpp = tex->getBitsPerPixelForFormat();
-        // Each texture takes up width * height * bytesPerPixel bytes.
-        auto bytes = tex->getPixelsWide() * tex->getPixelsHigh() * bpp / 8;
+        // Each texture takes up width * height * bytesPerPixel bytes, plus a third for the mipmaps.
+        auto bytes = tex->getMemorySize();
         totalBytes += bytes;
         count++;
         snprintf(buftmp,sizeof(buftmp)-1,"\"%s\" rc=%lu id=%lu %lu x %lu @ %ld bpp => %lu KB\n",
@@ -595,6 +760,10 @@ std::string TextureCache::getCachedTextureInfo() const
     snprintf(buftmp, sizeof(buftmp)-1, "TextureCache dumpDebugInfo: %ld textures, for %lu KB (%.2f MB)\n", (long)count, (long)totalBytes / 1024, totalBytes / (1024.0f*1024.0f));
     buffer += buftmp;
 
+    snprintf(buftmp, sizeof(buftmp)-1, "TextureCache memory budget: %lu KB (%.1f%% used), %u textures evicted\n",
+             (long)_memoryBudget / 1024, _memoryBudget ? totalBytes * 100.0f / _memoryBudget : 0.0f, _evictedTextureCount);
+    buffer += buftmp;
+
     return buffer;
 }
 
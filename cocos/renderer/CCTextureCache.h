@@ -36,10 +36,13 @@ THE SOFTWARE.
 #include <string>
 #include <unordered_map>
 #include <functional>
+#include <vector>
+#include <list>
 
 #include "base/CCRef.h"
 #include "renderer/CCTexture2D.h"
 #include "platform/CCImage.h"
+#include "base/CCJobSystem.h"
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     #include "platform/CCImage.h"
@@ -121,16 +124,45 @@ public:
      @since v0.8
     */
     virtual void addImageAsync(const std::string &filepath, const std::function<void(Texture2D*)>& callback);
+
+    /** Same as addImageAsync(filepath, callback), with a priority.
+    * The images waiting to be decoded are decoded by order of priority, then in the order they were added,
+    * so the textures that are visible first can be loaded first.
+     @param filepath A null terminated string.
+     @param callback A callback function would be inovked after the image is loaded.
+     @param priority Images of higher priority are decoded first. addImageAsync(filepath, callback) uses 0.
+     @since v3.9
+    */
+    void addImageAsync(const std::string &filepath, const std::function<void(Texture2D*)>& callback, int priority);
+
+    /** Changes the priority of an image that is waiting to be decoded.
+     * @param filename It's the related/absolute path of the file image.
+     * @param priority The new priority, images of higher priority are decoded first.
+     * @since v3.9
+     */
+    void setImageAsyncPriority(const std::string &filename, int priority);
+
+    /** Sets how many images can be decoded at the same time by addImageAsync, on the threads of the JobSystem.
+     * @param count Number of images decoded in parallel, 0 uses all the threads of the JobSystem. It is the default.
+     * @since v3.9
+     */
+    void setAsyncDecodeWorkerCount(int count);
+
+    /** Returns how many images can be decoded at the same time by addImageAsync.
+     * @since v3.9
+     */
+    int getAsyncDecodeWorkerCount() const;
     
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is invoked,
      * the object always need to unbind this callback manually.
+     * The load is cancelled: the image is not decoded if it did not start yet, and it is not converted to a texture.
      * @param filename It's the related/absolute path of the file image.
      * @since v3.1
      */
     virtual void unbindImageAsync(const std::string &filename);
     
-    /** Unbind all bound image asynchronous load callbacks.
+    /** Unbind all bound image asynchronous load callbacks, and cancel the loads.
      * @since v3.1
      */
     virtual void unbindAllImageAsync();
@@ -191,6 +223,31 @@ public:
     */
     std::string getCachedTextureInfo() const;
 
+    /** Sets the memory budget of the cached textures, in bytes.
+    * When the textures use more memory than the budget, the textures loaded from a file that are not used
+    * anymore (with a retain count of 1) are removed, the least recently used first.
+    * They are loaded again by the next addImage or addImageAsync of their file.
+    * Textures used in the current frame are never removed, so the budget may be exceeded for a while.
+    * @param bytes The budget in bytes, 0 means no budget. It is the default.
+    * @since v3.9
+    */
+    void setMemoryBudget(size_t bytes);
+
+    /** Returns the memory budget of the cached textures, in bytes. 0 means no budget.
+    * @since v3.9
+    */
+    size_t getMemoryBudget() const { return _memoryBudget; }
+
+    /** Returns the memory used by all the cached textures, in bytes.
+    * @since v3.9
+    */
+    size_t getTotalTextureMemory() const;
+
+    /** Returns how many textures were removed to stay within the memory budget.
+    * @since v3.9
+    */
+    unsigned int getEvictedTextureCount() const { return _evictedTextureCount; }
+
     //Wait for texture cahe to quit befor destroy instance.
     /**Called by director, please do not called outside.*/
     void waitForQuit();
@@ -206,28 +263,48 @@ public:
 
 private:
     void addImageAsyncCallBack(float dt);
-    void loadImage();
+    // starts decode jobs until there is one per request waiting, or the maximum is reached
+    void startDecodeJobs();
+    // run by the decode jobs, decodes requests until _requestQueue is empty
+    void decodeImages();
     void parseNinePatchImage(Image* image, Texture2D* texture, const std::string& path);
+    // moves a texture loaded from a file to the end of the LRU list
+    void touchTexture(const std::string& key);
+    void removeFromLRU(const std::string& key);
+    // removes unused textures, the least recently used first, until the memory budget is met
+    void evictTextures();
 public:
 protected:
     struct AsyncStruct;
     
-    std::thread* _loadingThread;
-
     std::deque<AsyncStruct*> _asyncStructQueue;
-    std::deque<AsyncStruct*> _requestQueue;
+    // requests in the order they were added, the decode jobs pick the one of highest priority
+    std::vector<AsyncStruct*> _requestQueue;
     std::deque<AsyncStruct*> _responseQueue;
 
     std::mutex _requestMutex;
     std::mutex _responseMutex;
-    
-    std::condition_variable _sleepCondition;
-
-    bool _needQuit;
 
     int _asyncRefCount;
 
+    // the images are decoded by jobs of the JobSystem
+    int _asyncDecodeWorkerCount;
+    int _runningDecodeJobs;
+    std::vector<JobSystem::JobHandle> _decodeJobs;
+
     std::unordered_map<std::string, Texture2D*> _textures;
+
+    struct LRUEntry
+    {
+        std::list<std::string>::iterator position;
+        unsigned int lastUsedFrame;
+    };
+    // the keys of the textures loaded from a file, which can be loaded again when evicted, least recently used first
+    std::list<std::string> _lruKeys;
+    std::unordered_map<std::string, LRUEntry> _lruEntries;
+
+    size_t _memoryBudget;
+    unsigned int _evictedTextureCount;
 };
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
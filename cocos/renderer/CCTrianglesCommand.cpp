@@ -78,7 +78,7 @@ TrianglesCommand::~TrianglesCommand()
 void TrianglesCommand::generateMaterialID()
 {
     
-    if(_glProgramState->getUniformCount() > 0)
+    if(_glProgramState->hasUniformCallbacks())
     {
         _materialID = Renderer::MATERIAL_ID_DO_NOT_BATCH;
     }
@@ -88,6 +88,13 @@ void TrianglesCommand::generateMaterialID()
         int intArray[4] = { glProgram, (int)_textureID, (int)_blendType.src, (int)_blendType.dst};
         
         _materialID = XXH32((const void*)intArray, sizeof(intArray), 0);
+
+        // commands using the same state (e.g. from GLProgramState::getShared) share the uniform values too
+        if(_glProgramState->getUniformCount() > 0)
+        {
+            uint32_t stateId = _glProgramState->getStateId();
+            _materialID = XXH32((const void*)&stateId, sizeof(stateId), _materialID);
+        }
     }
 }
 
@@ -141,12 +141,12 @@ bool VertexAttribBinding::init(MeshIndexData* meshIndexData, GLProgramState* glP
     // VAO hardware
     if (Configuration::getInstance()->supportsShareableVAO())
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
         glGenVertexArrays(1, &_handle);
         GL::bindVAO(_handle);
-        glBindBuffer(GL_ARRAY_BUFFER, meshVertexData->getVertexBuffer()->getVBO());
+        GL::bindBuffer(GL_ARRAY_BUFFER, meshVertexData->getVertexBuffer()->getVBO());
 
         auto flags = _vertexAttribsFlags;
         for (int i = 0; flags > 0; i++) {
@@ -156,7 +156,7 @@ bool VertexAttribBinding::init(MeshIndexData* meshIndexData, GLProgramState* glP
             flags &= ~flag;
         }
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshIndexData->getIndexBuffer()->getVBO());
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshIndexData->getIndexBuffer()->getVBO());
 
         for(auto &attribute : _attributes)
         {
@@ -181,8 +181,8 @@ void VertexAttribBinding::bind()
     {
         // software
         auto meshVertexData = _meshIndexData->getMeshVertexData();
-        glBindBuffer(GL_ARRAY_BUFFER, meshVertexData->getVertexBuffer()->getVBO());
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _meshIndexData->getIndexBuffer()->getVBO());
+        GL::bindBuffer(GL_ARRAY_BUFFER, meshVertexData->getVertexBuffer()->getVBO());
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _meshIndexData->getIndexBuffer()->getVBO());
 
         // Software mode
         GL::enableVertexAttribs(_vertexAttribsFlags);
@@ -205,8 +205,8 @@ void VertexAttribBinding::unbind()
     else
     {
         // Software
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 }
 
@@ -23,6 +23,7 @@
  ****************************************************************************/
 
 #include "renderer/CCVertexIndexBuffer.h"
+#include "renderer/ccGLStateCache.h"
 #include "base/CCEventType.h"
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventDispatcher.h"
@@ -77,7 +78,7 @@ VertexBuffer::~VertexBuffer()
 {
     if(glIsBuffer(_vbo))
     {
-        glDeleteBuffers(1, &_vbo);
+        GL::deleteBuffers(1, &_vbo);
         _vbo = 0;
     }
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID || CC_TARGET_PLATFORM == CC_PLATFORM_WINRT)
@@ -99,9 +100,9 @@ bool VertexBuffer::init(int sizePerVertex, int vertexNumber, GLenum usage/* = GL
     }
     
     glGenBuffers(1, &_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
     glBufferData(GL_ARRAY_BUFFER, getSize(), nullptr, _usage);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
     return true;
 }
 
@@ -136,9 +137,9 @@ bool VertexBuffer::updateVertices(const void* verts, int count, int begin)
         memcpy(&_shadowCopy[begin * _sizePerVertex], verts, count * _sizePerVertex);
     }
     
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
     glBufferSubData(GL_ARRAY_BUFFER, begin * _sizePerVertex, count * _sizePerVertex, verts);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
     
     return true;
 }
@@ -152,7 +153,7 @@ void VertexBuffer::recreateVBO() const
 {
     CCLOG("come to foreground of VertexBuffer");
     glGenBuffers(1, &_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
     const void* buffer = nullptr;
     if(isShadowCopyEnabled())
     {
@@ -160,7 +161,7 @@ void VertexBuffer::recreateVBO() const
     }
     CCLOG("recreate IndexBuffer with size %d %d", getSizePerVertex(), _vertexNumber);
     glBufferData(GL_ARRAY_BUFFER, _sizePerVertex * _vertexNumber, buffer, _usage);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
     if(!glIsBuffer(_vbo))
     {
         CCLOGERROR("recreate VertexBuffer Error");
@@ -204,7 +205,7 @@ IndexBuffer::~IndexBuffer()
 {
     if(glIsBuffer(_vbo))
     {
-        glDeleteBuffers(1, &_vbo);
+        GL::deleteBuffers(1, &_vbo);
         _vbo = 0;
     }
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID || CC_TARGET_PLATFORM == CC_PLATFORM_WINRT)
@@ -221,9 +222,9 @@ bool IndexBuffer::init(IndexBuffer::IndexType type, int number, GLenum usage/* =
     _usage = usage;
     
     glGenBuffers(1, &_vbo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, getSize(), nullptr, _usage);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     
     if(isShadowCopyEnabled())
     {
@@ -264,9 +265,9 @@ bool IndexBuffer::updateIndices(const void* indices, int count, int begin)
         count = _indexNumber - begin;
     }
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo);
     glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, begin * getSizePerIndex(), count * getSizePerIndex(), indices);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     
     if(isShadowCopyEnabled())
     {
@@ -290,7 +291,7 @@ void IndexBuffer::recreateVBO() const
 {
     CCLOG("come to foreground of IndexBuffer");
     glGenBuffers(1, &_vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    GL::bindBuffer(GL_ARRAY_BUFFER, _vbo);
     const void* buffer = nullptr;
     if(isShadowCopyEnabled())
     {
@@ -298,7 +299,7 @@ void IndexBuffer::recreateVBO() const
     }
     CCLOG("recreate IndexBuffer with size %d %d ", getSizePerIndex(), _indexNumber);
     glBufferData(GL_ARRAY_BUFFER, getSize(), buffer, _usage);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GL::bindBuffer(GL_ARRAY_BUFFER, 0);
     if(!glIsBuffer(_vbo))
     {
         CCLOGERROR("recreate IndexBuffer Error");
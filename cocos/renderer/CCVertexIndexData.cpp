@@ -130,10 +130,10 @@ void VertexData::use()
         auto vertexStreamAttrib = element.second._stream;
         auto vertexBuffer = element.second._buffer;
 
-        // don't call glBindBuffer() if not needed. Expensive operation.
+        // don't call GL::bindBuffer() if not needed. Expensive operation.
         int vbo = vertexBuffer->getVBO();
         if (vbo != lastVBO) {
-            glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer->getVBO());
+            GL::bindBuffer(GL_ARRAY_BUFFER, vertexBuffer->getVBO());
             lastVBO = vbo;
         }
         glVertexAttribPointer(GLint(vertexStreamAttrib._semantic),
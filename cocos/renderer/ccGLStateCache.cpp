@@ -37,12 +37,16 @@ NS_CC_BEGIN
 
 static const int MAX_ATTRIBUTES = 16;
 static const int MAX_ACTIVE_TEXTURE = 16;
+static const int MAX_CAPABILITIES = 6;
 
 namespace
 {
     static GLuint s_currentProjectionMatrix = -1;
     static uint32_t s_attributeFlags = 0;  // 32 attributes max
 
+    static unsigned int s_issuedStateChanges = 0;
+    static unsigned int s_skippedStateChanges = 0;
+
 #if CC_ENABLE_GL_STATE_CACHE
 
     static GLuint    s_currentShaderProgram = -1;
@@ -53,6 +57,34 @@ namespace
     static GLuint    s_VAO = 0;
     static GLenum    s_activeTexture = -1;
 
+    // shadow of the GL state, -1 means unknown
+    static int       s_capabilities[MAX_CAPABILITIES] = {-1, -1, -1, -1, -1, -1};
+    static int       s_depthMask = -1;
+    static GLenum    s_depthFunc = -1;
+    static GLenum    s_cullFace = -1;
+    static GLenum    s_frontFace = -1;
+    static GLenum    s_blendEquation = -1;
+    static GLenum    s_blendFuncSource = -1;
+    static GLenum    s_blendFuncDest = -1;
+    static GLuint    s_arrayBuffer = -1;
+    static GLuint    s_elementArrayBuffer = -1;
+
+
+    // index of the cached capabilities in s_capabilities, -1 if the capability is not cached
+    static int capabilityIndex(GLenum cap)
+    {
+        switch (cap)
+        {
+            case GL_BLEND: return 0;
+            case GL_DEPTH_TEST: return 1;
+            case GL_CULL_FACE: return 2;
+            case GL_SCISSOR_TEST: return 3;
+            case GL_STENCIL_TEST: return 4;
+            case GL_POLYGON_OFFSET_FILL: return 5;
+            default: return -1;
+        }
+    }
+
 #endif // CC_ENABLE_GL_STATE_CACHE
 }
 
@@ -66,6 +98,11 @@ void invalidateStateCache( void )
     s_currentProjectionMatrix = -1;
     s_attributeFlags = 0;
 
+    invalidateGLStateCache();
+}
+
+void invalidateGLStateCache( void )
+{
 #if CC_ENABLE_GL_STATE_CACHE
     s_currentShaderProgram = -1;
     for( int i=0; i < MAX_ACTIVE_TEXTURE; i++ )
@@ -76,11 +113,50 @@ void invalidateStateCache( void )
     s_blendingSource = -1;
     s_blendingDest = -1;
     s_GLServerState = 0;
-    s_VAO = 0;
+    s_VAO = -1;
+    s_activeTexture = -1;
+
+    for (int i = 0; i < MAX_CAPABILITIES; i++)
+    {
+        s_capabilities[i] = -1;
+    }
+    s_depthMask = -1;
+    s_depthFunc = -1;
+    s_cullFace = -1;
+    s_frontFace = -1;
+    s_blendEquation = -1;
+    s_blendFuncSource = -1;
+    s_blendFuncDest = -1;
+    s_arrayBuffer = -1;
+    s_elementArrayBuffer = -1;
     
 #endif // CC_ENABLE_GL_STATE_CACHE
 }
 
+void recordStateChange(bool issued)
+{
+    if (issued)
+        ++s_issuedStateChanges;
+    else
+        ++s_skippedStateChanges;
+}
+
+unsigned int getIssuedStateChanges()
+{
+    return s_issuedStateChanges;
+}
+
+unsigned int getSkippedStateChanges()
+{
+    return s_skippedStateChanges;
+}
+
+void resetStateChangeStats()
+{
+    s_issuedStateChanges = 0;
+    s_skippedStateChanges = 0;
+}
+
 void deleteProgram( GLuint program )
 {
 #if CC_ENABLE_GL_STATE_CACHE
@@ -99,9 +175,35 @@ void useProgram( GLuint program )
     if( program != s_currentShaderProgram ) {
         s_currentShaderProgram = program;
         glUseProgram(program);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
     }
 #else
     glUseProgram(program);
+    recordStateChange(true);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+static void applyBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (sfactor != s_blendFuncSource || dfactor != s_blendFuncDest)
+    {
+        s_blendFuncSource = sfactor;
+        s_blendFuncDest = dfactor;
+        glBlendFunc(sfactor, dfactor);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
+    }
+#else
+    glBlendFunc(sfactor, dfactor);
+    recordStateChange(true);
 #endif // CC_ENABLE_GL_STATE_CACHE
 }
 
@@ -109,17 +211,17 @@ static void SetBlending(GLenum sfactor, GLenum dfactor)
 {
 	if (sfactor == GL_ONE && dfactor == GL_ZERO)
     {
-		glDisable(GL_BLEND);
+		disable(GL_BLEND);
         RenderState::StateBlock::_defaultState->setBlend(false);
 	}
     else
     {
-		glEnable(GL_BLEND);
-		glBlendFunc(sfactor, dfactor);
+		enable(GL_BLEND);
+		applyBlendFunc(sfactor, dfactor);
 
         RenderState::StateBlock::_defaultState->setBlend(true);
         RenderState::StateBlock::_defaultState->setBlendSrc((RenderState::Blend)sfactor);
-        RenderState::StateBlock::_defaultState->setBlendSrc((RenderState::Blend)dfactor);
+        RenderState::StateBlock::_defaultState->setBlendDst((RenderState::Blend)dfactor);
     }
 }
 
@@ -132,6 +234,10 @@ void blendFunc(GLenum sfactor, GLenum dfactor)
         s_blendingDest = dfactor;
         SetBlending(sfactor, dfactor);
     }
+    else
+    {
+        recordStateChange(false);
+    }
 #else
     SetBlending( sfactor, dfactor );
 #endif // CC_ENABLE_GL_STATE_CACHE
@@ -139,10 +245,17 @@ void blendFunc(GLenum sfactor, GLenum dfactor)
 
 void blendResetToCache(void)
 {
-	glBlendEquation(GL_FUNC_ADD);
 #if CC_ENABLE_GL_STATE_CACHE
+    // the blending state may have been changed with raw GL calls
+    s_blendEquation = -1;
+    s_blendFuncSource = -1;
+    s_blendFuncDest = -1;
+    s_capabilities[capabilityIndex(GL_BLEND)] = -1;
+
+	blendEquation(GL_FUNC_ADD);
 	SetBlending(s_blendingSource, s_blendingDest);
 #else
+	blendEquation(GL_FUNC_ADD);
 	SetBlending(CC_BLEND_SRC, CC_BLEND_DST);
 #endif // CC_ENABLE_GL_STATE_CACHE
 }
@@ -161,10 +274,17 @@ void bindTexture2DN(GLuint textureUnit, GLuint textureId)
 		s_currentBoundTexture[textureUnit] = textureId;
 		activeTexture(GL_TEXTURE0 + textureUnit);
 		glBindTexture(GL_TEXTURE_2D, textureId);
+		recordStateChange(true);
+	}
+	else
+	{
+		recordStateChange(false);
 	}
 #else
 	glActiveTexture(GL_TEXTURE0 + textureUnit);
 	glBindTexture(GL_TEXTURE_2D, textureId);
+	recordStateChange(true);
+	recordStateChange(true);
 #endif
 }
 
@@ -177,10 +297,17 @@ void bindTextureN(GLuint textureUnit, GLuint textureId, GLuint textureType/* = G
         s_currentBoundTexture[textureUnit] = textureId;
         activeTexture(GL_TEXTURE0 + textureUnit);
         glBindTexture(textureType, textureId);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
     }
 #else
     glActiveTexture(GL_TEXTURE0 + textureUnit);
     glBindTexture(textureType, textureId);
+    recordStateChange(true);
+    recordStateChange(true);
 #endif
 }
 
@@ -211,9 +338,15 @@ void activeTexture(GLenum texture)
     if(s_activeTexture != texture) {
         s_activeTexture = texture;
         glActiveTexture(s_activeTexture);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
     }
 #else
     glActiveTexture(texture);
+    recordStateChange(true);
 #endif
 }
 
@@ -227,14 +360,234 @@ void bindVAO(GLuint vaoId)
         {
             s_VAO = vaoId;
             glBindVertexArray(vaoId);
+            recordStateChange(true);
+
+            // the element array buffer binding is part of the vertex array state
+            s_elementArrayBuffer = -1;
+        }
+        else
+        {
+            recordStateChange(false);
         }
 #else
         glBindVertexArray(vaoId);
+        recordStateChange(true);
 #endif // CC_ENABLE_GL_STATE_CACHE
     
     }
 }
 
+void enable(GLenum cap)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    int index = capabilityIndex(cap);
+    if (index < 0 || s_capabilities[index] != 1)
+    {
+        if (index >= 0)
+            s_capabilities[index] = 1;
+        glEnable(cap);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
+    }
+#else
+    glEnable(cap);
+    recordStateChange(true);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+void disable(GLenum cap)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    int index = capabilityIndex(cap);
+    if (index < 0 || s_capabilities[index] != 0)
+    {
+        if (index >= 0)
+            s_capabilities[index] = 0;
+        glDisable(cap);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
+    }
+#else
+    glDisable(cap);
+    recordStateChange(true);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+bool isEnabled(GLenum cap)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    int index = capabilityIndex(cap);
+    if (index >= 0)
+    {
+        if (s_capabilities[index] < 0)
+            s_capabilities[index] = glIsEnabled(cap) != GL_FALSE ? 1 : 0;
+        return s_capabilities[index] == 1;
+    }
+#endif // CC_ENABLE_GL_STATE_CACHE
+    return glIsEnabled(cap) != GL_FALSE;
+}
+
+void depthMask(GLboolean flag)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    int value = flag ? 1 : 0;
+    if (s_depthMask != value)
+    {
+        s_depthMask = value;
+        glDepthMask(flag);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
+    }
+#else
+    glDepthMask(flag);
+    recordStateChange(true);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+GLboolean getDepthMask(void)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (s_depthMask < 0)
+    {
+        GLboolean flag = GL_TRUE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &flag);
+        s_depthMask = flag ? 1 : 0;
+    }
+    return s_depthMask ? GL_TRUE : GL_FALSE;
+#else
+    GLboolean flag = GL_TRUE;
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &flag);
+    return flag;
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+void depthFunc(GLenum func)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (s_depthFunc != func)
+    {
+        s_depthFunc = func;
+        glDepthFunc(func);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
+    }
+#else
+    glDepthFunc(func);
+    recordStateChange(true);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+void cullFace(GLenum mode)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (s_cullFace != mode)
+    {
+        s_cullFace = mode;
+        glCullFace(mode);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
+    }
+#else
+    glCullFace(mode);
+    recordStateChange(true);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+void frontFace(GLenum mode)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (s_frontFace != mode)
+    {
+        s_frontFace = mode;
+        glFrontFace(mode);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
+    }
+#else
+    glFrontFace(mode);
+    recordStateChange(true);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+void blendEquation(GLenum mode)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    if (s_blendEquation != mode)
+    {
+        s_blendEquation = mode;
+        glBlendEquation(mode);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
+    }
+#else
+    glBlendEquation(mode);
+    recordStateChange(true);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+void bindBuffer(GLenum target, GLuint buffer)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    GLuint* cached = nullptr;
+    if (target == GL_ARRAY_BUFFER)
+        cached = &s_arrayBuffer;
+    else if (target == GL_ELEMENT_ARRAY_BUFFER)
+        cached = &s_elementArrayBuffer;
+
+    if (!cached || *cached != buffer)
+    {
+        if (cached)
+            *cached = buffer;
+        glBindBuffer(target, buffer);
+        recordStateChange(true);
+    }
+    else
+    {
+        recordStateChange(false);
+    }
+#else
+    glBindBuffer(target, buffer);
+    recordStateChange(true);
+#endif // CC_ENABLE_GL_STATE_CACHE
+}
+
+void deleteBuffers(GLsizei n, const GLuint* buffers)
+{
+#if CC_ENABLE_GL_STATE_CACHE
+    // deleting a bound buffer reverts the binding to zero
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        if (buffers[i] == s_arrayBuffer)
+            s_arrayBuffer = 0;
+        if (buffers[i] == s_elementArrayBuffer)
+            s_elementArrayBuffer = 0;
+    }
+#endif // CC_ENABLE_GL_STATE_CACHE
+
+    glDeleteBuffers(n, buffers);
+}
+
 // GL Vertex Attrib functions
 
 void enableVertexAttribs(uint32_t flags)
@@ -253,6 +606,7 @@ void enableVertexAttribs(uint32_t flags)
                 glEnableVertexAttribArray(i);
             else
                 glDisableVertexAttribArray(i);
+            recordStateChange(true);
         }
     }
     s_attributeFlags = flags;
@@ -60,12 +60,23 @@ enum {
 
 /** 
  * Invalidates the GL state cache.
+ * It should be called after changing a cached state with a raw GL call, so the next cached call is not skipped by mistake.
  *
  * If CC_ENABLE_GL_STATE_CACHE it will reset the GL state cache.
  * @since v2.0.0
  */
 void CC_DLL invalidateStateCache(void);
 
+/**
+ * Invalidates the cached GL state: program, textures, VAO, capabilities, depth, culling, blending and buffer bindings.
+ * Unlike invalidateStateCache(), it doesn't reset the matrix stack nor the enabled vertex attributes,
+ * so it can be called while rendering, after code that may have changed the GL state with raw GL calls.
+ *
+ * If CC_ENABLE_GL_STATE_CACHE is disabled, it does nothing.
+ * @since v3.9
+ */
+void CC_DLL invalidateGLStateCache(void);
+
 /** 
  * Uses the GL program in case program is different than the current one.
 
@@ -172,6 +183,116 @@ void CC_DLL activeTexture(GLenum texture);
  */
 void CC_DLL bindVAO(GLuint vaoId);
 
+/**
+ * Enables a server side capability in case it is not already enabled.
+ * GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST and GL_POLYGON_OFFSET_FILL are cached,
+ * the other capabilities are always enabled.
+ *
+ * If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glEnable() directly.
+ * @since v3.9
+ */
+void CC_DLL enable(GLenum cap);
+
+/**
+ * Disables a server side capability in case it is not already disabled.
+ *
+ * If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glDisable() directly.
+ * @since v3.9
+ */
+void CC_DLL disable(GLenum cap);
+
+/**
+ * Returns whether a server side capability is enabled. glIsEnabled() is only called if the state is not cached yet.
+ * @since v3.9
+ */
+bool CC_DLL isEnabled(GLenum cap);
+
+/**
+ * Enables or disables writing into the depth buffer in case it is not already set.
+ *
+ * If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glDepthMask() directly.
+ * @since v3.9
+ */
+void CC_DLL depthMask(GLboolean flag);
+
+/**
+ * Returns whether writing into the depth buffer is enabled. glGetBooleanv() is only called if the state is not cached yet.
+ * @since v3.9
+ */
+GLboolean CC_DLL getDepthMask(void);
+
+/**
+ * Sets the depth comparison function in case it is not already set.
+ *
+ * If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glDepthFunc() directly.
+ * @since v3.9
+ */
+void CC_DLL depthFunc(GLenum func);
+
+/**
+ * Sets the culled faces in case they are not already set.
+ *
+ * If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glCullFace() directly.
+ * @since v3.9
+ */
+void CC_DLL cullFace(GLenum mode);
+
+/**
+ * Sets the winding of the front faces in case it is not already set.
+ *
+ * If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glFrontFace() directly.
+ * @since v3.9
+ */
+void CC_DLL frontFace(GLenum mode);
+
+/**
+ * Sets the blend equation in case it is not already set.
+ *
+ * If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glBlendEquation() directly.
+ * @since v3.9
+ */
+void CC_DLL blendEquation(GLenum mode);
+
+/**
+ * If the buffer is not already bound to the target, it binds it.
+ * GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER are cached, the other targets are always bound.
+ *
+ * If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glBindBuffer() directly.
+ * @since v3.9
+ */
+void CC_DLL bindBuffer(GLenum target, GLuint buffer);
+
+/**
+ * It will delete the given buffers. If one of them was bound, it will invalidate the cached binding.
+ * @since v3.9
+ */
+void CC_DLL deleteBuffers(GLsizei n, const GLuint* buffers);
+
+/**
+ * Returns the number of state changes sent to GL since the last call to resetStateChangeStats().
+ * @since v3.9
+ */
+unsigned int CC_DLL getIssuedStateChanges(void);
+
+/**
+ * Returns the number of state changes skipped because GL was already in that state, since the last call to resetStateChangeStats().
+ * @since v3.9
+ */
+unsigned int CC_DLL getSkippedStateChanges(void);
+
+/**
+ * Clears the state change counters. The renderer calls it at the beginning of every frame.
+ * @since v3.9
+ */
+void CC_DLL resetStateChangeStats(void);
+
+/**
+ * Counts a state change done outside of this file, like the uniforms cached by GLProgram.
+ * @param issued Whether the change was sent to GL or skipped.
+ * @since v3.9
+ */
+void CC_DLL recordStateChange(bool issued);
+
 // end of support group
 /// @}
 
@@ -55,6 +55,9 @@ void GLNode::onDraw(Mat4 &transform, uint32_t flags)
 
                  JS_CallFunctionValue(cx, jsObj, fval, JS::HandleValueArray::empty(), &rval);
 
+                 // gl.bindTexture() and gl.blendFunc() are raw GL calls
+                 GL::invalidateGLStateCache();
+
                  director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
              }
         }
@@ -60,6 +60,9 @@ void GLNode::onDraw(const cocos2d::Mat4 &transform, uint32_t flags)
         stack->pushInt(flags);
         stack->executeFunctionByHandler(handler, 2);
         stack->clean();
+
+        // gl.bindTexture() and gl.blendFunc() are raw GL calls
+        GL::invalidateGLStateCache();
     }
 }
 
@@ -209,7 +212,7 @@ static int tolua_Cocos2d_glActiveTexture00(lua_State* tolua_S)
 #endif
     {
         unsigned int activeTexture = (unsigned int)tolua_tonumber(tolua_S,1,0);
-        glActiveTexture((GLenum)activeTexture);
+        GL::activeTexture((GLenum)activeTexture);
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -294,7 +297,7 @@ static int tolua_Cocos2d_glBindBuffer00(lua_State* tolua_S)
     {
         unsigned int target   = (unsigned int)tolua_tonumber(tolua_S,1,0);
         unsigned int buffer   = (unsigned int)tolua_tonumber(tolua_S,2,0);
-        glBindBuffer((GLenum)target,(GLuint)buffer);
+        GL::bindBuffer((GLenum)target,(GLuint)buffer);
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -439,7 +442,7 @@ static int tolua_Cocos2d_glBlendEquation00(lua_State* tolua_S)
 #endif
     {
         unsigned int mode   = (unsigned int)tolua_tonumber(tolua_S,1,0);
-        glBlendEquation((GLenum)mode);
+        GL::blendEquation((GLenum)mode);
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -1075,7 +1078,7 @@ static int tolua_Cocos2d_glCullFace00(lua_State* tolua_S)
 #endif
     {
         unsigned int mode   = (unsigned int)tolua_tonumber(tolua_S,1,0);
-        glCullFace((GLenum)mode  );
+        GL::cullFace((GLenum)mode  );
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -1101,7 +1104,7 @@ static int tolua_Cocos2d_glDeleteBuffers00(lua_State* tolua_S)
 #endif
     {
         unsigned int buffers   = (unsigned int)tolua_tonumber(tolua_S,1,0);
-        glDeleteBuffers(1,&buffers );
+        GL::deleteBuffers(1,&buffers );
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -1153,7 +1156,7 @@ static int tolua_Cocos2d_glDeleteProgram00(lua_State* tolua_S)
 #endif
     {
         unsigned int program   = (unsigned int)tolua_tonumber(tolua_S,1,0);
-        glDeleteProgram((GLuint)program);
+        GL::deleteProgram((GLuint)program);
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -1231,7 +1234,7 @@ static int tolua_Cocos2d_glDeleteTextures00(lua_State* tolua_S)
 #endif
     {
         unsigned int textures   = (unsigned int)tolua_tonumber(tolua_S,1,0);
-        glDeleteTextures(1,&textures );
+        GL::deleteTexture(textures);
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -1257,7 +1260,7 @@ static int tolua_Cocos2d_glDepthFunc00(lua_State* tolua_S)
 #endif
     {
         unsigned int func   = (unsigned int)tolua_tonumber(tolua_S,1,0);
-        glDepthFunc((GLenum)func);
+        GL::depthFunc((GLenum)func);
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -1283,7 +1286,7 @@ static int tolua_Cocos2d_glDepthMask00(lua_State* tolua_S)
 #endif
     {
         unsigned char flag   = (unsigned char)tolua_tonumber(tolua_S,1,0);
-        glDepthMask((GLboolean)flag  );
+        GL::depthMask((GLboolean)flag  );
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -1365,7 +1368,7 @@ static int tolua_Cocos2d_glDisable00(lua_State* tolua_S)
 #endif
     {
         unsigned int cap   = (unsigned int)tolua_tonumber(tolua_S,1,0);
-        glDisable((GLenum)cap );
+        GL::disable((GLenum)cap );
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -1548,7 +1551,7 @@ static int tolua_Cocos2d_glEnable00(lua_State* tolua_S)
 #endif
     {
         unsigned int cap   = (unsigned int)tolua_tonumber(tolua_S,1,0);
-        glEnable((GLenum)cap);
+        GL::enable((GLenum)cap);
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -1714,7 +1717,7 @@ static int tolua_Cocos2d_glFrontFace00(lua_State* tolua_S)
 #endif
     {
         unsigned int mode = (unsigned int)tolua_tonumber(tolua_S, 1, 0);
-        glFrontFace((GLenum)mode);
+        GL::frontFace((GLenum)mode);
     }
     return 0;
 #ifndef TOLUA_RELEASE
@@ -3986,7 +3989,7 @@ static int tolua_Cocos2d_glUseProgram00(lua_State* tolua_S)
 #endif
     {
         unsigned int arg0 = (unsigned int)tolua_tonumber(tolua_S, 1, 0);
-        glUseProgram((GLuint)arg0  );
+        GL::useProgram((GLuint)arg0  );
     }
     return 0;
 #ifndef TOLUA_RELEASE
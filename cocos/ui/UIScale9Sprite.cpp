@@ -1190,6 +1190,11 @@ namespace ui {
             return;
         }
 
+        if (beginVisitCache(renderer, parentTransform, parentFlags))
+        {
+            return;
+        }
+
         uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
         // IMPORTANT:
@@ -1271,6 +1276,7 @@ namespace ui {
 
         director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
 
+        endVisitCache(renderer);
     }
 
     Size Scale9Sprite::getOriginalSize()const
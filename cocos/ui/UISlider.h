@@ -276,6 +276,8 @@ protected:
     virtual void onPressStateChangedToPressed() override;
     virtual void onPressStateChangedToDisabled() override;
     virtual void onSizeChanged() override;
+    // the slid ball may stick out of the bar
+    virtual bool isHitTestBoundedByContentSize() const override { return false; }
 
     void setupBarTexture();
     void loadBarTexture(SpriteFrame* spriteframe);
@@ -633,6 +633,8 @@ protected:
     void insertTextEvent();
     void deleteBackwardEvent();
     virtual void onSizeChanged() override;
+    // the touch size may be larger than the content size
+    virtual bool isHitTestBoundedByContentSize() const override { return false; }
   
     void textfieldRendererScaleChangedWithSize();
     
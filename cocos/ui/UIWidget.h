@@ -899,6 +899,14 @@ protected:
     //call back function called when size changed.
     virtual void onSizeChanged();
 
+    /**
+     * Whether hitTest() never succeeds outside the content size, which lets the
+     * EventDispatcher skip the widget for touches that begin elsewhere.
+     * Widgets with a larger touch area have to return false.
+     *@since v3.9
+     */
+    virtual bool isHitTestBoundedByContentSize() const { return true; }
+
     //initializes renderer of widget.
     virtual void initRenderer();
 
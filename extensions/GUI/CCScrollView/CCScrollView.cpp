@@ -31,6 +31,7 @@
 #include "base/CCDirector.h"
 #include "base/CCEventDispatcher.h"
 #include "renderer/CCRenderer.h"
+#include "renderer/ccGLStateCache.h"
 
 #include <algorithm>
 
@@ -552,7 +553,7 @@ void ScrollView::onBeforeDraw()
             }
         }
         else {
-            glEnable(GL_SCISSOR_TEST);
+            GL::enable(GL_SCISSOR_TEST);
             glview->setScissorInPoints(frame.origin.x, frame.origin.y, frame.size.width, frame.size.height);
         }
     }
@@ -579,7 +580,7 @@ void ScrollView::onAfterDraw()
             glview->setScissorInPoints(_parentScissorRect.origin.x, _parentScissorRect.origin.y, _parentScissorRect.size.width, _parentScissorRect.size.height);
         }
         else {
-            glDisable(GL_SCISSOR_TEST);
+            GL::disable(GL_SCISSOR_TEST);
         }
     }
 }
@@ -592,6 +593,11 @@ void ScrollView::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t
         return;
     }
 
+    if (beginVisitCache(renderer, parentTransform, parentFlags))
+    {
+        return;
+    }
+
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
     // IMPORTANT:
@@ -642,6 +648,8 @@ void ScrollView::visit(Renderer *renderer, const Mat4 &parentTransform, uint32_t
     this->afterDraw();
 
     director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+
+    endVisitCache(renderer);
 }
 
 bool ScrollView::onTouchBegan(Touch* touch, Event* event)
@@ -20,6 +20,8 @@ ActionManagerTests::ActionManagerTests()
     ADD_TEST_CASE(StopAllActionsTest);
     ADD_TEST_CASE(StopActionsByFlagsTest);
     ADD_TEST_CASE(ResumeTest);
+    ADD_TEST_CASE(BatchedTweensTest);
+    ADD_TEST_CASE(UnbatchedTweensTest);
 }
 
 //------------------------------------------------------------------
@@ -342,3 +344,117 @@ std::string StopActionsByFlagsTest::subtitle() const
 {
     return "Stop All Actions By Flags Test";
 }
+
+//------------------------------------------------------------------
+//
+// BatchedTweensTest
+//
+//------------------------------------------------------------------
+void BatchedTweensTest::onEnter()
+{
+    ActionManagerTest::onEnter();
+
+    auto l = Label::createWithTTF("Grid should move, spin, scale, fade and tint,\nthe left half pauses for 1 second in every cycle", "fonts/Thonburi.ttf", 16.0f);
+    addChild(l, 1);
+    l->setPosition(VisibleRect::center().x, VisibleRect::top().y - 75);
+
+    const int columns = 20;
+    const int rows = 10;
+    const float step = 20;
+    const Vec2 origin = VisibleRect::center() - Vec2(step * (columns - 1) / 2, step * (rows - 1) / 2);
+
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            auto sprite = Sprite::create("Images/r1.png");
+            sprite->setPosition(origin + Vec2(column * step, row * step));
+            sprite->setScale(0.5f);
+            addChild(sprite, 0, column < columns / 2 ? kTagGrossini : kTagNode);
+        }
+    }
+
+    runTweens(0);
+    this->schedule(CC_SCHEDULE_SELECTOR(BatchedTweensTest::runTweens), 5.0f);
+    this->schedule(CC_SCHEDULE_SELECTOR(BatchedTweensTest::pauseHalf), 5.0f, CC_REPEAT_FOREVER, 1.0f);
+    this->schedule(CC_SCHEDULE_SELECTOR(BatchedTweensTest::resumeHalf), 5.0f, CC_REPEAT_FOREVER, 2.0f);
+}
+
+void BatchedTweensTest::runTweens(float time)
+{
+    _movingUp = !_movingUp;
+
+    // one tween of each kind per sprite, these actions are evaluated together by the ActionManager
+    for (const auto& child : getChildren())
+    {
+        if (child->getTag() != kTagGrossini && child->getTag() != kTagNode)
+        {
+            continue;
+        }
+
+        child->runAction(MoveBy::create(3.0f, Vec2(0, _movingUp ? 30 : -30)));
+        child->runAction(RotateBy::create(3.0f, 360));
+        child->runAction(ScaleTo::create(3.0f, child->getScale() < 0.6f ? 0.8f : 0.5f));
+        child->runAction(FadeTo::create(3.0f, child->getOpacity() < 192 ? 255 : 128));
+        child->runAction(TintTo::create(3.0f, (GLubyte)cocos2d::random(0, 255), (GLubyte)cocos2d::random(0, 255), (GLubyte)cocos2d::random(0, 255)));
+    }
+}
+
+void BatchedTweensTest::pauseHalf(float time)
+{
+    auto actionManager = Director::getInstance()->getActionManager();
+    for (const auto& child : getChildren())
+    {
+        if (child->getTag() == kTagGrossini)
+        {
+            actionManager->pauseTarget(child);
+        }
+    }
+}
+
+void BatchedTweensTest::resumeHalf(float time)
+{
+    auto actionManager = Director::getInstance()->getActionManager();
+    for (const auto& child : getChildren())
+    {
+        if (child->getTag() == kTagGrossini)
+        {
+            actionManager->resumeTarget(child);
+        }
+    }
+}
+
+std::string BatchedTweensTest::subtitle() const
+{
+    return "Batched tweens";
+}
+
+//------------------------------------------------------------------
+//
+// UnbatchedTweensTest
+//
+//------------------------------------------------------------------
+void UnbatchedTweensTest::runTweens(float time)
+{
+    // two tweens of the same kind on a sprite, the ActionManager updates its actions one by one
+    for (const auto& child : getChildren())
+    {
+        if (child->getTag() != kTagGrossini && child->getTag() != kTagNode)
+        {
+            continue;
+        }
+
+        child->runAction(MoveBy::create(1.5f, Vec2(0, 30)));
+        // stacks with the first MoveBy
+        child->runAction(MoveBy::create(3.0f, Vec2(0, -30)));
+        child->runAction(RotateBy::create(3.0f, 360));
+        child->runAction(ScaleTo::create(3.0f, child->getScale() < 0.6f ? 0.8f : 0.5f));
+        child->runAction(FadeTo::create(3.0f, child->getOpacity() < 192 ? 255 : 128));
+        child->runAction(TintTo::create(3.0f, (GLubyte)cocos2d::random(0, 255), (GLubyte)cocos2d::random(0, 255), (GLubyte)cocos2d::random(0, 255)));
+    }
+}
+
+std::string UnbatchedTweensTest::subtitle() const
+{
+    return "Unbatched tweens";
+}
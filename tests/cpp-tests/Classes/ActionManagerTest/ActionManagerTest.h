@@ -95,4 +95,29 @@ protected:
     const unsigned int kRepeatForeverFlag = 0x08; // You don't need this for the test, but it's for demonstration how to activate several flags on an action.
 };
 
+class BatchedTweensTest : public ActionManagerTest
+{
+public:
+    CREATE_FUNC(BatchedTweensTest);
+
+    BatchedTweensTest() : _movingUp(false) {}
+
+    virtual std::string subtitle() const override;
+    virtual void onEnter() override;
+    virtual void runTweens(float time);
+    void pauseHalf(float time);
+    void resumeHalf(float time);
+protected:
+    bool _movingUp;
+};
+
+class UnbatchedTweensTest : public BatchedTweensTest
+{
+public:
+    CREATE_FUNC(UnbatchedTweensTest);
+
+    virtual std::string subtitle() const override;
+    virtual void runTweens(float time) override;
+};
+
 #endif
@@ -17,6 +17,8 @@ FileUtilsTests::FileUtilsTests()
     ADD_TEST_CASE(TestWriteValueMap);
     ADD_TEST_CASE(TestWriteValueVector);
     ADD_TEST_CASE(TestUnicodePath);
+    ADD_TEST_CASE(TestMapFile);
+    ADD_TEST_CASE(TestPackFile);
 }
 
 // TestResolutionDirectories
@@ -956,3 +958,132 @@ std::string TestUnicodePath::subtitle() const
 {
     return "";
 }
+
+// TestMapFile
+
+void TestMapFile::onEnter()
+{
+    FileUtilsDemo::onEnter();
+    auto s = Director::getInstance()->getWinSize();
+    auto util = FileUtils::getInstance();
+
+    auto addResult = [&](const std::string& msg, int line) {
+        auto label = Label::createWithSystemFont(msg, "", 12, Size(s.width, 0));
+        label->setPosition(s.width / 2, s.height * line / 5);
+        this->addChild(label);
+    };
+
+    // files are only mapped when it is enabled
+    _fileMappingEnabled = util->isFileMappingEnabled();
+    util->setFileMappingEnabled(true);
+
+    // a file in the writable path, compared with getDataFromFile
+    std::string filePath = util->getWritablePath() + "mapFileTest.txt";
+    std::string writeDataStr = "the mapped data should be the same as the data read";
+    Data writeData;
+    writeData.copy((unsigned char *)writeDataStr.c_str(), writeDataStr.size());
+    util->writeDataToFile(writeData, filePath);
+
+    {
+        MappedFile mapped = util->mapFile(filePath);
+        Data readData = util->getDataFromFile(filePath);
+        bool same = !mapped.isNull() && mapped.getSize() == readData.getSize()
+            && memcmp(mapped.getBytes(), readData.getBytes(), readData.getSize()) == 0;
+        addResult(StringUtils::format("writable file: %s, %s, %d bytes", same ? "same content" : "DIFFERENT content",
+                                      mapped.isMapped() ? "mapped" : "read", (int)mapped.getSize()), 4);
+
+        // moving the view keeps the bytes
+        MappedFile moved = std::move(mapped);
+        addResult(StringUtils::format("after move: %s", (mapped.isNull() && moved.getBytes() != nullptr) ? "success" : "failed"), 3);
+    }
+    util->removeFile(filePath);
+
+    // a resource, in the apk on android
+    std::string fntFile = "fonts/bitmapFontTest.fnt";
+    MappedFile mappedFnt = util->mapFile(fntFile);
+    Data fntData = util->getDataFromFile(fntFile);
+    bool same = !mappedFnt.isNull() && mappedFnt.getSize() == fntData.getSize()
+        && memcmp(mappedFnt.getBytes(), fntData.getBytes(), fntData.getSize()) == 0;
+    addResult(StringUtils::format("%s: %s, %s", fntFile.c_str(), same ? "same content" : "DIFFERENT content",
+                                  mappedFnt.isMapped() ? "mapped" : "read"), 2);
+
+    // a missing file
+    MappedFile missing = util->mapFile("mapFileTest-missing.txt");
+    addResult(StringUtils::format("missing file: %s", missing.isNull() ? "null" : "NOT null"), 1);
+}
+
+void TestMapFile::onExit()
+{
+    FileUtils::getInstance()->setFileMappingEnabled(_fileMappingEnabled);
+    FileUtilsDemo::onExit();
+}
+
+std::string TestMapFile::title() const
+{
+    return "FileUtils: mapFile";
+}
+
+std::string TestMapFile::subtitle() const
+{
+    return "Mapped views should match getDataFromFile";
+}
+
+// TestPackFile
+
+void TestPackFile::onEnter()
+{
+    FileUtilsDemo::onEnter();
+    auto s = Director::getInstance()->getWinSize();
+    auto sharedFileUtils = FileUtils::getInstance();
+
+    // Misc/test.cpk is built with tools/pack-builder/build_pack.py, from a "packfile" directory
+    _defaultSearchPathArray = sharedFileUtils->getSearchPaths();
+    sharedFileUtils->addSearchPath("Misc/test.cpk", true);
+
+    // an image, stored uncompressed
+    auto sprite = Sprite::create("packfile/grossini.png");
+    if (sprite)
+    {
+        sprite->setPosition(s.width / 4, s.height / 2);
+        this->addChild(sprite);
+    }
+
+    // a compressed fnt file, and the texture of its page next to it in the pack file
+    auto label = Label::createWithBMFont("packfile/konqa32.fnt", "Pack file");
+    if (label)
+    {
+        label->setPosition(s.width * 3 / 4, s.height / 2);
+        this->addChild(label);
+    }
+
+    std::string fullPath = sharedFileUtils->fullPathForFilename("packfile/test.txt");
+    std::string content = sharedFileUtils->getStringFromFile("packfile/test.txt");
+    log("packfile/test.txt -> %s", fullPath.c_str());
+
+    auto result = Label::createWithSystemFont(StringUtils::format("%s\nexists: %s, size: %ld",
+                                                                  content.c_str(),
+                                                                  sharedFileUtils->isFileExist(fullPath) ? "true" : "false",
+                                                                  sharedFileUtils->getFileSize(fullPath)),
+                                              "", 12, Size(s.width, 0));
+    result->setPosition(s.width / 2, s.height / 4);
+    this->addChild(result);
+}
+
+void TestPackFile::onExit()
+{
+    FileUtils *sharedFileUtils = FileUtils::getInstance();
+
+    // reset search path, which closes the pack file
+    sharedFileUtils->setSearchPaths(_defaultSearchPathArray);
+    FileUtilsDemo::onExit();
+}
+
+std::string TestPackFile::title() const
+{
+    return "FileUtils: pack file search path";
+}
+
+std::string TestPackFile::subtitle() const
+{
+    return "A sprite, a BMFont label and a text read from Misc/test.cpk";
+}
@@ -157,4 +157,31 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class TestMapFile : public FileUtilsDemo
+{
+public:
+    CREATE_FUNC(TestMapFile);
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    bool _fileMappingEnabled;
+};
+
+class TestPackFile : public FileUtilsDemo
+{
+public:
+    CREATE_FUNC(TestPackFile);
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+private:
+    std::vector<std::string> _defaultSearchPathArray;
+};
+
 #endif /* __FILEUTILSTEST_H__ */
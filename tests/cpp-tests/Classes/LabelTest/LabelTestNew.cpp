@@ -88,6 +88,7 @@ NewLabelTests::NewLabelTests()
     ADD_TEST_CASE(LabelIssue10688Test);
     ADD_TEST_CASE(LabelIssue13202Test);
     ADD_TEST_CASE(LabelIssue9500Test);
+    ADD_TEST_CASE(LabelTTFDiskCacheTest);
 };
 
 LabelFNTColorAndOpacity::LabelFNTColorAndOpacity()
@@ -2003,3 +2004,46 @@ std::string LabelIssue9500Test::subtitle() const
 {
     return "Spaces should not be lost if label created with Fingerpop.ttf";
 }
+
+LabelTTFDiskCacheTest::LabelTTFDiskCacheTest()
+{
+    auto center = VisibleRect::center();
+
+    // sizes not used by the other tests, so the atlases are created by this test
+    FontAtlasCache::setDiskCacheEnabled(true);
+
+    auto label = Label::createWithTTF("Letters cached on disk", "fonts/arial.ttf", 37);
+    label->setPosition(center.x, center.y + 40);
+    addChild(label);
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 37, GlyphCollection::DYNAMIC, nullptr, false, 2);
+    auto outlineLabel = Label::createWithTTF(ttfConfig, "Outlined letters cached on disk");
+    outlineLabel->setPosition(center.x, center.y - 40);
+    outlineLabel->setTextColor(Color4B::RED);
+    addChild(outlineLabel);
+
+    auto menuItem = MenuItemFont::create("Remove disk cache", [](Ref*){
+        FontAtlasCache::removeDiskCache();
+    });
+    menuItem->setPosition(center.x, VisibleRect::bottom().y + 60);
+
+    auto menu = Menu::create(menuItem, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    addChild(menu);
+}
+
+void LabelTTFDiskCacheTest::onExit()
+{
+    FontAtlasCache::setDiskCacheEnabled(false);
+    AtlasDemoNew::onExit();
+}
+
+std::string LabelTTFDiskCacheTest::title() const
+{
+    return "Label TTF disk cache";
+}
+
+std::string LabelTTFDiskCacheTest::subtitle() const
+{
+    return "The letters should look the same when they are loaded from the cache in the writable path";
+}
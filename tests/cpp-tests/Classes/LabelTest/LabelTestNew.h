@@ -635,4 +635,17 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class LabelTTFDiskCacheTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelTTFDiskCacheTest);
+
+    LabelTTFDiskCacheTest();
+
+    virtual void onExit() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 #endif
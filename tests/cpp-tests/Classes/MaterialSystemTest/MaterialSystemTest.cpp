@@ -482,22 +482,22 @@ void Material_invalidate::draw(cocos2d::Renderer *renderer, const cocos2d::Mat4
 {
     _customCommand.init(_globalZOrder, transform, flags);
     _customCommand.func = []() {
-        glDisable(GL_DEPTH_TEST);
+        GL::disable(GL_DEPTH_TEST);
         CHECK_GL_ERROR_DEBUG();
 
-        glDepthMask(false);
+        GL::depthMask(false);
         CHECK_GL_ERROR_DEBUG();
 
-        glEnable(GL_CULL_FACE);
+        GL::enable(GL_CULL_FACE);
         CHECK_GL_ERROR_DEBUG();
 
-        glCullFace((GLenum)GL_FRONT);
+        GL::cullFace((GLenum)GL_FRONT);
         CHECK_GL_ERROR_DEBUG();
 
-        glFrontFace((GLenum)GL_CW);
+        GL::frontFace((GLenum)GL_CW);
         CHECK_GL_ERROR_DEBUG();
 
-        glDisable(GL_BLEND);
+        GL::disable(GL_BLEND);
         CHECK_GL_ERROR_DEBUG();
 
         // a non-optimal way is to pass all bits, but that would be very inefficient
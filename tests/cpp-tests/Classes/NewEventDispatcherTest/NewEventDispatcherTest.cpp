@@ -8,6 +8,7 @@
 
 #include "NewEventDispatcherTest.h"
 #include "testResource.h"
+#include "ui/CocosGUI.h"
 
 USING_NS_CC;
 
@@ -31,6 +32,7 @@ EventDispatcherTests::EventDispatcherTests()
     ADD_TEST_CASE(RegisterAndUnregisterWhileEventHanldingTest);
     ADD_TEST_CASE(Issue8194);
     ADD_TEST_CASE(Issue9898)
+    ADD_TEST_CASE(TouchBoundsIndexTest);
 }
 
 std::string EventDispatcherTestDemo::title() const
@@ -1473,3 +1475,200 @@ std::string Issue9898::subtitle() const
 {
     return  "Should not crash if dispatch event after remove\n event listener in callback";
 }
+
+// TouchBoundsIndexTest
+
+static ui::Layout* createTouchBoundsWidget(int tag, const Color3B& color, const Vec2& position)
+{
+    auto widget = ui::Layout::create();
+    widget->setBackGroundColorType(ui::Layout::BackGroundColorType::SOLID);
+    widget->setBackGroundColor(color);
+    widget->setContentSize(Size(60, 40));
+    widget->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    widget->setPosition(position);
+    widget->setTouchEnabled(true);
+    widget->setTag(tag);
+    return widget;
+}
+
+TouchBoundsIndexTest::TouchBoundsIndexTest()
+: _nextChange(0)
+, _claimedTag(-1)
+, _checkedTouches(0)
+, _mismatches(0)
+, _touchBoundsIndexEnabled(false)
+{
+    auto origin = Director::getInstance()->getVisibleOrigin();
+    auto size = Director::getInstance()->getVisibleSize();
+
+    auto containerA = Node::create();
+    containerA->setPosition(origin + Vec2(size.width * 0.3f, size.height * 0.5f));
+    addChild(containerA);
+
+    auto containerB = Node::create();
+    containerB->setPosition(origin + Vec2(size.width * 0.7f, size.height * 0.5f));
+    addChild(containerB);
+
+    const Vec2 offsets[] = { Vec2(-40, -30), Vec2(40, -30), Vec2(-40, 30), Vec2(40, 30) };
+    for (int i = 0; i < 4; ++i)
+    {
+        containerA->addChild(createTouchBoundsWidget(1 + i, Color3B(200, 60 + i * 40, 60), offsets[i]));
+        containerB->addChild(createTouchBoundsWidget(5 + i, Color3B(60, 60 + i * 40, 200), offsets[i]));
+    }
+    // overlaps the four widgets of containerA, it claims the touches first while it is on top
+    containerA->addChild(createTouchBoundsWidget(9, Color3B(60, 200, 60), Vec2::ZERO), 1);
+
+    auto onTouch = [this](Ref* sender, ui::Widget::TouchEventType type) {
+        if (type == ui::Widget::TouchEventType::BEGAN)
+        {
+            _claimedTag = static_cast<Node*>(sender)->getTag();
+        }
+    };
+    for (auto container : { containerA, containerB })
+    {
+        for (auto child : container->getChildren())
+        {
+            static_cast<ui::Widget*>(child)->addTouchEventListener(onTouch);
+        }
+    }
+
+    // one change per frame, the touches are checked on the next frame once the change was visited
+    _changes.push_back([=]() {
+        auto widget = containerA->getChildByTag(1);
+        widget->setPosition(widget->getPosition() + Vec2(50, 0));
+    });
+    _changes.push_back([=]() {
+        containerA->getChildByTag(2)->setRotation(45);
+    });
+    _changes.push_back([=]() {
+        auto widget = containerA->getChildByTag(3);
+        widget->retain();
+        widget->removeFromParentAndCleanup(false);
+        containerB->addChild(widget);
+        widget->release();
+    });
+    _changes.push_back([=]() {
+        containerB->setPosition(containerB->getPosition() + Vec2(-60, 40));
+    });
+    _changes.push_back([=]() {
+        containerA->setScale(1.5f);
+    });
+    _changes.push_back([=]() {
+        containerB->getChildByTag(5)->removeFromParent();
+    });
+    _changes.push_back([=]() {
+        containerB->getChildByTag(6)->setContentSize(Size(100, 60));
+    });
+    _changes.push_back([=]() {
+        containerA->getChildByTag(9)->setLocalZOrder(-1);
+    });
+    _changes.push_back([=]() {
+        auto widget = createTouchBoundsWidget(10, Color3B(200, 200, 60), Vec2(0, 60));
+        widget->addTouchEventListener(onTouch);
+        containerB->addChild(widget);
+    });
+}
+
+void TouchBoundsIndexTest::onEnter()
+{
+    EventDispatcherTestDemo::onEnter();
+
+    _touchBoundsIndexEnabled = _eventDispatcher->isTouchBoundsIndexEnabled();
+    _eventDispatcher->setTouchBoundsIndexEnabled(true);
+    scheduleUpdate();
+}
+
+void TouchBoundsIndexTest::onExit()
+{
+    _eventDispatcher->setTouchBoundsIndexEnabled(_touchBoundsIndexEnabled);
+    EventDispatcherTestDemo::onExit();
+}
+
+int TouchBoundsIndexTest::dispatchTouch(const Vec2& location)
+{
+    // touches are in screen coordinates, getLocation() converts them back
+    Vec2 point = Director::getInstance()->convertToUI(location);
+    auto touch = new (std::nothrow) Touch();
+    touch->setTouchInfo(0, point.x, point.y);
+
+    EventTouch event;
+    std::vector<Touch*> touches(1, touch);
+    event.setTouches(touches);
+
+    _claimedTag = -1;
+    event.setEventCode(EventTouch::EventCode::BEGAN);
+    _eventDispatcher->dispatchEvent(&event);
+    int claimedTag = _claimedTag;
+
+    event.setEventCode(EventTouch::EventCode::CANCELLED);
+    _eventDispatcher->dispatchEvent(&event);
+
+    touch->release();
+    return claimedTag;
+}
+
+std::vector<int> TouchBoundsIndexTest::dispatchSampleTouches()
+{
+    auto origin = Director::getInstance()->getVisibleOrigin();
+    auto size = Director::getInstance()->getVisibleSize();
+    const int columns = 48;
+    const int rows = 32;
+
+    std::vector<int> claimedTags;
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            Vec2 location = origin + Vec2(size.width * (column + 0.5f) / columns, size.height * (row + 0.5f) / rows);
+            claimedTags.push_back(dispatchTouch(location));
+        }
+    }
+    return claimedTags;
+}
+
+void TouchBoundsIndexTest::checkSampleTouches()
+{
+    auto withIndex = dispatchSampleTouches();
+    _eventDispatcher->setTouchBoundsIndexEnabled(false);
+    auto withoutIndex = dispatchSampleTouches();
+    _eventDispatcher->setTouchBoundsIndexEnabled(true);
+    // builds the new index now, so that the next change has to update it
+    dispatchTouch(Director::getInstance()->getVisibleOrigin());
+
+    for (size_t i = 0; i < withIndex.size(); ++i)
+    {
+        if (withIndex[i] != withoutIndex[i])
+        {
+            CCLOG("TouchBoundsIndexTest: after change %d, touch %d is claimed by %d with the index and by %d without it",
+                  (int)_nextChange, (int)i, withIndex[i], withoutIndex[i]);
+            ++_mismatches;
+        }
+    }
+    _checkedTouches += (int)withIndex.size();
+}
+
+void TouchBoundsIndexTest::update(float dt)
+{
+    checkSampleTouches();
+
+    if (_nextChange < _changes.size())
+    {
+        _changes[_nextChange++]();
+        return;
+    }
+
+    unscheduleUpdate();
+    CCASSERT(_mismatches == 0, "The touch bounds index changed which widget claims a touch");
+    _subtitleLabel->setString(StringUtils::format("%d touches checked after %d changes, %d mismatches",
+                                                  _checkedTouches, (int)_changes.size(), _mismatches));
+}
+
+std::string TouchBoundsIndexTest::title() const
+{
+    return "Touch bounds index";
+}
+
+std::string TouchBoundsIndexTest::subtitle() const
+{
+    return "The same widgets should claim the touches\nwith and without the index";
+}
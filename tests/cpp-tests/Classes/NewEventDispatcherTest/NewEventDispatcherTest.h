@@ -244,4 +244,31 @@ private:
     cocos2d::EventListenerCustom* _listener;
 };
 
+class TouchBoundsIndexTest : public EventDispatcherTestDemo
+{
+public:
+    CREATE_FUNC(TouchBoundsIndexTest);
+    TouchBoundsIndexTest();
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    // the tag of the widget which claimed each sample touch, -1 if none did
+    std::vector<int> dispatchSampleTouches();
+    int dispatchTouch(const cocos2d::Vec2& location);
+    void checkSampleTouches();
+
+    std::vector<std::function<void()>> _changes;
+    size_t _nextChange;
+    int _claimedTag;
+    int _checkedTouches;
+    int _mismatches;
+    bool _touchBoundsIndexEnabled;
+};
+
 #endif /* defined(__samples__NewEventDispatcherTest__) */
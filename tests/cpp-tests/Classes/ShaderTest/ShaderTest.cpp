@@ -18,6 +18,7 @@ ShaderTests::ShaderTests()
     ADD_TEST_CASE(ShaderMonjori);
     ADD_TEST_CASE(ShaderGlow);
     ADD_TEST_CASE(ShaderMultiTexture);
+    ADD_TEST_CASE(ShaderSharedState);
 }
 
 ///---------------------------------------
@@ -755,3 +756,59 @@ void ShaderMultiTexture::changeTexture(Ref*)
     auto programState = _sprite->getGLProgramState();
     programState->setUniformTexture("u_texture1", right->getTexture());
 }
+
+///---------------------------------------
+//
+// ShaderSharedState
+//
+///---------------------------------------
+ShaderSharedState::ShaderSharedState()
+: _sameShared(false)
+, _differentShared(false)
+{
+}
+
+std::string ShaderSharedState::title() const
+{
+    return "GLProgramState::getShared()";
+}
+
+std::string ShaderSharedState::subtitle() const
+{
+    return StringUtils::format("Same values share a state: %s\nDifferent values share a state: %s",
+                               _sameShared ? "yes" : "NO (error)",
+                               _differentShared ? "YES (error)" : "no");
+}
+
+bool ShaderSharedState::init()
+{
+    if (ShaderTestDemo::init())
+    {
+        auto s = Director::getInstance()->getWinSize();
+        auto texture = Director::getInstance()->getTextureCache()->addImage("Images/grossinis_sister2.png");
+        auto glprogram = GLProgram::createWithFilenames("Shaders/example_MultiTexture.vsh", "Shaders/example_MultiTexture.fsh");
+
+        // left and center: new states with the same values, right: a different interpolation
+        const float interpolations[] = { 0.5f, 0.5f, 0.2f };
+        GLProgramState* states[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            auto glprogramstate = GLProgramState::create(glprogram);
+            glprogramstate->setUniformTexture("u_texture1", texture);
+            glprogramstate->setUniformFloat("u_interpolate", interpolations[i]);
+            states[i] = GLProgramState::getShared(glprogramstate);
+
+            auto sprite = Sprite::create("Images/grossinis_sister1.png");
+            sprite->setGLProgramState(states[i]);
+            sprite->setPosition(s.width * (i + 1) / 4, s.height / 2);
+            addChild(sprite);
+        }
+
+        _sameShared = (states[0] == states[1]);
+        _differentShared = (states[0] == states[2]);
+
+        return true;
+    }
+
+    return false;
+}
@@ -162,6 +162,21 @@ public:
     virtual bool init() override;
 };
 
+class ShaderSharedState : public ShaderTestDemo
+{
+public:
+    CREATE_FUNC(ShaderSharedState);
+    ShaderSharedState();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual bool init() override;
+
+protected:
+    bool _sameShared;
+    bool _differentShared;
+};
+
 class ShaderMultiTexture : public ShaderTestDemo
 {
     static const int rightSpriteTag = 2014;
@@ -119,6 +119,7 @@ SpriteTests::SpriteTests()
 	ADD_TEST_CASE(SpriteCullTest1);
 	ADD_TEST_CASE(SpriteCullTest2);
     ADD_TEST_CASE(Sprite3DRotationTest);
+    ADD_TEST_CASE(SpriteStaticBatchNode);
 };
 
 //------------------------------------------------------------------
@@ -5014,6 +5015,48 @@ Sprite3DRotationTest::Sprite3DRotationTest()
     }, "update_key");
 }
 
+//------------------------------------------------------------------
+//
+// SpriteStaticBatchNode
+//
+//------------------------------------------------------------------
+SpriteStaticBatchNode::SpriteStaticBatchNode()
+{
+    Size s = Director::getInstance()->getWinSize();
 
+    auto cache = SpriteFrameCache::getInstance();
+    cache->addSpriteFramesWithFile("animations/grossini.plist");
+
+    auto batch = StaticBatchNode::create("animations/grossini.png");
+    addChild(batch);
 
+    // nested nodes are baked too, with their transforms
+    char str[100] = {0};
+    for (int row = 0; row < 3; row++)
+    {
+        auto line = Node::create();
+        line->setPosition(0, s.height/4 * (row+1));
+        line->setRotation(row * 5.0f - 5.0f);
+        batch->addChild(line);
 
+        for (int i = 0; i < 8; i++)
+        {
+            sprintf(str, "grossini_dance_%02d.png", (row*8 + i) % 14 + 1);
+            auto sprite = Sprite::createWithSpriteFrameName(str);
+            sprite->setPosition(s.width/9 * (i+1), 0);
+            sprite->setScale(0.5f);
+            line->addChild(sprite);
+        }
+    }
+
+    auto blinking = Sprite::createWithSpriteFrameName("grossini_dance_01.png");
+    blinking->setPosition(s.width/2, s.height/2);
+    blinking->runAction(RepeatForever::create(Blink::create(2, 2)));
+    batch->addChild(blinking);
+}
+
+void SpriteStaticBatchNode::onExit()
+{
+    SpriteTestDemo::onExit();
+    SpriteFrameCache::getInstance()->removeSpriteFramesFromFile("animations/grossini.plist");
+}
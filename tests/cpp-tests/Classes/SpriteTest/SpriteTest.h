@@ -765,4 +765,14 @@ protected:
     cocos2d::Vec3 rotation;
 };
 
+class SpriteStaticBatchNode : public SpriteTestDemo
+{
+public:
+    CREATE_FUNC(SpriteStaticBatchNode);
+    SpriteStaticBatchNode();
+    virtual void onExit() override;
+    virtual std::string title() const override { return "StaticBatchNode"; };
+    virtual std::string subtitle() const override { return "1 GL call. Only the blinking sprite bakes the quads again"; };
+};
+
 #endif
@@ -107,6 +107,7 @@ Texture2DTests::Texture2DTests()
     ADD_TEST_CASE(TextureConvertRGBA8888);
     ADD_TEST_CASE(TextureConvertI8);
     ADD_TEST_CASE(TextureConvertAI88);
+    ADD_TEST_CASE(TextureLoadInBands);
 };
 
 //------------------------------------------------------------------
@@ -2291,3 +2292,39 @@ std::string TextureConvertAI88::subtitle() const
 {
     return "RGBA8888,RGB888,RGB565,A8,I8,AI88,RGBA4444,RGB5A1";
 }
+
+//------------------------------------------------------------------
+//
+// TextureLoadInBands
+//
+//------------------------------------------------------------------
+void TextureLoadInBands::onEnter()
+{
+    TextureDemo::onEnter();
+
+    auto s = Director::getInstance()->getWinSize();
+
+    const char* images[] = { "Images/background1.jpg", "Images/test_image.png", "Images/test_image_ai88.png" };
+    const int bandHeights[] = { 16, 7, 1 };
+    for (int i = 0; i < 3; ++i)
+    {
+        auto texture = new (std::nothrow) Texture2D();
+        if (texture && texture->initWithImageFileInBands(images[i], bandHeights[i], Texture2D::PixelFormat::AUTO))
+        {
+            auto sprite = Sprite::createWithTexture(texture);
+            sprite->setPosition(Vec2((i + 1) * s.width / 4, s.height / 2));
+            addChild(sprite);
+        }
+        CC_SAFE_RELEASE(texture);
+    }
+}
+
+std::string TextureLoadInBands::title() const
+{
+    return "Load in bands";
+}
+
+std::string TextureLoadInBands::subtitle() const
+{
+    return "JPEG, PNG RGBA and PNG AI88 decoded by rows";
+}
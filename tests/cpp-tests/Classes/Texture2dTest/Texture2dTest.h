@@ -640,4 +640,14 @@ public:
     virtual std::string subtitle() const override;
 };
 
+// decodes and uploads PNG and JPEG files a band of rows at a time
+class TextureLoadInBands : public TextureDemo
+{
+public:
+    CREATE_FUNC(TextureLoadInBands);
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 #endif // __TEXTURE2D_TEST_H__
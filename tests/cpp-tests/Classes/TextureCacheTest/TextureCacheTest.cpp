@@ -8,6 +8,7 @@ USING_NS_CC;
 TextureCacheTests::TextureCacheTests()
 {
     ADD_TEST_CASE(TextureCacheTest);
+    ADD_TEST_CASE(TextureCacheBudgetTest);
 }
 
 TextureCacheTest::TextureCacheTest()
@@ -130,3 +131,52 @@ void TextureCacheTest::addSprite()
     this->addChild(s14);
     this->addChild(s15);
 }
+
+TextureCacheBudgetTest::TextureCacheBudgetTest()
+: _nextImage(0)
+, _previousBudget(0)
+{
+    auto size = Director::getInstance()->getWinSize();
+
+    _labelMemory = Label::createWithTTF("", "fonts/arial.ttf", 15);
+    _labelMemory->setPosition(Vec2(size.width / 2, size.height / 2));
+    this->addChild(_labelMemory);
+
+    _images.push_back("Images/background1.png");
+    _images.push_back("Images/background2.png");
+    _images.push_back("Images/background3.png");
+    _images.push_back("Images/blocks.png");
+    _images.push_back("Images/HelloWorld.png");
+}
+
+void TextureCacheBudgetTest::onEnter()
+{
+    TestCase::onEnter();
+
+    auto cache = Director::getInstance()->getTextureCache();
+    _previousBudget = cache->getMemoryBudget();
+    // room for the textures of the test scene and two of the images
+    cache->setMemoryBudget(cache->getTotalTextureMemory() + 2 * 1024 * 1024);
+
+    schedule(CC_SCHEDULE_SELECTOR(TextureCacheBudgetTest::loadNextImage), 0.5f);
+}
+
+void TextureCacheBudgetTest::onExit()
+{
+    Director::getInstance()->getTextureCache()->setMemoryBudget(_previousBudget);
+
+    TestCase::onExit();
+}
+
+void TextureCacheBudgetTest::loadNextImage(float dt)
+{
+    auto cache = Director::getInstance()->getTextureCache();
+    // the evicted textures are loaded again
+    cache->addImage(_images[_nextImage]);
+    _nextImage = (_nextImage + 1) % _images.size();
+
+    _labelMemory->setString(StringUtils::format("%lu KB used, budget %lu KB\n%u textures evicted",
+                                                (unsigned long)cache->getTotalTextureMemory() / 1024,
+                                                (unsigned long)cache->getMemoryBudget() / 1024,
+                                                cache->getEvictedTextureCount()));
+}
@@ -25,4 +25,25 @@ private:
     int _numberOfLoadedSprites;
 };
 
+class TextureCacheBudgetTest : public TestCase
+{
+public:
+    CREATE_FUNC(TextureCacheBudgetTest);
+
+    TextureCacheBudgetTest();
+
+    virtual std::string title() const override { return "TextureCache memory budget"; }
+    virtual std::string subtitle() const override { return "Unused textures are evicted, least recently used first"; }
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+    // loads the next image without keeping its texture, and shows the memory used
+    void loadNextImage(float dt);
+private:
+    cocos2d::Label *_labelMemory;
+    std::vector<std::string> _images;
+    size_t _nextImage;
+    size_t _previousBudget;
+};
+
 #endif // _TEXTURECACHE_TEST_H_
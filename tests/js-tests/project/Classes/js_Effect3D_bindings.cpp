@@ -325,12 +325,12 @@ void Effect3DOutline::draw(const Mat4 &transform)
     _glProgramState->setUniformVec4("u_color", Vec4(color.r, color.g, color.b, color.a));
     if(_sprite && _sprite->getMesh())
     {
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_FRONT);
-        glEnable(GL_DEPTH_TEST);
+        GL::enable(GL_CULL_FACE);
+        GL::cullFace(GL_FRONT);
+        GL::enable(GL_DEPTH_TEST);
         
         auto mesh = _sprite->getMesh();
-        glBindBuffer(GL_ARRAY_BUFFER, mesh->getVertexBuffer());
+        GL::bindBuffer(GL_ARRAY_BUFFER, mesh->getVertexBuffer());
         
         auto skin = _sprite->getMesh()->getSkin();
         if(_sprite && skin)
@@ -343,15 +343,15 @@ void Effect3DOutline::draw(const Mat4 &transform)
         if(_sprite)
             _glProgramState->apply(transform);
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->getIndexBuffer());
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->getIndexBuffer());
         glDrawElements(mesh->getPrimitiveType(), (GLsizei)mesh->getIndexCount(), mesh->getIndexFormat(), 0);
         CC_INCREMENT_GL_DRAWN_BATCHES_AND_VERTICES(1, mesh->getIndexCount());
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glDisable(GL_DEPTH_TEST);
-        glCullFace(GL_BACK);
-        glDisable(GL_CULL_FACE);
+        GL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::bindBuffer(GL_ARRAY_BUFFER, 0);
+        GL::disable(GL_DEPTH_TEST);
+        GL::cullFace(GL_BACK);
+        GL::disable(GL_CULL_FACE);
     }
 }
 
@@ -4,6 +4,7 @@
 
 #include "PerformanceCallbackTest.h"
 #include "Profile.h"
+#include "base/utlist.h"
 #include <algorithm>
 
 USING_NS_CC;
@@ -40,6 +41,11 @@ PerformceCallbackTests::PerformceCallbackTests()
     ADD_TEST_CASE(SimulateNewSchedulerCallbackPerfTest);
     ADD_TEST_CASE(InvokeMemberFunctionPerfTest);
     ADD_TEST_CASE(InvokeStdFunctionPerfTest);
+    ADD_TEST_CASE(SchedulerUpdatePerfTest);
+    ADD_TEST_CASE(SchedulerUnscheduleUpdatePerfTest);
+    ADD_TEST_CASE(SchedulerLongIntervalTimersPerfTest);
+    ADD_TEST_CASE(SchedulerPerformFunctionPerfTest);
+    ADD_TEST_CASE(LinkedListSchedulerUpdatePerfTest);
 }
 
 ////////////////////////////////////////////////////////
@@ -183,3 +189,251 @@ void InvokeStdFunctionPerfTest::onUpdate(float dt)
     }
     CC_PROFILER_STOP(_profileName.c_str());
 }
+
+////////////////////////////////////////////////////////
+//
+// SchedulerUpdatePerfTest
+//
+////////////////////////////////////////////////////////
+
+SchedulerUpdatePerfTest::SchedulerUpdatePerfTest()
+: _testScheduler(new (std::nothrow) Scheduler())
+, _targets(LOOP_COUNT)
+{
+}
+
+SchedulerUpdatePerfTest::~SchedulerUpdatePerfTest()
+{
+    CC_SAFE_RELEASE(_testScheduler);
+}
+
+void SchedulerUpdatePerfTest::onEnter()
+{
+    PerformanceCallbackScene::onEnter();
+    _profileName = "Scheduler::update";
+
+    for (int i = 0; i < LOOP_COUNT; ++i)
+    {
+        // spread the targets over the three priority ranges
+        _testScheduler->scheduleUpdate(&_targets[i], i % 3 - 1, false);
+
+        if (i % 4 == 0)
+        {
+            _testScheduler->schedule([](float){}, &_targets[i], 0.0f, false, "timer");
+        }
+    }
+}
+
+std::string SchedulerUpdatePerfTest::title() const
+{
+    return "Scheduler::update perf test";
+}
+
+std::string SchedulerUpdatePerfTest::subtitle() const
+{
+    return "See console";
+}
+
+void SchedulerUpdatePerfTest::onUpdate(float dt)
+{
+    CC_PROFILER_START(_profileName.c_str());
+    _testScheduler->update(dt);
+    CC_PROFILER_STOP(_profileName.c_str());
+}
+
+////////////////////////////////////////////////////////
+//
+// SchedulerUnscheduleUpdatePerfTest
+//
+////////////////////////////////////////////////////////
+
+void SchedulerUnscheduleUpdatePerfTest::onEnter()
+{
+    SchedulerUpdatePerfTest::onEnter();
+    _profileName = "Scheduler::unscheduleUpdate";
+}
+
+std::string SchedulerUnscheduleUpdatePerfTest::title() const
+{
+    return "Scheduler unschedule perf test";
+}
+
+void SchedulerUnscheduleUpdatePerfTest::onUpdate(float dt)
+{
+    CC_PROFILER_START(_profileName.c_str());
+    for (int i = 0; i < LOOP_COUNT; ++i)
+    {
+        _testScheduler->unscheduleUpdate(&_targets[i]);
+    }
+    for (int i = 0; i < LOOP_COUNT; ++i)
+    {
+        _testScheduler->scheduleUpdate(&_targets[i], i % 3 - 1, false);
+    }
+    _testScheduler->update(dt);
+    CC_PROFILER_STOP(_profileName.c_str());
+}
+
+////////////////////////////////////////////////////////
+//
+// SchedulerLongIntervalTimersPerfTest
+//
+////////////////////////////////////////////////////////
+
+void SchedulerLongIntervalTimersPerfTest::onEnter()
+{
+    PerformanceCallbackScene::onEnter();
+    _profileName = "Scheduler::update long timers";
+
+    for (int i = 0; i < LOOP_COUNT; ++i)
+    {
+        auto target = &_targets[i];
+        // spread the due times so that a few timers fire in every frame
+        _testScheduler->schedule([target](float dt){ target->update(dt); }, target, 30.0f, CC_REPEAT_FOREVER, 30.0f * i / LOOP_COUNT, false, "cooldown");
+    }
+}
+
+std::string SchedulerLongIntervalTimersPerfTest::title() const
+{
+    return "Scheduler long interval timers perf test";
+}
+
+////////////////////////////////////////////////////////
+//
+// SchedulerPerformFunctionPerfTest
+//
+////////////////////////////////////////////////////////
+
+SchedulerPerformFunctionPerfTest::SchedulerPerformFunctionPerfTest()
+: _producing(false)
+, _performed(0)
+, _statsElapsed(0)
+{
+}
+
+void SchedulerPerformFunctionPerfTest::onEnter()
+{
+    PerformanceCallbackScene::onEnter();
+    _profileName = "Scheduler::update perform functions";
+
+    // bursts of queued functions are spread over the next frames by the budget
+    _testScheduler->setPerformFunctionBudget(LOOP_COUNT, 0.004f);
+
+    _producing = true;
+    for (int i = 0; i < 4; ++i)
+    {
+        _producers.emplace_back([this]() {
+            while (_producing)
+            {
+                for (int j = 0; j < 100; ++j)
+                {
+                    _testScheduler->performFunctionInCocosThread([this]() { ++_performed; });
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+}
+
+void SchedulerPerformFunctionPerfTest::onExit()
+{
+    _producing = false;
+    for (auto& producer : _producers)
+    {
+        producer.join();
+    }
+    _producers.clear();
+
+    SchedulerUpdatePerfTest::onExit();
+}
+
+std::string SchedulerPerformFunctionPerfTest::title() const
+{
+    return "Scheduler perform function perf test";
+}
+
+std::string SchedulerPerformFunctionPerfTest::subtitle() const
+{
+    return "4 threads queuing functions, see console for queue depth and latency";
+}
+
+void SchedulerPerformFunctionPerfTest::onUpdate(float dt)
+{
+    CC_PROFILER_START(_profileName.c_str());
+    _testScheduler->update(dt);
+    CC_PROFILER_STOP(_profileName.c_str());
+
+    _statsElapsed += dt;
+    if (_statsElapsed >= 1.0f)
+    {
+        auto stats = _testScheduler->getPerformFunctionStats();
+        CCLOG("performed %d functions/s, last frame: %u performed, %u queued, latency avg %.2f ms max %.2f ms",
+              _performed, stats.performed, stats.queueDepth, stats.averageLatency * 1000, stats.maxLatency * 1000);
+        _performed = 0;
+        _statsElapsed = 0;
+    }
+}
+
+////////////////////////////////////////////////////////
+//
+// LinkedListSchedulerUpdatePerfTest
+//
+////////////////////////////////////////////////////////
+
+LinkedListSchedulerUpdatePerfTest::LinkedListSchedulerUpdatePerfTest()
+: _updates0List(nullptr)
+, _targets(LOOP_COUNT)
+{
+}
+
+LinkedListSchedulerUpdatePerfTest::~LinkedListSchedulerUpdatePerfTest()
+{
+    ListEntry *entry, *tmp;
+    DL_FOREACH_SAFE(_updates0List, entry, tmp)
+    {
+        DL_DELETE(_updates0List, entry);
+        delete entry;
+    }
+}
+
+void LinkedListSchedulerUpdatePerfTest::onEnter()
+{
+    PerformanceCallbackScene::onEnter();
+    _profileName = "LinkedListScheduler::update";
+
+    for (int i = 0; i < LOOP_COUNT; ++i)
+    {
+        auto target = &_targets[i];
+
+        ListEntry *listElement = new ListEntry();
+        listElement->callback = [target](float dt) { target->update(dt); };
+        listElement->target = target;
+        listElement->priority = 0;
+        listElement->paused = false;
+        listElement->markedForDeletion = false;
+        DL_APPEND(_updates0List, listElement);
+    }
+}
+
+std::string LinkedListSchedulerUpdatePerfTest::title() const
+{
+    return "Linked list scheduler perf test";
+}
+
+std::string LinkedListSchedulerUpdatePerfTest::subtitle() const
+{
+    return "Update lists of the previous scheduler, see console";
+}
+
+void LinkedListSchedulerUpdatePerfTest::onUpdate(float dt)
+{
+    CC_PROFILER_START(_profileName.c_str());
+    ListEntry *entry, *tmp;
+    DL_FOREACH_SAFE(_updates0List, entry, tmp)
+    {
+        if ((! entry->paused) && (! entry->markedForDeletion))
+        {
+            entry->callback(dt);
+        }
+    }
+    CC_PROFILER_STOP(_profileName.c_str());
+}
@@ -6,6 +6,9 @@
 
 #include "BaseTest.h"
 
+#include <atomic>
+#include <thread>
+
 DEFINE_TEST_SUITE(PerformceCallbackTests);
 
 class PerformanceCallbackScene : public TestCase
@@ -90,4 +93,110 @@ private:
     std::function<void(float)> _callback;
 };
 
+// Target used by the scheduler tests, counts its callbacks
+class SchedulerPerfTarget
+{
+public:
+    SchedulerPerfTarget() : _calls(0) {}
+    void update(float dt) { ++_calls; }
+    int getCalls() const { return _calls; }
+private:
+    int _calls;
+};
+
+// SchedulerUpdatePerfTest
+// LOOP_COUNT update callbacks and LOOP_COUNT / 4 timers ticked by a private Scheduler
+class SchedulerUpdatePerfTest : public PerformanceCallbackScene
+{
+public:
+    CREATE_FUNC(SchedulerUpdatePerfTest);
+
+    SchedulerUpdatePerfTest();
+    virtual ~SchedulerUpdatePerfTest();
+
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onUpdate(float dt) override;
+
+protected:
+    cocos2d::Scheduler* _testScheduler;
+    std::vector<SchedulerPerfTarget> _targets;
+};
+
+// SchedulerUnscheduleUpdatePerfTest
+// unschedules and schedules again LOOP_COUNT update callbacks every frame
+class SchedulerUnscheduleUpdatePerfTest : public SchedulerUpdatePerfTest
+{
+public:
+    CREATE_FUNC(SchedulerUnscheduleUpdatePerfTest);
+
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual void onUpdate(float dt) override;
+};
+
+// SchedulerLongIntervalTimersPerfTest
+// LOOP_COUNT timers firing every 30 seconds, they are kept in the timing wheel of the Scheduler
+class SchedulerLongIntervalTimersPerfTest : public SchedulerUpdatePerfTest
+{
+public:
+    CREATE_FUNC(SchedulerLongIntervalTimersPerfTest);
+
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+};
+
+// SchedulerPerformFunctionPerfTest
+// worker threads keep queuing functions with performFunctionInCocosThread, performed within a per frame budget
+class SchedulerPerformFunctionPerfTest : public SchedulerUpdatePerfTest
+{
+public:
+    CREATE_FUNC(SchedulerPerformFunctionPerfTest);
+
+    SchedulerPerformFunctionPerfTest();
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onUpdate(float dt) override;
+
+private:
+    std::vector<std::thread> _producers;
+    std::atomic<bool> _producing;
+    int _performed;
+    float _statsElapsed;
+};
+
+// LinkedListSchedulerUpdatePerfTest
+// the update lists of the 3.8 scheduler, one heap allocated entry per target, for comparison
+class LinkedListSchedulerUpdatePerfTest : public PerformanceCallbackScene
+{
+public:
+    CREATE_FUNC(LinkedListSchedulerUpdatePerfTest);
+
+    LinkedListSchedulerUpdatePerfTest();
+    virtual ~LinkedListSchedulerUpdatePerfTest();
+
+    virtual void onEnter() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onUpdate(float dt) override;
+
+    struct ListEntry
+    {
+        ListEntry *prev, *next;
+        cocos2d::ccSchedulerFunc callback;
+        void *target;
+        int priority;
+        bool paused;
+        bool markedForDeletion;
+    };
+
+private:
+    ListEntry* _updates0List;
+    std::vector<SchedulerPerfTarget> _targets;
+};
+
 #endif /* __PERFORMANCE_CALLBACK_TEST_H__ */
@@ -260,6 +260,8 @@ void PerformanceEventDispatcherScene::reset()
         Director::getInstance()->getEventDispatcher()->removeEventListener(listener);
     }
     
+    Director::getInstance()->getEventDispatcher()->setTouchBoundsIndexEnabled(false);
+    
     this->_lastRenderedCount = 0;
 }
 
@@ -407,6 +409,118 @@ void TouchEventDispatchingPerfTest::generateTestFunctions()
             CC_PROFILER_STOP(this->profilerName());
         } } ,
         
+        { "OneByOne-scenegraph-bounds-index",    [=](){
+            auto dispatcher = Director::getInstance()->getEventDispatcher();
+            Size size = Director::getInstance()->getWinSize();
+            if (quantityOfNodes != _lastRenderedCount)
+            {
+                // hit test like ui::Widget does, the index only skips the listeners
+                auto listener = EventListenerTouchOneByOne::create();
+                listener->setHitAreaBoundedByNode(true);
+                listener->onTouchBegan = [](Touch* touch, Event* event){
+                    auto target = event->getCurrentTarget();
+                    auto point = target->convertToNodeSpace(touch->getLocation());
+                    Rect rect(Vec2::ZERO, target->getContentSize());
+                    return rect.containsPoint(point);
+                };
+                
+                listener->onTouchMoved = [](Touch* touch, Event* event){};
+                listener->onTouchEnded = [](Touch* touch, Event* event){};
+                
+                dispatcher->setTouchBoundsIndexEnabled(true);
+                
+                // Create new touchable nodes spread over the screen
+                for (int i = 0; i < this->quantityOfNodes; ++i)
+                {
+                    auto node = Node::create();
+                    node->setTag(1000 + i);
+                    node->setContentSize(Size(40, 40));
+                    node->setPosition(rand() % (int)size.width, rand() % (int)size.height);
+                    this->addChild(node);
+                    this->_nodes.push_back(node);
+                    dispatcher->addEventListenerWithSceneGraphPriority(listener->clone(), node);
+                }
+                
+                _lastRenderedCount = quantityOfNodes;
+            }
+            
+            EventTouch touchEvent;
+            touchEvent.setEventCode(EventTouch::EventCode::BEGAN);
+            std::vector<Touch*> touches;
+            
+            for (int i = 0; i < 4; ++i)
+            {
+                Touch* touch = new (std::nothrow) Touch();
+                touch->autorelease();
+                touch->setTouchInfo(i, rand() % (int)size.width, rand() % (int)size.height);
+                touches.push_back(touch);
+            }
+            touchEvent.setTouches(touches);
+            
+            CC_PROFILER_START(this->profilerName());
+            dispatcher->dispatchEvent(&touchEvent);
+            CC_PROFILER_STOP(this->profilerName());
+            
+            // release the claimed touches, they would pile up otherwise
+            touchEvent.setEventCode(EventTouch::EventCode::ENDED);
+            dispatcher->dispatchEvent(&touchEvent);
+        } } ,
+        
+        { "OneByOne-scenegraph-churn",    [=](){
+            auto dispatcher = Director::getInstance()->getEventDispatcher();
+            auto createCell = [=](){
+                auto listener = EventListenerTouchOneByOne::create();
+                listener->onTouchBegan = [](Touch* touch, Event* event){
+                    return false;
+                };
+                listener->onTouchMoved = [](Touch* touch, Event* event){};
+                listener->onTouchEnded = [](Touch* touch, Event* event){};
+                
+                auto node = Node::create();
+                node->setLocalZOrder(rand() % 10);
+                this->addChild(node);
+                this->_nodes.push_back(node);
+                dispatcher->addEventListenerWithSceneGraphPriority(listener, node);
+            };
+            
+            if (quantityOfNodes != _lastRenderedCount)
+            {
+                for (int i = 0; i < this->quantityOfNodes; ++i)
+                {
+                    createCell();
+                }
+                
+                _lastRenderedCount = quantityOfNodes;
+            }
+            
+            // like a list view recycling its cells, some nodes leave and enter the scene every frame
+            for (int i = 0; i < 10 && !_nodes.empty(); ++i)
+            {
+                auto index = rand() % _nodes.size();
+                _nodes[index]->removeFromParent();
+                _nodes[index] = _nodes.back();
+                _nodes.pop_back();
+                createCell();
+            }
+            
+            EventTouch touchEvent;
+            touchEvent.setEventCode(EventTouch::EventCode::BEGAN);
+            std::vector<Touch*> touches;
+            
+            for (int i = 0; i < 4; ++i)
+            {
+                Touch* touch = new (std::nothrow) Touch();
+                touch->autorelease();
+                touch->setTouchInfo(i, rand() % 200, rand() % 200);
+                touches.push_back(touch);
+            }
+            touchEvent.setTouches(touches);
+            
+            CC_PROFILER_START(this->profilerName());
+            dispatcher->dispatchEvent(&touchEvent);
+            CC_PROFILER_STOP(this->profilerName());
+        } } ,
+        
         { "OneByOne-fixed",    [=](){
             auto dispatcher = Director::getInstance()->getEventDispatcher();
             if (quantityOfNodes != _lastRenderedCount)
@@ -814,6 +928,25 @@ void CustomEventDispatchingPerfTest::generateTestFunctions()
             dispatcher->dispatchEvent(&event);
             CC_PROFILER_STOP(this->profilerName());
         } } ,
+        { "custom-fixed-interned",    [=](){
+            auto dispatcher = Director::getInstance()->getEventDispatcher();
+            static const EventCustom::ID eventID = EventCustom::internEventName("custom_event_test_interned");
+            if (quantityOfNodes != _lastRenderedCount)
+            {
+                for (int i = 0; i < this->quantityOfNodes; ++i)
+                {
+                    auto l = EventListenerCustom::create("custom_event_test_interned", [](EventCustom* event){});
+                    this->_fixedPriorityListeners.push_back(l);
+                    dispatcher->addEventListenerWithFixedPriority(l, i+1);
+                }
+                
+                _lastRenderedCount = quantityOfNodes;
+            }
+            
+            CC_PROFILER_START(this->profilerName());
+            dispatcher->dispatchCustomEvent(eventID);
+            CC_PROFILER_STOP(this->profilerName());
+        } } ,
     };
     
     for (const auto& func : testFunctions)
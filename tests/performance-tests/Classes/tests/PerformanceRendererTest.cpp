@@ -0,0 +1,245 @@
+#include "PerformanceRendererTest.h"
+#include "Profile.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+// Enable profiles for this file
+#undef CC_PROFILER_DISPLAY_TIMERS
+#define CC_PROFILER_DISPLAY_TIMERS() Profiler::getInstance()->displayTimers()
+#undef CC_PROFILER_PURGE_ALL
+#define CC_PROFILER_PURGE_ALL() Profiler::getInstance()->releaseAllTimers()
+
+#undef CC_PROFILER_START
+#define CC_PROFILER_START(__name__) ProfilingBeginTimingBlock(__name__)
+#undef CC_PROFILER_STOP
+#define CC_PROFILER_STOP(__name__) ProfilingEndTimingBlock(__name__)
+#undef CC_PROFILER_RESET
+#define CC_PROFILER_RESET(__name__) ProfilingResetTimingBlock(__name__)
+
+#undef CC_PROFILER_START_CATEGORY
+#define CC_PROFILER_START_CATEGORY(__cat__, __name__) do{ if(__cat__) ProfilingBeginTimingBlock(__name__); } while(0)
+#undef CC_PROFILER_STOP_CATEGORY
+#define CC_PROFILER_STOP_CATEGORY(__cat__, __name__) do{ if(__cat__) ProfilingEndTimingBlock(__name__); } while(0)
+#undef CC_PROFILER_RESET_CATEGORY
+#define CC_PROFILER_RESET_CATEGORY(__cat__, __name__) do{ if(__cat__) ProfilingResetTimingBlock(__name__); } while(0)
+
+#undef CC_PROFILER_START_INSTANCE
+#define CC_PROFILER_START_INSTANCE(__id__, __name__) do{ ProfilingBeginTimingBlock( String::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
+#undef CC_PROFILER_STOP_INSTANCE
+#define CC_PROFILER_STOP_INSTANCE(__id__, __name__) do{ ProfilingEndTimingBlock(    String::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
+#undef CC_PROFILER_RESET_INSTANCE
+#define CC_PROFILER_RESET_INSTANCE(__id__, __name__) do{ ProfilingResetTimingBlock( String::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
+
+static const int K_INFO_QUANTITY_TAG = 1582;
+
+static int autoTestQuantities[] = {
+    10000, 20000, 40000
+};
+
+PerformceRendererTests::PerformceRendererTests()
+{
+    ADD_TEST_CASE(RenderQueueSortPerfTest);
+    ADD_TEST_CASE(RenderQueueRadixSortPerfTest);
+}
+
+void PerformanceRendererLayer::onEnter()
+{
+    TestCase::onEnter();
+    
+    CC_PROFILER_PURGE_ALL();
+    
+    if (isAutoTesting()) {
+        autoTestIndex = 0;
+        _quantity = autoTestQuantities[autoTestIndex];
+        Profile::getInstance()->testCaseBegin("RendererTest",
+                                              genStrVector("Type", "Quantity", nullptr),
+                                              genStrVector("Avg", "Min", "Max", nullptr));
+    }
+    
+    auto s = Director::getInstance()->getWinSize();
+    
+    MenuItemFont::setFontSize(65);
+    auto decrease = MenuItemFont::create(" - ", CC_CALLBACK_1(PerformanceRendererLayer::subQuantity, this));
+    decrease->setColor(Color3B(0,200,20));
+    auto increase = MenuItemFont::create(" + ", CC_CALLBACK_1(PerformanceRendererLayer::addQuantity, this));
+    increase->setColor(Color3B(0,200,20));
+    
+    auto menu = Menu::create(decrease, increase, nullptr);
+    menu->alignItemsHorizontally();
+    menu->setPosition(Vec2(s.width/2, s.height/2));
+    addChild(menu, 1);
+    
+    auto infoLabel = Label::createWithTTF("0", "fonts/Marker Felt.ttf", 30);
+    infoLabel->setColor(Color3B(0,200,20));
+    infoLabel->setPosition(Vec2(s.width/2, s.height/2 + 40));
+    addChild(infoLabel, 1, K_INFO_QUANTITY_TAG);
+    updateQuantityLabel();
+    generateCommands();
+    
+    getScheduler()->schedule(CC_SCHEDULE_SELECTOR(PerformanceRendererLayer::doPerformanceTest), this, 0.0f, false);
+    getScheduler()->schedule(CC_SCHEDULE_SELECTOR(PerformanceRendererLayer::dumpProfilerInfo), this, 2, false);
+}
+
+void PerformanceRendererLayer::onExit()
+{
+    for (auto command : _commands)
+    {
+        delete command;
+    }
+    _commands.clear();
+    
+    TestCase::onExit();
+}
+
+void PerformanceRendererLayer::generateCommands()
+{
+    for (auto command : _commands)
+    {
+        delete command;
+    }
+    _commands.clear();
+    _commands.reserve(_quantity);
+    
+    // few distinct values, so that there are a lot of commands with the same global Z order
+    for (int i = 0; i < _quantity; ++i)
+    {
+        auto command = new (std::nothrow) CustomCommand();
+        float globalZ = (float)random(-64, 64);
+        if (globalZ == 0)
+        {
+            globalZ = 1;
+        }
+        command->init(globalZ);
+        _commands.push_back(command);
+    }
+}
+
+void PerformanceRendererLayer::addQuantity(Ref *sender)
+{
+    _quantity += _stepCount;
+    CC_PROFILER_PURGE_ALL();
+    updateQuantityLabel();
+    generateCommands();
+}
+
+void PerformanceRendererLayer::subQuantity(Ref *sender)
+{
+    _quantity -= _stepCount;
+    _quantity = std::max(_quantity, 0);
+    CC_PROFILER_PURGE_ALL();
+    updateQuantityLabel();
+    generateCommands();
+}
+
+void PerformanceRendererLayer::updateQuantityLabel()
+{
+    auto infoLabel = (Label *) getChildByTag(K_INFO_QUANTITY_TAG);
+    char str[16] = {0};
+    sprintf(str, "%u", _quantity);
+    infoLabel->setString(str);
+}
+
+void PerformanceRendererLayer::dumpProfilerInfo(float dt)
+{
+    CC_PROFILER_DISPLAY_TIMERS();
+    
+    if (this->isAutoTesting()) {
+        // record the test result to class Profile
+        auto timer = Profiler::getInstance()->_activeTimers.at(_profileName);
+        auto numStr = genStr("%d", _quantity);
+        auto avgStr = genStr("%ldµ", timer->_averageTime2);
+        auto minStr = genStr("%ldµ", timer->minTime);
+        auto maxStr = genStr("%ldµ", timer->maxTime);
+        Profile::getInstance()->addTestResult(genStrVector(_profileName.c_str(), numStr.c_str(), nullptr),
+                                              genStrVector(avgStr.c_str(), minStr.c_str(), maxStr.c_str(), nullptr));
+        
+        auto testsSize = sizeof(autoTestQuantities)/sizeof(int);
+        if (autoTestIndex >= (testsSize - 1)) {
+            this->setAutoTesting(false);
+            Profile::getInstance()->testCaseEnd();
+        }
+        else
+        {
+            // update the auto test index
+            autoTestIndex++;
+            _quantity = autoTestQuantities[autoTestIndex];
+            updateQuantityLabel();
+            generateCommands();
+            CC_PROFILER_PURGE_ALL();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////
+//
+// RenderQueueSortPerfTest
+//
+////////////////////////////////////////////////////////
+
+void RenderQueueSortPerfTest::doPerformanceTest(float dt)
+{
+    _queue.clear();
+    for (auto command : _commands)
+    {
+        _queue.push_back(command);
+    }
+    
+    CC_PROFILER_START(_profileName.c_str());
+    _queue.sort();
+    CC_PROFILER_STOP(_profileName.c_str());
+}
+
+////////////////////////////////////////////////////////
+//
+// RenderQueueRadixSortPerfTest
+//
+////////////////////////////////////////////////////////
+
+void RenderQueueRadixSortPerfTest::onEnter()
+{
+    PerformanceRendererLayer::onEnter();
+    
+    // the radix sort should give the same order as a stable comparison sort
+    RenderQueue queue;
+    std::vector<RenderCommand*> expected;
+    for (auto command : _commands)
+    {
+        queue.push_back(command);
+        if (command->getGlobalOrder() < 0)
+        {
+            expected.push_back(command);
+        }
+    }
+    for (auto command : _commands)
+    {
+        if (command->getGlobalOrder() > 0)
+        {
+            expected.push_back(command);
+        }
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](RenderCommand* a, RenderCommand* b){
+        return a->getGlobalOrder() < b->getGlobalOrder();
+    });
+    
+    queue.radixSort();
+    
+    auto& negQueue = queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_NEG);
+    auto& posQueue = queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_POS);
+    bool sameOrder = std::equal(negQueue.begin(), negQueue.end(), expected.begin())
+        && std::equal(posQueue.begin(), posQueue.end(), expected.begin() + negQueue.size());
+    CCLOG("RenderQueue::radixSort order check: %s", sameOrder ? "passed" : "FAILED");
+}
+
+void RenderQueueRadixSortPerfTest::doPerformanceTest(float dt)
+{
+    _queue.clear();
+    for (auto command : _commands)
+    {
+        _queue.push_back(command);
+    }
+    
+    CC_PROFILER_START(_profileName.c_str());
+    _queue.radixSort();
+    CC_PROFILER_STOP(_profileName.c_str());
+}
@@ -0,0 +1,81 @@
+#ifndef __PERFORMANCE_RENDERER_TEST_H__
+#define __PERFORMANCE_RENDERER_TEST_H__
+
+#include "BaseTest.h"
+
+DEFINE_TEST_SUITE(PerformceRendererTests);
+
+/**
+ * The renderer tests only measure the CPU side of the renderer,
+ * no GL call is issued inside the profiled blocks.
+ */
+class PerformanceRendererLayer : public TestCase
+{
+public:
+    PerformanceRendererLayer()
+    : _quantity(20000)
+    , _stepCount(5000)
+    , _profileName("")
+    {
+
+    }
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+    virtual std::string title() const override{ return "Renderer Performance Test"; }
+    virtual std::string subtitle() const override{ return "PerformanceRendererLayer subTitle"; }
+
+    void addQuantity(cocos2d::Ref* sender);
+    void subQuantity(cocos2d::Ref* sender);
+protected:
+    virtual void doPerformanceTest(float dt) {};
+
+    void dumpProfilerInfo(float dt);
+    void updateQuantityLabel();
+
+    // creates _quantity commands with random global Z orders
+    void generateCommands();
+
+protected:
+    int autoTestIndex;
+    int _quantity;
+    int _stepCount;
+    std::string _profileName;
+    std::vector<cocos2d::CustomCommand*> _commands;
+    // reused between frames, like the renderer does
+    cocos2d::RenderQueue _queue;
+};
+
+class RenderQueueSortPerfTest : public PerformanceRendererLayer
+{
+public:
+    CREATE_FUNC(RenderQueueSortPerfTest);
+
+    RenderQueueSortPerfTest()
+    {
+        _profileName = "RenderQueue::sort";
+    }
+
+    virtual void doPerformanceTest(float dt) override;
+
+    virtual std::string subtitle() const override{ return "RenderQueue std::sort"; }
+};
+
+class RenderQueueRadixSortPerfTest : public PerformanceRendererLayer
+{
+public:
+    CREATE_FUNC(RenderQueueRadixSortPerfTest);
+
+    RenderQueueRadixSortPerfTest()
+    {
+        _profileName = "RenderQueue::radixSort";
+    }
+
+    virtual void onEnter() override;
+    virtual void doPerformanceTest(float dt) override;
+
+    virtual std::string subtitle() const override{ return "RenderQueue radix sort, see console for order check"; }
+};
+
+#endif //__PERFORMANCE_RENDERER_TEST_H__
@@ -6,6 +6,8 @@ USING_NS_CC;
 PerformceTextureTests::PerformceTextureTests()
 {
     ADD_TEST_CASE(TexturePerformceTest);
+    ADD_TEST_CASE(TextureAsyncDecodePerfTest);
+    ADD_TEST_CASE(TexturePixelConversionPerfTest);
 }
 
 static float calculateDeltaTime( struct timeval *lastUpdate )
@@ -332,3 +334,231 @@ std::string TexturePerformceTest::subtitle() const
 {
     return "See console for results";
 }
+
+////////////////////////////////////////////////////////
+//
+// TextureAsyncDecodePerfTest
+//
+////////////////////////////////////////////////////////
+TextureAsyncDecodePerfTest::TextureAsyncDecodePerfTest()
+: _workerCount(1)
+, _loadedCount(0)
+, _decodedBytes(0)
+{
+    _images.push_back("Images/test_image.png");
+    _images.push_back("Images/texture512x512.png");
+    _images.push_back("Images/texture1024x1024.png");
+    _images.push_back("Images/PlanetCute-1024x1024.png");
+    _images.push_back("Images/landscape-1024x1024.png");
+    for (int i = 1; i <= 14; ++i)
+    {
+        _images.push_back(StringUtils::format("Images/grossini_dance_%02d.png", i));
+    }
+}
+
+void TextureAsyncDecodePerfTest::onEnter()
+{
+    TestCase::onEnter();
+
+    _workerCount = 1;
+    startRun();
+}
+
+void TextureAsyncDecodePerfTest::onExit()
+{
+    auto cache = Director::getInstance()->getTextureCache();
+    cache->unbindAllImageAsync();
+    cache->setAsyncDecodeWorkerCount(0);
+
+    TestCase::onExit();
+}
+
+void TextureAsyncDecodePerfTest::startRun()
+{
+    auto cache = Director::getInstance()->getTextureCache();
+    // decode every image again
+    for (const auto& image : _images)
+    {
+        cache->removeTextureForKey(image);
+    }
+
+    _loadedCount = 0;
+    _decodedBytes = 0;
+    cache->setAsyncDecodeWorkerCount(_workerCount);
+    _runStart = std::chrono::steady_clock::now();
+    for (const auto& image : _images)
+    {
+        cache->addImageAsync(image, CC_CALLBACK_1(TextureAsyncDecodePerfTest::imageLoaded, this));
+    }
+}
+
+void TextureAsyncDecodePerfTest::imageLoaded(Texture2D* texture)
+{
+    if (texture)
+    {
+        _decodedBytes += texture->getPixelsWide() * texture->getPixelsHigh() * texture->getBitsPerPixelForFormat() / 8;
+    }
+
+    if (++_loadedCount < (int)_images.size())
+        return;
+
+    // the textures are created once per frame, so this includes up to one frame of latency
+    float seconds = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - _runStart).count();
+    log("%d decode workers: %d images in %.3f s, %.1f images/s, %.1f MB/s",
+        _workerCount, _loadedCount, seconds, _loadedCount / seconds, _decodedBytes / (1024.0f * 1024.0f) / seconds);
+
+    if (_workerCount < JobSystem::getInstance()->getWorkerCount())
+    {
+        ++_workerCount;
+        // start the next run outside the callback of the texture cache
+        scheduleOnce([this](float) { startRun(); }, 0, "nextRun");
+    }
+}
+
+std::string TextureAsyncDecodePerfTest::title() const
+{
+    return "Texture Async Decode Perf Test";
+}
+
+std::string TextureAsyncDecodePerfTest::subtitle() const
+{
+    return "Decode throughput by worker count, see console";
+}
+
+////////////////////////////////////////////////////////
+//
+// TexturePixelConversionPerfTest
+//
+////////////////////////////////////////////////////////
+namespace
+{
+    typedef void (*PixelConversionFunc)(const unsigned char* data, ssize_t dataLen, unsigned char* outData);
+
+    struct PixelConversionCase
+    {
+        const char* name;
+        int srcBytes;
+        int dstBytes;
+        PixelConversionFunc func;
+    };
+
+#define PIXEL_CONVERSION_CASE(src, dst, srcBytes, dstBytes) \
+    { #src " -> " #dst, srcBytes, dstBytes, &PixelConversion::convert##src##To##dst }
+
+    const PixelConversionCase s_pixelConversionCases[] = {
+        PIXEL_CONVERSION_CASE(I8, RGB888, 1, 3),
+        PIXEL_CONVERSION_CASE(I8, RGBA8888, 1, 4),
+        PIXEL_CONVERSION_CASE(I8, RGB565, 1, 2),
+        PIXEL_CONVERSION_CASE(I8, RGBA4444, 1, 2),
+        PIXEL_CONVERSION_CASE(I8, RGB5A1, 1, 2),
+        PIXEL_CONVERSION_CASE(I8, AI88, 1, 2),
+        PIXEL_CONVERSION_CASE(AI88, RGB888, 2, 3),
+        PIXEL_CONVERSION_CASE(AI88, RGBA8888, 2, 4),
+        PIXEL_CONVERSION_CASE(AI88, RGB565, 2, 2),
+        PIXEL_CONVERSION_CASE(AI88, RGBA4444, 2, 2),
+        PIXEL_CONVERSION_CASE(AI88, RGB5A1, 2, 2),
+        PIXEL_CONVERSION_CASE(AI88, A8, 2, 1),
+        PIXEL_CONVERSION_CASE(AI88, I8, 2, 1),
+        PIXEL_CONVERSION_CASE(RGB888, RGBA8888, 3, 4),
+        PIXEL_CONVERSION_CASE(RGB888, RGB565, 3, 2),
+        PIXEL_CONVERSION_CASE(RGB888, I8, 3, 1),
+        PIXEL_CONVERSION_CASE(RGB888, AI88, 3, 2),
+        PIXEL_CONVERSION_CASE(RGB888, RGBA4444, 3, 2),
+        PIXEL_CONVERSION_CASE(RGB888, RGB5A1, 3, 2),
+        PIXEL_CONVERSION_CASE(RGBA8888, RGB888, 4, 3),
+        PIXEL_CONVERSION_CASE(RGBA8888, RGB565, 4, 2),
+        PIXEL_CONVERSION_CASE(RGBA8888, I8, 4, 1),
+        PIXEL_CONVERSION_CASE(RGBA8888, A8, 4, 1),
+        PIXEL_CONVERSION_CASE(RGBA8888, AI88, 4, 2),
+        PIXEL_CONVERSION_CASE(RGBA8888, RGBA4444, 4, 2),
+        PIXEL_CONVERSION_CASE(RGBA8888, RGB5A1, 4, 2),
+    };
+
+#undef PIXEL_CONVERSION_CASE
+
+    // the best of a few runs, in milliseconds
+    template <typename Func>
+    float measureMilliseconds(const Func& func)
+    {
+        float best = FLT_MAX;
+        for (int run = 0; run < 5; ++run)
+        {
+            auto start = std::chrono::steady_clock::now();
+            func();
+            float ms = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(std::chrono::steady_clock::now() - start).count();
+            best = std::min(best, ms);
+        }
+        return best;
+    }
+}
+
+void TexturePixelConversionPerfTest::onEnter()
+{
+    TestCase::onEnter();
+
+    performTests();
+}
+
+void TexturePixelConversionPerfTest::performTests()
+{
+    // 1024x1024 pixels, and a few more to run the scalar tails too
+    const ssize_t pixelCount = 1024 * 1024 + 7;
+
+    std::vector<unsigned char> src(pixelCount * 4);
+    for (auto& byte : src)
+    {
+        byte = (unsigned char)(rand() & 0xFF);
+    }
+    std::vector<unsigned char> scalarOut(pixelCount * 4);
+    std::vector<unsigned char> simdOut(pixelCount * 4);
+
+    bool wasEnabled = PixelConversion::isSIMDEnabled();
+    log("--------------------------------------------------------------");
+    log("Pixel conversions of %d pixels, SIMD %s", (int)pixelCount, PixelConversion::isSIMDSupported() ? "supported" : "not supported");
+
+    int mismatches = 0;
+    for (const auto& conversion : s_pixelConversionCases)
+    {
+        ssize_t dataLen = pixelCount * conversion.srcBytes;
+        ssize_t outLen = pixelCount * conversion.dstBytes;
+
+        PixelConversion::setSIMDEnabled(false);
+        float scalarMs = measureMilliseconds([&]() { conversion.func(src.data(), dataLen, scalarOut.data()); });
+        PixelConversion::setSIMDEnabled(true);
+        float simdMs = measureMilliseconds([&]() { conversion.func(src.data(), dataLen, simdOut.data()); });
+
+        bool exact = memcmp(scalarOut.data(), simdOut.data(), outLen) == 0;
+        mismatches += exact ? 0 : 1;
+        log("%-20s scalar %7.3f ms, SIMD %7.3f ms, x%.2f, %s",
+            conversion.name, scalarMs, simdMs, scalarMs / simdMs, exact ? "bit-exact" : "MISMATCH");
+    }
+
+    // premultiplication is in place, start from the same pixels each run
+    PixelConversion::setSIMDEnabled(false);
+    float scalarMs = measureMilliseconds([&]() {
+        memcpy(scalarOut.data(), src.data(), pixelCount * 4);
+        PixelConversion::premultiplyAlpha(scalarOut.data(), pixelCount * 4);
+    });
+    PixelConversion::setSIMDEnabled(true);
+    float simdMs = measureMilliseconds([&]() {
+        memcpy(simdOut.data(), src.data(), pixelCount * 4);
+        PixelConversion::premultiplyAlpha(simdOut.data(), pixelCount * 4);
+    });
+    bool exact = memcmp(scalarOut.data(), simdOut.data(), pixelCount * 4) == 0;
+    mismatches += exact ? 0 : 1;
+    log("%-20s scalar %7.3f ms, SIMD %7.3f ms, x%.2f, %s",
+        "premultiply alpha", scalarMs, simdMs, scalarMs / simdMs, exact ? "bit-exact" : "MISMATCH");
+
+    log("%d mismatches", mismatches);
+    PixelConversion::setSIMDEnabled(wasEnabled);
+}
+
+std::string TexturePixelConversionPerfTest::title() const
+{
+    return "Texture Pixel Conversion Perf Test";
+}
+
+std::string TexturePixelConversionPerfTest::subtitle() const
+{
+    return "Scalar vs SIMD conversions, see console";
+}
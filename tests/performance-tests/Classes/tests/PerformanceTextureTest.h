@@ -2,6 +2,7 @@
 #define __PERFORMANCE_TEXTURE_TEST_H__
 
 #include "BaseTest.h"
+#include <chrono>
 
 DEFINE_TEST_SUITE(PerformceTextureTests);
 
@@ -18,4 +19,42 @@ public:
     virtual void onEnter() override;
 };
 
+class TextureAsyncDecodePerfTest : public TestCase
+{
+public:
+    CREATE_FUNC(TextureAsyncDecodePerfTest);
+
+    TextureAsyncDecodePerfTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+protected:
+    // loads all the images with addImageAsync, using _workerCount decode workers
+    void startRun();
+    void imageLoaded(cocos2d::Texture2D* texture);
+
+    std::vector<std::string> _images;
+    int _workerCount;
+    int _loadedCount;
+    size_t _decodedBytes;
+    std::chrono::steady_clock::time_point _runStart;
+};
+
+class TexturePixelConversionPerfTest : public TestCase
+{
+public:
+    CREATE_FUNC(TexturePixelConversionPerfTest);
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onEnter() override;
+
+protected:
+    // runs every conversion with the SIMD conversions disabled and enabled, and compares the results
+    void performTests();
+};
+
 #endif
@@ -13,6 +13,7 @@
 #include "PerformanceScenarioTest.h"
 #include "PerformanceCallbackTest.h"
 #include "PerformanceMathTest.h"
+#include "PerformanceRendererTest.h"
 #include "PerformanceContainerTest.h"
 
 #endif
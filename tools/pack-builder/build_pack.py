@@ -0,0 +1,160 @@
+#!/usr/bin/python
+#-*- coding: UTF-8 -*-
+# ----------------------------------------------------------------------------
+# Build a pack file (.cpk) from a resources directory.
+#
+# License: MIT
+# ----------------------------------------------------------------------------
+'''
+Build a pack file (.cpk) from a resources directory.
+
+A pack file is read by cocos2d::PackFile, see cocos/platform/CCPackFile.h for its layout.
+'''
+
+import os
+import struct
+import sys
+import zlib
+
+from argparse import ArgumentParser
+
+PACK_MAGIC = b'CCPK'
+PACK_VERSION = 1
+NO_ENTRY = 0xFFFFFFFF
+
+HEADER_FORMAT = '<4s7I'
+# hash, next, name offset, name length, compression, reserved, data offset, stored size, size
+ENTRY_FORMAT = '<3IHBBQ2I'
+DATA_ALIGNMENT = 16
+MAX_NAME_LENGTH = 0xFFFF
+
+# compression methods of the entries
+COMPRESSION_NONE = 0
+COMPRESSION_ZLIB = 1
+
+# formats which are compressed already, deflating them wastes load time for nothing
+STORED_EXTENSIONS = [
+    '.png', '.jpg', '.jpeg', '.webp', '.pkm', '.pvr.ccz', '.ccz', '.gz', '.zip',
+    '.mp3', '.ogg', '.m4a', '.caf', '.mp4', '.ttf', '.otf'
+]
+
+class KnownException(Exception):
+    pass
+
+def hash_name(name):
+    '''FNV-1a, like PackFile::hashName().'''
+    h = 2166136261
+    for byte in bytearray(name):
+        h ^= byte
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+def align(offset, alignment):
+    return (offset + alignment - 1) // alignment * alignment
+
+def collect_files(res_dir):
+    files = []
+    for root, dirs, names in os.walk(res_dir):
+        # skip hidden files and directories, like .svn or .DS_Store
+        dirs[:] = sorted(d for d in dirs if not d.startswith('.'))
+        for name in sorted(names):
+            if name.startswith('.'):
+                continue
+            full_path = os.path.join(root, name)
+            rel_path = os.path.relpath(full_path, res_dir).replace(os.sep, '/')
+            files.append((rel_path, full_path))
+    return files
+
+def should_compress(name, args):
+    if args.no_compress:
+        return False
+    lower = name.lower()
+    return not any(lower.endswith(ext) for ext in STORED_EXTENSIONS)
+
+def build_pack(res_dir, output, args):
+    if not os.path.isdir(res_dir):
+        raise KnownException('%s is not a directory' % res_dir)
+
+    files = collect_files(res_dir)
+    if len(files) >= NO_ENTRY:
+        raise KnownException('too many files')
+
+    entries = []
+    for rel_path, full_path in files:
+        with open(full_path, 'rb') as f:
+            data = f.read()
+        stored = data
+        compression = COMPRESSION_NONE
+        if should_compress(rel_path, args) and len(data) > 0:
+            compressed = zlib.compress(data, args.level)
+            # keep the compressed data only if it saves enough
+            if len(compressed) < len(data) and len(compressed) <= len(data) * args.max_ratio:
+                stored = compressed
+                compression = COMPRESSION_ZLIB
+        if len(data) > 0xFFFFFFFF:
+            raise KnownException('%s is larger than 4GB' % rel_path)
+        name = rel_path.encode('utf-8')
+        if len(name) > MAX_NAME_LENGTH:
+            raise KnownException('the name of %s is longer than %d bytes' % (rel_path, MAX_NAME_LENGTH))
+        entries.append({ 'name' : name, 'data' : data, 'stored' : stored, 'compression' : compression })
+
+    # at most one entry per bucket on average, and at least 2 buckets to keep the entries 8 byte aligned
+    bucket_count = 2
+    while bucket_count < len(entries):
+        bucket_count *= 2
+    buckets = [NO_ENTRY] * bucket_count
+
+    names = b''
+    for index, entry in enumerate(entries):
+        entry['hash'] = hash_name(entry['name'])
+        entry['name_offset'] = len(names)
+        names += entry['name']
+        # chain the entries of a bucket
+        bucket = entry['hash'] & (bucket_count - 1)
+        entry['next'] = buckets[bucket]
+        buckets[bucket] = index
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    entry_size = struct.calcsize(ENTRY_FORMAT)
+    names_offset = header_size + bucket_count * 4 + len(entries) * entry_size
+
+    offset = align(names_offset + len(names), DATA_ALIGNMENT)
+    for entry in entries:
+        entry['data_offset'] = offset
+        offset = align(offset + len(entry['stored']), DATA_ALIGNMENT)
+
+    with open(output, 'wb') as f:
+        f.write(struct.pack(HEADER_FORMAT, PACK_MAGIC, PACK_VERSION, len(entries), bucket_count, names_offset, 0, 0, 0))
+        f.write(struct.pack('<%dI' % bucket_count, *buckets))
+        for entry in entries:
+            f.write(struct.pack(ENTRY_FORMAT, entry['hash'], entry['next'], entry['name_offset'], len(entry['name']),
+                                entry['compression'], 0, entry['data_offset'], len(entry['stored']), len(entry['data'])))
+        f.write(names)
+        for entry in entries:
+            f.write(b'\0' * (entry['data_offset'] - f.tell()))
+            f.write(entry['stored'])
+
+    total_size = sum(len(entry['data']) for entry in entries)
+    compressed_count = sum(1 for entry in entries if entry['compression'] != COMPRESSION_NONE)
+    print('%s: %d files, %d compressed, %d bytes -> %d bytes' % (output, len(entries), compressed_count, total_size, offset))
+    if args.verbose:
+        for entry in entries:
+            print('  %s %d -> %d' % (entry['name'].decode('utf-8'), len(entry['data']), len(entry['stored'])))
+
+if __name__ == '__main__':
+    parser = ArgumentParser(description="Build a pack file (.cpk) from a resources directory.")
+    parser.add_argument('res_dir', help='the resources directory, the names of the entries are relative to it')
+    parser.add_argument('output', help='the pack file to write, e.g. res.cpk')
+    parser.add_argument('-l', '--level', dest='level', type=int, default=9, help='the zlib compression level, 1 to 9')
+    parser.add_argument('-r', '--max-ratio', dest='max_ratio', type=float, default=0.9,
+                        help='store a file compressed only if its compressed size is at most this ratio of its size, and smaller than it')
+    parser.add_argument('-n', '--no-compress', dest='no_compress', action='store_true',
+                        help='store all the files uncompressed, so they can all be memory mapped')
+    parser.add_argument('-v', '--verbose', dest='verbose', action='store_true', help='print every entry')
+    args = parser.parse_args()
+
+    try:
+        build_pack(args.res_dir, args.output, args)
+    except KnownException as e:
+        print(e)
+        sys.exit(1)